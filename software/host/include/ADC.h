@@ -0,0 +1,59 @@
+// Host-side stand-in for the pedvide ADC library used by oc::ADC. Conversions
+// complete instantly and return whatever the host HAL reports for the pin
+// (see host::SetAnalogInput), so oc::ADC::Scan runs unmodified. With DMA
+// enabled on ADC0 the HAL runs conversions in simulated time instead.
+
+#pragma once
+
+#include <stdint.h>
+#include "settings_defines.h"
+
+class ADC_Module {
+public:
+  explicit ADC_Module(uint8_t num) : num_(num) { }
+
+  void setReference(ADC_settings::ADC_REFERENCE) { }
+  void setResolution(uint8_t bits) { resolution_ = bits; }
+  uint8_t getResolution() const { return resolution_; }
+  void setConversionSpeed(ADC_settings::ADC_CONVERSION_SPEED) { }
+  void setSamplingSpeed(ADC_settings::ADC_SAMPLING_SPEED) { }
+  void setAveraging(uint8_t num);
+  void enableDMA();
+  void disableDMA();
+  void enableInterrupts(void (*)(void), uint8_t = 255) { }
+  void disableInterrupts() { }
+  void disableCompare() { }
+
+  bool startSingleRead(uint8_t pin) { pin_ = pin; return true; }
+  bool isComplete() const { return true; }
+  int readSingle() const;
+
+  uint16_t fail_flag = 0;
+
+private:
+  const uint8_t num_;
+  uint8_t resolution_ = 16;
+  uint8_t pin_ = 0;
+};
+
+class ADC {
+public:
+  ADC() : adc0(&adc0_), adc1(&adc1_), adc0_(ADC_0), adc1_(ADC_1) { }
+
+  ADC_Module *const adc0;
+  ADC_Module *const adc1;
+
+  bool startSingleRead(uint8_t pin, int8_t adc_num = -1) {
+    return (adc_num == ADC_1 ? adc1 : adc0)->startSingleRead(pin);
+  }
+  int readSingle(int8_t adc_num = -1) {
+    return (adc_num == ADC_1 ? adc1 : adc0)->readSingle();
+  }
+  bool isComplete(int8_t adc_num = -1) {
+    return (adc_num == ADC_1 ? adc1 : adc0)->isComplete();
+  }
+
+private:
+  ADC_Module adc0_;
+  ADC_Module adc1_;
+};
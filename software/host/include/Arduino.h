@@ -0,0 +1,164 @@
+// Host-side stand-in for the Teensyduino core headers.
+//
+// Only the subset of the Arduino/Teensy API that the firmware actually uses is
+// provided. Time, pins and the "hardware" registers are backed by the host HAL
+// (see host/hal.h) so the virtual module can drive them deterministically.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "kinetis.h"
+#include "usb_midi.h"
+
+#ifndef F_CPU
+#define F_CPU 120000000
+#endif
+#ifndef F_BUS
+#define F_BUS 60000000
+#endif
+
+#define FASTRUN
+#define PROGMEM
+#define DMAMEM
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+#define OUTPUT_OPENDRAIN 4
+#define INPUT_DISABLE 5
+
+#define RISING 2
+#define FALLING 3
+#define CHANGE 4
+
+#define CORE_NUM_DIGITAL 34
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+/* ---- time ---- */
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+static inline void yield() { }
+
+class elapsedMillis {
+public:
+  elapsedMillis() : ms_(millis()) { }
+  elapsedMillis(uint32_t val) : ms_(millis() - val) { }
+  operator uint32_t() const { return millis() - ms_; }
+  elapsedMillis &operator=(uint32_t val) { ms_ = millis() - val; return *this; }
+private:
+  uint32_t ms_;
+};
+
+class elapsedMicros {
+public:
+  elapsedMicros() : us_(micros()) { }
+  elapsedMicros(uint32_t val) : us_(micros() - val) { }
+  operator uint32_t() const { return micros() - us_; }
+  elapsedMicros &operator=(uint32_t val) { us_ = micros() - val; return *this; }
+private:
+  uint32_t us_;
+};
+
+/* ---- pins ---- */
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+uint8_t digitalRead(uint8_t pin);
+static inline void digitalWriteFast(uint8_t pin, uint8_t value) { digitalWrite(pin, value); }
+static inline uint8_t digitalReadFast(uint8_t pin) { return digitalRead(pin); }
+int analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+static inline void interrupts() { }
+static inline void noInterrupts() { }
+static inline void __disable_irq() { }
+static inline void __enable_irq() { }
+
+/* ---- random ---- */
+
+void randomSeed(uint32_t seed);
+int32_t random(int32_t howbig);
+int32_t random(int32_t howsmall, int32_t howbig);
+static inline int32_t random(uint32_t howbig) { return random((int32_t)howbig); }
+static inline int32_t random(int howsmall, uint32_t howbig) { return random((int32_t)howsmall, (int32_t)howbig); }
+
+/* ---- math helpers ---- */
+
+#ifdef __cplusplus
+template <class A, class B>
+constexpr auto min(const A &a, const B &b) -> decltype(a < b ? a : b) { return a < b ? a : b; }
+template <class A, class B>
+constexpr auto max(const A &a, const B &b) -> decltype(a > b ? a : b) { return a > b ? a : b; }
+#endif
+
+#define constrain(amt, low, high) ({ \
+  typeof(amt) _amt = (amt); \
+  typeof(low) _low = (low); \
+  typeof(high) _high = (high); \
+  (_amt < _low) ? _low : ((_amt > _high) ? _high : _amt); \
+})
+
+static inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/* ---- serial ---- */
+
+class usb_serial_class {
+public:
+  void begin(long) { }
+  int available() { return 0; }
+  int read() { return -1; }
+  void flush() { }
+  size_t print(const char *s);
+  size_t print(char c);
+  size_t print(int n);
+  size_t print(unsigned n);
+  size_t print(long n);
+  size_t print(unsigned long n);
+  size_t print(double n, int digits = 2);
+  size_t println();
+  template <typename T> size_t println(const T &t) { size_t n = print(t); return n + println(); }
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+  operator bool() const { return true; }
+};
+extern usb_serial_class Serial;
+
+/* ---- timers ---- */
+
+class IntervalTimer {
+public:
+  IntervalTimer() : fn_(nullptr), period_us_(0), priority_(128) { }
+  bool begin(void (*fn)(), uint32_t period_us);
+  void end();
+  void priority(uint8_t priority) { priority_ = priority; }
+
+  void (*fn() const)() { return fn_; }
+  uint32_t period_us() const { return period_us_; }
+
+private:
+  void (*fn_)();
+  uint32_t period_us_;
+  uint8_t priority_;
+};
+
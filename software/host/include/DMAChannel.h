@@ -0,0 +1,148 @@
+// Host-side stand-in for the Teensyduino DMAChannel.
+//
+// For channels triggered by a peripheral, the host HAL calls HostRequest when
+// the emulated peripheral would raise a DMA request; that moves one element and
+// follows any channel links, as does triggerManual. This is enough for the ADC
+// sequence in oc::ADC and the DAC transfers in oc::DAC. Writes to SPI0_PUSHR
+// are passed on to the emulated SPI0 in the host HAL.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "kinetis.h"
+
+class DMAChannel {
+public:
+  void begin(bool = false) { }
+
+  void destination(volatile uint8_t &p) { SetRegister(dst_, &p, 1); }
+  void destination(volatile uint16_t &p) { SetRegister(dst_, &p, 2); }
+  void destination(volatile uint32_t &p) { SetRegister(dst_, &p, 4); }
+  void destinationBuffer(volatile uint16_t p[], unsigned int len) { SetBuffer(dst_, p, 2, len); }
+  void source(volatile const uint8_t &p) { SetRegister(src_, &p, 1); }
+  void source(volatile const uint16_t &p) { SetRegister(src_, &p, 2); }
+  void source(volatile const uint32_t &p) { SetRegister(src_, &p, 4); }
+  void sourceBuffer(const uint8_t *p, unsigned int len) { SetBuffer(src_, p, 1, len); }
+  void sourceBuffer(const uint16_t *p, unsigned int len) { SetBuffer(src_, p, 2, len); }
+  void sourceBuffer(const uint32_t *p, unsigned int len) { SetBuffer(src_, p, 4, len); }
+  void transferSize(unsigned int) { }
+  void transferCount(unsigned int count) { count_ = count; }
+  void disableOnCompletion() { disable_on_completion_ = true; }
+  void interruptAtCompletion() { }
+  void triggerAtHardwareEvent(uint8_t source) { Register(source); }
+  void detachTrigger() { source_ = -1; }
+  void triggerAtTransfersOf(DMAChannel &ch) { ch.minor_link_ = this; }
+  void triggerAtCompletionOf(DMAChannel &ch) { ch.major_link_ = this; }
+  void triggerManual() { Transfer(); }
+  void attachInterrupt(void (*)(void)) { }
+  void enable() { enabled_ = true; }
+  void disable() { enabled_ = false; }
+  void clearComplete() { complete_ = false; }
+  void clearInterrupt() { }
+  bool complete() const { return complete_; }
+  bool enabled() const { return enabled_; }
+
+  void *sourceAddress() const { return Address(src_); }
+  void *destinationAddress() const { return Address(dst_); }
+
+  // Peripheral DMA request for the given DMAMUX source
+  static void HostRequest(uint8_t source) {
+    for (DMAChannel *channel : channels_) {
+      if (channel && channel->source_ == source && channel->enabled_)
+        channel->Transfer();
+    }
+  }
+
+private:
+  struct End {
+    volatile void *address = nullptr;
+    size_t size = 0;
+    size_t length = 0; // bytes, 0 for a register
+    size_t offset = 0;
+  };
+
+  End src_, dst_;
+  size_t count_ = 0; // minor loops per major loop, 0 = until a buffer wraps
+  size_t iteration_ = 0;
+  bool enabled_ = false;
+  bool disable_on_completion_ = false;
+  bool complete_ = false;
+  int source_ = -1;
+  DMAChannel *minor_link_ = nullptr;
+  DMAChannel *major_link_ = nullptr;
+
+  static constexpr size_t kNumChannels = 16;
+  static inline DMAChannel *channels_[kNumChannels] = { };
+
+  static void SetRegister(End &end, volatile const void *p, size_t size) {
+    end.address = const_cast<volatile void *>(p);
+    end.size = size;
+    end.length = 0;
+    end.offset = 0;
+  }
+
+  void SetBuffer(End &end, volatile const void *p, size_t size, size_t len) {
+    SetRegister(end, p, size);
+    end.length = len;
+    count_ = len / size;
+    iteration_ = 0;
+  }
+
+  static void *Address(const End &end) {
+    return (uint8_t *)end.address + end.offset;
+  }
+
+  static bool Advance(End &end) {
+    if (!end.length)
+      return false;
+    end.offset += end.size;
+    if (end.offset < end.length)
+      return false;
+    end.offset = 0;
+    return true;
+  }
+
+  void Register(uint8_t source) {
+    source_ = source;
+    for (DMAChannel *&channel : channels_) {
+      if (channel == this) return;
+    }
+    for (DMAChannel *&channel : channels_) {
+      if (!channel) { channel = this; return; }
+    }
+  }
+
+  // One minor loop of one element, then the linked channel; the major loop is
+  // complete after count_ minor loops, or when a buffer side wraps around.
+  void Transfer() {
+    if (!enabled_ || !src_.address || !dst_.address)
+      return;
+    uint32_t value = 0;
+    memcpy(&value, Address(src_), src_.size);
+    void *destination = Address(dst_);
+    memcpy(destination, &value, dst_.size);
+
+    bool major_complete = Advance(src_);
+    major_complete |= Advance(dst_);
+    if (count_ && ++iteration_ >= count_) {
+      major_complete = true;
+      src_.offset = dst_.offset = 0;
+    }
+    if (major_complete) {
+      iteration_ = 0;
+      complete_ = true;
+      if (disable_on_completion_)
+        enabled_ = false;
+    }
+    DMAChannel *link = major_complete ? major_link_ : minor_link_;
+    if (link)
+      link->Transfer();
+
+    // The frame goes out after the channel has moved on, so a request from
+    // SPI0 that links back here moves the next element
+    if (destination == const_cast<uint32_t *>(&SPI0_PUSHR))
+      host::SPI0Push(value);
+  }
+};
@@ -0,0 +1,57 @@
+// Host-side stand-in for the Teensyduino EEPROM library, backed by a RAM
+// array. The virtual module can load/save the contents from/to a file so that
+// settings survive between runs.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace host {
+static constexpr size_t kEEPROMSize = 2048;
+extern uint8_t eeprom_memory[kEEPROMSize];
+extern uint32_t eeprom_writes;
+};
+
+struct EERef {
+  EERef(const int index) : index(index) { }
+
+  uint8_t operator*() const { return host::eeprom_memory[index % host::kEEPROMSize]; }
+  operator uint8_t() const { return **this; }
+
+  EERef &operator=(const EERef &ref) { return *this = *ref; }
+  EERef &operator=(uint8_t in) {
+    host::eeprom_memory[index % host::kEEPROMSize] = in;
+    ++host::eeprom_writes;
+    return *this;
+  }
+  EERef &update(uint8_t in) { return in != *this ? *this = in : *this; }
+
+  int index;
+};
+
+struct EEPtr {
+  EEPtr(const int index) : index(index) { }
+
+  operator int() const { return index; }
+  EEPtr &operator=(int in) { index = in; return *this; }
+  bool operator!=(const EEPtr &ptr) { return index != ptr.index; }
+  EERef operator*() { return index; }
+
+  EEPtr &operator++() { ++index; return *this; }
+  EEPtr &operator--() { --index; return *this; }
+  EEPtr operator++(int) { return index++; }
+  EEPtr operator--(int) { return index--; }
+
+  int index;
+};
+
+struct EEPROMClass {
+  uint8_t read(int idx) { return EERef(idx); }
+  void write(int idx, uint8_t val) { (EERef(idx)) = val; }
+  void update(int idx, uint8_t val) { EERef(idx).update(val); }
+  EERef operator[](const int idx) { return idx; }
+  uint16_t length() { return host::kEEPROMSize; }
+};
+
+extern EEPROMClass EEPROM;
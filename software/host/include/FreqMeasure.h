@@ -0,0 +1,20 @@
+// Host-side stand-in for the FreqMeasure library (FTM input capture on TR4).
+// The host can feed it capture counts; by default nothing is ever available.
+
+#pragma once
+
+#include <stdint.h>
+
+class FreqMeasureClass {
+public:
+  static void begin();
+  static uint8_t available();
+  static uint32_t read();
+  static float countToFrequency(uint32_t count);
+  static void end();
+
+  // Host-side: queue a measured period, in F_BUS cycles
+  static void Inject(uint32_t count);
+};
+
+extern FreqMeasureClass FreqMeasure;
@@ -0,0 +1,29 @@
+// Host-side stand-in for the Teensy SPIFIFO helper. Every word written is
+// forwarded to the host HAL together with the current chip-select pin, so the
+// DAC command stream can be captured and inspected.
+
+#pragma once
+
+#include <stdint.h>
+
+#define SPI_CONTINUE 1
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+#define SPI_CLOCK_24MHz 0
+#define SPI_CLOCK_12MHz 1
+
+class SPIFIFOclass {
+public:
+  void begin(uint8_t pin, uint32_t speed, uint32_t mode = SPI_MODE0);
+  void write(uint32_t b, uint32_t cont = 0);
+  void write16(uint32_t b, uint32_t cont = 0);
+  uint32_t read() { return 0; }
+  void clear() { }
+
+private:
+  uint8_t cs_pin_ = 0;
+};
+
+extern SPIFIFOclass SPIFIFO;
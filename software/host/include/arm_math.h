@@ -0,0 +1,11 @@
+// Host-side stand-in for the CMSIS intrinsics used by util/sync.h. The virtual
+// module runs "interrupts" on the same thread, so plain loads/stores suffice.
+
+#pragma once
+
+#include <stdint.h>
+
+static inline void __DMB() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline uint32_t __LDREXW(volatile uint32_t *addr) { return *addr; }
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) { *addr = value; return 0; }
+static inline void __CLREX() { }
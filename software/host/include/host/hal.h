@@ -0,0 +1,48 @@
+// Host HAL for the virtual module.
+//
+// The stand-in Teensy headers in host/include are backed by the state here.
+// Simulated time only advances when the host says so, which keeps runs
+// deterministic: the virtual module advances it by one core ISR period per
+// tick, and everything that reads millis()/micros() follows along.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace host {
+
+// Simulated time
+void AdvanceMicros(uint32_t us);
+
+// Inputs. Analog values are raw 16-bit ADC readings (as returned by the ADC
+// library before oc::ADC shifts them down); digital levels are the pin level,
+// so remember the trigger inputs are active low. Changing a digital input
+// fires the handler registered with attachInterrupt on a matching edge; with
+// delay_us the edge is timestamped that far after the current time.
+void SetAnalogInput(uint8_t pin, uint16_t value);
+// Replay recorded readings instead: every conversion of the pin takes the next
+// sample, wrapping around at the end. An empty set goes back to the value from
+// SetAnalogInput.
+void SetAnalogSamples(uint8_t pin, const uint16_t *samples, size_t count);
+void SetDigitalInput(uint8_t pin, uint8_t level, uint32_t delay_us = 0);
+
+// Convert a voltage in mV into the raw reading of an uncalibrated CV input
+uint16_t MillivoltsToADC(int32_t mv);
+
+// SPI capture: called for every word pushed through SPIFIFO or written to
+// SPI0_PUSHR by DMA, together with the chip select that was configured with
+// SPIFIFO.begin.
+typedef void (*SPIHandler)(uint8_t cs_pin, uint32_t word, bool is16);
+void SetSPIHandler(SPIHandler handler);
+
+// Display capture: the host SH1106 driver keeps a copy of the panel RAM.
+static constexpr size_t kDisplayWidth = 128;
+static constexpr size_t kDisplayHeight = 64;
+const uint8_t *display_ram();
+uint32_t display_pages_sent();
+
+// Write the display contents as a plain PBM (P1) image
+bool WriteDisplayPBM(const char *filename);
+
+};  // namespace host
@@ -0,0 +1,37 @@
+// Firmware lifecycle on the host: boot, tick, and drive the module's jacks.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace host {
+
+// Equivalent of setup() without the splash screen, which busy-waits on the
+// display ISR. The CV inputs idle at 0V and the trigger inputs are released.
+void BootModule();
+
+// One core ISR period: advance time, run the core ISR, the UI ISR when it is
+// due, then one pass of the main loop.
+void TickModule();
+
+// As TickModule, but only the ISRs
+void TickISRs();
+
+// After every frame the display driver completes, check that the panel RAM
+// matches the frame, i.e. that skipping unchanged pages gives the same result
+// as a full redraw. Mismatches are reported on stderr and counted.
+void EnableDisplayCheck(bool enable);
+uint32_t display_check_failures();
+
+// Switch to the app with the given two-character id (e.g. "HS")
+bool SelectApp(const char *twocc);
+
+// Jack-level inputs, channels are 0-3
+void SetCVInput(int channel, int32_t mv);
+// Replay a recording at the ADC's conversion rate instead, see SetAnalogSamples
+void SetCVSamples(int channel, const int32_t *mv, size_t count);
+void SetTriggerInput(int channel, bool high, uint32_t delay_us = 0);
+void SetButton(uint8_t pin, bool pressed);
+
+};  // namespace host
@@ -0,0 +1,110 @@
+// Host-side stand-ins for the MK20 peripheral registers touched by the
+// firmware. Writes land in plain variables and are otherwise ignored; the
+// drivers that would busy-wait on status registers are replaced by host
+// implementations instead (see host/src).
+
+#pragma once
+
+#include <stdint.h>
+
+namespace host {
+namespace regs {
+extern volatile uint32_t SIM_SCGC2, SIM_SCGC6;
+extern volatile uint8_t VREF_TRM, VREF_SC;
+extern volatile uint8_t DAC0_C0;
+extern volatile uint16_t DAC0_DAT0;
+extern volatile uint32_t PORT_PCR[64];
+extern volatile uint32_t GPIO_PDDR[64];
+extern volatile uint32_t SPI0_MCR, SPI0_CTAR0, SPI0_CTAR1, SPI0_SR, SPI0_RSER, SPI0_PUSHR, SPI0_POPR;
+extern volatile uint32_t ARM_DEMCR, ARM_DWT_CTRL;
+extern volatile uint32_t ADC0_SC1A, ADC0_CFG2, ADC0_RA, ADC0_SC2;
+}; // namespace regs
+
+// Free-running cycle counter at F_CPU, derived from the host's monotonic clock
+uint32_t CycleCount();
+// Cycle counter in simulated time, for timestamps that end up in the output
+uint32_t SimulatedCycleCount();
+// Emulated SPI0: a word written to SPI0_PUSHR by DMA is sent immediately and
+// raises DMAMUX_SOURCE_SPI0_RX if RX FIFO DMA requests are enabled in RSER
+void SPI0Push(uint32_t pushr);
+}; // namespace host
+
+#define SIM_SCGC2 host::regs::SIM_SCGC2
+#define SIM_SCGC6 host::regs::SIM_SCGC6
+#define SIM_SCGC2_DAC0 ((uint32_t)0x00001000)
+#define SIM_SCGC6_SPI0 ((uint32_t)0x00001000)
+
+#define VREF_TRM host::regs::VREF_TRM
+#define VREF_SC host::regs::VREF_SC
+
+#define DAC0_C0 host::regs::DAC0_C0
+#define DAC0_DAT0L (*(volatile uint8_t *)&host::regs::DAC0_DAT0)
+#define DAC_C0_DACEN ((uint8_t)0x80)
+
+#define PORT_PCR_DSE ((uint32_t)0x00000040)
+#define PORT_PCR_ODE ((uint32_t)0x00000020)
+#define PORT_PCR_PE ((uint32_t)0x00000002)
+#define PORT_PCR_PS ((uint32_t)0x00000001)
+#define PORT_PCR_MUX(n) ((uint32_t)(((n) & 7) << 8))
+#define CORE_PIN11_CONFIG host::regs::PORT_PCR[11]
+#define CORE_PIN13_CONFIG host::regs::PORT_PCR[13]
+
+#define portConfigRegister(pin) (&host::regs::PORT_PCR[(pin) & 63])
+#define portModeRegister(pin) (&host::regs::GPIO_PDDR[(pin) & 63])
+#define digitalPinToBitMask(pin) (1U)
+
+#define SPI0_MCR host::regs::SPI0_MCR
+#define SPI0_CTAR0 host::regs::SPI0_CTAR0
+#define SPI0_CTAR1 host::regs::SPI0_CTAR1
+#define SPI0_SR host::regs::SPI0_SR
+#define SPI0_RSER host::regs::SPI0_RSER
+#define SPI0_PUSHR host::regs::SPI0_PUSHR
+#define SPI0_POPR host::regs::SPI0_POPR
+
+#define SPI_MCR_MSTR ((uint32_t)0x80000000)
+#define SPI_MCR_MDIS ((uint32_t)0x00004000)
+#define SPI_MCR_HALT ((uint32_t)0x00000001)
+#define SPI_MCR_CLR_TXF ((uint32_t)0x00000800)
+#define SPI_MCR_CLR_RXF ((uint32_t)0x00000400)
+#define SPI_MCR_PCSIS(n) (((n) & 0x1F) << 16)
+#define SPI_CTAR_DBR ((uint32_t)0x80000000)
+#define SPI_CTAR_FMSZ(n) (((n) & 15) << 27)
+#define SPI_CTAR_PBR(n) (((n) & 3) << 16)
+#define SPI_CTAR_BR(n) (((n) & 15) << 0)
+#define SPI_SR_TCF ((uint32_t)0x80000000)
+#define SPI_SR_RXCTR ((uint32_t)0x000000F0)
+#define SPI_RSER_TFFF_RE ((uint32_t)0x02000000)
+#define SPI_RSER_TFFF_DIRS ((uint32_t)0x01000000)
+#define SPI_RSER_RFDF_RE ((uint32_t)0x00020000)
+#define SPI_RSER_RFDF_DIRS ((uint32_t)0x00010000)
+#define SPI_PUSHR_CONT ((uint32_t)0x80000000)
+#define SPI_PUSHR_CTAS(n) (((n) & 7) << 28)
+#define SPI_PUSHR_PCS(n) (((n) & 31) << 16)
+
+#define ARM_DEMCR host::regs::ARM_DEMCR
+#define ARM_DEMCR_TRCENA (1 << 24)
+#define ARM_DWT_CTRL host::regs::ARM_DWT_CTRL
+#define ARM_DWT_CTRL_CYCCNTENA (1 << 0)
+#define ARM_DWT_CYCCNT (host::CycleCount())
+#define OC_EDGE_TIMESTAMP() (host::SimulatedCycleCount())
+
+#define IRQ_PORTA 0
+#define IRQ_PORTB 1
+#define IRQ_PORTC 2
+#define IRQ_PORTD 3
+#define IRQ_PORTE 4
+#define NVIC_SET_PRIORITY(irqnum, priority) do { (void)(irqnum); (void)(priority); } while (0)
+
+#define DMAMUX_SOURCE_SPI0_RX 14
+#define DMAMUX_SOURCE_SPI0_TX 15
+#define DMAMUX_SOURCE_ADC0 40
+
+// ADC0 is emulated while DMA is enabled: every conversion reads the channel
+// in ADC0_SC1A, puts the result in ADC0_RA and raises DMAMUX_SOURCE_ADC0.
+#define ADC0_SC1A host::regs::ADC0_SC1A
+#define ADC0_CFG2 host::regs::ADC0_CFG2
+#define ADC0_RA host::regs::ADC0_RA
+#define ADC0_SC2 host::regs::ADC0_SC2
+#define ADC_SC1_ADCH(n) ((uint32_t)(((n) & 0x1F) << 0))
+#define ADC_CFG2_MUXSEL ((uint32_t)0x10)
+#define ADC_SC2_DMAEN ((uint32_t)0x04)
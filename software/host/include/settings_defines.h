@@ -0,0 +1,18 @@
+// Host-side stand-in for the ADC library's settings_defines.h
+
+#pragma once
+
+#include <stdint.h>
+
+#define ADC_0 0
+#define ADC_1 1
+
+namespace ADC_settings {
+enum class ADC_REFERENCE : uint8_t { REF_3V3, REF_1V2, REF_EXT, NONE };
+enum class ADC_SAMPLING_SPEED : uint8_t {
+  VERY_LOW_SPEED, LOW_SPEED, LOW_MED_SPEED, MED_SPEED, MED_HIGH_SPEED, HIGH_SPEED, HIGH_VERY_HIGH_SPEED, VERY_HIGH_SPEED
+};
+enum class ADC_CONVERSION_SPEED : uint8_t {
+  VERY_LOW_SPEED, LOW_SPEED, MED_SPEED, HIGH_SPEED_16BITS, HIGH_SPEED, VERY_HIGH_SPEED, ADACK_2_4, ADACK_4_0, ADACK_5_2, ADACK_6_2
+};
+};
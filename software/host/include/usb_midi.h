@@ -0,0 +1,98 @@
+// Host-side stand-in for the Teensyduino usbMIDI object. Incoming messages
+// are queued by the host (e.g. from a MIDI script) and outgoing messages are
+// counted and optionally logged, so MIDI apps can run in the virtual module.
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class usb_midi_class {
+public:
+  enum MidiType : uint8_t {
+    InvalidType = 0x00,
+    NoteOff = 0x80,
+    NoteOn = 0x90,
+    AfterTouchPoly = 0xA0,
+    ControlChange = 0xB0,
+    ProgramChange = 0xC0,
+    AfterTouchChannel = 0xD0,
+    PitchBend = 0xE0,
+    SystemExclusive = 0xF0,
+    TimeCodeQuarterFrame = 0xF1,
+    SongPosition = 0xF2,
+    SongSelect = 0xF3,
+    TuneRequest = 0xF6,
+    Clock = 0xF8,
+    Start = 0xFA,
+    Continue = 0xFB,
+    Stop = 0xFC,
+    ActiveSensing = 0xFE,
+    SystemReset = 0xFF,
+  };
+
+  static constexpr size_t kSysExMaxSize = 290;
+
+  struct Message {
+    uint8_t type;
+    uint8_t channel; // 1-16
+    uint8_t data1;
+    uint8_t data2;
+  };
+
+  // Host-side
+
+  // Queue a message to be returned by a later ::read call
+  bool Inject(const Message &message);
+  // Queue a sysex message (without framing F0/F7)
+  bool InjectSysEx(const uint8_t *data, size_t length);
+  void set_tx_handler(void (*handler)(const Message &)) { tx_handler_ = handler; }
+  uint32_t tx_count() const { return tx_count_; }
+  uint32_t rx_count() const { return rx_count_; }
+  uint32_t read_calls() const { return read_calls_; }
+
+  // Teensyduino API
+
+  bool read(uint8_t channel = 0);
+  uint8_t getType() const { return current_.type; }
+  uint8_t getChannel() const { return current_.channel; }
+  uint8_t getData1() const { return current_.data1; }
+  uint8_t getData2() const { return current_.data2; }
+  uint8_t *getSysExArray() { return sysex_; }
+  uint16_t getSysExArrayLength() const { return sysex_length_; }
+
+  void sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t cable = 0) { send(NoteOff, note, velocity, channel, cable); }
+  void sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel, uint8_t cable = 0) { send(NoteOn, note, velocity, channel, cable); }
+  void sendPolyPressure(uint8_t note, uint8_t pressure, uint8_t channel, uint8_t cable = 0) { send(AfterTouchPoly, note, pressure, channel, cable); }
+  void sendAfterTouchPoly(uint8_t note, uint8_t pressure, uint8_t channel, uint8_t cable = 0) { send(AfterTouchPoly, note, pressure, channel, cable); }
+  void sendControlChange(uint8_t control, uint8_t value, uint8_t channel, uint8_t cable = 0) { send(ControlChange, control, value, channel, cable); }
+  void sendProgramChange(uint8_t program, uint8_t channel, uint8_t cable = 0) { send(ProgramChange, program, 0, channel, cable); }
+  void sendAfterTouch(uint8_t pressure, uint8_t channel, uint8_t cable = 0) { send(AfterTouchChannel, pressure, 0, channel, cable); }
+  void sendPitchBend(int value, uint8_t channel, uint8_t cable = 0) {
+    value += 8192;
+    send(PitchBend, value & 0x7f, (value >> 7) & 0x7f, channel, cable);
+  }
+  void sendRealTime(uint8_t type, uint8_t cable = 0) { send(type, 0, 0, 0, cable); }
+  void sendSysEx(uint32_t length, const uint8_t *data, bool has_term = false, uint8_t cable = 0);
+  void send(uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel, uint8_t cable);
+  void send_now() { }
+
+private:
+  static constexpr size_t kQueueSize = 256;
+
+  Message queue_[kQueueSize];
+  size_t queue_read_ = 0, queue_write_ = 0;
+  Message current_ = { InvalidType, 0, 0, 0 };
+
+  uint8_t pending_sysex_[kSysExMaxSize];
+  size_t pending_sysex_length_ = 0;
+  uint8_t sysex_[kSysExMaxSize];
+  uint16_t sysex_length_ = 0;
+
+  void (*tx_handler_)(const Message &) = nullptr;
+  uint32_t tx_count_ = 0;
+  uint32_t rx_count_ = 0;
+  uint32_t read_calls_ = 0;
+};
+
+extern usb_midi_class usbMIDI;
@@ -0,0 +1,64 @@
+// Host replacement for drivers/SH1106_128x64_driver.cpp: pages are copied
+// into a RAM image of the panel instead of being clocked out over SPI.
+
+#include <Arduino.h>
+#include "drivers/SH1106_128x64_driver.h"
+#include "host/hal.h"
+
+namespace host {
+
+static uint8_t display_memory[SH1106_128x64_Driver::kFrameSize];
+static uint32_t pages_sent = 0;
+
+const uint8_t *display_ram() {
+  return display_memory;
+}
+
+uint32_t display_pages_sent() {
+  return pages_sent;
+}
+
+bool WriteDisplayPBM(const char *filename) {
+  FILE *f = fopen(filename, "w");
+  if (!f)
+    return false;
+
+  fprintf(f, "P1\n%u %u\n", (unsigned)kDisplayWidth, (unsigned)kDisplayHeight);
+  for (size_t y = 0; y < kDisplayHeight; ++y) {
+    const uint8_t *page = display_memory + (y / 8) * kDisplayWidth;
+    for (size_t x = 0; x < kDisplayWidth; ++x)
+      fputc(page[x] & (1 << (y & 7)) ? '1' : '0', f);
+    fputc('\n', f);
+  }
+  return 0 == fclose(f);
+}
+
+};  // namespace host
+
+/*static*/
+void SH1106_128x64_Driver::Init() {
+  Clear();
+}
+
+/*static*/
+void SH1106_128x64_Driver::Flush() {
+}
+
+/*static*/
+void SH1106_128x64_Driver::Clear() {
+  memset(host::display_memory, 0, sizeof(host::display_memory));
+}
+
+/*static*/
+void SH1106_128x64_Driver::SendPage(uint_fast8_t index, const uint8_t *data) {
+  memcpy(host::display_memory + index * kPageSize, data, kPageSize);
+  ++host::pages_sent;
+}
+
+/*static*/
+void SH1106_128x64_Driver::SPI_send(void *, size_t) {
+}
+
+/*static*/
+void SH1106_128x64_Driver::AdjustOffset(uint8_t) {
+}
@@ -0,0 +1,205 @@
+// Applet cost benchmark.
+//
+// Runs every applet in HEMISPHERE_APPLETS on both sides of the virtual module
+// with a canned stimulus (clocks on all trigger inputs, slow CV ramps) and
+// reports the per-tick cost of Controller() and the per-frame cost of View().
+// Cycle counts are host time scaled to F_CPU, so they are only meaningful
+// relative to each other (and between runs on the same machine); the output is
+// a plain table meant to be diffed between commits.
+//
+// The core ISR keeps running (ADC, digital inputs) but the app ISR and main
+// loop are not, so the applets are called here instead of by the Manager.
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "HEMISPHERE.hpp"
+#include "drivers/display.h"
+#include "host/hal.h"
+#include "host/module.h"
+#include "oc/config.h"
+#include "oc/core.h"
+
+// Stringize the applet list once more to get the class names
+#undef DECLARE_APPLET
+#define DECLARE_APPLET(id, categories, class_name) { id, #class_name }
+
+namespace {
+
+struct AppletName {
+  int id;
+  const char *name;
+};
+
+constexpr AppletName applet_names[] = HEMISPHERE_APPLETS;
+static_assert(ARRAY_SIZE(applet_names) == ARRAY_SIZE(hemisphere::available_applets),
+              "Applet name table out of sync");
+
+struct Options {
+  uint32_t ticks = OC_CORE_ISR_FREQ;  // 1s
+  uint32_t warmup_ticks = OC_CORE_ISR_FREQ / 10;
+  uint32_t clock_ticks = 1042;        // 16ths @ 120BPM
+  uint32_t frame_ticks = 333;         // ~50 fps
+  bool json = false;
+  bool sizes = false;
+  int only_id = -1;
+};
+
+struct Stats {
+  uint32_t mean, p99, max;
+};
+
+Stats Summarize(std::vector<uint32_t> &samples) {
+  Stats stats = { 0, 0, 0 };
+  if (samples.empty())
+    return stats;
+  uint64_t sum = 0;
+  for (auto s : samples) sum += s;
+  std::sort(samples.begin(), samples.end());
+  stats.mean = static_cast<uint32_t>(sum / samples.size());
+  stats.p99 = samples[(samples.size() * 99) / 100];
+  stats.max = samples.back();
+  return stats;
+}
+
+// Clocks on all four inputs (1ms pulses, TR2/TR4 at half rate) and four
+// phase-shifted -3V..+6V triangle ramps with a 1s period.
+void Stimulus(const Options &options, uint32_t tick) {
+  uint32_t phase = tick % options.clock_ticks;
+  uint32_t pulse = 1000 / OC_CORE_TIMER_RATE;
+  bool odd = (tick / options.clock_ticks) & 1;
+  host::SetTriggerInput(0, phase < pulse);
+  host::SetTriggerInput(1, phase < pulse && !odd);
+  host::SetTriggerInput(2, phase < pulse);
+  host::SetTriggerInput(3, phase < pulse && odd);
+
+  for (int ch = 0; ch < 4; ++ch) {
+    uint32_t t = (tick + ch * OC_CORE_ISR_FREQ / 4) % OC_CORE_ISR_FREQ;
+    int32_t tri = t < OC_CORE_ISR_FREQ / 2 ? t : OC_CORE_ISR_FREQ - t;
+    host::SetCVInput(ch, -3000 + (tri * 9000) / (OC_CORE_ISR_FREQ / 2));
+  }
+}
+
+void Usage(const char *name) {
+  fprintf(stderr,
+      "Usage: %s [options]\n"
+      "  --ticks N        measured core ISR ticks per applet (default %u)\n"
+      "  --clock N        clock period in ticks (default 1042)\n"
+      "  --applet ID      only run the applet with this id\n"
+      "  --json           JSON output instead of CSV\n"
+      "  --sizes          only list sizeof() of each applet against the slot size\n",
+      name, (unsigned)OC_CORE_ISR_FREQ);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!strcmp(arg, "--json")) {
+      options.json = true;
+    } else if (!strcmp(arg, "--sizes")) {
+      options.sizes = true;
+    } else if (!strcmp(arg, "--ticks") && value) {
+      options.ticks = strtoul(value, nullptr, 0); ++i;
+    } else if (!strcmp(arg, "--clock") && value) {
+      options.clock_ticks = strtoul(value, nullptr, 0); ++i;
+    } else if (!strcmp(arg, "--applet") && value) {
+      options.only_id = atoi(value); ++i;
+    } else {
+      Usage(argv[0]);
+      return strcmp(arg, "--help") ? 1 : 0;
+    }
+  }
+  if (!options.clock_ticks)
+    options.clock_ticks = 1;
+
+  if (options.sizes) {
+    // Host sizes, so pointers and vtables are twice as big as on the Teensy
+    printf("id,name,size,slot_size\n");
+    for (size_t i = 0; i < ARRAY_SIZE(hemisphere::available_applets); ++i) {
+      printf("%d,%s,%zu,%zu\n", applet_names[i].id, applet_names[i].name,
+             hemisphere::available_applets[i].SizeOf(), sizeof(hemisphere::AppletSlot));
+    }
+    return 0;
+  }
+
+  host::BootModule();
+  if (!host::SelectApp("HS")) {
+    fprintf(stderr, "Hemisphere app not available\n");
+    return 1;
+  }
+  oc::core::app_isr_enabled = false;
+
+  if (options.json)
+    printf("[\n");
+  else
+    printf("id,name,hemisphere,controller_mean,controller_p99,controller_max,view_mean,view_p99,view_max\n");
+
+  std::vector<uint32_t> controller_cycles, view_cycles;
+  controller_cycles.reserve(options.ticks);
+  bool first = true;
+  uint8_t frame[SH1106_128x64_Driver::kFrameSize];
+
+  for (size_t i = 0; i < ARRAY_SIZE(hemisphere::available_applets); ++i) {
+    const hemisphere::Applet &applet = hemisphere::available_applets[i];
+    if (options.only_id >= 0 && applet.id != options.only_id)
+      continue;
+
+    for (int h = LEFT_HEMISPHERE; h <= RIGHT_HEMISPHERE; ++h) {
+      randomSeed(1);
+      applet.Start(h);
+      controller_cycles.clear();
+      view_cycles.clear();
+
+      uint32_t total_ticks = options.warmup_ticks + options.ticks;
+      for (uint32_t tick = 0; tick < total_ticks; ++tick) {
+        Stimulus(options, tick);
+        host::TickISRs();
+
+        uint32_t start = host::CycleCount();
+        applet.Controller(h, false);
+        uint32_t cycles = host::CycleCount() - start;
+        if (tick < options.warmup_ticks)
+          continue;
+        controller_cycles.push_back(cycles);
+
+        if (!(tick % options.frame_ticks)) {
+          graphics.Begin(frame, true);
+          start = host::CycleCount();
+          applet.View(h);
+          view_cycles.push_back(host::CycleCount() - start);
+          graphics.End();
+        }
+      }
+
+      applet.Unload(h);
+
+      Stats controller = Summarize(controller_cycles);
+      Stats view = Summarize(view_cycles);
+      if (options.json) {
+        printf("%s  {\"id\": %d, \"name\": \"%s\", \"hemisphere\": %d, "
+               "\"controller\": {\"mean\": %u, \"p99\": %u, \"max\": %u}, "
+               "\"view\": {\"mean\": %u, \"p99\": %u, \"max\": %u}}",
+               first ? "" : ",\n", applet.id, applet_names[i].name, h,
+               controller.mean, controller.p99, controller.max,
+               view.mean, view.p99, view.max);
+      } else {
+        printf("%d,%s,%d,%u,%u,%u,%u,%u,%u\n", applet.id, applet_names[i].name, h,
+               controller.mean, controller.p99, controller.max,
+               view.mean, view.p99, view.max);
+      }
+      first = false;
+    }
+  }
+
+  if (options.json)
+    printf("\n]\n");
+  return 0;
+}
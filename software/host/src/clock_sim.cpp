@@ -0,0 +1,205 @@
+// Master clock simulation.
+//
+// Runs the Hemisphere master clock against a reference: an external clock on
+// TR1 at a given tempo and PPQN, optionally with timing jitter, or with
+// --free the internal clock at the reference tempo. Clock output 1 is set to
+// x1 and each of its tocks is timed against the reference beat it should fall
+// on, which gives the tempo error (the mean beat length against the reference)
+// and the jitter (the spread of the beat timing). The output is a plain report
+// meant to be compared between commits.
+//
+// Tocks are timed to the tick, so the beat timing has the tick's resolution
+// (60us, i.e. about 17us RMS) on top of whatever the clock itself does.
+//
+// The core ISRs and the Hemisphere app ISR run, the main loop doesn't.
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "hemisphere/clock_manager.hpp"
+#include "host/hal.h"
+#include "host/module.h"
+#include "oc/config.h"
+
+namespace {
+
+struct Options {
+  double bpm = 120.0;
+  int ppqn = 4;
+  double jitter_us = 0;  // RMS
+  double seconds = 600;
+  double warmup_seconds = 10;
+  int bandwidth = CLOCK_SYNC_BANDWIDTH_DEFAULT;
+  bool free = false;
+  uint32_t seed = 1;
+};
+
+constexpr double kTickMicros = OC_CORE_TIMER_RATE;
+constexpr double kPulseMicros = 5000;
+
+void Usage(const char *name) {
+  fprintf(stderr,
+      "Usage: %s [options]\n"
+      "  --bpm BPM        reference tempo, may be fractional (default 120)\n"
+      "  --ppqn N         external clock pulses per beat (default 4)\n"
+      "  --jitter US      RMS timing jitter of the external clock (default 0)\n"
+      "  --bandwidth N    sync loop bandwidth, %d-%d (default %d)\n"
+      "  --free           no external clock, the internal clock at the BPM rounded\n"
+      "  --seconds S      simulated time (default 600)\n"
+      "  --warmup S       time to lock before measuring (default 10)\n"
+      "  --seed N         jitter random seed (default 1)\n",
+      name, CLOCK_SYNC_BANDWIDTH_MIN, CLOCK_SYNC_BANDWIDTH_MAX, CLOCK_SYNC_BANDWIDTH_DEFAULT);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!strcmp(arg, "--free")) {
+      options.free = true;
+    } else if (!strcmp(arg, "--bpm") && value) {
+      options.bpm = atof(value); ++i;
+    } else if (!strcmp(arg, "--ppqn") && value) {
+      options.ppqn = atoi(value); ++i;
+    } else if (!strcmp(arg, "--jitter") && value) {
+      options.jitter_us = atof(value); ++i;
+    } else if (!strcmp(arg, "--bandwidth") && value) {
+      options.bandwidth = atoi(value); ++i;
+    } else if (!strcmp(arg, "--seconds") && value) {
+      options.seconds = atof(value); ++i;
+    } else if (!strcmp(arg, "--warmup") && value) {
+      options.warmup_seconds = atof(value); ++i;
+    } else if (!strcmp(arg, "--seed") && value) {
+      options.seed = strtoul(value, nullptr, 0); ++i;
+    } else {
+      Usage(argv[0]);
+      return strcmp(arg, "--help") ? 1 : 0;
+    }
+  }
+  if (options.bpm < CLOCK_TEMPO_MIN || options.bpm > CLOCK_TEMPO_MAX ||
+      options.ppqn < 1 || options.ppqn > 24) {
+    fprintf(stderr, "Tempo or PPQN out of range\n");
+    return 1;
+  }
+
+  host::BootModule();
+  if (!host::SelectApp("HS")) {
+    fprintf(stderr, "Hemisphere app not available\n");
+    return 1;
+  }
+
+  host::SetTriggerInput(0, false);
+
+  hemisphere::ClockManager *clock_m = hemisphere::ClockManager::get();
+  clock_m->SetMultiply(1, 0);
+  clock_m->SetClockPPQN(options.free ? 0 : options.ppqn);
+  clock_m->SetSyncBandwidth(options.bandwidth);
+  clock_m->SetTempoBPM(options.free ? lround(options.bpm) : 120);
+
+  // Times are in us from the start of the first tick
+  const double beat_us = 60e6 / options.bpm;
+  const double clock_us = beat_us / options.ppqn;
+  const double first_edge_us = 1000;
+  std::mt19937 random(options.seed);
+  std::normal_distribution<double> jitter(0, options.jitter_us > 0 ? options.jitter_us : 1);
+
+  // The external clock starts the paused clock; the free one is started now
+  // and its first tock is the first beat
+  if (options.free)
+    clock_m->Start();
+  else
+    clock_m->Start(true);
+
+  uint64_t ticks = static_cast<uint64_t>(options.seconds * 1e6 / kTickMicros);
+  uint64_t edge = 0;
+  double next_edge_us = first_edge_us;
+  double release_us = -1;
+  double first_beat_us = options.free ? -1 : first_edge_us;
+  std::vector<double> tocks;
+
+  for (uint64_t tick = 0; tick < ticks; ++tick) {
+    double tick_start_us = tick * kTickMicros;
+    double tick_end_us = tick_start_us + kTickMicros;
+    if (!options.free) {
+      if (release_us >= 0 && release_us < tick_end_us) {
+        host::SetTriggerInput(0, false);
+        release_us = -1;
+      }
+      if (next_edge_us < tick_end_us) {
+        double delay = next_edge_us - tick_start_us;
+        host::SetTriggerInput(0, true, delay > 0 ? static_cast<uint32_t>(delay) : 0);
+        release_us = next_edge_us + std::min(kPulseMicros, clock_us / 2);
+        ++edge;
+        next_edge_us = first_edge_us + edge * clock_us;
+        if (options.jitter_us > 0)
+          next_edge_us += jitter(random);
+      }
+    }
+
+    host::TickISRs();
+
+    // The tock happened at the end of this tick, when the ISR ran
+    if (clock_m->IsRunning() && clock_m->Tock(0)) {
+      if (first_beat_us < 0)
+        first_beat_us = tick_end_us;
+      tocks.push_back(tick_end_us);
+    }
+  }
+
+  // Beat n of the reference is at first_beat_us + n * beat_us; the tocks
+  // after the warmup are matched with the nearest beat
+  double sum = 0, sum_squares = 0, max_error = 0;
+  double first_tock = 0, last_tock = 0, last_error = 0;
+  long first_beat = 0, last_beat = 0;
+  size_t count = 0;
+  for (double tock : tocks) {
+    if (tock < options.warmup_seconds * 1e6)
+      continue;
+    long beat = lround((tock - first_beat_us) / beat_us);
+    double error = tock - (first_beat_us + beat * beat_us);
+    if (!count) {
+      first_tock = tock;
+      first_beat = beat;
+    }
+    last_tock = tock;
+    last_beat = beat;
+    last_error = error;
+    sum += error;
+    sum_squares += error * error;
+    max_error = std::max(max_error, fabs(error));
+    ++count;
+  }
+
+  printf("reference        %.3f BPM, %s\n", options.bpm,
+         options.free ? "internal clock" : "external clock");
+  if (!options.free)
+    printf("external clock   %d PPQN, %.1fus RMS jitter, sync bandwidth %d\n",
+           options.ppqn, options.jitter_us, clock_m->GetSyncBandwidth());
+  if (count < 2 || last_beat == first_beat) {
+    printf("not enough beats after the warmup\n");
+    return 1;
+  }
+  printf("beats            %zu after the warmup, %ld missed or extra\n", count,
+         labs(static_cast<long>(count) - (last_beat - first_beat + 1)));
+
+  double mean = sum / count;
+  double jitter_rms = sqrt(std::max(0.0, sum_squares / count - mean * mean));
+  double measured_beat_us = (last_tock - first_tock) / (last_beat - first_beat);
+  double tempo_error_ppm = (beat_us / measured_beat_us - 1) * 1e6;
+
+  printf("displayed tempo  %u BPM\n", clock_m->GetTempo());
+  printf("tempo error      %+.2f ppm (%+.5f BPM)\n", tempo_error_ppm,
+         options.bpm * tempo_error_ppm * 1e-6);
+  printf("beat offset      %+.1fus mean, %.1fus RMS jitter, %.1fus max\n",
+         mean, jitter_rms, max_error);
+  printf("drift at end     %+.1fus after %.0fs\n", last_error, options.seconds);
+  return 0;
+}
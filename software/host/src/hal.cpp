@@ -0,0 +1,444 @@
+// Host HAL: backing state for the stand-in Teensy headers.
+
+#include <Arduino.h>
+#include <ADC.h>
+#include <DMAChannel.h>
+#include <EEPROM.h>
+#include <FreqMeasure.h>
+#include <SPIFIFO.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#if defined(__linux__) && defined(__x86_64__)
+#include <signal.h>
+#include <ucontext.h>
+#endif
+
+#include "host/hal.h"
+
+// The register names are macros for host::regs::*, so these define them
+volatile uint32_t SIM_SCGC2, SIM_SCGC6;
+volatile uint8_t VREF_TRM, VREF_SC;
+volatile uint8_t DAC0_C0;
+volatile uint16_t host::regs::DAC0_DAT0;
+volatile uint32_t host::regs::PORT_PCR[64];
+volatile uint32_t host::regs::GPIO_PDDR[64];
+volatile uint32_t SPI0_MCR, SPI0_CTAR0, SPI0_CTAR1, SPI0_SR, SPI0_RSER, SPI0_PUSHR, SPI0_POPR;
+volatile uint32_t ARM_DEMCR, ARM_DWT_CTRL;
+volatile uint32_t ADC0_SC1A, ADC0_CFG2, ADC0_RA, ADC0_SC2;
+
+namespace host {
+
+uint8_t eeprom_memory[kEEPROMSize];
+uint32_t eeprom_writes = 0;
+
+static constexpr int kNumPins = 64;
+
+static uint64_t now_us = 0;
+static uint32_t edge_delay_us = 0;
+static uint16_t analog_inputs[kNumPins];
+static std::vector<uint16_t> analog_samples[kNumPins];
+static size_t analog_sample_index[kNumPins];
+static uint8_t digital_levels[kNumPins];
+static void (*pin_isr[kNumPins])();
+static int pin_isr_mode[kNumPins];
+static SPIHandler spi_handler = nullptr;
+
+uint32_t CycleCount() {
+  using namespace std::chrono;
+  static const auto start = steady_clock::now();
+  auto ns = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+  return static_cast<uint32_t>(ns * (F_CPU / 1000000) / 1000);
+}
+
+#if defined(__linux__) && defined(__x86_64__)
+// Cortex-M SDIV/UDIV return 0 on division by zero (DIV_0_TRP is not set), and
+// a few applets rely on that. x86 traps instead, so skip the faulting div/idiv
+// and give it the ARM result: quotient 0, and since the firmware computes
+// remainders as a - (a / b) * b, remainder = dividend.
+static void sigfpe_handler(int, siginfo_t *, void *context) {
+  ucontext_t *uc = static_cast<ucontext_t *>(context);
+  greg_t *regs = uc->uc_mcontext.gregs;
+  const uint8_t *ip = reinterpret_cast<const uint8_t *>(regs[REG_RIP]);
+  const uint8_t *p = ip;
+
+  while (*p == 0x66 || *p == 0x67 || (*p & 0xf0) == 0x40) ++p; // prefixes, REX
+  if (*p != 0xf7 && *p != 0xf6) {
+    signal(SIGFPE, SIG_DFL);
+    return;
+  }
+  ++p;
+  uint8_t modrm = *p++;
+  uint8_t mod = modrm >> 6, rm = modrm & 7;
+  if (mod != 3) {
+    if (rm == 4) {
+      uint8_t sib = *p++;
+      if (mod == 0 && (sib & 7) == 5) p += 4;
+    } else if (mod == 0 && rm == 5) {
+      p += 4;
+    }
+    if (mod == 1) p += 1;
+    if (mod == 2) p += 4;
+  }
+
+  regs[REG_RDX] = regs[REG_RAX];
+  regs[REG_RAX] = 0;
+  regs[REG_RIP] += p - ip;
+}
+
+static struct InstallFaultHandlers {
+  InstallFaultHandlers() {
+    struct sigaction action = {};
+    action.sa_sigaction = sigfpe_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigaction(SIGFPE, &action, nullptr);
+  }
+} install_fault_handlers;
+#endif
+
+uint32_t SimulatedCycleCount() {
+  return static_cast<uint32_t>((now_us + edge_delay_us) * (F_CPU / 1000000));
+}
+
+// Each ADC sample takes roughly this long at 16 bits and HIGH_SPEED sampling,
+// times the number of hardware averages
+static constexpr uint32_t kADCSampleNanos = 2000;
+// ADC0 channel (SC1A ADCH) of pins 14-23, i.e. A0-A9
+static constexpr uint8_t kADC0Channels[] = { 5, 14, 8, 9, 13, 12, 6, 7, 15, 4 };
+
+static uint32_t adc0_averages = 1;
+static uint64_t adc0_elapsed_ns = 0;
+
+static uint16_t ReadAnalogInput(uint8_t pin) {
+  pin %= kNumPins;
+  std::vector<uint16_t> &samples = analog_samples[pin];
+  if (samples.empty())
+    return analog_inputs[pin];
+  size_t index = analog_sample_index[pin];
+  analog_sample_index[pin] = (index + 1) % samples.size();
+  return samples[index];
+}
+
+// Back-to-back conversions on ADC0 for as long as DMA keeps writing a channel
+// into SC1A
+static void RunADC0(uint32_t us) {
+  if (!(ADC0_SC2 & ADC_SC2_DMAEN))
+    return;
+  const uint64_t conversion_ns = kADCSampleNanos * adc0_averages;
+  adc0_elapsed_ns += us * 1000ULL;
+  while (adc0_elapsed_ns >= conversion_ns) {
+    adc0_elapsed_ns -= conversion_ns;
+    const uint32_t channel = ADC0_SC1A & 0x1f;
+    const uint8_t *pin = std::find(std::begin(kADC0Channels), std::end(kADC0Channels), channel);
+    if (pin == std::end(kADC0Channels)) {
+      adc0_elapsed_ns = 0;
+      break;
+    }
+    ADC0_RA = ReadAnalogInput(14 + (pin - kADC0Channels));
+    DMAChannel::HostRequest(DMAMUX_SOURCE_ADC0);
+  }
+}
+
+void AdvanceMicros(uint32_t us) {
+  now_us += us;
+  RunADC0(us);
+}
+
+void SetAnalogInput(uint8_t pin, uint16_t value) {
+  analog_inputs[pin % kNumPins] = value;
+}
+
+void SetAnalogSamples(uint8_t pin, const uint16_t *samples, size_t count) {
+  pin %= kNumPins;
+  analog_samples[pin].assign(samples, samples + count);
+  analog_sample_index[pin] = 0;
+}
+
+void SetDigitalInput(uint8_t pin, uint8_t level, uint32_t delay_us) {
+  pin %= kNumPins;
+  level = level ? HIGH : LOW;
+  uint8_t previous = digital_levels[pin];
+  digital_levels[pin] = level;
+  if (previous == level || !pin_isr[pin])
+    return;
+
+  edge_delay_us = delay_us;
+  switch (pin_isr_mode[pin]) {
+    case RISING: if (HIGH == level) pin_isr[pin](); break;
+    case FALLING: if (LOW == level) pin_isr[pin](); break;
+    case CHANGE: pin_isr[pin](); break;
+    default: break;
+  }
+  edge_delay_us = 0;
+}
+
+uint16_t MillivoltsToADC(int32_t mv) {
+  // Uncalibrated inputs read 0V at 2/3 full scale and 409.6 counts/V (12 bit)
+  int32_t value = 2730 - (mv * 4096) / 10000;
+  if (value < 0) value = 0;
+  if (value > 4095) value = 4095;
+  return static_cast<uint16_t>(value << 4);
+}
+
+void SetSPIHandler(SPIHandler handler) {
+  spi_handler = handler;
+}
+
+static void OnSPIWrite(uint8_t cs_pin, uint32_t word, bool is16) {
+  if (spi_handler)
+    spi_handler(cs_pin, word, is16);
+}
+
+// Chip select pin behind each PCS signal, as configured with SPIFIFO.begin
+static uint8_t spi0_pcs_pins[5];
+
+static void SetPCSPin(uint8_t pin) {
+  switch (pin) {
+    case 10: case 2: spi0_pcs_pins[0] = pin; break;
+    case 9: case 6: spi0_pcs_pins[1] = pin; break;
+    case 20: case 23: spi0_pcs_pins[2] = pin; break;
+    case 21: case 22: spi0_pcs_pins[3] = pin; break;
+    case 15: spi0_pcs_pins[4] = pin; break;
+    default: break;
+  }
+}
+
+void SPI0Push(uint32_t pushr) {
+  uint8_t cs_pin = 0;
+  const uint32_t pcs = (pushr >> 16) & 0x1f;
+  for (size_t i = 0; i < 5; ++i) {
+    if (pcs & (1 << i))
+      cs_pin = spi0_pcs_pins[i];
+  }
+  // CTAR1 is configured for 16 bit frames
+  const bool is16 = (pushr & SPI_PUSHR_CTAS(7)) == SPI_PUSHR_CTAS(1);
+  OnSPIWrite(cs_pin, pushr & (is16 ? 0xffff : 0xff), is16);
+
+  if ((SPI0_RSER & (SPI_RSER_RFDF_RE | SPI_RSER_RFDF_DIRS)) == (SPI_RSER_RFDF_RE | SPI_RSER_RFDF_DIRS))
+    DMAChannel::HostRequest(DMAMUX_SOURCE_SPI0_RX);
+}
+
+};  // namespace host
+
+/* ---- time ---- */
+
+uint32_t millis() {
+  return static_cast<uint32_t>(host::now_us / 1000);
+}
+
+uint32_t micros() {
+  return static_cast<uint32_t>(host::now_us);
+}
+
+void delay(uint32_t ms) {
+  host::AdvanceMicros(ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  host::AdvanceMicros(us);
+}
+
+/* ---- pins ---- */
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  // Inputs with pullups idle high, which for the trigger inputs means "off"
+  if (INPUT_PULLUP == mode)
+    host::digital_levels[pin % host::kNumPins] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  host::digital_levels[pin % host::kNumPins] = value ? HIGH : LOW;
+}
+
+uint8_t digitalRead(uint8_t pin) {
+  return host::digital_levels[pin % host::kNumPins];
+}
+
+int analogRead(uint8_t pin) {
+  return host::analog_inputs[pin % host::kNumPins];
+}
+
+void attachInterrupt(uint8_t pin, void (*function)(void), int mode) {
+  host::pin_isr[pin % host::kNumPins] = function;
+  host::pin_isr_mode[pin % host::kNumPins] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  host::pin_isr[pin % host::kNumPins] = nullptr;
+}
+
+/* ---- random ---- */
+
+// Small xorshift so runs are reproducible regardless of the host libc
+static uint32_t random_state = 0x2545f491;
+
+void randomSeed(uint32_t seed) {
+  if (seed)
+    random_state = seed;
+}
+
+static uint32_t random_next() {
+  uint32_t x = random_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return random_state = x;
+}
+
+int32_t random(int32_t howbig) {
+  if (howbig <= 0)
+    return 0;
+  return random_next() % howbig;
+}
+
+int32_t random(int32_t howsmall, int32_t howbig) {
+  if (howsmall >= howbig)
+    return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+/* ---- serial ---- */
+
+usb_serial_class Serial;
+
+size_t usb_serial_class::print(const char *s) { return fputs(s, stderr) >= 0 ? strlen(s) : 0; }
+size_t usb_serial_class::print(char c) { return fputc(c, stderr) != EOF ? 1 : 0; }
+size_t usb_serial_class::print(int n) { return fprintf(stderr, "%d", n); }
+size_t usb_serial_class::print(unsigned n) { return fprintf(stderr, "%u", n); }
+size_t usb_serial_class::print(long n) { return fprintf(stderr, "%ld", n); }
+size_t usb_serial_class::print(unsigned long n) { return fprintf(stderr, "%lu", n); }
+size_t usb_serial_class::print(double n, int digits) { return fprintf(stderr, "%.*f", digits, n); }
+size_t usb_serial_class::println() { return print('\n'); }
+
+size_t usb_serial_class::printf(const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = vfprintf(stderr, fmt, args);
+  va_end(args);
+  return n > 0 ? n : 0;
+}
+
+/* ---- timers ---- */
+
+// The virtual module calls the registered ISRs itself, so begin() only
+// records them.
+bool IntervalTimer::begin(void (*fn)(), uint32_t period_us) {
+  fn_ = fn;
+  period_us_ = period_us;
+  return true;
+}
+
+void IntervalTimer::end() {
+  fn_ = nullptr;
+}
+
+/* ---- EEPROM ---- */
+
+EEPROMClass EEPROM;
+
+/* ---- usbMIDI ---- */
+
+usb_midi_class usbMIDI;
+
+bool usb_midi_class::Inject(const Message &message) {
+  size_t next = (queue_write_ + 1) % kQueueSize;
+  if (next == queue_read_)
+    return false;
+  queue_[queue_write_] = message;
+  queue_write_ = next;
+  return true;
+}
+
+bool usb_midi_class::InjectSysEx(const uint8_t *data, size_t length) {
+  if (length + 2 > kSysExMaxSize || pending_sysex_length_)
+    return false;
+  pending_sysex_[0] = 0xF0;
+  memcpy(pending_sysex_ + 1, data, length);
+  pending_sysex_[length + 1] = 0xF7;
+  pending_sysex_length_ = length + 2;
+  return Inject({SystemExclusive, 0, 0, 0});
+}
+
+bool usb_midi_class::read(uint8_t channel) {
+  ++read_calls_;
+  while (queue_read_ != queue_write_) {
+    current_ = queue_[queue_read_];
+    queue_read_ = (queue_read_ + 1) % kQueueSize;
+
+    if (SystemExclusive == current_.type) {
+      memcpy(sysex_, pending_sysex_, pending_sysex_length_);
+      sysex_length_ = pending_sysex_length_;
+      pending_sysex_length_ = 0;
+    }
+    if (channel && current_.type < SystemExclusive && current_.channel != channel)
+      continue;
+    ++rx_count_;
+    return true;
+  }
+  return false;
+}
+
+void usb_midi_class::sendSysEx(uint32_t length, const uint8_t *data, bool has_term, uint8_t cable) {
+  (void)length; (void)data; (void)has_term;
+  send(SystemExclusive, 0, 0, 0, cable);
+}
+
+void usb_midi_class::send(uint8_t type, uint8_t data1, uint8_t data2, uint8_t channel, uint8_t cable) {
+  (void)cable;
+  ++tx_count_;
+  if (tx_handler_)
+    tx_handler_({type, channel, data1, data2});
+}
+
+/* ---- FreqMeasure ---- */
+
+FreqMeasureClass FreqMeasure;
+
+static uint32_t freq_measure_count = 0;
+static bool freq_measure_available = false;
+
+void FreqMeasureClass::begin() { freq_measure_available = false; }
+uint8_t FreqMeasureClass::available() { return freq_measure_available ? 1 : 0; }
+uint32_t FreqMeasureClass::read() { freq_measure_available = false; return freq_measure_count; }
+float FreqMeasureClass::countToFrequency(uint32_t count) { return count ? (float)F_BUS / (float)count : 0.f; }
+void FreqMeasureClass::end() { }
+void FreqMeasureClass::Inject(uint32_t count) { freq_measure_count = count; freq_measure_available = true; }
+
+/* ---- SPIFIFO ---- */
+
+SPIFIFOclass SPIFIFO;
+
+void SPIFIFOclass::begin(uint8_t pin, uint32_t, uint32_t) {
+  cs_pin_ = pin;
+  host::SetPCSPin(pin);
+}
+
+void SPIFIFOclass::write(uint32_t b, uint32_t) {
+  host::OnSPIWrite(cs_pin_, b & 0xff, false);
+}
+
+void SPIFIFOclass::write16(uint32_t b, uint32_t) {
+  host::OnSPIWrite(cs_pin_, b & 0xffff, true);
+}
+
+/* ---- ADC ---- */
+
+int ADC_Module::readSingle() const {
+  return host::ReadAnalogInput(pin_);
+}
+
+void ADC_Module::setAveraging(uint8_t num) {
+  if (ADC_0 == num_)
+    host::adc0_averages = num ? num : 1;
+}
+
+void ADC_Module::enableDMA() {
+  if (ADC_0 == num_)
+    ADC0_SC2 |= ADC_SC2_DMAEN;
+}
+
+void ADC_Module::disableDMA() {
+  if (ADC_0 == num_)
+    ADC0_SC2 &= ~ADC_SC2_DMAEN;
+}
@@ -0,0 +1,140 @@
+// Firmware lifecycle on the host, see host/module.h
+
+#include <Arduino.h>
+#include <string.h>
+#include <vector>
+
+#include "drivers/display.h"
+#include "host/hal.h"
+#include "host/module.h"
+#include "oc/ADC.h"
+#include "oc/DAC.h"
+#include "oc/apps.h"
+#include "oc/calibration.h"
+#include "oc/config.h"
+#include "oc/core.h"
+#include "oc/debug.h"
+#include "oc/digital_inputs.h"
+#include "oc/gpio.h"
+#include "oc/midi_in.h"
+#include "oc/midi_out.h"
+#include "oc/menus.h"
+#include "oc/render_scheduler.h"
+#include "oc/ui.h"
+
+// o_c_REV.cpp
+extern IntervalTimer CORE_timer;
+extern IntervalTimer UI_timer;
+extern oc::UiMode ui_mode;
+void CORE_timer_ISR();
+void UI_timer_ISR();
+void loop_step();
+
+namespace host {
+
+static constexpr uint8_t kCVPins[ADC_CHANNEL_LAST] = { CV1, CV2, CV3, CV4 };
+static constexpr uint8_t kTriggerPins[oc::DIGITAL_INPUT_LAST] = { TR1, TR2, TR3, TR4 };
+
+static uint32_t ui_elapsed_us = 0;
+static bool display_check = false;
+static uint32_t display_check_failures_ = 0;
+
+void BootModule() {
+  for (int ch = 0; ch < ADC_CHANNEL_LAST; ++ch)
+    SetCVInput(ch, 0);
+
+  SPI_init();
+  oc::DEBUG::Init();
+  oc::DigitalInputs::Init();
+  oc::MidiIn::Init();
+  oc::MidiOut::Init();
+  oc::ADC::Init(&oc::calibration_data.adc);
+  oc::DAC::Init(&oc::calibration_data.dac);
+
+  display::Init();
+
+  calibration_load();
+  display::AdjustOffset(oc::calibration_data.display_offset);
+
+  oc::menu::Init();
+  oc::render_scheduler.Init(FRAME_PERIOD_US, FRAME_BUDGET_US * (F_CPU / 1000000));
+  oc::ui.Init();
+  oc::ui.configure_encoders(oc::calibration_data.encoder_config());
+
+  CORE_timer.begin(CORE_timer_ISR, OC_CORE_TIMER_RATE);
+  UI_timer.begin(UI_timer_ISR, OC_UI_TIMER_RATE);
+
+  ui_mode = oc::UI_MODE_MENU;
+  oc::ui.set_screensaver_timeout(oc::calibration_data.screensaver_timeout);
+  oc::apps::Init(false);
+  oc::core::app_isr_enabled = true;
+}
+
+void EnableDisplayCheck(bool enable) {
+  display_check = enable;
+}
+
+uint32_t display_check_failures() {
+  return display_check_failures_;
+}
+
+void TickISRs() {
+  AdvanceMicros(OC_CORE_TIMER_RATE);
+
+  // The frame being sent stays readable until the core ISR completes it, and
+  // the main loop can't draw over it before the next tick.
+  const uint8_t *frame = display::driver.frame_valid() ? display::frame_buffer.readable_frame() : nullptr;
+  const uint32_t frames = display::driver.frames();
+  CORE_timer.fn()();
+  if (display_check && frame && frames != display::driver.frames() &&
+      memcmp(frame, display_ram(), SH1106_128x64_Driver::kFrameSize)) {
+    fprintf(stderr, "Display mismatch after frame %u\n", (unsigned)frames);
+    ++display_check_failures_;
+  }
+
+  ui_elapsed_us += OC_CORE_TIMER_RATE;
+  if (ui_elapsed_us >= UI_timer.period_us()) {
+    ui_elapsed_us -= UI_timer.period_us();
+    UI_timer.fn()();
+  }
+}
+
+void TickModule() {
+  TickISRs();
+  loop_step();
+}
+
+bool SelectApp(const char *twocc) {
+  if (strlen(twocc) != 2)
+    return false;
+  uint16_t id = ((twocc[0] & 0xff) << 8) | (twocc[1] & 0xff);
+  if (!oc::apps::find(id))
+    return false;
+
+  oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SUSPEND);
+  oc::apps::set_current_app(oc::apps::index_of(id));
+  oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_RESUME);
+  return true;
+}
+
+void SetCVInput(int channel, int32_t mv) {
+  SetAnalogInput(kCVPins[channel], MillivoltsToADC(mv));
+}
+
+void SetCVSamples(int channel, const int32_t *mv, size_t count) {
+  std::vector<uint16_t> samples(count);
+  for (size_t i = 0; i < count; ++i)
+    samples[i] = MillivoltsToADC(mv[i]);
+  SetAnalogSamples(kCVPins[channel], samples.data(), count);
+}
+
+void SetTriggerInput(int channel, bool high, uint32_t delay_us) {
+  // Trigger inputs are inverted, a high gate pulls the pin low
+  SetDigitalInput(kTriggerPins[channel], high ? LOW : HIGH, delay_us);
+}
+
+void SetButton(uint8_t pin, bool pressed) {
+  SetDigitalInput(pin, pressed ? LOW : HIGH);
+}
+
+};  // namespace host
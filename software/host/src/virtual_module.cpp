@@ -0,0 +1,469 @@
+// Virtual module: runs the firmware on the host against scripted inputs.
+//
+// The firmware's ISRs are driven from a simulated timeline rather than real
+// timers: every tick advances time by OC_CORE_TIMER_RATE, runs the core ISR,
+// the UI ISR when it is due, and one pass of the main loop. Inputs come from a
+// plain-text script, outputs are the DAC values per tick and optionally the
+// final display contents. Identical inputs produce identical outputs.
+//
+// Script lines are "<tick> <command> <args...>", sorted by tick:
+//   <tick> cv <1-4> <mV>        set CV input (holds until changed)
+//   <tick> gate <1-4> <0|1> [us]  set trigger input level
+//   <tick> trig <1-4> [us]      1ms trigger pulse
+// The optional us places the edge that many microseconds into the tick.
+//   <tick> button <top|bot|l|r> <0|1>
+//   <tick> midi <status> <data1> <data2>
+// Blank lines and lines starting with '#' are ignored.
+//
+// With --adc, the CV inputs replay a recording instead: one line per
+// conversion with the four inputs in mV ("<cv1> <cv2> <cv3> <cv4>"), looped.
+// Each input steps through its column as it is converted, so the timing
+// follows the ADC scan (round robin, or the DMA sequence with
+// ENABLE_ADC_DMA). Script cv commands have no effect on replayed inputs.
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "HEMISPHERE.hpp"
+#include "drivers/display.h"
+#include "host/hal.h"
+#include "host/module.h"
+#include "oc/ADC.h"
+#include "oc/DAC.h"
+#include "oc/apps.h"
+#include "oc/config.h"
+#include "oc/debug.h"
+#include "oc/gpio.h"
+#include "oc/midi_in.h"
+#include "oc/midi_out.h"
+#include "oc/render_scheduler.h"
+
+namespace {
+
+constexpr uint32_t kTriggerPulseTicks = 1000 / OC_CORE_TIMER_RATE;
+
+enum EventType {
+  EVENT_CV,
+  EVENT_GATE,
+  EVENT_BUTTON,
+  EVENT_MIDI,
+};
+
+struct Event {
+  uint32_t tick;
+  EventType type;
+  int channel;
+  int32_t value;
+  uint8_t data[3];
+  uint32_t delay_us;
+};
+
+struct Options {
+  const char *app = nullptr;
+  int applets[2] = { -1, -1 };
+  const char *input = nullptr;
+  const char *adc = nullptr;
+  const char *dac = nullptr;
+  uint32_t dac_every = 1;
+  const char *dac_spi = nullptr;
+  const char *midi_out = nullptr;
+  const char *eeprom = nullptr;
+  const char *screen = nullptr;
+  uint32_t ticks = OC_CORE_ISR_FREQ;
+  uint32_t seed = 0;
+  int32_t frame_budget_us = -1;
+  bool stats = false;
+  bool check_display = false;
+  bool save = false;
+};
+
+void Usage(const char *name) {
+  fprintf(stderr,
+      "Usage: %s [options]\n"
+      "  --app XX         start app with two-character id XX (e.g. HS)\n"
+      "  --left ID        Hemisphere applet id for the left side\n"
+      "  --right ID       Hemisphere applet id for the right side\n"
+      "  --input FILE     input script\n"
+      "  --adc FILE       replay CV input samples from FILE\n"
+      "  --ticks N        number of core ISR ticks to run (default %u)\n"
+      "  --dac FILE       write \"tick a b c d\" DAC values ('-' for stdout)\n"
+      "  --dac-every N    only write every Nth tick\n"
+      "  --dac-spi FILE   write \"tick channel value\" for each DAC8565 command sent\n"
+      "  --midi-out FILE  write \"tick status data1 data2\" for each MIDI message sent\n"
+      "  --eeprom FILE    load EEPROM contents from FILE, save back on exit\n"
+      "  --save           save the settings at the end, like the app menu does\n"
+      "  --screen FILE    write final display as PBM image\n"
+      "  --seed N         random seed\n"
+      "  --frame-budget US  draw time before Hemisphere draws its halves in turns\n"
+      "  --stats          print ISR timing (host cycles scaled to F_CPU)\n"
+      "  --check-display  verify the display after every frame against a full redraw\n",
+      name, (unsigned)OC_CORE_ISR_FREQ);
+}
+
+int ButtonPin(const char *name) {
+  if (!strcmp(name, "top")) return but_top;
+  if (!strcmp(name, "bot")) return but_bot;
+  if (!strcmp(name, "l")) return butL;
+  if (!strcmp(name, "r")) return butR;
+  return -1;
+}
+
+bool LoadADCSamples(const char *filename) {
+  FILE *f = fopen(filename, "r");
+  if (!f) {
+    fprintf(stderr, "Can't open %s\n", filename);
+    return false;
+  }
+
+  std::vector<int32_t> samples[ADC_CHANNEL_LAST];
+  char line[256];
+  int line_number = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), f)) {
+    ++line_number;
+    char *p = line;
+    while (*p == ' ' || *p == '\t') ++p;
+    if (!*p || *p == '#' || *p == '\n' || *p == '\r')
+      continue;
+
+    int mv[ADC_CHANNEL_LAST];
+    ok = sscanf(p, "%d %d %d %d", &mv[0], &mv[1], &mv[2], &mv[3]) == ADC_CHANNEL_LAST;
+    if (!ok)
+      fprintf(stderr, "%s:%d: expected four values in mV\n", filename, line_number);
+    for (int ch = 0; ok && ch < ADC_CHANNEL_LAST; ++ch)
+      samples[ch].push_back(mv[ch]);
+  }
+  fclose(f);
+
+  for (int ch = 0; ok && ch < ADC_CHANNEL_LAST; ++ch)
+    host::SetCVSamples(ch, samples[ch].data(), samples[ch].size());
+  return ok;
+}
+
+bool ParseScript(const char *filename, std::vector<Event> &events) {
+  FILE *f = fopen(filename, "r");
+  if (!f) {
+    fprintf(stderr, "Can't open %s\n", filename);
+    return false;
+  }
+
+  char line[256];
+  int line_number = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof(line), f)) {
+    ++line_number;
+    char *p = line;
+    while (*p == ' ' || *p == '\t') ++p;
+    if (!*p || *p == '#' || *p == '\n' || *p == '\r')
+      continue;
+
+    unsigned tick = 0;
+    char command[16] = { 0 };
+    char arg[16] = { 0 };
+    int a = 0, b = 0, c = 0;
+    unsigned us = 0;
+    Event event = {};
+    if (sscanf(p, "%u %15s", &tick, command) != 2) {
+      ok = false;
+    } else if (!strcmp(command, "cv")) {
+      ok = sscanf(p, "%*u %*s %d %d", &a, &b) == 2 && a >= 1 && a <= 4;
+      event = { tick, EVENT_CV, a - 1, b, {} };
+      events.push_back(event);
+    } else if (!strcmp(command, "gate")) {
+      ok = sscanf(p, "%*u %*s %d %d %u", &a, &b, &us) >= 2 && a >= 1 && a <= 4;
+      event = { tick, EVENT_GATE, a - 1, b, {}, us };
+      events.push_back(event);
+    } else if (!strcmp(command, "trig")) {
+      ok = sscanf(p, "%*u %*s %d %u", &a, &us) >= 1 && a >= 1 && a <= 4;
+      event = { tick, EVENT_GATE, a - 1, 1, {}, us };
+      events.push_back(event);
+      event = { tick + kTriggerPulseTicks, EVENT_GATE, a - 1, 0, {}, us };
+      events.push_back(event);
+    } else if (!strcmp(command, "button")) {
+      ok = sscanf(p, "%*u %*s %15s %d", arg, &b) == 2 && ButtonPin(arg) >= 0;
+      event = { tick, EVENT_BUTTON, ButtonPin(arg), b, {} };
+      events.push_back(event);
+    } else if (!strcmp(command, "midi")) {
+      ok = sscanf(p, "%*u %*s %i %i %i", &a, &b, &c) == 3;
+      event = { tick, EVENT_MIDI, 0, 0, { (uint8_t)a, (uint8_t)b, (uint8_t)c } };
+      events.push_back(event);
+    } else {
+      ok = false;
+    }
+    if (!ok)
+      fprintf(stderr, "%s:%d: can't parse '%s'\n", filename, line_number, command);
+  }
+  fclose(f);
+
+  // Trigger releases may be out of order; keep the input order for equal ticks
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event &l, const Event &r) { return l.tick < r.tick; });
+  return ok;
+}
+
+void ApplyEvent(const Event &event) {
+  switch (event.type) {
+    case EVENT_CV:
+      host::SetCVInput(event.channel, event.value);
+      break;
+    case EVENT_GATE:
+      host::SetTriggerInput(event.channel, event.value, event.delay_us);
+      break;
+    case EVENT_BUTTON:
+      host::SetButton(event.channel, event.value);
+      break;
+    case EVENT_MIDI: {
+      usb_midi_class::Message message;
+      message.type = event.data[0] < 0xF0 ? event.data[0] & 0xF0 : event.data[0];
+      message.channel = event.data[0] < 0xF0 ? (event.data[0] & 0x0F) + 1 : 0;
+      message.data1 = event.data[1];
+      message.data2 = event.data[2];
+      usbMIDI.Inject(message);
+      } break;
+  }
+}
+
+void LoadEEPROM(const char *filename) {
+  FILE *f = fopen(filename, "rb");
+  if (f) {
+    size_t n = fread(host::eeprom_memory, 1, host::kEEPROMSize, f);
+    fclose(f);
+    fprintf(stderr, "* Loaded %zu bytes of EEPROM from %s\n", n, filename);
+  }
+}
+
+// Decodes the DAC8565 commands sent over SPI. The outputs this reconstructs
+// are checked against the DAC values after every tick.
+struct DACCapture {
+  FILE *out = nullptr;
+  uint32_t tick = 0;
+  int command = -1;
+  uint32_t outputs[DAC_CHANNEL_LAST] = { };
+  uint32_t writes = 0;
+  uint32_t errors = 0;
+};
+
+DACCapture dac_capture;
+
+void CaptureDACSPI(uint8_t cs_pin, uint32_t word, bool is16) {
+  if (DAC_CS != cs_pin)
+    return;
+  if (!is16) {
+    dac_capture.command = word;
+    return;
+  }
+  for (size_t channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel) {
+    if (oc::DAC::command(channel) == dac_capture.command) {
+      const uint32_t value = oc::DAC::data(word);
+      dac_capture.outputs[channel] = value;
+      ++dac_capture.writes;
+      if (dac_capture.out)
+        fprintf(dac_capture.out, "%u %zu %u\n", dac_capture.tick, channel, value);
+      break;
+    }
+  }
+  dac_capture.command = -1;
+}
+
+FILE *midi_out = nullptr;
+
+void CaptureMIDIOut(const usb_midi_class::Message &message) {
+  const uint8_t status = message.type < usbMIDI.SystemExclusive ? message.type | ((message.channel - 1) & 0x0f) : message.type;
+  fprintf(midi_out, "%u 0x%02X %u %u\n", dac_capture.tick, status, message.data1, message.data2);
+}
+
+void SaveEEPROM(const char *filename) {
+  FILE *f = fopen(filename, "wb");
+  if (!f || fwrite(host::eeprom_memory, 1, host::kEEPROMSize, f) != host::kEEPROMSize)
+    fprintf(stderr, "Failed to write EEPROM to %s\n", filename);
+  if (f)
+    fclose(f);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!strcmp(arg, "--help") || !strcmp(arg, "-h")) {
+      Usage(argv[0]);
+      return 0;
+    }
+    if (!strcmp(arg, "--stats")) {
+      options.stats = true;
+      continue;
+    }
+    if (!strcmp(arg, "--check-display")) {
+      options.check_display = true;
+      continue;
+    }
+    if (!strcmp(arg, "--save")) {
+      options.save = true;
+      continue;
+    }
+    if (!value || strncmp(arg, "--", 2)) {
+      Usage(argv[0]);
+      return 1;
+    }
+    ++i;
+    if (!strcmp(arg, "--app")) options.app = value;
+    else if (!strcmp(arg, "--left")) options.applets[LEFT_HEMISPHERE] = atoi(value);
+    else if (!strcmp(arg, "--right")) options.applets[RIGHT_HEMISPHERE] = atoi(value);
+    else if (!strcmp(arg, "--input")) options.input = value;
+    else if (!strcmp(arg, "--adc")) options.adc = value;
+    else if (!strcmp(arg, "--ticks")) options.ticks = strtoul(value, nullptr, 0);
+    else if (!strcmp(arg, "--dac")) options.dac = value;
+    else if (!strcmp(arg, "--dac-every")) options.dac_every = strtoul(value, nullptr, 0);
+    else if (!strcmp(arg, "--dac-spi")) options.dac_spi = value;
+    else if (!strcmp(arg, "--midi-out")) options.midi_out = value;
+    else if (!strcmp(arg, "--eeprom")) options.eeprom = value;
+    else if (!strcmp(arg, "--screen")) options.screen = value;
+    else if (!strcmp(arg, "--seed")) options.seed = strtoul(value, nullptr, 0);
+    else if (!strcmp(arg, "--frame-budget")) options.frame_budget_us = atoi(value);
+    else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (!options.dac_every)
+    options.dac_every = 1;
+
+  std::vector<Event> events;
+  if (options.input && !ParseScript(options.input, events))
+    return 1;
+
+  FILE *dac_out = nullptr;
+  if (options.dac) {
+    dac_out = strcmp(options.dac, "-") ? fopen(options.dac, "w") : stdout;
+    if (!dac_out) {
+      fprintf(stderr, "Can't open %s\n", options.dac);
+      return 1;
+    }
+  }
+
+  if (options.dac_spi) {
+    dac_capture.out = strcmp(options.dac_spi, "-") ? fopen(options.dac_spi, "w") : stdout;
+    if (!dac_capture.out) {
+      fprintf(stderr, "Can't open %s\n", options.dac_spi);
+      return 1;
+    }
+  }
+  host::SetSPIHandler(CaptureDACSPI);
+  if (options.midi_out) {
+    midi_out = strcmp(options.midi_out, "-") ? fopen(options.midi_out, "w") : stdout;
+    if (!midi_out) {
+      fprintf(stderr, "Can't open %s\n", options.midi_out);
+      return 1;
+    }
+    usbMIDI.set_tx_handler(CaptureMIDIOut);
+  }
+
+  if (options.eeprom)
+    LoadEEPROM(options.eeprom);
+  randomSeed(options.seed);
+
+  host::BootModule();
+  host::EnableDisplayCheck(options.check_display);
+  if (options.frame_budget_us >= 0)
+    oc::render_scheduler.set_budget(options.frame_budget_us * (F_CPU / 1000000));
+  if (options.adc && !LoadADCSamples(options.adc))
+    return 1;
+
+  if (options.app && !host::SelectApp(options.app)) {
+    fprintf(stderr, "Unknown app '%s'\n", options.app);
+    return 1;
+  }
+  for (int h = LEFT_HEMISPHERE; h <= RIGHT_HEMISPHERE; ++h) {
+    if (options.applets[h] >= 0)
+      SelectManagerApplet(h, options.applets[h]);
+  }
+
+  // The core ISR sends the values from the end of the previous tick
+  uint32_t dac_values[DAC_CHANNEL_LAST];
+  for (size_t channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel)
+    dac_values[channel] = oc::DAC::value(channel);
+
+  const uint32_t start_cycles = host::CycleCount();
+  auto next_event = events.begin();
+  for (uint32_t tick = 0; tick < options.ticks; ++tick) {
+    while (next_event != events.end() && next_event->tick <= tick)
+      ApplyEvent(*next_event++);
+
+    dac_capture.tick = tick;
+    host::TickModule();
+
+    for (size_t channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel) {
+      if (dac_capture.outputs[channel] != dac_values[channel]) {
+        if (!dac_capture.errors)
+          fprintf(stderr, "DAC output %zu is %u instead of %u in tick %u\n", channel,
+                  dac_capture.outputs[channel], dac_values[channel], tick);
+        ++dac_capture.errors;
+      }
+      dac_values[channel] = oc::DAC::value(channel);
+    }
+
+    if (dac_out && !(tick % options.dac_every)) {
+      fprintf(dac_out, "%u %u %u %u %u\n", tick,
+              (unsigned)oc::DAC::value(0), (unsigned)oc::DAC::value(1),
+              (unsigned)oc::DAC::value(2), (unsigned)oc::DAC::value(3));
+    }
+  }
+
+  if (options.stats) {
+    uint32_t elapsed_us = debug::cycles_to_us(host::CycleCount() - start_cycles);
+    fprintf(stderr, "* %u ticks (%u ms simulated) in %u ms\n", options.ticks,
+            options.ticks * OC_CORE_TIMER_RATE / 1000, elapsed_us / 1000);
+    fprintf(stderr, "* CORE ISR cycles: avg %u min %u max %u\n",
+            oc::DEBUG::ISR_cycles.value(), oc::DEBUG::ISR_cycles.min_value(),
+            oc::DEBUG::ISR_cycles.max_value());
+    fprintf(stderr, "* UI ISR cycles: avg %u min %u max %u\n",
+            oc::DEBUG::UI_cycles.value(), oc::DEBUG::UI_cycles.min_value(),
+            oc::DEBUG::UI_cycles.max_value());
+    oc::DEBUG::DumpProfile();
+    fprintf(stderr, "* Display: %u frames, %u pages sent, %u skipped\n",
+            display::driver.frames(), display::driver.pages_sent(),
+            display::driver.pages_skipped());
+    fprintf(stderr, "* Frames: %u drawn, %u dropped, %u partial\n",
+            oc::render_scheduler.frames(), oc::render_scheduler.dropped(),
+            oc::render_scheduler.partial());
+    fprintf(stderr, "* MIDI in: %u received, %u dropped, %u deferred scans\n",
+            oc::MidiIn::received(), oc::MidiIn::dropped(), oc::MidiIn::deferred());
+    fprintf(stderr, "* MIDI out: %u sent, %u coalesced, %u dropped, max queue depth %u\n",
+            oc::MidiOut::sent(), oc::MidiOut::coalesced(), oc::MidiOut::dropped(),
+            (unsigned)oc::MidiOut::max_depth());
+    fprintf(stderr, "* DAC: %u channel writes, %u busy waits, %u output errors\n",
+            dac_capture.writes, oc::DAC::busy_waits(), dac_capture.errors);
+  }
+
+  if (dac_capture.out && dac_capture.out != stdout)
+    fclose(dac_capture.out);
+  if (midi_out && midi_out != stdout)
+    fclose(midi_out);
+  if (dac_out && dac_out != stdout)
+    fclose(dac_out);
+  if (options.screen && !host::WriteDisplayPBM(options.screen))
+    fprintf(stderr, "Failed to write %s\n", options.screen);
+  if (options.save) {
+    oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SUSPEND);
+    uint32_t eeprom_writes = host::eeprom_writes;
+    oc::apps::SaveSettings();
+    const oc::apps::SaveStats &save = oc::apps::last_save;
+    fprintf(stderr, "* Save: %u bytes of app data, %u bytes changed (%u EEPROM writes), "
+            "%u apps changed, %u compressed, %u skipped\n",
+            save.used, save.changed, host::eeprom_writes - eeprom_writes,
+            save.dirty_apps, save.compressed_apps, save.skipped_apps);
+  }
+  if (options.eeprom)
+    SaveEEPROM(options.eeprom);
+
+  if (dac_capture.errors)
+    return 3;
+  return host::display_check_failures() ? 2 : 0;
+}
@@ -25,7 +25,9 @@
 
 static hemisphere::Manager manager;
 
-void ReceiveManagerSysEx();
+
+// Select an applet by id without touching the presets
+void SelectManagerApplet(int hemisphere, int applet_id);
 
 ////////////////////////////////////////////////////////////////////////////////
 //// O_C App Functions
@@ -13,20 +13,42 @@
 // but allows a new frame to be written while the old one is being
 // transferred.
 // See https://gist.github.com/patrickdowling/0029f58fb20e63d7db9d
+//
+// Each written frame is compared page by page against the one before, so the
+// driver can skip pages that haven't changed since they were last sent. This
+// relies on every frame being sent in order: the previous frame is what the
+// display shows once the current one has been sent.
 
-template <size_t frame_size, size_t frames>
+template <size_t frame_size, size_t frames, size_t num_pages>
 class FrameBuffer {
 public:
 
   static const size_t kFrameSize = frame_size;
+  static const size_t kNumPages = num_pages;
+  static const size_t kPageSize = frame_size / num_pages;
+
+  typedef uint32_t PageMask;
+  static const PageMask kAllPages = num_pages < 32 ? (1UL << num_pages) - 1 : ~0UL;
+
+  static_assert(frames > 1, "Page comparison needs the previous frame");
+  static_assert(num_pages <= 32, "Too many pages for PageMask");
 
   FrameBuffer() { }
 
   void Init() {
     memset(frame_memory_, 0, sizeof(frame_memory_));
-    for (size_t f = 0; f < frames; ++f)
+    for (size_t f = 0; f < frames; ++f) {
       frame_buffers_[f] = frame_memory_ + kFrameSize * f;
+      dirty_pages_[f] = kAllPages;
+    }
     write_ptr_ = read_ptr_ = 0;
+    redraw_ = true;
+  }
+
+  // Send the next written frame in full, e.g. if the display was modified
+  // outside of the frame buffer
+  void Invalidate() {
+    redraw_ = true;
   }
 
   size_t writeable() const {
@@ -42,23 +64,49 @@ public:
     return frame_buffers_[read_ptr_ % frames];
   }
 
+  // @return pages of the readable frame that differ from the previous frame
+  PageMask readable_dirty_pages() const {
+    return dirty_pages_[read_ptr_ % frames];
+  }
+
   // @return next writeable frame (assumes one exists)
   uint8_t *writeable_frame() {
     return frame_buffers_[write_ptr_ % frames];
   }
 
+  // @return the frame written before the writeable one, i.e. what the display
+  // shows (or will show) until the writeable one is sent
+  const uint8_t *previous_frame() const {
+    return frame_buffers_[(write_ptr_ - 1) % frames];
+  }
+
   void read() {
     ++read_ptr_;
   }
 
   void written() {
-    ++write_ptr_;
+    const size_t write_ptr = write_ptr_;
+    PageMask dirty_pages = kAllPages;
+    if (!redraw_) {
+      const uint8_t *page = frame_buffers_[write_ptr % frames];
+      const uint8_t *previous = frame_buffers_[(write_ptr - 1) % frames];
+      dirty_pages = 0;
+      for (size_t p = 0; p < kNumPages; ++p, page += kPageSize, previous += kPageSize) {
+        if (memcmp(page, previous, kPageSize))
+          dirty_pages |= 1UL << p;
+      }
+    }
+    redraw_ = false;
+    dirty_pages_[write_ptr % frames] = dirty_pages;
+    write_ptr_ = write_ptr + 1;
   }
 
 private:
 
   uint8_t frame_memory_[kFrameSize * frames] __attribute__ ((aligned (4)));
   uint8_t *frame_buffers_[frames];
+  PageMask dirty_pages_[frames];
+  volatile bool redraw_;
 
   volatile size_t write_ptr_;
   volatile size_t read_ptr_;
@@ -7,6 +7,9 @@
 // In theory parts of the transfer may be done via DMA and the page memory
 // will have to be valid until that completes, so the ::Flush call is used
 // to determine if cleanup is necessary.
+//
+// Pages that aren't in the frame's dirty mask are skipped, so an unchanged
+// frame costs no SPI traffic at all.
 template <typename display_driver>
 class PagedDisplayDriver {
 public:
@@ -19,21 +22,27 @@ public:
 
     current_page_index_ = 0;
     current_page_data_ = NULL;
+    dirty_pages_ = 0;
+    pages_sent_ = pages_skipped_ = frames_ = 0;
   }
 
-  void Begin(const uint8_t *frame) {
+  void Begin(const uint8_t *frame, uint32_t dirty_pages = ~0UL) {
     current_page_data_ = frame;
     current_page_index_ = 0;
+    dirty_pages_ = dirty_pages;
   }
 
+  // Send the next dirty page, if any. Clean pages before and after it are
+  // skipped too, so the frame completes with the last dirty page.
   void Update() {
-    uint_fast8_t page = current_page_index_;
+    uint_fast8_t page = skip_clean_pages(current_page_index_);
     if (page < display_driver::kNumPages) {
-      const uint8_t *data = current_page_data_;
-      display_driver::SendPage(page, data);
-      current_page_index_ = page + 1;
-      current_page_data_ = data + display_driver::kPageSize;
+      display_driver::SendPage(page, current_page_data_);
+      ++pages_sent_;
+      current_page_data_ += display_driver::kPageSize;
+      page = skip_clean_pages(page + 1);
     }
+    current_page_index_ = page;
   }
 
   bool Flush() {
@@ -43,6 +52,7 @@ public:
     } else {
       current_page_index_ = 0;
       current_page_data_ = NULL;
+      ++frames_;
       return true;
     }
   }
@@ -51,9 +61,28 @@ public:
     return NULL != current_page_data_;
   }
 
+  // Running totals
+  uint32_t pages_sent() const { return pages_sent_; }
+  uint32_t pages_skipped() const { return pages_skipped_; }
+  uint32_t frames() const { return frames_; }
+
 private:
   uint_fast8_t current_page_index_;
   const uint8_t *current_page_data_;
+  uint32_t dirty_pages_;
+
+  uint32_t pages_sent_;
+  uint32_t pages_skipped_;
+  uint32_t frames_;
+
+  uint_fast8_t skip_clean_pages(uint_fast8_t page) {
+    while (page < display_driver::kNumPages && !(dirty_pages_ & (1UL << page))) {
+      ++page;
+      ++pages_skipped_;
+      current_page_data_ += display_driver::kPageSize;
+    }
+    return page;
+  }
 
   DISALLOW_COPY_AND_ASSIGN(PagedDisplayDriver);
 };
@@ -64,6 +64,10 @@ public:
   void invertRect(coord_t x, coord_t y, coord_t w, coord_t h);
   void drawFrame(coord_t x, coord_t y, coord_t w, coord_t h);
 
+  // Copy columns x to x + w - 1 from another frame, e.g. to keep that part
+  // of the previous frame
+  void copyColumns(const uint8_t *frame, coord_t x, coord_t w);
+
   void drawHLine(coord_t x, coord_t y, coord_t w);
   void drawHLineDots(coord_t x, coord_t y, coord_t w);
   void drawVLine(coord_t x, coord_t y, coord_t h);
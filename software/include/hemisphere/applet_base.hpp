@@ -27,13 +27,18 @@
 
 #pragma once
 
+#include <new>
 #include "FreqMeasure.h"
 #include "hemisphere/applet_base.hpp"
 #include "hemisphere/clock_manager.hpp"
 #include "hemisphere/icons.hpp"
+#include "hemisphere/proportion.hpp"
+#include "hemisphere/waveform_preview.hpp"
 #include "oc/ADC.h"
 #include "oc/DAC.h"
 #include "oc/digital_inputs.h"
+#include "util/bit_packer.h"
+#include "util/delay_line.h"
 
 // Simulated fixed floats by multiplying and dividing by powers of 2
 #ifndef int2simfloat
@@ -90,7 +95,9 @@ typedef int32_t simfloat;
     id, categories, class_name##_Start, class_name##_Controller,   \
         class_name##_View, class_name##_OnButtonPress,             \
         class_name##_OnEncoderMove, class_name##_ToggleHelpScreen, \
-        class_name##_OnDataRequest, class_name##_OnDataReceive     \
+        class_name##_OnDataRequest, class_name##_OnDataReceive,    \
+        class_name##_OnBlobRequest, class_name##_OnBlobReceive,    \
+        class_name##_Unload, class_name##_SizeOf                   \
   }
 
 #include "hemisphere_config.h"
@@ -108,14 +115,72 @@ typedef struct Applet {
   void (*ToggleHelpScreen)(bool);         // Help Screen has been requested
   uint64_t (*OnDataRequest)(bool);        // Get a data int from the applet
   void (*OnDataReceive)(bool, uint64_t);  // Send a data int to the applet
+  uint8_t (*OnBlobRequest)(bool, util::BitWriter &);  // Extra state, if any
+  void (*OnBlobReceive)(bool, uint8_t, util::BitReader &);
+  void (*Unload)(bool);                   // Destroy when deselected
+  size_t (*SizeOf)();                     // Size of the applet instance
 } Applet;
 
 constexpr Applet available_applets[] = HEMISPHERE_APPLETS;
 constexpr Applet clock_setup_applet = DECLARE_APPLET(9999, 0x01, ClockSetup);
 
 extern int octave_max;
+
+// Only the two selected applets exist at any time: each hemisphere has one
+// slot, the applet's Start() constructs it there and Unload() destroys it
+// again (see Manager::SetApplet). The slot size is checked against every
+// applet at compile time.
+#ifndef HEMISPHERE_APPLET_SLOT_SIZE
+#define HEMISPHERE_APPLET_SLOT_SIZE 1792
+#endif
+
+struct AppletSlot {
+  uint8_t storage[HEMISPHERE_APPLET_SLOT_SIZE] __attribute__((aligned(8)));
+};
+
+extern AppletSlot applet_slots[2];
+
+// Delay memory for applets like LoFi Echo, shared by the hemispheres: one
+// delay gets all of it, two get half each.
+#ifndef HEMISPHERE_DELAY_POOL_SIZE
+#define HEMISPHERE_DELAY_POOL_SIZE 4096
+#endif
+
+extern util::DelayPool<HEMISPHERE_DELAY_POOL_SIZE> delay_pool;
+
+template <typename T>
+inline T &SlotInstance(bool hemisphere) {
+  return *reinterpret_cast<T *>(applet_slots[hemisphere].storage);
+}
+
+template <typename T>
+inline T &ConstructInSlot(bool hemisphere) {
+  // Value-initialized, so members start zeroed like the old static instances
+  return *new (applet_slots[hemisphere].storage) T();
+}
+
 }  // namespace hemisphere
 
+// Boilerplate for the applet functions that manage the instance; the other
+// functions use class_name##_instance(hemisphere) to get at it.
+#define DECLARE_APPLET_INSTANCE(class_name)                                   \
+  static_assert(sizeof(class_name) <= sizeof(hemisphere::AppletSlot),         \
+                #class_name " does not fit in HEMISPHERE_APPLET_SLOT_SIZE");   \
+  static inline class_name &class_name##_instance(bool hemisphere) {          \
+    return hemisphere::SlotInstance<class_name>(hemisphere);                  \
+  }                                                                           \
+  void class_name##_Unload(bool hemisphere) {                                 \
+    class_name##_instance(hemisphere).~class_name();                          \
+  }                                                                           \
+  size_t class_name##_SizeOf() { return sizeof(class_name); }                 \
+  uint8_t class_name##_OnBlobRequest(bool hemisphere, util::BitWriter &blob) { \
+    return class_name##_instance(hemisphere).OnBlobRequest(blob);             \
+  }                                                                           \
+  void class_name##_OnBlobReceive(bool hemisphere, uint8_t version,           \
+                                  util::BitReader &blob) {                    \
+    class_name##_instance(hemisphere).OnBlobReceive(version, blob);           \
+  }
+
 
 namespace hemisphere {
 // Specifies where data goes in flash storage for each selcted applet, and how
@@ -136,20 +201,25 @@ class AppletBase {
   static uint32_t last_clock[4];   // Tick number of the last clock observed by
                                    // the child class
   static uint32_t cycle_ticks[4];  // Number of ticks between last two clocks
+  static uint32_t clock_period[4];  // Cycles between the last two clocks
+  static uint32_t clock_offset[4];  // Cycles between the last clock edge and
+                                    // the tick it was seen on
   static bool changed_cv[4];  // Has the input changed by more than 1/8 semitone
                               // since the last read?
   static int last_cv[4];      // For change detection
   static int cursor_countdown[2];
+  static int full_screen_hemisphere;  // Hemisphere whose applet has the whole
+                                      // display, or -1 if none
 
   static uint8_t trig_length;
   static uint8_t modal_edit_mode;
 
   static void CycleEditMode() { ++modal_edit_mode %= 3; }
 
-  virtual const char *applet_name();  // Maximum of 9 characters
-  virtual void Start();
-  virtual void Controller();
-  virtual void View();
+  virtual const char *applet_name() = 0;  // Maximum of 9 characters
+  virtual void Start() = 0;
+  virtual void Controller() = 0;
+  virtual void View() = 0;
 
   void BaseStart(bool hemisphere_);
 
@@ -168,6 +238,17 @@ class AppletBase {
   // boilerplate
   void BaseScreensaverView() {}
 
+  /* State that doesn't fit in the 64 bits of OnDataRequest goes in the
+   * preset's blob (see PresetBlob), which has room for a few bytes. An applet
+   * that uses it hides these two: OnBlobRequest packs the state and returns
+   * its format version (1-7), and OnBlobReceive gets that version back, so a
+   * newer applet can still read an older blob. OnDataReceive is always called
+   * first, and the blob is only there if it was saved by this applet. When
+   * the other side has a blob too, OnBlobRequest may only get half the room,
+   * so it can check blob.remaining() and fall back to a shorter format. */
+  uint8_t OnBlobRequest(util::BitWriter &blob) { return 0; }
+  void OnBlobReceive(uint8_t version, util::BitReader &blob) {}
+
   /* Help Screen Toggle */
   void HelpScreen() { help_active = 1 - help_active; }
 
@@ -254,6 +335,13 @@ class AppletBase {
     graphics.drawLine(x + gfx_offset, y, x2 + gfx_offset, y2, p);
   }
 
+  // Draws a cached waveform, see WaveformPreview
+  template <size_t max_points>
+  void gfxPreview(const WaveformPreview<max_points> &preview) {
+    for (size_t i = 1; i < preview.size(); ++i)
+      gfxLine(preview.x(i - 1), preview.y(i - 1), preview.x(i), preview.y(i));
+  }
+
   void gfxCircle(int x, int y, int r) {
     graphics.drawCircle(x + gfx_offset, y, r);
   }
@@ -333,40 +421,61 @@ class AppletBase {
     bool clocked = 0;
     hemisphere::ClockManager *clock_m = clock_m->get();
     bool useTock = (!physical && clock_m->IsRunning());
+    oc::DigitalInput input = oc::DIGITAL_INPUT_LAST;
 
     if (ch == 0) {  // clock triggers
       if (hemisphere == LEFT_HEMISPHERE) {
         if (useTock && clock_m->GetMultiply(0) != 0)
           clocked = clock_m->Tock(0);
         else
-          clocked = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_1>();
+          input = oc::DIGITAL_INPUT_1;
       } else {  // right side is special
         if (useTock && clock_m->GetMultiply(2) != 0)
           clocked = clock_m->Tock(2);
         else if (master_clock_bus)  // forwarding from left
-          clocked = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_1>();
+          input = oc::DIGITAL_INPUT_1;
         else
-          clocked = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_3>();
+          input = oc::DIGITAL_INPUT_3;
       }
     } else if (ch == 1) {  // TR2 and TR4
       if (hemisphere == LEFT_HEMISPHERE) {
         if (useTock && clock_m->GetMultiply(1) != 0)
           clocked = clock_m->Tock(1);
         else
-          clocked = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_2>();
+          input = oc::DIGITAL_INPUT_2;
       } else {
         if (useTock && clock_m->GetMultiply(3) != 0)
           clocked = clock_m->Tock(3);
         else
-          clocked = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_4>();
+          input = oc::DIGITAL_INPUT_4;
       }
     }
+    if (input != oc::DIGITAL_INPUT_LAST)
+      clocked = oc::DigitalInputs::clocked(input);
+
+    // Physical clocks are timed from the edge timestamps, anything else only
+    // to the tick
+    uint32_t period = 0;
+    if (clocked && input != oc::DIGITAL_INPUT_LAST)
+      period = oc::DigitalInputs::edge_period(input);
 
     clocked = clocked || clock_m->Beep(io_offset + ch);
 
     if (clocked) {
-      cycle_ticks[io_offset + ch] =
-          oc::core::ticks - last_clock[io_offset + ch];
+      if (period) {
+        cycle_ticks[io_offset + ch] =
+            (period + oc::DigitalInputs::kCyclesPerTick / 2) /
+            oc::DigitalInputs::kCyclesPerTick;
+        clock_period[io_offset + ch] = period;
+        clock_offset[io_offset + ch] = oc::DigitalInputs::edge_offset(input);
+      } else {
+        uint32_t ticks = oc::core::ticks - last_clock[io_offset + ch];
+        cycle_ticks[io_offset + ch] = ticks;
+        clock_period[io_offset + ch] =
+            min(ticks, 0xffffffff / oc::DigitalInputs::kCyclesPerTick) *
+            oc::DigitalInputs::kCyclesPerTick;
+        clock_offset[io_offset + ch] = 0;
+      }
       last_clock[io_offset + ch] = oc::core::ticks;
     }
     return clocked;
@@ -402,13 +511,21 @@ class AppletBase {
   int ViewIn(int ch) { return inputs[io_offset + ch]; }
   int ViewOut(int ch) { return outputs[io_offset + ch]; }
   int ClockCycleTicks(int ch) { return cycle_ticks[io_offset + ch]; }
+  uint32_t ClockPeriod(int ch) { return clock_period[io_offset + ch]; }
+  uint32_t ClockOffset(int ch) { return clock_offset[io_offset + ch]; }
+  // Position between the master clock's tocks for Clock(ch), a full turn of
+  // the uint32_t per tock; 0 when the master clock isn't running
+  uint32_t ClockPhase(int ch) {
+    hemisphere::ClockManager *clock_m = clock_m->get();
+    return clock_m->IsRunning() ? clock_m->Phase(io_offset + ch) : 0;
+  }
   bool Changed(int ch) { return changed_cv[io_offset + ch]; }
 
  protected:
   bool hemisphere;         // Which hemisphere (0, 1) this applet uses
   bool isEditing = false;  // modal editing toggle
   const char *help[4];
-  virtual void SetHelp();
+  virtual void SetHelp() = 0;
 
   /* Forces applet's Start() method to run the next time the applet is selected.
    * This allows an applet to start up the same way every time, regardless of
@@ -416,6 +533,18 @@ class AppletBase {
    */
   void AllowRestart() { applet_started = 0; }
 
+  /* Asks the manager to give this applet the whole display (or to go back to
+   * sharing it). A full screen View() draws with graphics directly, since the
+   * gfx methods are offset to the applet's side.
+   */
+  void SetFullScreen(bool on) {
+    if (on)
+      full_screen_hemisphere = hemisphere;
+    else if (FullScreen())
+      full_screen_hemisphere = -1;
+  }
+  bool FullScreen() { return full_screen_hemisphere == hemisphere; }
+
   //////////////// Calculation methods
   ////////////////////////////////////////////////////////////////////////////////
 
@@ -431,9 +560,18 @@ class AppletBase {
    *
    * Out(ch, Proportion(value, 100, HEMISPHERE_MAX_CV));
    *
+   * If the denominator is a constant, prefer the template version, which
+   * avoids the division:
+   *
+   * Out(ch, Proportion<100>(value, HEMISPHERE_MAX_CV));
    */
   int Proportion(int numerator, int denominator, int max_value);
 
+  template <int32_t denominator>
+  static int Proportion(int numerator, int max_value) {
+    return hemisphere::Proportion<denominator>(numerator, max_value);
+  }
+
   /* Proportion CV values into pixels for display purposes.
    *
    * Solves this:     cv_value           ???
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "hemisphere/proportion.hpp"
 
 namespace hemisphere {
 
@@ -45,10 +46,10 @@ class ApplicationBase {
   static constexpr auto THREE_VOLTS = 4608;
   static constexpr auto CHANGE_THRESHOLD = 32;
 
-  virtual void Start();
-  virtual void Controller();
-  virtual void View();
-  virtual void Resume();
+  virtual void Start() = 0;
+  virtual void Controller() = 0;
+  virtual void View() = 0;
+  virtual void Resume() = 0;
 
   void BaseController();
 
@@ -58,6 +59,12 @@ class ApplicationBase {
 
   int Proportion(int numerator, int denominator, int max_value);
 
+  // As above, without the division for constant denominators
+  template <int32_t denominator>
+  static int Proportion(int numerator, int max_value) {
+    return hemisphere::Proportion<denominator>(numerator, max_value);
+  }
+
   //////////////// Hemisphere-like IO methods
   ////////////////////////////////////////////////////////////////////////////////
   void Out(int ch, int value, int octave = 0);
@@ -20,6 +20,18 @@
 
 // A "tick" is one ISR cycle, which happens 16666.667 times per second, or a
 // million times per minute. A "tock" is a metronome beat.
+//
+// The clock is a phase accumulator: a 32-bit beat phase that advances by a
+// fractional increment every tick, so the tempo isn't limited to a whole
+// number of ticks per beat and doesn't drift. The outputs derive their phase
+// from it, a multiplied output being the beat phase times the multiplier
+// (wrapping), so there are no divisions per tick.
+//
+// An external clock on TR1 is followed with a phase-locked loop: each clock
+// pulse measures how far the beat phase is from the nearest clock and the
+// increment is steered to take that out, proportionally for the next clock
+// and integrated into the tempo. The measured clock period pulls the tempo
+// along too (frequency-locked), which also snaps it on a tempo change.
 
 #pragma once
 #include <stdint.h>
@@ -33,6 +45,12 @@ constexpr int MIDI_OUT_PPQN = 24;
 constexpr int CLOCK_MAX_MULTIPLE = 24;
 constexpr int CLOCK_MIN_MULTIPLE = -31;  // becomes /32
 
+// Loop bandwidth of the external clock sync; higher follows the clock more
+// tightly, lower smooths out more of its jitter
+constexpr int CLOCK_SYNC_BANDWIDTH_MIN = 1;
+constexpr int CLOCK_SYNC_BANDWIDTH_MAX = 7;
+constexpr int CLOCK_SYNC_BANDWIDTH_DEFAULT = 6;
+
 namespace hemisphere {
 
 class ClockManager {
@@ -47,35 +65,63 @@ class ClockManager {
     NR_OF_CLOCKS
   };
 
+  // Beat phase increments per tick for the tempo range
+  static constexpr uint32_t kIncrementMin = (UINT64_C(1) << 32) / CLOCK_TICKS_MAX;
+  static constexpr uint32_t kIncrementMax = (UINT64_C(1) << 32) / CLOCK_TICKS_MIN;
+  // Outputs tock when their phase wraps, so that can't happen twice in a tick,
+  // even with the sync correction (up to twice the maximum tempo)
+  static_assert(UINT64_C(2) * kIncrementMax * CLOCK_MAX_MULTIPLE < (UINT64_C(1) << 32) &&
+                MIDI_OUT_PPQN <= CLOCK_MAX_MULTIPLE, "Clock phase can wrap twice in a tick");
+
   uint16_t tempo;           // The set tempo, for display somewhere else
-  uint32_t ticks_per_beat;  // Based on the selected tempo in BPM
   bool running = 0;  // Specifies whether the clock is running for interprocess
                      // communication
   bool paused = 0;   // Specifies whethr the clock is paused
   bool forwarded = 0;  // Master clock forwarding is enabled when true
 
+  // Position in the beat, a full turn of the uint32_t is one beat
+  uint32_t phase = 0;
+  // Added to phase on every tick: the tempo plus the sync correction
+  uint32_t phase_increment;
+  // The tempo as a phase increment
+  uint32_t tempo_increment;
+  // Sync correction, until the next external clock
+  int32_t sync_correction = 0;
+  // Set by Reset; the next tick is the start of a beat
+  bool restart = 0;
+
   // tick when a physical clock was received on DIGITAL 1
   uint32_t clock_tick = 0;
-
-  // The tick to count from
-  uint32_t beat_tick = 0;
+  // External clocks since the beat was restarted, while that's within a beat
+  int clock_count = 0;
+  // The tempo has been taken from the external clock since it (re)started
+  bool synced = 0;
+  int sync_bandwidth = CLOCK_SYNC_BANDWIDTH_DEFAULT;
 
   // The current tock value
   bool tock[NR_OF_CLOCKS] = {0, 0, 0, 0, 0};
 
+  // Whether the last tock was on the beat
+  bool on_beat[NR_OF_CLOCKS] = {0, 0, 0, 0, 0};
+
   // Multiplier
   int16_t tocks_per_beat[NR_OF_CLOCKS] = {4, 0, 8, 0, MIDI_OUT_PPQN};
 
-  // Multiple counter, 0 is a special case when first starting the clock
+  // Beats since the last tock, for divisions
   int count[NR_OF_CLOCKS] = {0, 0, 0, 0, 0};
 
   int clock_ppqn = 4;  // external clock multiple
-  bool cycle = 0;      // Alternates for each tock, for display purposes
+  bool cycle = 0;      // Alternates for each beat, for display purposes
 
   bool boop[4];  // Manual triggers
 
   ClockManager() { SetTempoBPM(120); }
 
+  void SetTempoIncrement(uint32_t increment);
+
+  // Steers the phase towards a clock edge, see the top of the file
+  void SyncToClock(uint32_t period_cycles, uint32_t offset_cycles);
+
  public:
   static ClockManager *get() {
     if (!instance) instance = new ClockManager;
@@ -87,29 +133,24 @@ class ClockManager {
   // adjusts the expected clock multiple for external clock pulses
   void SetClockPPQN(int clkppqn);
 
-  /* Set ticks per tock, based on one million ticks per minute divided by beats
-   * per minute. This is approximate, because the arithmetical value is likely
-   * to be fractional, and we need to live with a certain amount of imprecision
-   * here. So I'm not even rounding up.
-   */
+  void SetSyncBandwidth(int bandwidth);
+
+  // Set the tempo in beats per minute
   void SetTempoBPM(uint16_t bpm);
 
   void SetTempoFromTaps(uint32_t *taps, int count);
 
   int GetMultiply(int ch = 0) { return tocks_per_beat[ch]; }
   int GetClockPPQN() { return clock_ppqn; }
+  int GetSyncBandwidth() { return sync_bandwidth; }
 
   /* Gets the current tempo. This can be used between client processes, like two
    * different hemispheres.
    */
   uint16_t GetTempo() { return tempo; }
 
-  // Reset - Resync multipliers, optionally skipping the first tock
-  void Reset(bool count_skip = 0);
-
-  // Nudge - Used to align the internal clock with incoming clock pulses
-  // The rationale is that it's better to be short by 1 than to overshoot by 1
-  void Nudge(int diff);
+  // Reset - Restart the beat, all clocks fire on the next tick
+  void Reset();
 
   // call this on every tick when clock is running, before all Controllers
   void SyncTrig(bool clocked, bool hard_reset = false);
@@ -154,8 +195,16 @@ class ClockManager {
   // Returns true if MIDI Clock should be sent on this tick
   bool MIDITock() { return Tock(MIDI_CLOCK); }
 
-  bool EndOfBeat(int ch = 0) { return count[ch] == 1; }
+  bool EndOfBeat(int ch = 0) { return on_beat[ch]; }
 
   bool Cycle(int ch = 0) { return cycle; }
+
+  /* Position within the current beat, where a full turn of the uint32_t is
+   * one beat */
+  uint32_t BeatPhase() { return phase; }
+
+  /* Position within the current cycle of clock output ch, i.e. between its
+   * last tock and the next, in the same scale. 0 if the output is off. */
+  uint32_t Phase(int ch = 0);
 };
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #pragma once
+#include <atomic>
 #include "hemisphere/application_base.hpp"
+#include "hemisphere/output_quantizer.hpp"
 #include "preset.hpp"
+#include "oc/midi_in.h"
 #include "oc/ui.h"
 
 namespace hemisphere {
@@ -46,23 +49,35 @@ public:
 
     void SetHelpScreen(int hemisphere);
 
+    // The output quantizer settings are shared by all presets, and stored
+    // after them
+    static constexpr size_t quantizersSize() { return OutputQuantizer::kStorageSize; }
+    size_t SaveQuantizers(void *storage) const;
+    size_t RestoreQuantizers(const void *storage);
+
 private:
     int preset_id = 0;
     int preset_cursor = 0;
-    int my_applet[2]; // Indexes to available_applets
+    int my_applet[2] = { -1, -1 }; // Indexes to available_applets, -1 if none loaded
+    // Set while a side's slot is being destroyed and rebuilt, so the core ISR
+    // doesn't run a half-constructed applet
+    std::atomic<bool> applet_loading[2] = { {false}, {false} };
     int select_mode;
     bool clock_setup;
     bool config_menu;
     bool isEditing = false;
     int config_cursor = 0;
+    int quantizer_output = 0; // Output shown in the config menu
+    OutputQuantizer output_quantizer;
 
     int help_hemisphere; // Which of the hemispheres (if any) is in help mode, or -1 if none
-    int midi_in_hemisphere; // Which of the hemispheres (if any) is using MIDI In
+    oc::MidiSubscription sysex_subscription { oc::MidiTypeBit(usbMIDI.SystemExclusive) };
     uint32_t click_tick; // Measure time between clicks for double-click
     int first_click; // The first button pushed of a double-click set, to see if the same one is pressed
     ClockManager *clock_m = clock_m->get();
 
     void ConfigEncoderAction(int h, int dir);
+    void QuantizerEncoderAction(int dir);
     void ConfigButtonPush(int h);
 
     void DrawConfigMenu();
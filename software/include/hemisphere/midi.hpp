@@ -30,6 +30,7 @@
 #pragma once
 #include <Arduino.h>
 #include <usb_midi.h>
+#include "oc/midi_in.h"
 
 // Teensyduino USB MIDI Library message numbers
 // See https://www.pjrc.com/teensy/td_midi.html
@@ -216,30 +217,28 @@ public:
      * generating an UnpackedData instance, which contains an array of up to 48 uint8_t bytes,
      * converting it to a PackedData instance, and passing that PackedData to SysExSend().
      */
-    virtual void OnSendSysEx();
+    virtual void OnSendSysEx() = 0;
 
     /* OnReciveSysEx() is called when a system exclusive message comes in. In OnReceiveSysEx(),
      * the app is responsible for converting a PackedData instance into an UnpackedData instance,
      * which contains an array of up to 48 uint8_t bytes, and putting that data into the app's
      * internal data system.
      */
-    virtual void OnReceiveSysEx();
+    virtual void OnReceiveSysEx() = 0;
 
 protected:
     /* ListenForSysEx() is for use by apps that don't otherwise deal with listening to MIDI input.
      * A call to ListenForSysEx() is placed in the ISR. When SysEx is recieved, ListenForSysEx()
      * calls OnReceiveSysEx().
      *
-     * IMPORTANT! Do not use ListenForSysEx() in apps that use MIDI in, because ListenForSysEx()
-     * will devour most of the incoming MIDI events, and MIDI in won't work.
+     * Apps that use MIDI in can still call it; it only sees SysEx messages, the other messages
+     * are left for the app's own oc::MidiSubscription.
      */
     bool ListenForSysEx() {
         bool heard_sysex = 0;
-        if (usbMIDI.read()) {
-            if (usbMIDI.getType() == usbMIDI.SystemExclusive) {
-                OnReceiveSysEx();
-                heard_sysex = 1;
-            }
+        while (oc::MidiIn::Read(sysex_subscription_)) {
+            OnReceiveSysEx();
+            heard_sysex = 1;
         }
         return heard_sysex;
     }
@@ -297,6 +296,7 @@ protected:
 
 private:
     char last_app_code; // The most recent application code received
+    oc::MidiSubscription sysex_subscription_ { oc::MidiTypeBit(usbMIDI.SystemExclusive) };
 };
 
 /*
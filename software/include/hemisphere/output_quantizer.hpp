@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include "braids/quantizer.h"
+#include "oc/scales.h"
+#include "util/bit_packer.h"
+
+namespace hemisphere {
+
+// Quantizer settings for one output, which uses every note of the scale. They
+// are packed so that all zeros, which is what settings saved before there was
+// an output quantizer restore as, is off.
+struct OutputQuantizerConfig {
+  static constexpr size_t kPackedBits = 8 + 4;
+  static_assert(oc::Scales::NUM_SCALES < 255, "Scale index doesn't fit");
+
+  int scale;     // oc::Scales index, SCALE_NONE for off
+  int root;      // semitones, 0-11
+
+  void Reset() {
+    scale = oc::Scales::SCALE_NONE;
+    root = 0;
+  }
+
+  bool enabled() const {
+    return scale != oc::Scales::SCALE_NONE;
+  }
+
+  void Pack(util::BitWriter &writer) const {
+    writer.Write(enabled() ? scale + 1 : 0, 8);
+    writer.Write(root, 4);
+  }
+
+  void Unpack(util::BitReader &reader) {
+    int packed_scale = reader.Read(8);
+    scale = packed_scale && packed_scale <= oc::Scales::NUM_SCALES ? packed_scale - 1
+                                                                    : oc::Scales::SCALE_NONE;
+    root = reader.Read(4);
+    if (root > 11) root = 0;
+  }
+};
+
+/* Output quantizer stage
+ *
+ * Quantizes the selected outputs after both applets have run, so any applet's
+ * pitch output can be put in a scale without the applet having its own
+ * quantizer. The applets' outputs[] are left as they set them; only the DAC
+ * gets the quantized pitch.
+ *
+ * The settings belong to Hemisphere rather than to a preset: they are stored
+ * once, after the presets, and loading a preset leaves them as they are.
+ *
+ * Process runs in the core ISR and owns the quantizers. Configure only
+ * stores the settings and marks them pending, and Process applies them before
+ * it next quantizes that output, so the UI never changes a quantizer that the
+ * ISR may be in the middle of using.
+ */
+class OutputQuantizer {
+ public:
+  static constexpr int kNumOutputs = 4;
+  static constexpr size_t kStorageSize =
+      (kNumOutputs * OutputQuantizerConfig::kPackedBits + 7) / 8;
+
+  void Init();
+
+  const OutputQuantizerConfig &config(int ch) const {
+    return config_[ch];
+  }
+
+  void Configure(int ch, const OutputQuantizerConfig &config);
+
+  // Applies pending settings, and quantizes the outputs that have a scale;
+  // nothing to do if none do
+  void Process();
+
+  void Pack(uint8_t *storage) const;
+  void Unpack(const uint8_t *storage);
+
+ private:
+  OutputQuantizerConfig config_[kNumOutputs];
+  std::atomic<uint8_t> pending_mask_;
+
+  // Only used by Process
+  braids::Quantizer quantizer_[kNumOutputs];
+  int root_[kNumOutputs];
+  uint8_t enabled_mask_;
+
+  void Apply(int ch);
+};
+
+}  // namespace hemisphere
@@ -1,6 +1,7 @@
 #pragma once
 #include "hemisphere/applet_base.hpp"
 #include "hemisphere/midi.hpp"
+#include "hemisphere/preset_blob.hpp"
 #include "util/settings.h"
 
 namespace hemisphere {
@@ -26,6 +27,13 @@ enum class Setting {
 
 constexpr int kNumPresets = 4;
 
+// Bytes per preset for applet state beyond the 64 bits of data (see
+// PresetBlob). They come out of the app storage in EEPROM, which all the apps
+// share and which is nearly full.
+#ifndef HEMISPHERE_PRESET_BLOB_SIZE
+#define HEMISPHERE_PRESET_BLOB_SIZE 10
+#endif
+
 constexpr const char *preset_name[kNumPresets] = {"A", "B", "C", "D"};
 
 /* Hemisphere Preset
@@ -49,13 +57,30 @@ class Preset
   /* Manually store state data for one side */
   void SetData(int h, uint64_t data);
 
+  // Extra state for the applets on both sides. If the two records don't fit
+  // together, both applets are asked again for one that fits in half the blob;
+  // an applet whose state still doesn't fit gets no blob.
+  void StoreBlobs(const Applet &left, const Applet &right);
+  void LoadBlob(int h, const Applet &applet);
+
+  // The blobs are stored after the settings of all the presets, so that the
+  // settings are laid out as before
+  static constexpr size_t blobSize() { return HEMISPHERE_PRESET_BLOB_SIZE; }
+  size_t SaveBlob(void *storage) const;
+  size_t RestoreBlob(const void *storage);
+
   void OnSendSysEx();
   void OnReceiveSysEx();
+
+ private:
+  PresetBlob<HEMISPHERE_PRESET_BLOB_SIZE> blob_;
+
+  bool StoreBlob(int h, const Applet &applet, size_t room);
 };
 
 // hemisphere::Preset hem_config; // special place for Clock data and Config data,
 // 64 bits each
 
-static Preset presets[kNumPresets];
-static Preset *active_preset;
+extern Preset presets[kNumPresets];
+extern Preset *active_preset;
 };
\ No newline at end of file
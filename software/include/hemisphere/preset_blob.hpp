@@ -0,0 +1,82 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace hemisphere {
+
+/* Applet state beyond the 64 bits of data in a Preset
+ *
+ * There is one record per hemisphere, left first: a header byte with the
+ * applet's format version in the top 3 bits and the length in the bottom 5,
+ * then the data. The records share the blob, so one applet can use nearly all
+ * of it. Version 0 means no record, so an all-zero blob (which is what a
+ * preset saved before there were blobs restores as) is empty.
+ */
+template <size_t blob_size>
+class PresetBlob {
+ public:
+  static_assert(blob_size >= 2, "Blob needs room for both headers");
+  static constexpr size_t kSize = blob_size;
+  static constexpr size_t kMaxLength = blob_size - 2 < 31 ? blob_size - 2 : 31;
+  // Records of up to this length always fit on both sides
+  static constexpr size_t kHalfLength = (blob_size - 2) / 2 < kMaxLength ? (blob_size - 2) / 2 : kMaxLength;
+  static constexpr uint8_t kMaxVersion = 7;
+
+  void Clear() { memset(bytes_, 0, sizeof(bytes_)); }
+
+  // Replaces the record for one side. If it doesn't fit next to the other
+  // side's record, that side is left without one and false is returned.
+  bool Set(int h, uint8_t version, const uint8_t *data, size_t length) {
+    const uint8_t *other_data;
+    size_t other_length;
+    uint8_t other_version = Get(!h, other_data, other_length);
+    uint8_t other[kMaxLength];
+    memcpy(other, other_data, other_length);
+
+    bool fits = version && version <= kMaxVersion && length <= kMaxLength &&
+                2 + length + other_length <= blob_size;
+    if (!fits) version = length = 0;
+
+    Clear();
+    if (h) {
+      size_t offset = Put(0, other_version, other, other_length);
+      Put(offset, version, data, length);
+    } else {
+      size_t offset = Put(0, version, data, length);
+      Put(offset, other_version, other, other_length);
+    }
+    return fits;
+  }
+
+  // Returns the record's version, or 0 if there is none
+  uint8_t Get(int h, const uint8_t *&data, size_t &length) const {
+    size_t offset = 0;
+    if (h) offset = 1 + (bytes_[0] & 0x1f);
+    data = bytes_;
+    length = 0;
+    // Anything that doesn't add up (e.g. a blob of junk) is no record
+    if (offset + 1 > blob_size) return 0;
+    size_t record_length = bytes_[offset] & 0x1f;
+    uint8_t version = bytes_[offset] >> 5;
+    if (!version || offset + 1 + record_length > blob_size) return 0;
+    data = bytes_ + offset + 1;
+    length = record_length;
+    return version;
+  }
+
+  uint8_t *bytes() { return bytes_; }
+  const uint8_t *bytes() const { return bytes_; }
+
+ private:
+  uint8_t bytes_[blob_size];
+
+  size_t Put(size_t offset, uint8_t version, const uint8_t *data,
+             size_t length) {
+    bytes_[offset] = (version << 5) | length;
+    memcpy(bytes_ + offset + 1, data, length);
+    return offset + 1 + length;
+  }
+};
+
+}  // namespace hemisphere
@@ -0,0 +1,30 @@
+// Proportion in simulated fixed float (14 fractional bits), i.e.
+//
+//   numerator        result
+//  ----------- = ------------
+//  denominator    max_value
+//
+// This is the arithmetic behind AppletBase::Proportion and friends. The
+// template version takes the denominator as a compile-time constant, so the
+// compiler turns the division into a multiply by the reciprocal (and shifts)
+// instead of an SDIV, with bit-identical results.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace hemisphere {
+
+inline int32_t Proportion(int32_t numerator, int32_t denominator, int32_t max_value) {
+  int32_t proportion = (numerator << 14) / denominator;
+  return (proportion * max_value) >> 14;
+}
+
+template <int32_t denominator>
+inline int32_t Proportion(int32_t numerator, int32_t max_value) {
+  static_assert(denominator != 0, "Proportion of zero");
+  int32_t proportion = (numerator << 14) / denominator;
+  return (proportion * max_value) >> 14;
+}
+
+}; // namespace hemisphere
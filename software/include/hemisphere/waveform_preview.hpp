@@ -0,0 +1,61 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+namespace hemisphere {
+
+/* Cached waveform preview
+ *
+ * A polyline of up to max_points points for applets that draw their waveform,
+ * so the points are only worked out again when the waveform changes rather
+ * than on every frame. The key is whatever the shape depends on (the applet
+ * packs its shape parameters into it); the points are stale when it differs
+ * from the one they were rendered for, or after Invalidate().
+ *
+ *   if (preview.Stale(key)) {
+ *     preview.Begin(key);
+ *     for (...) preview.Add(x, y);
+ *   }
+ *   gfxPreview(preview);
+ */
+template <size_t max_points>
+class WaveformPreview {
+ public:
+  static_assert(max_points >= 2 && max_points <= 255, "Points don't fit");
+
+  bool Stale(uint32_t key) const {
+    return !valid_ || key != key_;
+  }
+
+  void Begin(uint32_t key) {
+    key_ = key;
+    valid_ = true;
+    count_ = 0;
+  }
+
+  void Add(uint8_t x, uint8_t y) {
+    if (count_ < max_points) {
+      x_[count_] = x;
+      y_[count_] = y;
+      ++count_;
+    }
+  }
+
+  // For changes the key doesn't cover
+  void Invalidate() {
+    valid_ = false;
+  }
+
+  size_t size() const { return count_; }
+  uint8_t x(size_t i) const { return x_[i]; }
+  uint8_t y(size_t i) const { return y_[i]; }
+
+ private:
+  uint32_t key_ = 0;
+  bool valid_ = false;
+  uint8_t count_ = 0;
+  uint8_t x_[max_points];
+  uint8_t y_[max_points];
+};
+
+}  // namespace hemisphere
@@ -11,7 +11,9 @@
 // * Category filtering is deprecated at 1.8, but I'm leaving the per-applet categorization
 // alone to avoid breaking forked codebases by other developers.
 
+#include <stddef.h>
 #include <stdint.h>
+#include "util/bit_packer.h"
 
 #define APPLET(class_name) \
   extern void class_name ## _Start(bool); \
@@ -22,6 +24,10 @@
   extern void class_name ## _ToggleHelpScreen(bool); \
   extern uint64_t class_name ## _OnDataRequest(bool); \
   extern void class_name ## _OnDataReceive(bool, uint64_t); \
+  extern uint8_t class_name ## _OnBlobRequest(bool, util::BitWriter &); \
+  extern void class_name ## _OnBlobReceive(bool, uint8_t, util::BitReader &); \
+  extern void class_name ## _Unload(bool); \
+  extern size_t class_name ## _SizeOf(); \
 
 
 APPLET(ADSREG);
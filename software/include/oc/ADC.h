@@ -10,6 +10,11 @@
 
 #include <ADC.h>
 //#define ENABLE_ADC_DEBUG
+//#define ENABLE_ADC_DMA
+
+#ifdef ENABLE_ADC_DMA
+#include <DMAChannel.h>
+#endif
 
 enum ADC_CHANNEL {
   ADC_CHANNEL_1,
@@ -38,6 +43,22 @@ public:
 
   static constexpr uint32_t kAdcValueShift = kAdcSmoothBits;
 
+#ifdef ENABLE_ADC_DMA
+  // With DMA the ADC converts continuously, so fewer hardware averages per
+  // sample and the rest is made up by oversampling in the sequence.
+  static constexpr uint8_t kAdcDMAAverages = 4;
+  static constexpr uint8_t kAdcMaxOversampling = 3; // log2
+  static constexpr size_t kAdcMaxSequenceLength = ADC_CHANNEL_LAST << kAdcMaxOversampling;
+#endif
+
+  // Trade-off between latency and noise, set per app. Apps start out with
+  // FILTER_PROFILE_STANDARD and can pick another one on APP_EVENT_RESUME.
+  enum FilterProfile {
+    FILTER_PROFILE_LOW_LATENCY,
+    FILTER_PROFILE_STANDARD,
+    FILTER_PROFILE_LOW_NOISE,
+    FILTER_PROFILE_LAST
+  };
 
   struct CalibrationData {
     uint16_t offset[ADC_CHANNEL_LAST];
@@ -49,11 +70,28 @@ public:
 
   // Read the value of the last conversion and update current channel, then
   // start the next conversion. If necessary, some channels could be given
-  // priority by scanning them more often. Even better might be some kind of
-  // continuous/DMA sampling to make things even more independent of the main
-  // ISR timing restrictions.
+  // priority by scanning them more often.
+  //
+  // With ENABLE_ADC_DMA the ADC instead runs continuously through a sequence
+  // of channels, with DMA collecting results into a double buffer and
+  // re-arming the next conversion; Scan only decimates the most recently
+  // completed half into all four channels.
   static void Scan();
 
+  // Sets the smoothing and oversampling of all channels. Without DMA this has
+  // no effect, the round robin always uses kAdcSmoothing.
+  static void set_filter_profile(FilterProfile profile);
+
+  static FilterProfile filter_profile() {
+    return filter_profile_;
+  }
+
+#ifdef ENABLE_ADC_DMA
+  // Per-channel override of the oversampling as log2(samples per sequence),
+  // up to kAdcMaxOversampling. Applied by the next Scan.
+  static void set_oversampling(ADC_CHANNEL channel, uint8_t oversampling);
+#endif
+
   template <ADC_CHANNEL channel>
   static int32_t value() {
     return calibration_data_->offset[channel] - (smoothed_[channel] >> kAdcValueShift);
@@ -101,16 +139,37 @@ private:
 
   template <ADC_CHANNEL channel>
   static void update(uint32_t value) {
+    update(channel, value);
+  }
+
+  static void update(size_t channel, uint32_t value) {
     value = (value  >> (kAdcScanResolution - kAdcResolution)) << kAdcSmoothBits;
     raw_[channel] = value;
-    // division should be shift if kAdcSmoothing is power-of-two
-    value = (smoothed_[channel] * (kAdcSmoothing - 1) + value) / kAdcSmoothing;
+    const uint32_t smoothing_shift = smoothing_shift_;
+    value = (smoothed_[channel] * ((1U << smoothing_shift) - 1) + value) >> smoothing_shift;
     smoothed_[channel] = value;
   }
 
   static ::ADC adc_;
   static size_t scan_channel_;
   static CalibrationData *calibration_data_;
+  static FilterProfile filter_profile_;
+  static uint8_t smoothing_shift_;
+
+#ifdef ENABLE_ADC_DMA
+  static void StartDMA();
+
+  static DMAChannel dma_result_;
+  static DMAChannel dma_mux_;
+  static uint8_t oversampling_[ADC_CHANNEL_LAST];
+  static volatile bool sequence_dirty_;
+  static size_t sequence_length_;
+  static uint8_t sequence_channel_[kAdcMaxSequenceLength];
+  static uint8_t sequence_oversampling_[ADC_CHANNEL_LAST];
+  static uint32_t sequence_sc1a_[kAdcMaxSequenceLength];
+  static volatile uint16_t dma_samples_[2 * kAdcMaxSequenceLength];
+  static bool dma_primed_;
+#endif
 
   static uint32_t raw_[ADC_CHANNEL_LAST];
   static uint32_t smoothed_[ADC_CHANNEL_LAST];
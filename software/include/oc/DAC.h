@@ -8,10 +8,14 @@
 #include "util/math.h"
 #include "util/macros.h"
 
-extern void set8565_CHA(uint32_t data);
-extern void set8565_CHB(uint32_t data);
-extern void set8565_CHC(uint32_t data);
-extern void set8565_CHD(uint32_t data);
+// Write the DAC with DMA paced by the SPI0 RX FIFO, so the core ISR only
+// queues the changed channels instead of waiting for the SPI transfers
+//#define ENABLE_DAC_DMA
+
+#ifdef ENABLE_DAC_DMA
+#include <DMAChannel.h>
+#endif
+
 extern void SPI_init();
 
 enum DAC_CHANNEL {
@@ -39,6 +43,11 @@ public:
   static constexpr size_t kHistoryDepth = 8;
   static constexpr uint16_t MAX_VALUE = 65535; // DAC fullscale 
 
+  // Channels are only written when their value changed; in addition, one
+  // channel is rewritten every kRefreshTicks so that all of them get refreshed
+  // regularly even if they never change.
+  static constexpr uint32_t kRefreshTicks = 64;
+
   #ifdef BUCHLA_4U
     static constexpr int kOctaveZero = 0;
   #elif defined(VOR) 
@@ -213,12 +222,38 @@ public:
     return calibration_data_->calibrated_octaves[channel][kOctaveZero + octave];
   }
 
+  // DAC8565 single-channel update command for each channel
+  static constexpr uint8_t command(size_t channel) {
+  #ifdef FLIP_180
+    return 0x16 - (channel << 1);
+  #else
+    return 0x10 + (channel << 1);
+  #endif
+  }
+
+  // DAC8565 data word for a value
+  static constexpr uint16_t data(uint32_t value) {
+  #ifdef BUCHLA_cOC
+    return value;
+  #else
+    return MAX_VALUE - value;
+  #endif
+  }
+
   static void Update() {
 
-    set8565_CHA(values_[DAC_CHANNEL_A]);
-    set8565_CHB(values_[DAC_CHANNEL_B]);
-    set8565_CHC(values_[DAC_CHANNEL_C]);
-    set8565_CHD(values_[DAC_CHANNEL_D]);
+    uint32_t channels = 0;
+    for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i) {
+      if (values_[i] != sent_values_[i])
+        channels |= 0x1 << i;
+    }
+    if (!--refresh_ticks_) {
+      refresh_ticks_ = kRefreshTicks;
+      channels |= 0x1 << refresh_channel_;
+      refresh_channel_ = (refresh_channel_ + 1) % DAC_CHANNEL_LAST;
+    }
+    if (channels)
+      Write(channels);
 
     size_t tail = history_tail_;
     history_[DAC_CHANNEL_A][tail] = values_[DAC_CHANNEL_A];
@@ -243,9 +278,46 @@ public:
       *dst++ = *src++;
   }
 
+  // The DAC transfer has to be finished before anything else uses SPI0.
+  // Without ENABLE_DAC_DMA, Update already waited for it.
+  //
+  // The display page DMA also enables the SPI0 RX request, so dma_rx_ is only
+  // attached to it for the duration of a DAC transfer.
+  static void WaitForTransfer() {
+  #ifdef ENABLE_DAC_DMA
+    if (dma_busy_) {
+      if (!dma_rx_.complete()) {
+        ++busy_waits_;
+        while (!dma_rx_.complete()) { }
+      }
+      SPI0_RSER = 0;
+      dma_rx_.detachTrigger();
+      dma_busy_ = false;
+    }
+  #endif
+  }
+
+  static uint32_t busy_waits() {
+    return busy_waits_;
+  }
+
 private:
+  // Send the given channels (bit mask) to the DAC
+  static void Write(uint32_t channels);
+
   static CalibrationData *calibration_data_;
   static uint32_t values_[DAC_CHANNEL_LAST];
+  static uint32_t sent_values_[DAC_CHANNEL_LAST];
+  static uint32_t refresh_ticks_;
+  static size_t refresh_channel_;
+  static volatile uint32_t busy_waits_;
+#ifdef ENABLE_DAC_DMA
+  static DMAChannel dma_tx_;
+  static DMAChannel dma_rx_;
+  static uint32_t dma_commands_[2 * DAC_CHANNEL_LAST];
+  static volatile uint32_t dma_rx_data_;
+  static bool dma_busy_;
+#endif
   static uint16_t history_[DAC_CHANNEL_LAST][kHistoryDepth];
   static volatile size_t history_tail_;
   static uint8_t DAC_scaling[DAC_CHANNEL_LAST];
@@ -65,6 +65,10 @@ struct App {
   void (*HandleEncoderEvent)(const UI::Event &);
 
   void (*isr)();
+
+  // The storage has only ever grown by appending to it, so settings saved by
+  // an older version (a shorter chunk) can be restored with the rest zeroed
+  bool appendable_storage;
 };
 
 namespace apps {
@@ -81,6 +85,22 @@ namespace apps {
 
   App *find(uint16_t id);
   int index_of(uint16_t id);
+  void set_current_app(int index);
+
+  // Save the global settings and all apps' settings to EEPROM
+  void SaveSettings();
+
+  // What the last SaveSettings cost
+  struct SaveStats {
+    uint32_t used; // bytes of app data
+    uint32_t changed; // bytes that differed from EEPROM, i.e. were written
+    uint32_t dirty_apps; // apps whose chunk changed
+    uint32_t compressed_apps;
+    uint32_t skipped_apps; // didn't fit, so not saved
+    uint32_t us; // time taken
+  };
+
+  extern SaveStats last_save;
 
 }; // namespace apps
 
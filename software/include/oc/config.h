@@ -22,6 +22,11 @@ static constexpr int OC_GPIO_ISR_PRIO   = 112; // higher
 static constexpr int OC_UI_TIMER_PRIO   = 128; // default
 
 static constexpr unsigned long REDRAW_TIMEOUT_MS = 1;
+// Frames are drawn about every FRAME_PERIOD_US. If the views of a frame take
+// longer than FRAME_BUDGET_US to draw, the Hemisphere halves are drawn in turns
+// (see oc::RenderScheduler)
+static constexpr uint32_t FRAME_PERIOD_US = (REDRAW_TIMEOUT_MS + 1) * 1000;
+static constexpr uint32_t FRAME_BUDGET_US = 1000;
 static constexpr uint32_t SCREENSAVER_TIMEOUT_S = 25; // default time out menu (in s)
 static constexpr uint32_t SCREENSAVER_TIMEOUT_MAX_S = 120;
 
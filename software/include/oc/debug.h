@@ -19,6 +19,31 @@ namespace DEBUG {
   extern uint32_t UI_event_count;
   extern uint32_t UI_max_queue_depth;
   extern uint32_t UI_queue_overflow;
+
+  // Per-stage breakdown of the core ISR, in call order
+  enum ISR_STAGE {
+    ISR_STAGE_DISPLAY_FLUSH,
+    ISR_STAGE_DAC,
+    ISR_STAGE_ADC,
+    ISR_STAGE_DIGITAL_INPUTS,
+    ISR_STAGE_MIDI_IN,
+    ISR_STAGE_DISPLAY_UPDATE,
+    ISR_STAGE_APP,
+    ISR_STAGE_LAST
+  };
+
+  extern const char * const ISR_stage_names[ISR_STAGE_LAST];
+  extern debug::CycleHistogram ISR_stage_cycles[ISR_STAGE_LAST];
+  extern debug::CycleHistogram ISR_total_cycles;
+  extern uint32_t ISR_overruns; // ticks that took longer than OC_CORE_TIMER_RATE
+
+  // Hemisphere applet Controller() cost per side, and ClockSetup
+  extern debug::CycleHistogram APPLET_cycles[2];
+  extern int APPLET_ids[2];
+  extern debug::CycleHistogram CLOCK_SETUP_cycles;
+
+  void ResetProfile();
+  void DumpProfile(); // print histograms to USB serial
 };
 
 class DebugPins {
@@ -37,6 +62,9 @@ public:
 #define OC_DEBUG_PROFILE_SCOPE(var) \
   debug::ScopedCycleMeasurement cycles(var)
 
+#define OC_DEBUG_PROFILE_STAGE(measurement, stage) \
+  oc::DEBUG::ISR_stage_cycles[stage].push(measurement.lap())
+
 #define OC_DEBUG_RESET_CYCLES(counter, count, var) \
   do { \
     if (!((counter) & (count - 1))) \
@@ -23,6 +23,12 @@ static constexpr uint32_t DIGITAL_INPUT_2_MASK = DIGITAL_INPUT_MASK(DIGITAL_INPU
 static constexpr uint32_t DIGITAL_INPUT_3_MASK = DIGITAL_INPUT_MASK(DIGITAL_INPUT_3);
 static constexpr uint32_t DIGITAL_INPUT_4_MASK = DIGITAL_INPUT_MASK(DIGITAL_INPUT_4);
 
+// Edge timestamps come from the cycle counter; the host build substitutes
+// simulated time so captures are reproducible.
+#ifndef OC_EDGE_TIMESTAMP
+#define OC_EDGE_TIMESTAMP() ARM_DWT_CYCCNT
+#endif
+
 template <DigitalInput> struct InputPinDesc { };
 template <> struct InputPinDesc<DIGITAL_INPUT_1> { static constexpr int PIN = TR1; };
 template <> struct InputPinDesc<DIGITAL_INPUT_2> { static constexpr int PIN = TR2; };
@@ -31,6 +37,7 @@ template <> struct InputPinDesc<DIGITAL_INPUT_4> { static constexpr int PIN = TR
 
 class DigitalInputs {
 public:
+  static constexpr uint32_t kCyclesPerTick = (F_CPU / 1000000) * OC_CORE_TIMER_RATE;
 
   static void Init();
 
@@ -53,6 +60,28 @@ public:
     return clocked_mask_ & (0x1 << input);
   }
 
+  // Cycle counter at the last Scan; edge offsets are relative to this
+  static inline uint32_t scan_timestamp() {
+    return scan_timestamp_;
+  }
+
+  // @return number of edges on input since the last Scan (usually 0 or 1)
+  static inline uint32_t edge_count(DigitalInput input) {
+    return edge_count_[input];
+  }
+
+  // @return cycles between the latest edge on input and the last Scan, i.e.
+  // how far before the current tick it actually happened
+  static inline uint32_t edge_offset(DigitalInput input) {
+    return scan_timestamp_ - edge_timestamp_[input];
+  }
+
+  // @return cycles between the two most recent edges on input, or 0 if there
+  // aren't two recent enough to tell
+  static inline uint32_t edge_period(DigitalInput input) {
+    return edge_period_[input];
+  }
+
   template <DigitalInput input> static inline bool read_immediate() {
     return !digitalReadFast(InputPinDesc<input>::PIN);
   }
@@ -61,8 +90,12 @@ public:
     return !digitalReadFast(InputPinMap(input));
   }
 
+  // Called from the pin ISRs. The queue is only written here and only read
+  // in Scan, so the two don't need to lock each other out.
   template <DigitalInput input> static inline void clock() {
-    clocked_[input] = 1;
+    uint32_t write = edge_queue_[input].write;
+    edge_queue_[input].timestamps[write % kEdgeQueueSize] = OC_EDGE_TIMESTAMP();
+    edge_queue_[input].write = write + 1;
   }
 
 private:
@@ -78,17 +111,45 @@ private:
     return 0;
   }
 
+  static constexpr uint32_t kEdgeQueueSize = 4; // power of 2
+  // Edges further apart than this can't be timed before the counter wraps
+  static constexpr uint32_t kMaxEdgePeriodTicks = 0x7fffffff / kCyclesPerTick;
+
+  struct EdgeQueue {
+    volatile uint32_t timestamps[kEdgeQueueSize];
+    volatile uint32_t write;
+    uint32_t read;
+  };
+
   static uint32_t clocked_mask_;
-  static volatile uint32_t clocked_[DIGITAL_INPUT_LAST];
+  static EdgeQueue edge_queue_[DIGITAL_INPUT_LAST];
+  static uint32_t scan_timestamp_;
+  static uint32_t edge_count_[DIGITAL_INPUT_LAST];
+  static uint32_t edge_timestamp_[DIGITAL_INPUT_LAST];
+  static uint32_t edge_ticks_[DIGITAL_INPUT_LAST];
+  static uint32_t edge_period_[DIGITAL_INPUT_LAST];
 
   template <DigitalInput input>
   static uint32_t ScanInput() {
-    if (clocked_[input]) {
-      clocked_[input] = 0;
-      return DIGITAL_INPUT_MASK(input);
-    } else {
+    EdgeQueue &queue = edge_queue_[input];
+    uint32_t write = queue.write;
+    uint32_t count = write - queue.read;
+    queue.read = write;
+    edge_count_[input] = count;
+    if (!count)
       return 0;
-    }
+
+    // If there were more edges than fit, the oldest ones are lost
+    uint32_t timestamp = queue.timestamps[(write - 1) % kEdgeQueueSize];
+    uint32_t previous = edge_timestamp_[input];
+    if (count > 1)
+      previous = queue.timestamps[(write - 2) % kEdgeQueueSize];
+    else if (!edge_ticks_[input] || core::ticks - edge_ticks_[input] > kMaxEdgePeriodTicks)
+      previous = timestamp;
+    edge_period_[input] = timestamp - previous;
+    edge_timestamp_[input] = timestamp;
+    edge_ticks_[input] = core::ticks ? core::ticks : 1;
+    return DIGITAL_INPUT_MASK(input);
   }
 };
 
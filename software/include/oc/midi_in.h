@@ -0,0 +1,121 @@
+#ifndef OC_MIDI_IN_H_
+#define OC_MIDI_IN_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "oc/core.h"
+
+namespace oc {
+
+// One USB MIDI message as returned by usbMIDI.getType() etc.
+struct MidiMessage {
+  uint8_t type;    // usbMIDI.NoteOn, usbMIDI.Clock, ...
+  uint8_t channel; // 1-16, 0 for system messages
+  uint8_t data1;
+  uint8_t data2;
+};
+
+// Bit in a subscription's type mask for a message type: channel messages
+// 0x80-0xE0 are bits 0-6, system messages 0xF0-0xFF are bits 8-23
+static constexpr uint32_t MidiTypeBit(uint8_t type) {
+  return type >= 0xf0 ? (0x100U << (type & 0x0f)) : (0x1U << ((type >> 4) & 0x07));
+}
+
+static constexpr uint32_t MIDI_TYPE_ALL = 0xffffffff;
+static constexpr uint16_t MIDI_CHANNEL_ALL = 0xffff;
+
+// Filter and read position of one MIDI In consumer. The channel mask only
+// applies to channel messages (bit 0 = channel 1), system messages pass if
+// their type is in the type mask.
+class MidiSubscription {
+public:
+  constexpr MidiSubscription(uint32_t type_mask, uint16_t channel_mask = MIDI_CHANNEL_ALL)
+  : type_mask_(type_mask), channel_mask_(channel_mask)
+  { }
+
+  void set_type_mask(uint32_t type_mask) { type_mask_ = type_mask; }
+  void set_channel_mask(uint16_t channel_mask) { channel_mask_ = channel_mask; }
+
+  // Messages that were overwritten before this consumer read them
+  uint32_t dropped() const { return dropped_; }
+
+  inline bool accepts(const MidiMessage &message) const {
+    if (!(type_mask_ & MidiTypeBit(message.type)))
+      return false;
+    return message.type >= 0xf0 || (channel_mask_ & (0x1 << ((message.channel - 1) & 0x0f)));
+  }
+
+private:
+  friend class MidiIn;
+
+  uint32_t type_mask_;
+  uint16_t channel_mask_;
+  uint32_t read_ptr_ = 0;
+  uint32_t last_tick_ = 0;
+  uint32_t dropped_ = 0;
+};
+
+// Single reader of the USB MIDI endpoint. Scan runs once per core ISR tick,
+// before the apps, and copies the incoming messages into a ring that every
+// consumer reads with its own MidiSubscription. Consumers are also called from
+// the core ISR, so there is exactly one writer and the reads never race it;
+// the messages returned by Read stay valid for the rest of the tick.
+//
+// A subscription that wasn't read on the previous tick (e.g. the app was
+// suspended, or the applet was just started) restarts with this tick's
+// messages, instead of seeing whatever arrived meanwhile.
+//
+// SysEx data isn't copied: Scan stops after a SysEx message so that
+// usbMIDI.getSysExArray() still holds it while the consumers run.
+class MidiIn {
+public:
+  static constexpr size_t kQueueSize = 64; // power of 2
+  // Bounds the USB read cost per tick; anything left over stays in the USB
+  // buffers until the next tick
+  static constexpr size_t kMaxReadsPerScan = 16;
+
+  static void Init();
+
+  static void Scan();
+
+  // @return next message for the subscription, nullptr if there are none
+  static const MidiMessage *Read(MidiSubscription &subscription) {
+    const uint32_t tick = core::ticks;
+    if (tick - subscription.last_tick_ > 1) {
+      subscription.read_ptr_ = scan_write_ptr_;
+    } else if (write_ptr_ - subscription.read_ptr_ > kQueueSize) {
+      uint32_t lost = write_ptr_ - subscription.read_ptr_ - kQueueSize;
+      subscription.dropped_ += lost;
+      dropped_ += lost;
+      subscription.read_ptr_ = write_ptr_ - kQueueSize;
+    }
+    subscription.last_tick_ = tick;
+
+    while (subscription.read_ptr_ != write_ptr_) {
+      const MidiMessage &message = queue_[subscription.read_ptr_++ & (kQueueSize - 1)];
+      if (subscription.accepts(message))
+        return &message;
+    }
+    return nullptr;
+  }
+
+  // Total messages read from USB
+  static uint32_t received() { return received_; }
+  // Total messages lost by all subscribers
+  static uint32_t dropped() { return dropped_; }
+  // Scans that stopped at kMaxReadsPerScan
+  static uint32_t deferred() { return deferred_; }
+
+private:
+  static MidiMessage queue_[kQueueSize];
+  static uint32_t write_ptr_;
+  static uint32_t scan_write_ptr_; // write_ptr_ before the current tick's messages
+
+  static uint32_t received_;
+  static uint32_t dropped_;
+  static uint32_t deferred_;
+};
+
+} // namespace oc
+
+#endif // OC_MIDI_IN_H_
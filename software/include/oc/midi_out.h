@@ -0,0 +1,94 @@
+#ifndef OC_MIDI_OUT_H_
+#define OC_MIDI_OUT_H_
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "oc/midi_in.h"
+
+namespace oc {
+
+// Queue for all USB MIDI output. The apps mostly send from the core ISR, where
+// usbMIDI can block for as long as the USB buffers are full; instead, messages
+// are queued here and sent from the main loop by Drain.
+//
+// - Realtime messages (clock, start, stop...) have their own queue that is
+//   always sent first and in full.
+// - Other messages are sent at most kMaxSendsPerDrain per pass, i.e. one USB
+//   packet, so a burst doesn't stall the main loop either.
+// - A control change, channel pressure or pitch bend replaces a queued one for
+//   the same controller and channel, unless a note for that channel was queued
+//   after it. Only the latest value goes out.
+//
+// Messages can be queued from both the ISR and the main loop; the main loop
+// only runs Drain, so the queues are single consumer, and the producers are
+// serialized by briefly disabling interrupts.
+class MidiOut {
+public:
+  static constexpr size_t kQueueSize = 128; // power of 2
+  static constexpr size_t kRealTimeQueueSize = 16; // power of 2
+  static constexpr size_t kMaxSendsPerDrain = 16;
+  // How far back a controller value is looked for
+  static constexpr size_t kCoalesceDepth = 8;
+
+  static void Init();
+
+  // Main loop
+  static void Drain();
+
+  static void SendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+    Push(usbMIDI.NoteOn, channel, note, velocity);
+  }
+
+  static void SendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel) {
+    Push(usbMIDI.NoteOff, channel, note, velocity);
+  }
+
+  static void SendControlChange(uint8_t control, uint8_t value, uint8_t channel) {
+    Push(usbMIDI.ControlChange, channel, control, value);
+  }
+
+  static void SendAfterTouch(uint8_t pressure, uint8_t channel) {
+    Push(usbMIDI.AfterTouchChannel, channel, pressure, 0);
+  }
+
+  // Same argument as usbMIDI.sendPitchBend, which it is passed on to
+  static void SendPitchBend(int16_t value, uint8_t channel) {
+    Push(usbMIDI.PitchBend, channel, value & 0xff, (value >> 8) & 0xff);
+  }
+
+  static void SendRealTime(uint8_t type);
+
+  // "All Notes Off" (CC 123) on every channel
+  static void AllNotesOff();
+
+  // Messages waiting to be sent
+  static size_t depth() { return write_ptr_ - read_ptr_; }
+  // Highest depth so far
+  static size_t max_depth() { return max_depth_; }
+  static uint32_t sent() { return sent_; }
+  static uint32_t coalesced() { return coalesced_; }
+  // Messages lost because the queue was full
+  static uint32_t dropped() { return dropped_; }
+
+private:
+  static void Push(uint8_t type, uint8_t channel, uint8_t data1, uint8_t data2);
+  static void Send(const MidiMessage &message);
+
+  static MidiMessage queue_[kQueueSize];
+  static volatile uint32_t write_ptr_;
+  static volatile uint32_t read_ptr_;
+
+  static uint8_t realtime_queue_[kRealTimeQueueSize];
+  static volatile uint32_t realtime_write_ptr_;
+  static volatile uint32_t realtime_read_ptr_;
+
+  static size_t max_depth_;
+  static uint32_t sent_;
+  static uint32_t coalesced_;
+  static uint32_t dropped_;
+};
+
+} // namespace oc
+
+#endif // OC_MIDI_OUT_H_
@@ -0,0 +1,150 @@
+#ifndef OC_RENDER_SCHEDULER_H_
+#define OC_RENDER_SCHEDULER_H_
+
+#include <stdint.h>
+
+namespace oc {
+
+/* Render scheduler
+ *
+ * Keeps the time the main loop spends drawing in check. Frames are counted as
+ * they're started, and a frame that starts more than one frame period late
+ * counts the periods it missed as dropped.
+ *
+ * A view made of independent regions (the Hemisphere halves) plans each frame
+ * with Plan() and reports what each region took to draw. While all of them fit
+ * in the budget every region is drawn every frame; when they don't, a frame
+ * only draws one region and the others keep what the previous frame showed.
+ * A region with a UI event goes first, so whatever is being edited keeps up
+ * with the encoder, but never for so long that the others stop updating.
+ * Anything that moves regions about has to InvalidateAll().
+ */
+class RenderScheduler {
+public:
+  static constexpr int kMaxRegions = 2;
+  // A pending region counts as this many frames older than it is
+  static constexpr uint32_t kPendingPriority = 2;
+  static constexpr uint32_t kSmoothing = 8;
+
+  void Init(uint32_t period_us, uint32_t budget_cycles) {
+    period_us_ = period_us;
+    budget_cycles_ = budget_cycles;
+    frame_ = 0;
+    frames_ = dropped_ = partial_ = 0;
+    last_frame_us_ = 0;
+    planned_frame_ = 0;
+    full_redraw_ = true;
+    for (int r = 0; r < kMaxRegions; ++r) {
+      cycles_[r] = 0;
+      age_[r] = 0;
+    }
+    pending_ = 0;
+  }
+
+  void set_budget(uint32_t budget_cycles) {
+    budget_cycles_ = budget_cycles;
+  }
+
+  uint32_t budget() const {
+    return budget_cycles_;
+  }
+
+  // Called when a frame is started, now_us from micros()
+  void BeginFrame(uint32_t now_us) {
+    if (frames_) {
+      uint32_t periods = (now_us - last_frame_us_) / period_us_;
+      if (periods > 1) dropped_ += periods - 1;
+    }
+    last_frame_us_ = now_us;
+    ++frames_;
+    ++frame_;
+  }
+
+  // @return mask of the regions to draw in this frame, the others have to be
+  // copied from the previous frame
+  uint32_t Plan(int num_regions) {
+    const uint32_t all = (1UL << num_regions) - 1;
+    // The previous frame has to be a planned one for the copy to be right
+    bool full = full_redraw_ || planned_frame_ + 1 != frame_;
+    full_redraw_ = false;
+    planned_frame_ = frame_;
+
+    uint32_t total = 0;
+    for (int r = 0; r < num_regions; ++r)
+      total += cycles_[r];
+
+    if (full || total <= budget_cycles_) {
+      pending_ = 0;
+      for (int r = 0; r < num_regions; ++r)
+        age_[r] = 0;
+      return all;
+    }
+
+    // The region that has waited longest, with a head start for UI events;
+    // ties go to the one drawn longest ago
+    int region = 0;
+    uint32_t best = 0;
+    for (int r = 0; r < num_regions; ++r) {
+      uint32_t score = age_[r] + ((pending_ >> r) & 1 ? kPendingPriority : 0);
+      if (score > best || (score == best && age_[r] > age_[region])) {
+        best = score;
+        region = r;
+      }
+    }
+    for (int r = 0; r < num_regions; ++r)
+      ++age_[r];
+    age_[region] = 0;
+    pending_ &= ~(1UL << region);
+    ++partial_;
+    return 1UL << region;
+  }
+
+  // The cost follows increases right away, so one slow frame is enough to
+  // start drawing in turns, and decays slowly
+  void RegionDrawn(int region, uint32_t cycles) {
+    if (cycles > cycles_[region])
+      cycles_[region] = cycles;
+    else
+      cycles_[region] = (cycles_[region] * (kSmoothing - 1) + cycles) / kSmoothing;
+  }
+
+  // The region changed because of a UI event
+  void Invalidate(int region) {
+    pending_ |= 1UL << region;
+  }
+
+  // Draw all regions in the next frame
+  void InvalidateAll() {
+    full_redraw_ = true;
+  }
+
+  uint32_t frames() const { return frames_; }
+  uint32_t dropped() const { return dropped_; }
+  uint32_t partial() const { return partial_; }
+
+  uint32_t region_cycles(int region) const {
+    return cycles_[region];
+  }
+
+private:
+  uint32_t period_us_ = 1000;
+  uint32_t budget_cycles_ = 0xffffffff;
+
+  uint32_t frame_ = 0;
+  uint32_t frames_ = 0;
+  uint32_t dropped_ = 0;
+  uint32_t partial_ = 0;
+  uint32_t last_frame_us_ = 0;
+
+  uint32_t planned_frame_ = 0;
+  bool full_redraw_ = true;
+  uint32_t cycles_[kMaxRegions] = { };
+  uint32_t age_[kMaxRegions] = { };
+  uint32_t pending_ = 0;
+};
+
+extern RenderScheduler render_scheduler;
+
+}; // namespace oc
+
+#endif // OC_RENDER_SCHEDULER_H_
@@ -147,13 +147,24 @@ private:
 
   UI::EventQueue<kEventQueueDepth> event_queue_;
 
-  inline void PushEvent(UI::EventType t, uint16_t c, int16_t v, uint16_t m) {
+  // Encoder steps that didn't fit into the queue, sent with the next event
+  int32_t encoder_right_backlog_;
+  int32_t encoder_left_backlog_;
+
+  inline bool PushEvent(UI::EventType t, uint16_t c, int16_t v, uint16_t m) {
+    bool pushed = event_queue_.PushEvent(t, c, v, m);
 #ifdef OC_UI_DEBUG
-    if (!event_queue_.writable())
+    if (!pushed)
       ++DEBUG::UI_queue_overflow;
     ++DEBUG::UI_event_count;
 #endif
-    event_queue_.PushEvent(t, c, v, m);
+    return pushed;
+  }
+
+  inline void PushEncoderEvent(UiControl encoder, int32_t &backlog, int32_t increment, uint16_t m) {
+    increment += backlog;
+    if (increment)
+      backlog = PushEvent(UI::EVENT_ENCODER, encoder, increment, m) ? 0 : increment;
   }
 
   bool IgnoreEvent(const UI::Event &event) {
@@ -52,15 +52,10 @@ public:
     return events_.readable();
   }
 
-  inline void PushEvent(EventType t, uint16_t c, int16_t v) {
-    // TODO EmplaceWrite?
-    events_.Write(Event(t, c, v, 0));
-    Poke();
-  }
-
-  inline void PushEvent(EventType t, uint16_t c, int16_t v, uint16_t m) {
-    events_.Write(Event(t, c, v, m));
+  // @return false if the queue was full and the event was dropped
+  inline bool PushEvent(EventType t, uint16_t c, int16_t v, uint16_t m = 0) {
     Poke();
+    return events_.EmplaceWrite(t, c, v, m);
   }
 
   inline Event PullEvent() {
@@ -80,6 +75,10 @@ public:
     return events_.writable();
   }
 
+  inline uint32_t overflows() const {
+    return events_.overflows();
+  }
+
 private:
 
   util::RingBuffer<Event, size> events_;
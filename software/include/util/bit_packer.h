@@ -0,0 +1,89 @@
+#ifndef UTIL_BIT_PACKER_H_
+#define UTIL_BIT_PACKER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace util {
+
+// Packs fields of any width (up to 32 bits) into a byte buffer, LSB first, so
+// a 5-bit note only takes 5 bits. Writing past the end of the buffer drops the
+// field and sets overflow(), so the caller can check once at the end.
+class BitWriter {
+public:
+  BitWriter(uint8_t *buffer, size_t size) : buffer_(buffer), size_(size), bits_(0), overflow_(false) {
+    memset(buffer_, 0, size_);
+  }
+
+  void Write(uint32_t value, size_t bits) {
+    if (bits_ + bits > size_ * 8) {
+      overflow_ = true;
+      return;
+    }
+    for (size_t i = 0; i < bits; ++i, ++bits_) {
+      if ((value >> i) & 1)
+        buffer_[bits_ >> 3] |= 1 << (bits_ & 7);
+    }
+  }
+
+  // Bytes used so far, rounding up a partial one
+  size_t length() const {
+    return (bits_ + 7) >> 3;
+  }
+
+  // Bits left to write
+  size_t remaining() const {
+    return size_ * 8 - bits_;
+  }
+
+  bool overflow() const {
+    return overflow_;
+  }
+
+private:
+  uint8_t *buffer_;
+  size_t size_;
+  size_t bits_;
+  bool overflow_;
+};
+
+// Reads back what a BitWriter wrote. Reading past the end returns 0 and sets
+// overflow(), which is how a shorter (older) blob reads back: the fields it
+// didn't have come out as 0.
+class BitReader {
+public:
+  BitReader(const uint8_t *buffer, size_t size) : buffer_(buffer), size_(size), bits_(0), overflow_(false) { }
+
+  uint32_t Read(size_t bits) {
+    if (bits_ + bits > size_ * 8) {
+      overflow_ = true;
+      return 0;
+    }
+    uint32_t value = 0;
+    for (size_t i = 0; i < bits; ++i, ++bits_) {
+      if ((buffer_[bits_ >> 3] >> (bits_ & 7)) & 1)
+        value |= 1U << i;
+    }
+    return value;
+  }
+
+  // Bits left to read
+  size_t remaining() const {
+    return size_ * 8 - bits_;
+  }
+
+  bool overflow() const {
+    return overflow_;
+  }
+
+private:
+  const uint8_t *buffer_;
+  size_t size_;
+  size_t bits_;
+  bool overflow_;
+};
+
+} // namespace util
+
+#endif // UTIL_BIT_PACKER_H_
@@ -0,0 +1,214 @@
+#ifndef UTIL_DELAY_LINE_H_
+#define UTIL_DELAY_LINE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace util {
+
+enum DelaySampleFormat {
+  DELAY_SAMPLE_8BIT,
+  DELAY_SAMPLE_ULAW, // 8 bits, G.711 mu-law: ~13 bits of range
+  DELAY_SAMPLE_16BIT, // Half the length of the other formats
+  DELAY_SAMPLE_FORMAT_LAST
+};
+
+// Memory handed out by a DelayPool. The size is a power of 2 (or 0), so the
+// delay lines can wrap with a mask.
+struct DelayBlock {
+  uint8_t * volatile data;
+  volatile uint32_t size; // bytes
+  volatile uint32_t generation; // changes whenever data or size do
+};
+
+// Delay memory shared by two owners (the hemispheres). Each owner can hold one
+// block: the left one is placed at the start of the pool, the right one at the
+// end, and a block is the largest power of 2 that fits in what the other owner
+// leaves free. So a single delay gets the whole pool and two get half each: if
+// the other owner holds more than half, it is shrunk to half first.
+//
+// Allocation and release happen in the main loop while the ISR uses the other
+// block, so a block only ever shrinks in place, and the size is written before
+// the data pointer. Every intermediate state stays inside the pool.
+template <size_t pool_size>
+class DelayPool {
+public:
+  static_assert(pool_size && !(pool_size & (pool_size - 1)), "Pool size must be a power of 2");
+  static constexpr size_t kSize = pool_size;
+
+  DelayPool() : blocks_{ { memory_, 0, 0 }, { memory_ + pool_size, 0, 0 } } { }
+
+  // Claim (or re-claim) the block for owner 0 or 1, up to wanted bytes
+  const DelayBlock *Allocate(int owner, size_t wanted) {
+    DelayBlock &other = blocks_[!owner];
+    if (other.size > pool_size / 2)
+      Resize(!owner, pool_size / 2);
+
+    size_t size = pool_size - other.size;
+    if (wanted < size) size = wanted;
+    Resize(owner, size ? 1U << (31 - __builtin_clz(size)) : 0);
+    return &blocks_[owner];
+  }
+
+  void Release(int owner) {
+    Resize(owner, 0);
+  }
+
+  const DelayBlock *block(int owner) const {
+    return &blocks_[owner];
+  }
+
+  // Bytes not held by either owner
+  size_t available() const {
+    return pool_size - blocks_[0].size - blocks_[1].size;
+  }
+
+private:
+  uint8_t memory_[pool_size] __attribute__((aligned(4)));
+  DelayBlock blocks_[2];
+
+  void Resize(int owner, size_t size) {
+    DelayBlock &block = blocks_[owner];
+    if (size < block.size) {
+      block.size = size;
+      block.data = owner ? memory_ + pool_size - size : memory_;
+    } else {
+      block.data = owner ? memory_ + pool_size - size : memory_;
+      block.size = size;
+    }
+    block.generation = block.generation + 1;
+  }
+};
+
+// G.711 mu-law, on 16-bit samples
+inline uint8_t ULawEncode(int16_t sample) {
+  int32_t s = sample;
+  uint8_t sign = 0;
+  if (s < 0) {
+    s = -s;
+    sign = 0x80;
+  }
+  if (s > 32635) s = 32635;
+  s += 0x84;
+  // s >= 0x84, so the top bit is in 7..14
+  int exponent = (31 - __builtin_clz(s)) - 7;
+  uint8_t mantissa = (s >> (exponent + 3)) & 0x0f;
+  return ~(sign | (exponent << 4) | mantissa);
+}
+
+inline int16_t ULawDecode(uint8_t value) {
+  value = ~value;
+  int exponent = (value >> 4) & 0x07;
+  int32_t s = ((((value & 0x0f) << 3) + 0x84) << exponent) - 0x84;
+  return (value & 0x80) ? -s : s;
+}
+
+// A delay line in a DelayBlock, with 16-bit samples stored in one of the
+// DelaySampleFormats. Indices wrap at length(), so the caller can just keep
+// counting up.
+//
+// A new (or changed) block is cleared a few bytes per Tick rather than all at
+// once, which would take too long in the ISR; until then, the part that isn't
+// clear yet reads as silence and ignores writes.
+//
+// Tick and Write belong to the ISR; a new format only takes effect on the next
+// Tick, so set_format and Read can be used from the UI as well.
+class DelayLine {
+public:
+  static constexpr size_t kClearBytesPerTick = 64;
+
+  void Init(const DelayBlock *block, DelaySampleFormat format) {
+    block_ = block;
+    format_ = requested_format_ = format;
+    Restart();
+  }
+
+  // Once per ISR tick, before any Read or Write
+  void Tick() {
+    if (generation_ != block_->generation || format_ != requested_format_)
+      Restart();
+    if (cleared_ < size_) {
+      size_t count = size_ - cleared_;
+      if (count > kClearBytesPerTick) count = kClearBytesPerTick;
+      // Silence is 0xff in mu-law
+      memset(data_ + cleared_, format_ == DELAY_SAMPLE_ULAW ? 0xff : 0, count);
+      cleared_ += count;
+    }
+  }
+
+  void set_format(DelaySampleFormat format) {
+    requested_format_ = format;
+  }
+
+  DelaySampleFormat format() const {
+    return requested_format_;
+  }
+
+  // In samples
+  uint32_t length() const {
+    return format_ == DELAY_SAMPLE_16BIT ? size_ >> 1 : size_;
+  }
+
+  bool cleared() const {
+    return cleared_ == size_;
+  }
+
+  int16_t Read(uint32_t index) const {
+    // The data pointer goes first: if a Tick gets in between, the mask can
+    // only have shrunk
+    const uint8_t *data = data_;
+    switch (format_) {
+    case DELAY_SAMPLE_16BIT:
+      index = (index << 1) & mask_;
+      return index < cleared_ ? *reinterpret_cast<const int16_t *>(data + index) : 0;
+    case DELAY_SAMPLE_ULAW:
+      index &= mask_;
+      return index < cleared_ ? ULawDecode(data[index]) : 0;
+    default:
+      index &= mask_;
+      return index < cleared_ ? static_cast<int8_t>(data[index]) * 256 : 0;
+    }
+  }
+
+  void Write(uint32_t index, int16_t sample) {
+    switch (format_) {
+    case DELAY_SAMPLE_16BIT:
+      index = (index << 1) & mask_;
+      if (index < cleared_) *reinterpret_cast<int16_t *>(data_ + index) = sample;
+      break;
+    case DELAY_SAMPLE_ULAW:
+      index &= mask_;
+      if (index < cleared_) data_[index] = ULawEncode(sample);
+      break;
+    default:
+      index &= mask_;
+      if (index < cleared_) data_[index] = static_cast<uint8_t>(sample >> 8);
+      break;
+    }
+  }
+
+private:
+  const DelayBlock *block_;
+  DelaySampleFormat format_;
+  volatile DelaySampleFormat requested_format_;
+  uint32_t generation_;
+  uint8_t *data_;
+  uint32_t size_;
+  uint32_t mask_; // bytes
+  uint32_t cleared_; // bytes
+
+  void Restart() {
+    format_ = requested_format_;
+    generation_ = block_->generation;
+    size_ = block_->size;
+    data_ = block_->data;
+    // 16-bit samples stay aligned
+    mask_ = size_ ? (size_ - 1) & ~(format_ == DELAY_SAMPLE_16BIT ? 1U : 0U) : 0;
+    cleared_ = 0;
+  }
+};
+
+} // namespace util
+
+#endif // UTIL_DELAY_LINE_H_
@@ -0,0 +1,65 @@
+#ifndef UTIL_FIXED_POINT_H_
+#define UTIL_FIXED_POINT_H_
+
+#include <stdint.h>
+
+namespace util {
+
+// Q-format fixed point for code in the ISR path. The MK20 has no FPU, so each
+// float or double operation is a call into the soft-float library that costs
+// from tens to hundreds of cycles (see resources/check_isr_softfloat.py).
+//
+// A Qn value is an int32_t with n fractional bits, e.g. 1.0 in Q16 is 65536.
+// Products go through 64 bits, which is a single SMULL on the Cortex-M4.
+
+template <int frac_bits>
+constexpr int32_t ToQ(int32_t value) {
+  return value * (INT32_C(1) << frac_bits);
+}
+
+// Rounds to nearest, halves up
+template <int frac_bits>
+constexpr int32_t RoundQ(int32_t value) {
+  return (value + (INT32_C(1) << (frac_bits - 1))) >> frac_bits;
+}
+
+template <int frac_bits>
+inline int32_t MultiplyQ(int32_t a, int32_t b) {
+  return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> frac_bits);
+}
+
+// One-pole lowpass, i.e. alpha * state + (1 - alpha) * target, with state and
+// target in the same Q format and alpha in Q<alpha_bits> (0 = no smoothing,
+// 1.0 = state never moves). Heavy smoothing needs the extra bits: with alpha
+// close to 1.0 the precision of 1 - alpha sets the time constant.
+// The difference between state and target is taken in 64 bits, so they can
+// use the whole int32_t range.
+template <int alpha_bits>
+inline int32_t OnePole(int32_t state, int32_t target, uint32_t alpha) {
+  int64_t error = static_cast<int64_t>(target) - state;
+  int64_t step = (((INT64_C(1) << alpha_bits) - alpha) * error) >> alpha_bits;
+  return static_cast<int32_t>(state + step);
+}
+
+// log2(value) in Q16, for value >= 1 (0 for 0). It's within 2 LSBs, but takes a
+// 64-bit multiply per fractional bit, so it's meant for settings changes and
+// tables rather than per-tick use.
+inline uint32_t Log2Q16(uint32_t value) {
+  if (!value) return 0;
+  uint32_t integer = 31 - __builtin_clz(value);
+  // Mantissa in [1, 2) as Q30
+  uint64_t mantissa = (static_cast<uint64_t>(value) << 30) >> integer;
+  uint32_t fraction = 0;
+  for (int bit = 15; bit >= 0; --bit) {
+    mantissa = (mantissa * mantissa) >> 30;
+    if (mantissa >= (UINT64_C(2) << 30)) {
+      mantissa >>= 1;
+      fraction |= 1U << bit;
+    }
+  }
+  return (integer << 16) | fraction;
+}
+
+} // namespace util
+
+#endif // UTIL_FIXED_POINT_H_
@@ -43,14 +43,24 @@
 inline uint32_t USAT16(uint32_t value) __attribute__((always_inline));
 inline uint32_t USAT16(uint32_t value) {
   uint32_t result;
+#ifdef __arm__
   __asm("usat %0, %1, %2" : "=r" (result) : "I" (16), "r" (value));
+#else
+  // usat operates on the signed value
+  int32_t v = static_cast<int32_t>(value);
+  result = v < 0 ? 0 : (v > 65535 ? 65535 : v);
+#endif
   return result;
 }
 
 inline uint32_t USAT16(int32_t value) __attribute__((always_inline));
 inline uint32_t USAT16(int32_t value) {
   uint32_t result;
+#ifdef __arm__
   __asm("usat %0, %1, %2" : "=r" (result) : "I" (16), "r" (value));
+#else
+  result = value < 0 ? 0 : (value > 65535 ? 65535 : value);
+#endif
   return result;
 }
 
@@ -58,25 +68,37 @@ inline uint32_t USAT16(int32_t value) {
 static inline uint32_t multiply_u32xu32_rshift32(uint32_t a, uint32_t b) __attribute__((always_inline));
 static inline uint32_t multiply_u32xu32_rshift32(uint32_t a, uint32_t b)
 {
+#ifdef __arm__
   uint32_t out, tmp;
   asm volatile("umull %0, %1, %2, %3" : "=r" (tmp), "=r" (out) : "r" (a), "r" (b));
   return out;
+#else
+  return (static_cast<uint64_t>(a) * b) >> 32;
+#endif
 }
 
 static inline uint32_t multiply_u32xu32_rshift24(uint32_t a, uint32_t b) __attribute__((always_inline));
 static inline uint32_t multiply_u32xu32_rshift24(uint32_t a, uint32_t b)
 {
+#ifdef __arm__
   register uint32_t lo, hi;
   asm volatile("umull %0, %1, %2, %3" : "=r" (lo), "=r" (hi) : "r" (a), "r" (b));
   return (lo >> 24) | (hi << 8);
+#else
+  return (static_cast<uint64_t>(a) * b) >> 24;
+#endif
 }
 
 static inline uint32_t multiply_u32xu32_rshift(uint32_t a, uint32_t b, uint32_t shift) __attribute__((always_inline));
 static inline uint32_t multiply_u32xu32_rshift(uint32_t a, uint32_t b, uint32_t shift)
 {
+#ifdef __arm__
   register uint32_t lo, hi;
   asm volatile("umull %0, %1, %2, %3" : "=r" (lo), "=r" (hi) : "r" (a), "r" (b));
   return (lo >> shift) | (hi << (32 - shift));
+#else
+  return (static_cast<uint64_t>(a) * b) >> shift;
+#endif
 }
 
 template <typename T, T smoothing>
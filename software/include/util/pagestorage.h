@@ -102,6 +102,7 @@ public:
    */
   void Init() {
     page_index_ = -1;
+    changed_bytes_ = 0;
     page_.header.fourcc = DATA_TYPE::FOURCC;
     page_.header.size = sizeof(DATA_TYPE);
   }
@@ -115,6 +116,7 @@ public:
   bool Load(DATA_TYPE &data) {
 
     page_index_ = -1;
+    changed_bytes_ = 0;
     memset(&page_, 0, sizeof(page_));
     page_.header.generation = -1;
     page_data next_page;
@@ -153,6 +155,22 @@ public:
     }
   }
 
+  /**
+   * @return the data as last loaded or saved
+   */
+  const DATA_TYPE &data() const {
+    return page_.data;
+  }
+
+  /**
+   * @return number of data bytes that changed in the last ::Save. With
+   * STORAGE_UPDATE and a single page these, and the header, are the only
+   * bytes actually written.
+   */
+  size_t changed_bytes() const {
+    return changed_bytes_;
+  }
+
   /**
    * Save data to storage; assumes ::load has been called!
    * @param data data to be stored
@@ -161,6 +179,7 @@ public:
   bool Save(const DATA_TYPE &data) {
 
     bool dirty = false;
+    changed_bytes_ = 0;
     const uint8_t *src = (const uint8_t*)&data;
     uint8_t *dst = (uint8_t*)&page_.data;
     size_t length = sizeof(DATA_TYPE);
@@ -168,6 +187,7 @@ public:
       if (*dst != *src) {
         dirty = true;
         *dst = *src;
+        ++changed_bytes_;
       }
       ++dst;
       ++src;
@@ -191,6 +211,7 @@ protected:
 
   int page_index_;
   page_data page_;
+  size_t changed_bytes_;
 
   static uint16_t checksum(const page_data &page) {
     uint16_t c = 0;
@@ -23,6 +23,7 @@
 #ifndef OC_PROFILING_H_
 #define OC_PROFILING_H_
 
+#include <string.h>
 #include "util/macros.h"
 #include "util/math.h"
 
@@ -38,6 +39,14 @@ public:
     return ARM_DWT_CYCCNT - start_;
   }
 
+  // Return cycles since start (or previous lap) and restart measurement
+  uint32_t lap() {
+    uint32_t now = ARM_DWT_CYCCNT;
+    uint32_t cycles = now - start_;
+    start_ = now;
+    return cycles;
+  }
+
   static void Init() {
     ARM_DEMCR |= ARM_DEMCR_TRCENA;
     ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
@@ -85,6 +94,60 @@ struct AveragedCycles {
   }
 };
 
+// Log2 histogram of cycle counts: bucket n holds values in [2^(n-1), 2^n), so
+// bucket 0 is only 0 and the last bucket also collects everything larger.
+// Unlike AveragedCycles this keeps the shape of the tail, which is what
+// matters for deadlines.
+struct CycleHistogram {
+  static constexpr size_t kNumBuckets = 17; // up to 65535+ cycles
+
+  CycleHistogram() { Reset(); }
+
+  uint32_t buckets_[kNumBuckets];
+  uint32_t count_;
+  uint32_t max_;
+  uint64_t sum_;
+
+  void Reset() {
+    memset(buckets_, 0, sizeof(buckets_));
+    count_ = max_ = 0;
+    sum_ = 0;
+  }
+
+  void push(uint32_t value) {
+    size_t bucket = value ? 32 - __builtin_clz(value) : 0;
+    if (bucket >= kNumBuckets) bucket = kNumBuckets - 1;
+    ++buckets_[bucket];
+    ++count_;
+    sum_ += value;
+    if (value > max_) max_ = value;
+  }
+
+  uint32_t count() const {
+    return count_;
+  }
+
+  uint32_t max_value() const {
+    return max_;
+  }
+
+  uint32_t mean() const {
+    return count_ ? static_cast<uint32_t>(sum_ / count_) : 0;
+  }
+
+  // Upper bound (exclusive) of the bucket containing the given percentile
+  uint32_t percentile_bound(uint32_t percent) const {
+    uint32_t threshold = static_cast<uint32_t>((static_cast<uint64_t>(count_) * percent + 99) / 100);
+    uint32_t total = 0;
+    for (size_t b = 0; b < kNumBuckets; ++b) {
+      total += buckets_[b];
+      if (total >= threshold && total)
+        return 1UL << b;
+    }
+    return 0;
+  }
+};
+
 class ScopedCycleMeasurement {
 public:
   ScopedCycleMeasurement(AveragedCycles &dest)
@@ -100,6 +163,21 @@ private:
   CycleMeasurement cycles_;
 };
 
+class ScopedCycleHistogram {
+public:
+  ScopedCycleHistogram(CycleHistogram &dest)
+  : dest_(dest)
+  , cycles_() { }
+
+  ~ScopedCycleHistogram() {
+    dest_.push(cycles_.read());
+  }
+
+private:
+  CycleHistogram &dest_;
+  CycleMeasurement cycles_;
+};
+
 }; // namespace debug
 
 #endif // OC_PROFILING_H_
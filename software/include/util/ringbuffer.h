@@ -22,6 +22,9 @@
 #define UTIL_RINGBUFFER_H_
 
 #include <stdint.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
 #include "util/macros.h"
 
 namespace util {
@@ -31,41 +34,158 @@ namespace util {
 // and "full" states (e.g. MI stmlib/utils/ring_buffer.h). The other relies on
 // wrapping read/write heads and appears to use all available items.
 // This implements the latter.
-// - Pretty much assumes single producer/consumer
-// - Assume size is pow2
+//
+// Lock-free for a single producer and a single consumer, e.g. an ISR writing
+// and the main loop reading. Each side only ever stores its own head:
+// - The producer fills a slot, then publishes it with a release store of
+//   write_ptr_; the consumer's acquire load of write_ptr_ makes the slot
+//   contents visible.
+// - The consumer releases a slot with a release store of read_ptr_, which the
+//   producer loads with acquire before it reuses the slot.
+// Writing to a full buffer drops the item and counts an overflow instead of
+// overwriting unread items.
+//
+// Besides single items there are contiguous spans (ReadSpan/Consume and
+// WriteSpan/Commit) so a batch can be handled in place without copying; a span
+// stops at the end of the storage, so draining everything may take two.
+//
+// Poke/Freeze are for using the buffer as a history of the most recent writes
+// (ASR) and are producer-side only.
 //
 template <typename T, size_t size>
 class RingBuffer {
 public:
+  static_assert(size && !(size & (size - 1)), "RingBuffer size must be pow2");
+
   RingBuffer() { }
 
   void Init() {
-    write_ptr_ = read_ptr_ = poke_ptr_ = 0;
+    write_ptr_.store(0, std::memory_order_relaxed);
+    read_ptr_.store(0, std::memory_order_relaxed);
+    overflows_.store(0, std::memory_order_relaxed);
+    poke_ptr_ = 0;
   }
 
   inline size_t readable() const {
-    return write_ptr_ - read_ptr_;
+    return write_ptr_.load(std::memory_order_acquire) - read_ptr_.load(std::memory_order_acquire);
   }
 
   inline size_t writable() const {
     return size - readable();
   }
 
+  // Number of items dropped because the buffer was full
+  inline uint32_t overflows() const {
+    return overflows_.load(std::memory_order_relaxed);
+  }
+
+  // Consumer side
+
+  // Only valid if readable()
   inline T Read() {
-    size_t read_ptr = read_ptr_;
+    size_t read_ptr = read_ptr_.load(std::memory_order_relaxed);
     T value = buffer_[read_ptr & (size - 1)];
-    read_ptr_ = read_ptr + 1;
+    read_ptr_.store(read_ptr + 1, std::memory_order_release);
     return value;
   }
 
-  inline void Write(T value) {
-    size_t write_ptr = write_ptr_;
-    buffer_[write_ptr & (size - 1)] = value;
-    poke_ptr_ = write_ptr_ = write_ptr + 1;
+  // @return number of items read into dst
+  size_t Read(T *dst, size_t count) {
+    size_t total = 0;
+    const T *span;
+    size_t length;
+    while (total < count && (length = ReadSpan(span))) {
+      if (length > count - total)
+        length = count - total;
+      for (size_t i = 0; i < length; ++i)
+        dst[total + i] = span[i];
+      Consume(length);
+      total += length;
+    }
+    return total;
+  }
+
+  // Contiguous readable items starting at the read head; they stay valid (the
+  // producer won't touch them) until they're Consume'd.
+  // @return number of items in span
+  inline size_t ReadSpan(const T *&span) const {
+    size_t read_ptr = read_ptr_.load(std::memory_order_relaxed);
+    size_t available = write_ptr_.load(std::memory_order_acquire) - read_ptr;
+    size_t offset = read_ptr & (size - 1);
+    span = buffer_ + offset;
+    return available < size - offset ? available : size - offset;
+  }
+
+  inline void Consume(size_t count) {
+    read_ptr_.store(read_ptr_.load(std::memory_order_relaxed) + count, std::memory_order_release);
   }
 
+  // Discards everything that is readable
   inline void Flush() {
-    write_ptr_ = read_ptr_ = 0;
+    read_ptr_.store(write_ptr_.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  // Producer side
+
+  inline bool Write(const T &value) {
+    T *span;
+    if (!WriteSpan(span)) {
+      overflows_.store(overflows() + 1, std::memory_order_relaxed);
+      return false;
+    }
+    *span = value;
+    Commit(1);
+    return true;
+  }
+
+  // Constructs the item in its slot instead of copying a temporary
+  template <typename... Args>
+  inline bool EmplaceWrite(Args&&... args) {
+    static_assert(std::is_trivially_destructible<T>::value, "Slots are reused without destruction");
+    T *span;
+    if (!WriteSpan(span)) {
+      overflows_.store(overflows() + 1, std::memory_order_relaxed);
+      return false;
+    }
+    new (span) T(static_cast<Args&&>(args)...);
+    Commit(1);
+    return true;
+  }
+
+  // Items that don't fit are dropped and counted as overflows
+  // @return number of items written
+  size_t Write(const T *src, size_t count) {
+    size_t total = 0;
+    T *span;
+    size_t length;
+    while (total < count && (length = WriteSpan(span))) {
+      if (length > count - total)
+        length = count - total;
+      for (size_t i = 0; i < length; ++i)
+        span[i] = src[total + i];
+      Commit(length);
+      total += length;
+    }
+    if (total < count)
+      overflows_.store(overflows() + (count - total), std::memory_order_relaxed);
+    return total;
+  }
+
+  // Contiguous free slots starting at the write head, to be filled and then
+  // published with Commit.
+  // @return number of slots in span
+  inline size_t WriteSpan(T *&span) {
+    size_t write_ptr = write_ptr_.load(std::memory_order_relaxed);
+    size_t available = size - (write_ptr - read_ptr_.load(std::memory_order_acquire));
+    size_t offset = write_ptr & (size - 1);
+    span = buffer_ + offset;
+    return available < size - offset ? available : size - offset;
+  }
+
+  inline void Commit(size_t count) {
+    size_t write_ptr = write_ptr_.load(std::memory_order_relaxed) + count;
+    write_ptr_.store(write_ptr, std::memory_order_release);
+    poke_ptr_ = write_ptr;
   }
 
   inline T Poke(size_t index_offset) {
@@ -75,17 +195,19 @@ public:
   } 
 
   inline void Freeze(size_t buf_size) {
-    size_t start_ptr = (write_ptr_ - buf_size);
-    poke_ptr_ = (poke_ptr_ >= write_ptr_) ? start_ptr : poke_ptr_;
+    size_t write_ptr = write_ptr_.load(std::memory_order_relaxed);
+    size_t start_ptr = (write_ptr - buf_size);
+    poke_ptr_ = (poke_ptr_ >= write_ptr) ? start_ptr : poke_ptr_;
     poke_ptr_++;
   } 
 
 private:
 
   T buffer_[size];
-  volatile size_t write_ptr_;
-  volatile size_t read_ptr_;
-  volatile size_t poke_ptr_;
+  std::atomic<size_t> write_ptr_;
+  std::atomic<size_t> read_ptr_;
+  std::atomic<uint32_t> overflows_;
+  size_t poke_ptr_;
 
   DISALLOW_COPY_AND_ASSIGN(RingBuffer);
 };
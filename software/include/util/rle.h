@@ -0,0 +1,78 @@
+#ifndef UTIL_RLE_H_
+#define UTIL_RLE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace util {
+
+// PackBits-style run-length encoding, for settings blobs: these are mostly
+// small values and unused (zero) settings, packed two nibbles or one byte at a
+// time, so runs of the same byte are common and nothing fancier pays off.
+//
+// A control byte 0..127 is followed by that many + 1 literal bytes, 129..255
+// repeats the following byte (control - 126) times, i.e. 3..129 times, and 128
+// does nothing (it can pad the output).
+static constexpr size_t kRleMaxLiterals = 128;
+static constexpr size_t kRleMinRun = 3;
+static constexpr size_t kRleMaxRun = 129;
+static constexpr uint8_t kRleNop = 128;
+
+// Returns the encoded length, or 0 if it doesn't fit in dst_size
+inline size_t RleEncode(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size) {
+  size_t in = 0, out = 0;
+  size_t literals = 0; // pending, ending at in
+  while (in < length) {
+    size_t run = 1;
+    while (in + run < length && run < kRleMaxRun && src[in + run] == src[in])
+      ++run;
+
+    if (run >= kRleMinRun || literals == kRleMaxLiterals) {
+      if (literals) {
+        if (dst_size - out < 1 + literals) return 0;
+        dst[out++] = literals - 1;
+        for (size_t i = in - literals; i < in; ++i) dst[out++] = src[i];
+        literals = 0;
+      }
+    }
+    if (run >= kRleMinRun) {
+      if (dst_size - out < 2) return 0;
+      dst[out++] = run + 126;
+      dst[out++] = src[in];
+      in += run;
+    } else {
+      ++literals;
+      ++in;
+    }
+  }
+  if (literals) {
+    if (dst_size - out < 1 + literals) return 0;
+    dst[out++] = literals - 1;
+    for (size_t i = in - literals; i < in; ++i) dst[out++] = src[i];
+  }
+  return out;
+}
+
+// Returns the decoded length, or 0 if the input is truncated or doesn't fit in
+// dst_size
+inline size_t RleDecode(const uint8_t *src, size_t length, uint8_t *dst, size_t dst_size) {
+  size_t in = 0, out = 0;
+  while (in < length) {
+    uint8_t control = src[in++];
+    if (control < kRleMaxLiterals) {
+      size_t count = control + 1;
+      if (in + count > length || out + count > dst_size) return 0;
+      while (count--) dst[out++] = src[in++];
+    } else if (control != kRleNop) {
+      size_t count = control - 126;
+      if (in >= length || out + count > dst_size) return 0;
+      while (count--) dst[out++] = src[in];
+      ++in;
+    }
+  }
+  return out;
+}
+
+} // namespace util
+
+#endif // UTIL_RLE_H_
@@ -0,0 +1,176 @@
+#ifndef UTIL_SCOPE_CAPTURE_H_
+#define UTIL_SCOPE_CAPTURE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace util {
+
+enum ScopeTrigger {
+  SCOPE_TRIGGER_FREE, // Roll continuously
+  SCOPE_TRIGGER_RISE, // Channel 1 crosses the level going up
+  SCOPE_TRIGGER_FALL, // ... or going down
+  SCOPE_TRIGGER_HIGH, // Channel 1 is at or above the level
+  SCOPE_TRIGGER_EXTERNAL, // Sample() is told so
+  SCOPE_TRIGGER_LAST
+};
+
+struct ScopeColumn {
+  uint8_t min;
+  uint8_t max;
+};
+
+// Two-channel scope capture. Every sample goes into the min/max of the current
+// pixel column, so a pulse shorter than a column still shows up, and a column
+// is finished every ticks_per_column samples. All the decimation happens here,
+// a sample at a time; the view just draws column(channel, x).
+//
+// In free mode the columns roll. Otherwise a trigger, which is checked on
+// every sample, captures a frame with a quarter of the width before it; the
+// frame is copied out and shown until the next one is complete. The capture
+// re-arms straight away.
+template <size_t max_columns>
+class ScopeCapture {
+public:
+  static_assert(max_columns && !(max_columns & (max_columns - 1)), "Column count must be a power of 2");
+  static constexpr size_t kMaxColumns = max_columns;
+
+  void Init(size_t width, uint32_t ticks_per_column) {
+    memset(columns_, 0, sizeof(columns_));
+    memset(frame_, 0, sizeof(frame_));
+    trigger_ = SCOPE_TRIGGER_FREE;
+    level_ = 128;
+    last_sample_ = 0;
+    write_ptr_ = 0;
+    has_frame_ = false;
+    width_ = width;
+    ticks_per_column_ = ticks_per_column;
+    Restart();
+  }
+
+  void set_width(size_t width) {
+    if (width != width_) {
+      width_ = width;
+      has_frame_ = false;
+      Restart();
+    }
+  }
+
+  void set_ticks_per_column(uint32_t ticks) {
+    if (ticks != ticks_per_column_) {
+      ticks_per_column_ = ticks;
+      Restart();
+    }
+  }
+
+  void set_trigger(ScopeTrigger trigger, uint8_t level) {
+    if (trigger != trigger_) {
+      trigger_ = trigger;
+      has_frame_ = false;
+      Restart();
+    }
+    level_ = level;
+  }
+
+  size_t width() const { return width_; }
+  uint32_t ticks_per_column() const { return ticks_per_column_; }
+
+  // A triggered capture has been completed and is shown
+  bool has_frame() const { return has_frame_; }
+  // Waiting for the rest of a frame after a trigger
+  bool triggered() const { return state_ == STATE_TRIGGERED; }
+
+  void Sample(uint8_t a, uint8_t b, bool external_trigger = false) {
+    if (a < current_[0].min) current_[0].min = a;
+    if (a > current_[0].max) current_[0].max = a;
+    if (b < current_[1].min) current_[1].min = b;
+    if (b > current_[1].max) current_[1].max = b;
+
+    if (state_ == STATE_ARMED && history_ >= width_ / 4 && Trigger(a, external_trigger)) {
+      state_ = STATE_TRIGGERED;
+      remaining_ = width_ - width_ / 4;
+    }
+    last_sample_ = a;
+
+    if (--countdown_ == 0) {
+      countdown_ = ticks_per_column_;
+      NextColumn();
+    }
+  }
+
+  // x counts from the left (oldest) column
+  ScopeColumn column(int channel, size_t x) const {
+    if (has_frame_) return frame_[channel][x];
+    return columns_[channel][(write_ptr_ - width_ + x) & (max_columns - 1)];
+  }
+
+private:
+  enum State {
+    STATE_ROLLING,
+    STATE_ARMED,
+    STATE_TRIGGERED
+  };
+
+  ScopeColumn columns_[2][max_columns]; // Ring
+  ScopeColumn frame_[2][max_columns]; // Last triggered capture
+  ScopeColumn current_[2];
+
+  ScopeTrigger trigger_;
+  uint8_t level_;
+  uint8_t last_sample_;
+  State state_;
+  bool has_frame_;
+
+  size_t width_;
+  uint32_t ticks_per_column_;
+  uint32_t countdown_;
+  uint32_t write_ptr_;
+  size_t history_; // Columns captured since the last restart, up to width
+  size_t remaining_; // Columns to go after a trigger
+
+  bool Trigger(uint8_t sample, bool external_trigger) const {
+    switch (trigger_) {
+    case SCOPE_TRIGGER_RISE: return last_sample_ < level_ && sample >= level_;
+    case SCOPE_TRIGGER_FALL: return last_sample_ >= level_ && sample < level_;
+    case SCOPE_TRIGGER_HIGH: return sample >= level_;
+    case SCOPE_TRIGGER_EXTERNAL: return external_trigger;
+    default: return false;
+    }
+  }
+
+  void Restart() {
+    state_ = trigger_ == SCOPE_TRIGGER_FREE ? STATE_ROLLING : STATE_ARMED;
+    countdown_ = ticks_per_column_;
+    history_ = 0;
+    ResetColumn();
+  }
+
+  void ResetColumn() {
+    current_[0].min = current_[1].min = 255;
+    current_[0].max = current_[1].max = 0;
+  }
+
+  void NextColumn() {
+    size_t index = write_ptr_ & (max_columns - 1);
+    columns_[0][index] = current_[0];
+    columns_[1][index] = current_[1];
+    ++write_ptr_;
+    ResetColumn();
+    if (history_ < width_) ++history_;
+
+    if (state_ == STATE_TRIGGERED && --remaining_ == 0) {
+      for (size_t x = 0; x < width_; ++x) {
+        index = (write_ptr_ - width_ + x) & (max_columns - 1);
+        frame_[0][x] = columns_[0][index];
+        frame_[1][x] = columns_[1][index];
+      }
+      has_frame_ = true;
+      state_ = STATE_ARMED;
+    }
+  }
+};
+
+} // namespace util
+
+#endif // UTIL_SCOPE_CAPTURE_H_
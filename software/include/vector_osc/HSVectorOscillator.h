@@ -66,6 +66,13 @@ enum {
 
 typedef hemisphere::VOSegment VOSegment;
 
+/*
+ * The VectorOscillator plays a waveform compiled from its segments: where each segment starts
+ * in the cycle and the reciprocal of its length, both Q16. A 32-bit phase accumulator, advanced
+ * by an increment worked out from the frequency, runs through the cycle, so a tick is an add and
+ * a linear interpolation within the current segment; the segment's start level and slope are
+ * only worked out (at the current scale) when the phase moves into it.
+ */
 class VectorOscillator {
 public:
     /* Oscillator defaults to cycling. Turn off cycling for EGs, etc */
@@ -74,12 +81,32 @@ public:
     /* Oscillator defaults to non-sustaining. Turing on for EGs, etc. */
     void Sustain(bool sustain_ = 1) {sustain = sustain_;}
 
-    /* Move to the release stage after sustain */
+    /* Move to the release stage after sustain. The release heads for the last level from wherever
+     * the signal is at the last segment's rate, so releasing early makes for a shorter release. */
     void Release() {
+        bool holding = !sustained && slope == 0; // Part way through a segment that holds a level
         sustained = 0;
-        segment_index = segment_count - 1;
-        rise = calculate_rise(segment_index);
-//        if (rise == 0) countdown = 1;
+        if (segment_count < 2 || (eoc && !cycle)) return;
+
+        byte last = segment_count - 1;
+        int32_t signal = value();
+        int32_t target = level(last);
+        int32_t rise = target - level(last - 1);
+        uint64_t end = segment_index < last ? phase_at(segment_index + 1) : UINT64_C(1) << 32;
+        uint64_t left = end - phase;
+        enter(last);
+
+        // Phase left until the end of the cycle at the segment's rate. A flat release holds the
+        // signal for the length of the segment, or for what's left of a hold it interrupts.
+        uint64_t remaining = static_cast<uint64_t>(0x10000 - start[last]) << 16;
+        if (rise) remaining = remaining * abs(target - signal) / abs(rise);
+        else if (holding && left < remaining) remaining = left;
+        if (remaining < 1) remaining = 1;
+        if (remaining > 0xffffffff) remaining = 0xffffffff;
+
+        phase = segment_start = -static_cast<uint32_t>(remaining);
+        from = signal;
+        if ((target < signal) != (slope < 0)) slope = -slope;
     }
 
     /* The offset amount will be added to each voltage output */
@@ -91,6 +118,7 @@ public:
             memcpy(&segments[segment_count], &segment, sizeof(segments[segment_count]));
             total_time += segments[segment_count].time;
             segment_count++;
+            compile();
         }
     }
 
@@ -101,6 +129,7 @@ public:
         memcpy(&segments[ix], &segment, sizeof(segments[ix]));
         total_time += segments[ix].time;
         if (ix == segment_count) segment_count++;
+        compile();
     }
 
     hemisphere::VOSegment GetSegment(byte ix) {
@@ -108,12 +137,15 @@ public:
         return segments[ix];
     }
 
+    /* The running segment keeps the scale it started with */
     void SetScale(uint16_t scale_) {scale = scale_;}
 
     /* frequency is centihertz (e.g., 440 Hz is 44000) */
     void SetFrequency(uint32_t frequency_) {
         frequency = frequency_;
-        rise = calculate_rise(segment_index);
+        // The oscillator only runs with a frequency and at least two segments with some time
+        if (segment_count < 2 || total_time == 0) phase_increment = 0;
+        else phase_increment = (static_cast<uint64_t>(frequency) * INCREMENT_PER_CENTIHERTZ) >> 16;
     }
 
     bool GetEOC() {return eoc;}
@@ -128,106 +160,88 @@ public:
     }
 
     void Reset() {
-        segment_index = 0;
-        signal = scale_level(segments[segment_count - 1].level);
-        rise = calculate_rise(segment_index);
+        phase = 0;
+        enter(0);
         sustained = 0;
         eoc = !cycle;
     }
 
     int32_t Next() {
-    		// For non-cycling waveforms, send the level of the last step if eoc
-    		if (eoc && cycle == 0) {
-    			vosignal_t nr_signal = scale_level(segments[segment_count - 1].level);
-    			return signal2int(nr_signal) + offset;
-    		}
-        if (!sustained) { // Observe sustain state
-			eoc = 0;
-			if (validate()) {
-				if (rise) {
-					signal += rise;
-					if (rise >= 0 && signal >= target) advance_segment();
-					if (rise < 0 && signal <= target) advance_segment();
-				} else {
-					if (countdown) {
-						--countdown;
-						if (countdown == 0) advance_segment();
-					}
-				}
-			}
+        // For non-cycling waveforms, send the level of the last step if eoc
+        if (eoc && cycle == 0) return level(segment_count - 1) + offset;
+        if (sustained) return from + offset;
+
+        uint32_t previous = phase;
+        phase += phase_increment;
+        eoc = phase < previous;
+        if (eoc) {
+            enter(0);
+            if (cycle == 0) return level(segment_count - 1) + offset;
         }
-        return signal2int(signal) + offset;
+
+        // Move on to the segment the phase is in, skipping any with no time
+        while (segment_index + 1 < segment_count && (phase >> 16) >= start[segment_index + 1]) {
+            if (sustain && segment_index + 2 == segment_count) {
+                // Hold at the end of the penultimate segment
+                phase = phase_at(segment_index + 1);
+                enter(segment_index + 1);
+                sustained = 1;
+                break;
+            }
+            enter(segment_index + 1);
+        }
+        return value() + offset;
     }
 
     /* Get the value of the waveform at a specific phase. Degrees are expressed in tenths of a degree */
     int32_t Phase(int degrees) {
-    		degrees = degrees % 3600;
-    		degrees = abs(degrees);
-
-    		// I need to find out which segment the specified phase occurs in
-    		byte time_index = Proportion(degrees, 3600, total_time);
-    		byte segment = 0;
-    		byte time = 0;
-    		for (byte ix = 0; ix < segment_count; ix++)
-    		{
-    			time += segments[ix].time;
-    			if (time > time_index) {
-    				segment = ix;
-    				break;
-    			}
-    		}
-
-    		// Where does this segment start, and how many degrees does it span?
-    		int start_degree = Proportion(time - segments[segment].time, total_time, 3600);
-    		int segment_degrees = Proportion(segments[segment].time, total_time, 3600);
-
-    		// Start and end point of the total segment
-    		int start = signal2int(scale_level(segment == 0 ? segments[segment_count - 1].level : segments[segment - 1].level));
-    		int end = signal2int(scale_level(segments[segment].level));
-
-    		// Determine the signal based on the levels and the position within the segment
-    		int signal = Proportion(degrees - start_degree, segment_degrees, end - start) + start;
-
-        return signal + offset;
+        degrees = degrees % 3600;
+        degrees = abs(degrees);
+        uint32_t at = degrees * PHASE_PER_TENTH_DEGREE;
+
+        // The last segment that starts at or before the phase
+        byte lo = 0;
+        byte hi = segment_count;
+        while (hi - lo > 1) {
+            byte mid = (lo + hi) / 2;
+            if (start[mid] <= (at >> 16)) lo = mid;
+            else hi = mid;
+        }
+
+        int32_t from_level = level(lo ? lo - 1 : segment_count - 1);
+        return from_level + interpolate(at - phase_at(lo), rate(lo, from_level)) + offset;
     }
 
 private:
-    VOSegment segments[12]; // Array of segments in this Oscillator
+    // Phase increment per tick (at 16666.67 ticks a second) for each centihertz, Q16
+    static constexpr uint32_t INCREMENT_PER_CENTIHERTZ = (UINT64_C(3) << 48) / 5000000;
+    static constexpr uint32_t PHASE_PER_TENTH_DEGREE = 1193047; // 2^32 / 3600, rounded up
+
+    VOSegment segments[hemisphere::VO_MAX_SEGMENTS] = {}; // Array of segments in this Oscillator
     byte segment_count = 0; // Number of segments
     int total_time = 0; // Sum of time values for all segments
-    vosignal_t signal = 0; // Current scaled signal << 10 for more precision
-    vosignal_t target = 0; // Target scaled signal. When the target is reached, the Oscillator moves to the next segment.
-    bool eoc = 1; // The most recent tick's next() read was the end of a cycle
+    uint16_t start[hemisphere::VO_MAX_SEGMENTS] = {}; // Where each segment starts in the cycle, Q16
+    uint32_t recip[hemisphere::VO_MAX_SEGMENTS] = {}; // 1 / the segment's share of the cycle, Q16
+    uint32_t phase = 0; // Position in the cycle, 2^32 to a cycle
+    uint32_t phase_increment = 0; // Phase per tick
     byte segment_index = 0; // Which segment the Oscillator is currently traversing
-    vosignal_t rise; // The amount (per tick) the signal must rise to reach the target
-    uint32_t frequency; // In centihertz
-    uint16_t scale; // The maximum (and minimum negative) output for this Oscillator
-    uint32_t countdown; // Ticks left for a segment with a rise of 0
+    uint32_t segment_start = 0; // The phase at which the current segment started
+    int32_t from = 0; // Signal at segment_start
+    int32_t slope = 0; // Signal per cycle over the current segment
+    bool eoc = 1; // The most recent tick's next() read was the end of a cycle
+    uint32_t frequency = 0; // In centihertz
+    uint16_t scale = 0; // The maximum (and minimum negative) output for this Oscillator
     bool cycle = 1; // Waveform will cycle
     int32_t offset = 0; // Amount added to each voltage output (e.g., to make it unipolar)
     bool sustain = 0; // Waveform stops when it reaches the end of the penultimate stage
     bool sustained = 0; // Current state of sustain. Only active when sustain = 1
 
-    /*
-     * The Oscillator can only oscillate if the following conditions are true:
-     *     (1) The frequency must be greater than 0
-     *     (2) There must be more than one steps
-     *     (3) The total time must be greater than 0
-     *     (4) The scale is greater than 0
-     */
-    bool validate() {
-        bool valid = 1;
-        if (frequency == 0) valid = 0;
-        if (segment_count < 2) valid = 0;
-        if (total_time == 0) valid = 0;
-        if (scale == 0) valid = 0;
-        return valid;
-    }
-
-    int32_t Proportion(int numerator, int denominator, int max_value) {
-        vosignal_t proportion = int2signal((int32_t)numerator) / (int32_t)denominator;
-        int32_t scaled = signal2int(proportion * max_value);
-        return scaled;
+    // Constant denominator, so no division
+    template <int32_t denominator>
+    static int32_t Proportion(int numerator, int max_value) {
+        static_assert(denominator != 0, "Proportion of zero");
+        vosignal_t proportion = int2signal((int32_t)numerator) / denominator;
+        return signal2int(proportion * max_value);
     }
 
     /*
@@ -236,74 +250,59 @@ private:
      */
     vosignal_t scale_level(byte level) {
         int b_level = constrain(level, 0, 255) - 128;
-        int scaled = Proportion(b_level, 127, scale);
+        int scaled = Proportion<127>(b_level, scale);
         vosignal_t scaled_level = int2signal(scaled);
         return scaled_level;
     }
 
-    void advance_segment() {
-        if (sustain && segment_index == segment_count - 2) {
-            sustained = 1;
-        } else {
-            if (++segment_index >= segment_count) {
-                if (cycle) Reset();
-                eoc = 1;
-            } else rise = calculate_rise(segment_index);
-            sustained = 0;
-        }
+    /* The output level at the end of segment ix */
+    int32_t level(byte ix) {
+        return ix < segment_count ? signal2int(scale_level(segments[ix].level)) : 0;
     }
 
-    vosignal_t calculate_rise(byte ix) {
-        // Determine the target level for this segment
-        byte level = segments[ix].level;
-        int time = static_cast<uint32_t>(segments[ix].time);
-        target = scale_level(level);
-
-        // Determine the starting level of this segment to get the total segment rise
-        if (ix > 0) ix--;
-        else ix = segment_count - 1;
-        level = segments[ix].level;
-        vosignal_t starting = scale_level(level);
-
-        // How many ticks should a complete cycle last? cycle_ticks is 10 times that number.
-        int32_t cycle_ticks = 16666667 / frequency;
-
-        // How many ticks should the current segment last?
-        int32_t segment_ticks = Proportion(time, total_time, cycle_ticks);
-
-        // The total difference between the target and the current signal, divided by how many ticks
-        // it should take to get there, is the rise. The / 10 is to cancel the extra precision
-        // from the previous two calculations.
-        vosignal_t new_rise = 0;
-        if (segment_ticks > 0) {
-            new_rise = ((target - starting) * 10) / segment_ticks;
-            if (new_rise == 0) {
-                uint32_t prev_countdown = countdown;
-                countdown = segment_ticks / 10;
-                if (prev_countdown > 0 && prev_countdown < countdown) countdown = prev_countdown;
-            }
+    /* Slope of segment ix, which starts at from_level, per cycle */
+    int32_t rate(byte ix, int32_t from_level) {
+        return (static_cast<int64_t>(level(ix) - from_level) * recip[ix]) >> 16;
+    }
 
-            // The following line is here to deal with the cases where the signal is coming from a different
-            // direction than it would be coming from if it were coming from the previous segment. This can
-            // only happen when the Vector Oscillator is being used as an envelope generator with Sustain/Release,
-            // and the envelope is ungated prior to the sustain (penultimate) segment, and one of these happens:
-            //
-            // (1) The signal level at release is lower than the final signal level, but the sustain segment's
-            //     level is higher, OR
-            // (2) The signal level at release is higher than the final signal level, but the sustain segment's
-            //     level is lower.
-            //
-            // This scenario would result in a rise with the wrong polarity; that is, the signal would move away
-            // from the target instead of toward it. The remedy, as the Third Doctor would say, is to Reverse
-            // The Polarity. So I test for a difference in sign via multiplication. A negative result (value < 0)
-            // indicates that the rise is the reverse of what it should be:
-            else if ((signal2int(target) - signal2int(starting)) * (signal2int(target) - signal2int(signal)) < 0) new_rise = -new_rise;
-        } else {
-            signal = target;
-            countdown = 1;
+    static int32_t interpolate(uint32_t into_segment, int32_t slope_) {
+        return (static_cast<int64_t>(into_segment) * slope_) >> 32;
+    }
+
+    uint32_t phase_at(byte ix) {
+        return static_cast<uint32_t>(start[ix]) << 16;
+    }
+
+    int32_t value() {
+        return from + interpolate(phase - segment_start, slope);
+    }
+
+    void enter(byte ix) {
+        segment_index = ix;
+        segment_start = phase_at(ix);
+        from = level(ix ? ix - 1 : segment_count - 1);
+        slope = rate(ix, from);
+    }
+
+    /* Work out the segment table, after the segments change */
+    void compile() {
+        int time = 0;
+        for (byte ix = 0; ix < segment_count; ix++)
+        {
+            uint32_t begin = total_time ? (time << 16) / total_time : 0;
+            time += segments[ix].time;
+            uint32_t end = total_time ? (time << 16) / total_time : 0;
+            start[ix] = begin > 0xffff ? 0xffff : begin; // Zero-time segments at the very end
+            recip[ix] = end > begin ? ((UINT64_C(1) << 32) + (end - begin) / 2) / (end - begin) : 0;
         }
+        SetFrequency(frequency);
 
-        return new_rise;
+        // Carry on from the same phase
+        if (!sustained) {
+            byte ix = 0;
+            while (ix + 1 < segment_count && start[ix + 1] <= (phase >> 16)) ix++;
+            enter(ix);
+        }
     }
 };
 
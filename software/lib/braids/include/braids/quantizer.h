@@ -30,17 +30,23 @@
 // Heavily modified from the one included in Braids to remove the use a
 // codebook. This significantly reduces the amount of memory required.
 // Furthermore, it enables changing the configuration on the fly.
+//
+// Instead of scanning all notes whenever the pitch leaves the current cell,
+// the note selection is precomputed as a short table of segments of the
+// octave (one per reachable note). The table only depends on the notes and
+// span, so it's rebuilt lazily when Configure actually changes them.
 
 #ifndef BRAIDS_QUANTIZER_H_
 #define BRAIDS_QUANTIZER_H_
 
 #include "stmlib/stmlib.h"
+#include <string.h>
 
 namespace braids {
 
 struct Scale {
   int16_t span;
-  size_t num_notes;
+  uint32_t num_notes;
   int16_t notes[16];
 };
 
@@ -59,12 +65,19 @@ class Quantizer {
   int32_t Process(int32_t pitch, int32_t root, int32_t transpose);
 
   void Configure(const Scale& scale, uint16_t mask = 0xffff) {
-    num_notes_ = 0;
+    int16_t notes[16];
+    uint8_t num_notes = 0;
     for (uint16_t i = 0; i < scale.num_notes; i++) {
-      if (mask & 1) notes_[num_notes_++] = scale.notes[i];
+      if (mask & 1) notes[num_notes++] = scale.notes[i];
       mask >>= 1;
     }
-    span_ = scale.span;
+    if (num_notes != num_notes_ || scale.span != span_ ||
+        memcmp(notes, notes_, num_notes * sizeof(int16_t))) {
+      memcpy(notes_, notes, num_notes * sizeof(int16_t));
+      num_notes_ = num_notes;
+      span_ = scale.span;
+      table_dirty_ = true;
+    }
     enabled_ = notes_ != NULL && num_notes_ != 0 && span_ != 0;
   }
 
@@ -79,6 +92,18 @@ class Quantizer {
   void Requantize() { requantize_ = true; }
 
  private:
+  // Notes plus the nearest neighbours in the octaves above and below
+  static constexpr size_t kMaxSegments = 16 + 2;
+
+  struct Segment {
+    int16_t start; // first pitch in octave
+    uint8_t q;
+    int8_t octave;
+  };
+
+  void BuildTable();
+  void Nearest(int16_t rel_pitch, int32_t pitch, int16_t &q, int16_t &octave) const;
+
   bool enabled_;
   int32_t codeword_;
   int32_t transpose_;
@@ -91,6 +116,10 @@ class Quantizer {
   uint16_t note_number_;
   bool requantize_;
 
+  bool table_dirty_;
+  uint8_t num_segments_; // 0 if the table can't be used
+  Segment segments_[kMaxSegments];
+
   DISALLOW_COPY_AND_ASSIGN(Quantizer);
 };
 
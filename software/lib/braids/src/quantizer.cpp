@@ -49,6 +49,81 @@ void Quantizer::Init() {
   transpose_ = 0;
   previous_boundary_ = 0;
   next_boundary_ = 0;
+  requantize_ = false;
+  table_dirty_ = true;
+  num_segments_ = 0;
+}
+
+// Nearest note for a pitch within the octave, which may also be the first
+// note of the next octave or the last note of the previous one. The octave
+// neighbours use the untruncated pitch, which only differs from rel_pitch if
+// the octave overflowed.
+void Quantizer::Nearest(int16_t rel_pitch, int32_t pitch, int16_t &q, int16_t &octave) const {
+  int16_t best_distance = 16384;
+  q = -1;
+  octave = 0;
+  for (int16_t i = 0; i < num_notes_; i++) {
+    int16_t distance = abs(rel_pitch - notes_[i]);
+    if (distance < best_distance) {
+      best_distance = distance;
+      q = i;
+    }
+  }
+
+  if (abs(pitch - span_ - notes_[0]) < best_distance) {
+    octave = 1;
+    q = 0;
+  } else if (abs(pitch + span_ - notes_[num_notes_ - 1]) <= best_distance) {
+    octave = -1;
+    q = num_notes_ - 1;
+  }
+}
+
+// The nearest note can only change around the midpoints between adjacent
+// candidate notes, so evaluating Nearest there gives the segments of the
+// octave [0, span] exactly, ties included.
+void Quantizer::BuildTable() {
+  table_dirty_ = false;
+  num_segments_ = 0;
+  if (!num_notes_ || span_ <= 0)
+    return;
+
+  int32_t candidates[16 + 2];
+  size_t num_candidates = 0;
+  for (size_t i = 0; i < num_notes_; ++i)
+    candidates[num_candidates++] = notes_[i];
+  candidates[num_candidates++] = notes_[0] + span_;
+  candidates[num_candidates++] = notes_[num_notes_ - 1] - span_;
+  std::sort(candidates, candidates + num_candidates);
+
+  int32_t starts[3 * (16 + 2)];
+  size_t num_starts = 0;
+  starts[num_starts++] = 0;
+  for (size_t i = 1; i < num_candidates; ++i) {
+    int32_t midpoint = (candidates[i - 1] + candidates[i]) >> 1;
+    for (int32_t start = midpoint; start <= midpoint + 2; ++start) {
+      if (start > 0 && start <= span_)
+        starts[num_starts++] = start;
+    }
+  }
+  std::sort(starts, starts + num_starts);
+
+  size_t num_segments = 0;
+  for (size_t i = 0; i < num_starts; ++i) {
+    if (i && starts[i] == starts[i - 1])
+      continue;
+    int16_t q, octave;
+    Nearest(starts[i], starts[i], q, octave);
+    if (q < 0)
+      return;
+    if (num_segments && segments_[num_segments - 1].q == q &&
+        segments_[num_segments - 1].octave == octave)
+      continue;
+    if (num_segments >= kMaxSegments)
+      return;
+    segments_[num_segments++] = { static_cast<int16_t>(starts[i]), static_cast<uint8_t>(q), static_cast<int8_t>(octave) };
+  }
+  num_segments_ = num_segments;
 }
 
 int32_t Quantizer::Process(int32_t pitch, int32_t root, int32_t transpose) {
@@ -71,23 +146,25 @@ int32_t Quantizer::Process(int32_t pitch, int32_t root, int32_t transpose) {
     int16_t octave = pitch / span_ - (pitch < 0 ? 1 : 0);
     int16_t rel_pitch = pitch - span_ * octave;
 
-    int16_t best_distance = 16384;
-    int16_t q = -1;
-    for (int16_t i = 0; i < num_notes_; i++) {
-      int16_t distance = abs(rel_pitch - notes_[i]);
-      if (distance < best_distance) {
-        best_distance = distance;
-        q = i;
+    if (table_dirty_)
+      BuildTable();
+
+    int16_t q, octave_offset;
+    if (num_segments_ && rel_pitch >= 0 && rel_pitch <= span_) {
+      size_t lo = 0, hi = num_segments_;
+      while (hi - lo > 1) {
+        size_t mid = (lo + hi) >> 1;
+        if (segments_[mid].start <= rel_pitch)
+          lo = mid;
+        else
+          hi = mid;
       }
+      q = segments_[lo].q;
+      octave_offset = segments_[lo].octave;
+    } else {
+      Nearest(rel_pitch, pitch - span_ * octave, q, octave_offset);
     }
-
-    if (abs(pitch - (octave + 1) * span_ - notes_[0]) < best_distance) {
-      octave++;
-      q = 0;
-    } else if (abs(pitch - (octave - 1) * span_ - notes_[num_notes_ - 1]) <= best_distance) {
-      octave--;
-      q = num_notes_ - 1;
-    }
+    octave += octave_offset;
 
     // set boundaries for hysteresis
     codeword_ = notes_[q] + octave * span_;
@@ -130,7 +207,9 @@ int32_t Quantizer::Process(int32_t pitch, int32_t root, int32_t transpose) {
 
 int32_t Quantizer::Lookup(int32_t index) const {
   index -= 64;
-  int16_t octave = index / num_notes_ - (index < 0 ? 1 : 0);
+  // Round towards -inf; index / num_notes_ - 1 is one octave off (and reads
+  // notes_[num_notes_]) when index is a negative multiple of num_notes_
+  int16_t octave = (index >= 0 ? index : index - num_notes_ + 1) / num_notes_;
   int16_t rel_ix = index - octave * num_notes_;
   int32_t pitch = notes_[rel_ix] + octave * span_;
   return pitch;
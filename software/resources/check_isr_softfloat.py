@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Flags soft-float library calls that are reachable from the ISRs.
+
+The MK20 has no FPU, so every float/double operation is a call into libgcc
+(__aeabi_fmul, __aeabi_dadd, ...) costing tens to hundreds of cycles, which
+adds up quickly at 16.666kHz. This disassembles the firmware, follows direct
+calls and branches from the roots and lists the soft-float functions it
+reaches, with the path to each.
+
+Apps and applets are called through function pointer tables and virtual
+functions, which can't be followed in the disassembly, so their ISR entry
+points are roots of their own (see DEFAULT_ROOTS).
+
+Standalone:
+  check_isr_softfloat.py [--objdump arm-none-eabi-objdump] [--error] firmware.elf
+
+As a PlatformIO extra script ("post:resources/check_isr_softfloat.py") it runs
+after linking and prints warnings; with "custom_isr_softfloat = error" in the
+environment it fails the build instead.
+"""
+
+import argparse
+import collections
+import re
+import subprocess
+import sys
+
+# Searched for in the mangled names
+DEFAULT_ROOTS = [
+    r"CORE_timer_ISR",
+    r"_isrv",                # App ISRs, e.g. HEMISPHERE_isr()
+    r"10ControllerEv",       # Controller() of the applets, called virtually
+]
+
+DEFAULT_PATTERN = (
+    r"^(__aeabi_(f|d|[iu]l?2[fd])\w*"                             # EABI names
+    r"|__(add|sub|mul|div|neg|cmp|eq|ne|lt|le|gt|ge|unord)[sd]f[23]"  # libgcc
+    r"|__(float|fix|extend|trunc)\w*[sd]f\w*)$"                     # conversions
+)
+
+HEADER = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+INSTRUCTION = re.compile(r"^\s*[0-9a-f]+:\s+(\S+)\s+.*<([^>+]+)(\+0x[0-9a-f]+)?>\s*$")
+BRANCH = re.compile(r"^(b[a-z]*|cbn?z|call[a-z]*|jmp[a-z]*|j[a-z]{1,3})(\.[nw])?$")
+
+
+def call_graph(objdump, elf):
+  """Returns {function: set of functions it calls or branches to}"""
+  output = subprocess.run([objdump, "-d", "--no-show-raw-insn", elf],
+                          check=True, stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout
+  graph = collections.defaultdict(set)
+  function = None
+  for line in output.splitlines():
+    header = HEADER.match(line)
+    if header:
+      function = header.group(2)
+      graph[function]
+      continue
+    instruction = INSTRUCTION.match(line)
+    if function and instruction and BRANCH.match(instruction.group(1)):
+      target = instruction.group(2)
+      if target != function:
+        graph[function].add(target)
+  return graph
+
+
+def find_soft_float(graph, roots, pattern):
+  """Returns {soft-float function: path from a root} for the reachable ones"""
+  parent = {}
+  queue = collections.deque()
+  for function in sorted(graph):
+    if any(re.search(root, function) for root in roots) and not pattern.match(function):
+      parent[function] = None
+      queue.append(function)
+
+  found = {}
+  while queue:
+    function = queue.popleft()
+    for callee in sorted(graph.get(function, ())):
+      if callee in parent:
+        continue
+      parent[callee] = function
+      if pattern.match(callee):
+        path = [callee]
+        while parent[path[-1]] is not None:
+          path.append(parent[path[-1]])
+        found[callee] = list(reversed(path))
+      else:
+        queue.append(callee)
+  return found
+
+
+def demangler(objdump):
+  cxxfilt = re.sub(r"objdump(\.exe)?$", r"c++filt\1", objdump)
+  def demangle(names):
+    try:
+      return subprocess.run([cxxfilt], input="\n".join(names), check=True,
+                            stdout=subprocess.PIPE,
+                            universal_newlines=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError):
+      return names
+  return demangle
+
+
+def check(elf, objdump, roots=DEFAULT_ROOTS, pattern=DEFAULT_PATTERN):
+  """Prints what was found, returns the number of soft-float functions"""
+  found = find_soft_float(call_graph(objdump, elf), roots, re.compile(pattern))
+  if not found:
+    print("check_isr_softfloat: no soft-float calls reachable from the ISRs")
+    return 0
+
+  demangle = demangler(objdump)
+  print("check_isr_softfloat: %d soft-float function(s) reachable from the ISRs:"
+        % len(found))
+  for function in sorted(found):
+    print("  %s" % function)
+    print("    via %s" % " > ".join(demangle(found[function][:-1])))
+  return len(found)
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument("elf")
+  parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+  parser.add_argument("--root", action="append",
+                      help="regex for a root function (mangled), repeatable; "
+                      "replaces the defaults")
+  parser.add_argument("--pattern", default=DEFAULT_PATTERN,
+                      help="regex for the functions to flag")
+  parser.add_argument("--error", action="store_true",
+                      help="exit with an error if anything is found")
+  args = parser.parse_args()
+  count = check(args.elf, args.objdump, args.root or DEFAULT_ROOTS, args.pattern)
+  return 1 if count and args.error else 0
+
+
+try:
+  Import("env")  # noqa: F821 (PlatformIO/SCons)
+except NameError:
+  sys.exit(main())
+else:
+  def post_link(source, target, env):
+    objdump = env.subst("$OBJCOPY").replace("objcopy", "objdump")
+    objdump = env.WhereIs(objdump) or objdump
+    try:
+      count = check(str(target[0]), objdump)
+    except (OSError, subprocess.CalledProcessError) as e:
+      print("check_isr_softfloat: can't disassemble the firmware: %s" % e)
+      return
+    if count and env.GetProjectOption("custom_isr_softfloat", "warn") == "error":
+      env.Exit(1)
+
+  env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", post_link)  # noqa: F821
@@ -58,13 +58,13 @@ public:
 
             //if (signal != target) { // Logarhythm fix 8/2020
                 int segment = phase == 1
-                    ? effective_attack + Proportion(DetentedIn(0), HEMISPHERE_MAX_INPUT_CV, HEM_ADEG_MAX_VALUE)
-                    : effective_decay + Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, HEM_ADEG_MAX_VALUE);
+                    ? effective_attack + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(0), HEM_ADEG_MAX_VALUE)
+                    : effective_decay + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), HEM_ADEG_MAX_VALUE);
                 segment = constrain(segment, 0, HEM_ADEG_MAX_VALUE);
                 simfloat remaining = target - signal;
 
                 // The number of ticks it would take to get from 0 to HEMISPHERE_MAX_CV
-                int max_change = Proportion(segment, HEM_ADEG_MAX_VALUE, HEM_ADEG_MAX_TICKS);
+                int max_change = Proportion<HEM_ADEG_MAX_VALUE>(segment, HEM_ADEG_MAX_TICKS);
 
                 // The number of ticks it would take to move the remaining amount at max_change
                 int ticks_to_remaining = Proportion(simfloat2int(remaining), HEMISPHERE_MAX_CV, max_change);
@@ -102,11 +102,11 @@ public:
     void OnEncoderMove(int direction) {
         if (cursor == 0) {
             attack = constrain(attack + direction, 0, HEM_ADEG_MAX_VALUE);
-            last_ms_value = Proportion(attack, HEM_ADEG_MAX_VALUE, HEM_ADEG_MAX_TICKS) / 17;
+            last_ms_value = Proportion<HEM_ADEG_MAX_VALUE>(attack, HEM_ADEG_MAX_TICKS) / 17;
         }
         else {
             decay = constrain(decay + direction, 0, HEM_ADEG_MAX_VALUE);
-            last_ms_value = Proportion(decay, HEM_ADEG_MAX_VALUE, HEM_ADEG_MAX_TICKS) / 17;
+            last_ms_value = Proportion<HEM_ADEG_MAX_VALUE>(decay, HEM_ADEG_MAX_TICKS) / 17;
         }
         last_change_ticks = oc::core::ticks;
     }
@@ -147,8 +147,8 @@ private:
     int decay; // Time to reach signal level if signal > 0V
 
     void DrawIndicator() {
-        int a_x = Proportion(attack, HEM_ADEG_MAX_VALUE, 31);
-        int d_x = a_x + Proportion(decay, HEM_ADEG_MAX_VALUE, 31);
+        int a_x = Proportion<HEM_ADEG_MAX_VALUE>(attack, 31);
+        int d_x = a_x + Proportion<HEM_ADEG_MAX_VALUE>(decay, 31);
 
         if (d_x > 0) { // Stretch to use the whole viewport
             a_x = Proportion(62, d_x, a_x);
@@ -178,13 +178,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ADEG ADEG_instance[2];
-
-void ADEG_Start(bool hemisphere) {ADEG_instance[hemisphere].BaseStart(hemisphere);}
-void ADEG_Controller(bool hemisphere, bool forwarding) {ADEG_instance[hemisphere].BaseController(forwarding);}
-void ADEG_View(bool hemisphere) {ADEG_instance[hemisphere].BaseView();}
-void ADEG_OnButtonPress(bool hemisphere) {ADEG_instance[hemisphere].OnButtonPress();}
-void ADEG_OnEncoderMove(bool hemisphere, int direction) {ADEG_instance[hemisphere].OnEncoderMove(direction);}
-void ADEG_ToggleHelpScreen(bool hemisphere) {ADEG_instance[hemisphere].HelpScreen();}
-uint64_t ADEG_OnDataRequest(bool hemisphere) {return ADEG_instance[hemisphere].OnDataRequest();}
-void ADEG_OnDataReceive(bool hemisphere, uint64_t data) {ADEG_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(ADEG)
+
+void ADEG_Start(bool hemisphere) {hemisphere::ConstructInSlot<ADEG>(hemisphere).BaseStart(hemisphere);}
+void ADEG_Controller(bool hemisphere, bool forwarding) {ADEG_instance(hemisphere).BaseController(forwarding);}
+void ADEG_View(bool hemisphere) {ADEG_instance(hemisphere).BaseView();}
+void ADEG_OnButtonPress(bool hemisphere) {ADEG_instance(hemisphere).OnButtonPress();}
+void ADEG_OnEncoderMove(bool hemisphere, int direction) {ADEG_instance(hemisphere).OnEncoderMove(direction);}
+void ADEG_ToggleHelpScreen(bool hemisphere) {ADEG_instance(hemisphere).HelpScreen();}
+uint64_t ADEG_OnDataRequest(bool hemisphere) {return ADEG_instance(hemisphere).OnDataRequest();}
+void ADEG_OnDataReceive(bool hemisphere, uint64_t data) {ADEG_instance(hemisphere).OnDataReceive(data);}
@@ -188,14 +188,14 @@ private:
     int DrawDecay(int x, int length) {
         int xD = x + Proportion(decay, length, 62);
         if (xD < 0) xD = 0;
-        int yS = Proportion(sustain, eg::MAX_VALUE, eg::DISPLAY_HEIGHT);
+        int yS = Proportion<eg::MAX_VALUE>(sustain, eg::DISPLAY_HEIGHT);
         gfxLine(x, BottomAlign(eg::DISPLAY_HEIGHT), xD, BottomAlign(yS), edit_stage != eg::DECAY);
         return xD;
     }
 
     int DrawSustain(int x, int length) {
         int xS = x + Proportion(SUSTAIN_CONST, length, 62);
-        int yS = Proportion(sustain, eg::MAX_VALUE, eg::DISPLAY_HEIGHT);
+        int yS = Proportion<eg::MAX_VALUE>(sustain, eg::DISPLAY_HEIGHT);
         if (yS < 0) yS = 0;
         if (xS < 0) xS = 0;
         gfxLine(x, BottomAlign(yS), xS, BottomAlign(yS), edit_stage != eg::SUSTAIN);
@@ -204,14 +204,14 @@ private:
 
     int DrawRelease(int x, int length) {
         int xR = x + Proportion(release, length, 62);
-        int yS = Proportion(sustain, eg::MAX_VALUE, eg::DISPLAY_HEIGHT);
+        int yS = Proportion<eg::MAX_VALUE>(sustain, eg::DISPLAY_HEIGHT);
         gfxLine(x, BottomAlign(yS), xR, BottomAlign(0), edit_stage != eg::RELEASE);
         return xR;
     }
 
     void AttackAmplitude(int ch) {
         int effective_attack = constrain(attack + attack_mod, 1, eg::MAX_VALUE);
-        int total_stage_ticks = Proportion(effective_attack, eg::MAX_VALUE, eg::MAX_TICKS_AD);
+        int total_stage_ticks = Proportion<eg::MAX_VALUE>(effective_attack, eg::MAX_TICKS_AD);
         int ticks_remaining = total_stage_ticks - stage_ticks[ch];
         if (effective_attack == 1) ticks_remaining = 0;
         if (ticks_remaining <= 0) { // End of attack; move to decay
@@ -226,14 +226,14 @@ private:
     }
 
     void DecayAmplitude(int ch) {
-        int total_stage_ticks = Proportion(decay, eg::MAX_VALUE, eg::MAX_TICKS_AD);
+        int total_stage_ticks = Proportion<eg::MAX_VALUE>(decay, eg::MAX_TICKS_AD);
         int ticks_remaining = total_stage_ticks - stage_ticks[ch];
-        simfloat amplitude_remaining = amplitude[ch] - int2simfloat(Proportion(sustain, eg::MAX_VALUE, HEMISPHERE_MAX_CV));
+        simfloat amplitude_remaining = amplitude[ch] - int2simfloat(Proportion<eg::MAX_VALUE>(sustain, HEMISPHERE_MAX_CV));
         if (sustain == 1) ticks_remaining = 0;
         if (ticks_remaining <= 0) { // End of decay; move to sustain
             stage[ch] = eg::SUSTAIN;
             stage_ticks[ch] = 0;
-            amplitude[ch] = int2simfloat(Proportion(sustain, eg::MAX_VALUE, HEMISPHERE_MAX_CV));
+            amplitude[ch] = int2simfloat(Proportion<eg::MAX_VALUE>(sustain, HEMISPHERE_MAX_CV));
         } else {
             simfloat decrease = amplitude_remaining / ticks_remaining;
             amplitude[ch] -= decrease;
@@ -241,12 +241,12 @@ private:
     }
 
     void SustainAmplitude(int ch) {
-        amplitude[ch] = int2simfloat(Proportion(sustain - 1, eg::MAX_VALUE, HEMISPHERE_MAX_CV));
+        amplitude[ch] = int2simfloat(Proportion<eg::MAX_VALUE>(sustain - 1, HEMISPHERE_MAX_CV));
     }
 
     void ReleaseAmplitude(int ch) {
         int effective_release = constrain(release + release_mod, 1, eg::MAX_VALUE) - 1;
-        int total_stage_ticks = Proportion(effective_release, eg::MAX_VALUE, eg::MAX_TICKS_R);
+        int total_stage_ticks = Proportion<eg::MAX_VALUE>(effective_release, eg::MAX_TICKS_R);
         int ticks_remaining = total_stage_ticks - stage_ticks[ch];
         if (effective_release == 0) ticks_remaining = 0;
         if (ticks_remaining <= 0 || amplitude[ch] <= 0) { // End of release; turn off envelope
@@ -261,7 +261,7 @@ private:
 
     int get_modification_with_input(int in) {
         int mod = 0;
-        mod = Proportion(DetentedIn(in), HEMISPHERE_MAX_INPUT_CV, eg::MAX_VALUE / 2);
+        mod = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(in), eg::MAX_VALUE / 2);
         return mod;
     }
 };
@@ -275,36 +275,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ADSREG ADSREG_instance[2];
+DECLARE_APPLET_INSTANCE(ADSREG)
 
 void ADSREG_Start(bool hemisphere) {
-    ADSREG_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<ADSREG>(hemisphere).BaseStart(hemisphere);
 }
 
 void ADSREG_Controller(bool hemisphere, bool forwarding) {
-    ADSREG_instance[hemisphere].BaseController(forwarding);
+    ADSREG_instance(hemisphere).BaseController(forwarding);
 }
 
 void ADSREG_View(bool hemisphere) {
-    ADSREG_instance[hemisphere].BaseView();
+    ADSREG_instance(hemisphere).BaseView();
 }
 
 void ADSREG_OnButtonPress(bool hemisphere) {
-    ADSREG_instance[hemisphere].OnButtonPress();
+    ADSREG_instance(hemisphere).OnButtonPress();
 }
 
 void ADSREG_OnEncoderMove(bool hemisphere, int direction) {
-    ADSREG_instance[hemisphere].OnEncoderMove(direction);
+    ADSREG_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void ADSREG_ToggleHelpScreen(bool hemisphere) {
-    ADSREG_instance[hemisphere].HelpScreen();
+    ADSREG_instance(hemisphere).HelpScreen();
 }
 
 uint64_t ADSREG_OnDataRequest(bool hemisphere) {
-    return ADSREG_instance[hemisphere].OnDataRequest();
+    return ADSREG_instance(hemisphere).OnDataRequest();
 }
 
 void ADSREG_OnDataReceive(bool hemisphere, uint64_t data) {
-    ADSREG_instance[hemisphere].OnDataReceive(data);
+    ADSREG_instance(hemisphere).OnDataReceive(data);
 }
@@ -49,7 +49,7 @@ public:
                 int cv = In(0);
                 buffer_m->WriteValueToBuffer(cv, hemisphere);
             }
-            index_mod = Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, 32);
+            index_mod = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), 32);
             ForEachChannel(ch)
             {
                 int cv = buffer_m->ReadNextValue(ch, hemisphere, index_mod);
@@ -156,13 +156,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ASR ASR_instance[2];
-
-void ASR_Start(bool hemisphere) {ASR_instance[hemisphere].BaseStart(hemisphere);}
-void ASR_Controller(bool hemisphere, bool forwarding) {ASR_instance[hemisphere].BaseController(forwarding);}
-void ASR_View(bool hemisphere) {ASR_instance[hemisphere].BaseView();}
-void ASR_OnButtonPress(bool hemisphere) {ASR_instance[hemisphere].OnButtonPress();}
-void ASR_OnEncoderMove(bool hemisphere, int direction) {ASR_instance[hemisphere].OnEncoderMove(direction);}
-void ASR_ToggleHelpScreen(bool hemisphere) {ASR_instance[hemisphere].HelpScreen();}
-uint64_t ASR_OnDataRequest(bool hemisphere) {return ASR_instance[hemisphere].OnDataRequest();}
-void ASR_OnDataReceive(bool hemisphere, uint64_t data) {ASR_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(ASR)
+
+void ASR_Start(bool hemisphere) {hemisphere::ConstructInSlot<ASR>(hemisphere).BaseStart(hemisphere);}
+void ASR_Controller(bool hemisphere, bool forwarding) {ASR_instance(hemisphere).BaseController(forwarding);}
+void ASR_View(bool hemisphere) {ASR_instance(hemisphere).BaseView();}
+void ASR_OnButtonPress(bool hemisphere) {ASR_instance(hemisphere).OnButtonPress();}
+void ASR_OnEncoderMove(bool hemisphere, int direction) {ASR_instance(hemisphere).OnEncoderMove(direction);}
+void ASR_ToggleHelpScreen(bool hemisphere) {ASR_instance(hemisphere).HelpScreen();}
+uint64_t ASR_OnDataRequest(bool hemisphere) {return ASR_instance(hemisphere).OnDataRequest();}
+void ASR_OnDataReceive(bool hemisphere, uint64_t data) {ASR_instance(hemisphere).OnDataReceive(data);}
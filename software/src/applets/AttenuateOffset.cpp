@@ -41,7 +41,7 @@ public:
         
         ForEachChannel(ch)
         {
-            int signal = Proportion(level[ch], 63, In(ch)) + (offset[ch] * ATTENOFF_INCREMENTS);
+            int signal = Proportion<63>(level[ch], In(ch)) + (offset[ch] * ATTENOFF_INCREMENTS);
             if (ch == 1 && mix_final) {
                 signal = signal + prevSignal;
             }
@@ -129,7 +129,7 @@ private:
             gfxPrint(0, 15 + (ch * 20), (hemisphere ? (ch ? "D " : "C ") : (ch ? "B " : "A ")));
             int cv = offset[ch] * ATTENOFF_INCREMENTS;
             gfxPrintVoltage(cv);
-            gfxPrint(16, 25 + (ch * 20), Proportion(level[ch], 63, 100));
+            gfxPrint(16, 25 + (ch * 20), Proportion<63>(level[ch], 100));
             gfxPrint("%");
         }
 
@@ -157,13 +157,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-AttenuateOffset AttenuateOffset_instance[2];
-
-void AttenuateOffset_Start(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseStart(hemisphere);}
-void AttenuateOffset_Controller(bool hemisphere, bool forwarding) {AttenuateOffset_instance[hemisphere].BaseController(forwarding);}
-void AttenuateOffset_View(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseView();}
-void AttenuateOffset_OnButtonPress(bool hemisphere) {AttenuateOffset_instance[hemisphere].OnButtonPress();}
-void AttenuateOffset_OnEncoderMove(bool hemisphere, int direction) {AttenuateOffset_instance[hemisphere].OnEncoderMove(direction);}
-void AttenuateOffset_ToggleHelpScreen(bool hemisphere) {AttenuateOffset_instance[hemisphere].HelpScreen();}
-uint64_t AttenuateOffset_OnDataRequest(bool hemisphere) {return AttenuateOffset_instance[hemisphere].OnDataRequest();}
-void AttenuateOffset_OnDataReceive(bool hemisphere, uint64_t data) {AttenuateOffset_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(AttenuateOffset)
+
+void AttenuateOffset_Start(bool hemisphere) {hemisphere::ConstructInSlot<AttenuateOffset>(hemisphere).BaseStart(hemisphere);}
+void AttenuateOffset_Controller(bool hemisphere, bool forwarding) {AttenuateOffset_instance(hemisphere).BaseController(forwarding);}
+void AttenuateOffset_View(bool hemisphere) {AttenuateOffset_instance(hemisphere).BaseView();}
+void AttenuateOffset_OnButtonPress(bool hemisphere) {AttenuateOffset_instance(hemisphere).OnButtonPress();}
+void AttenuateOffset_OnEncoderMove(bool hemisphere, int direction) {AttenuateOffset_instance(hemisphere).OnEncoderMove(direction);}
+void AttenuateOffset_ToggleHelpScreen(bool hemisphere) {AttenuateOffset_instance(hemisphere).HelpScreen();}
+uint64_t AttenuateOffset_OnDataRequest(bool hemisphere) {return AttenuateOffset_instance(hemisphere).OnDataRequest();}
+void AttenuateOffset_OnDataReceive(bool hemisphere, uint64_t data) {AttenuateOffset_instance(hemisphere).OnDataReceive(data);}
@@ -109,36 +109,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Binary Binary_instance[2];
+DECLARE_APPLET_INSTANCE(Binary)
 
 void Binary_Start(bool hemisphere) {
-    Binary_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Binary>(hemisphere).BaseStart(hemisphere);
 }
 
 void Binary_Controller(bool hemisphere, bool forwarding) {
-    Binary_instance[hemisphere].BaseController(forwarding);
+    Binary_instance(hemisphere).BaseController(forwarding);
 }
 
 void Binary_View(bool hemisphere) {
-    Binary_instance[hemisphere].BaseView();
+    Binary_instance(hemisphere).BaseView();
 }
 
 void Binary_OnButtonPress(bool hemisphere) {
-    Binary_instance[hemisphere].OnButtonPress();
+    Binary_instance(hemisphere).OnButtonPress();
 }
 
 void Binary_OnEncoderMove(bool hemisphere, int direction) {
-    Binary_instance[hemisphere].OnEncoderMove(direction);
+    Binary_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Binary_ToggleHelpScreen(bool hemisphere) {
-    Binary_instance[hemisphere].HelpScreen();
+    Binary_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Binary_OnDataRequest(bool hemisphere) {
-    return Binary_instance[hemisphere].OnDataRequest();
+    return Binary_instance(hemisphere).OnDataRequest();
 }
 
 void Binary_OnDataReceive(bool hemisphere, uint64_t data) {
-    Binary_instance[hemisphere].OnDataReceive(data);
+    Binary_instance(hemisphere).OnDataReceive(data);
 }
@@ -87,13 +87,13 @@ public:
         }
 
         // Bass Drum Output
-        signal = Proportion((BNC_MAX_PARAM - blend) + BNC_MAX_PARAM, BNC_MAX_PARAM * 2, bd_signal);
-        signal += Proportion(blend, BNC_MAX_PARAM * 2, sd_signal); // Blend in snare drum
+        signal = Proportion<BNC_MAX_PARAM * 2>((BNC_MAX_PARAM - blend) + BNC_MAX_PARAM, bd_signal);
+        signal += Proportion<BNC_MAX_PARAM * 2>(blend, sd_signal); // Blend in snare drum
         Out(0, signal);
 
         // Snare Drum Output
-        signal = Proportion((BNC_MAX_PARAM - blend) + BNC_MAX_PARAM, BNC_MAX_PARAM * 2, sd_signal);
-        signal += Proportion(blend, BNC_MAX_PARAM * 2, bd_signal); // Blend in bass drum
+        signal = Proportion<BNC_MAX_PARAM * 2>((BNC_MAX_PARAM - blend) + BNC_MAX_PARAM, sd_signal);
+        signal += Proportion<BNC_MAX_PARAM * 2>(blend, bd_signal); // Blend in bass drum
         Out(1, signal);
     }
 
@@ -194,7 +194,7 @@ private:
 
     void DrawKnobAt(byte y, byte value, bool is_cursor) {
         byte x = 45;
-        byte w = Proportion(value, BNC_MAX_PARAM, 16);
+        byte w = Proportion<BNC_MAX_PARAM>(value, 16);
         byte p = is_cursor ? 1 : 3;
         gfxDottedLine(x, y + 4, 62, y + 4, p);
         gfxRect(x + w, y, 2, 7);
@@ -202,11 +202,11 @@ private:
     }
 
     void SetBDFreq() {
-        bass.SetFrequency(Proportion(tone[0], BNC_MAX_PARAM, 3000) + 3000);
+        bass.SetFrequency(Proportion<BNC_MAX_PARAM>(tone[0], 3000) + 3000);
     }
 
     void SetEGFreq(byte ch) {
-        eg[ch].SetFrequency(1000 - Proportion(decay[ch], BNC_MAX_PARAM, 900));
+        eg[ch].SetFrequency(1000 - Proportion<BNC_MAX_PARAM>(decay[ch], 900));
     }
 };
 
@@ -219,13 +219,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-BootsNCat BootsNCat_instance[2];
-
-void BootsNCat_Start(bool hemisphere) {BootsNCat_instance[hemisphere].BaseStart(hemisphere);}
-void BootsNCat_Controller(bool hemisphere, bool forwarding) {BootsNCat_instance[hemisphere].BaseController(forwarding);}
-void BootsNCat_View(bool hemisphere) {BootsNCat_instance[hemisphere].BaseView();}
-void BootsNCat_OnButtonPress(bool hemisphere) {BootsNCat_instance[hemisphere].OnButtonPress();}
-void BootsNCat_OnEncoderMove(bool hemisphere, int direction) {BootsNCat_instance[hemisphere].OnEncoderMove(direction);}
-void BootsNCat_ToggleHelpScreen(bool hemisphere) {BootsNCat_instance[hemisphere].HelpScreen();}
-uint64_t BootsNCat_OnDataRequest(bool hemisphere) {return BootsNCat_instance[hemisphere].OnDataRequest();}
-void BootsNCat_OnDataReceive(bool hemisphere, uint64_t data) {BootsNCat_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(BootsNCat)
+
+void BootsNCat_Start(bool hemisphere) {hemisphere::ConstructInSlot<BootsNCat>(hemisphere).BaseStart(hemisphere);}
+void BootsNCat_Controller(bool hemisphere, bool forwarding) {BootsNCat_instance(hemisphere).BaseController(forwarding);}
+void BootsNCat_View(bool hemisphere) {BootsNCat_instance(hemisphere).BaseView();}
+void BootsNCat_OnButtonPress(bool hemisphere) {BootsNCat_instance(hemisphere).OnButtonPress();}
+void BootsNCat_OnEncoderMove(bool hemisphere, int direction) {BootsNCat_instance(hemisphere).OnEncoderMove(direction);}
+void BootsNCat_ToggleHelpScreen(bool hemisphere) {BootsNCat_instance(hemisphere).HelpScreen();}
+uint64_t BootsNCat_OnDataRequest(bool hemisphere) {return BootsNCat_instance(hemisphere).OnDataRequest();}
+void BootsNCat_OnDataReceive(bool hemisphere, uint64_t data) {BootsNCat_instance(hemisphere).OnDataReceive(data);}
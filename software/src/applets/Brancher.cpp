@@ -37,7 +37,7 @@ public:
     void Controller() {
         // handles physical and logical clock
         if (Clock(0)) {
-            int prob = p + Proportion(DetentedIn(0), HEMISPHERE_MAX_INPUT_CV, 100);
+            int prob = p + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(0), 100);
             choice = (random(1, 100) <= prob) ? 0 : 1;
 
             // will be true only for logical clocks
@@ -112,36 +112,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Brancher Brancher_instance[2];
+DECLARE_APPLET_INSTANCE(Brancher)
 
 void Brancher_Start(bool hemisphere) {
-    Brancher_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Brancher>(hemisphere).BaseStart(hemisphere);
 }
 
 void Brancher_Controller(bool hemisphere, bool forwarding) {
-	Brancher_instance[hemisphere].BaseController(forwarding);
+	Brancher_instance(hemisphere).BaseController(forwarding);
 }
 
 void Brancher_View(bool hemisphere) {
-    Brancher_instance[hemisphere].BaseView();
+    Brancher_instance(hemisphere).BaseView();
 }
 
 void Brancher_OnButtonPress(bool hemisphere) {
-    Brancher_instance[hemisphere].OnButtonPress();
+    Brancher_instance(hemisphere).OnButtonPress();
 }
 
 void Brancher_OnEncoderMove(bool hemisphere, int direction) {
-    Brancher_instance[hemisphere].OnEncoderMove(direction);
+    Brancher_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Brancher_ToggleHelpScreen(bool hemisphere) {
-    Brancher_instance[hemisphere].HelpScreen();
+    Brancher_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Brancher_OnDataRequest(bool hemisphere) {
-    return Brancher_instance[hemisphere].OnDataRequest();
+    return Brancher_instance(hemisphere).OnDataRequest();
 }
 
 void Brancher_OnDataReceive(bool hemisphere, uint64_t data) {
-    Brancher_instance[hemisphere].OnDataReceive(data);
+    Brancher_instance(hemisphere).OnDataReceive(data);
 }
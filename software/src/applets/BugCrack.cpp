@@ -59,7 +59,7 @@ public:
         noise = random(0, (1<<12));
 
         kick = WaveformManager::VectorOscillatorFromWaveform(hemisphere::Sine);
-        kick.SetFrequency(Proportion(tone_kick, BNC_MAX_PARAM, 3000) + 3000);
+        kick.SetFrequency(Proportion<BNC_MAX_PARAM>(tone_kick, 3000) + 3000);
         kick.SetScale((12 << 7) * 3);
 
         ForEachChannel(ch) levels[ch] = 0;
@@ -77,7 +77,7 @@ public:
         SetEnvDecayPunch(decay_punch);
 
         snare = WaveformManager::VectorOscillatorFromWaveform(hemisphere::Sine);
-        snare.SetFrequency(Proportion(tone_snare, BNC_MAX_PARAM, 60000) + 10000);
+        snare.SetFrequency(Proportion<BNC_MAX_PARAM>(tone_snare, 60000) + 10000);
         snare.SetScale((12 << 7) * 3);
 
         env_snare = WaveformManager::VectorOscillatorFromWaveform(hemisphere::Exponential);
@@ -101,8 +101,8 @@ public:
         int32_t bd_signal = 0;
         int32_t sd_signal = 0;
         int32_t ns_signal = 0;
-        cv_kick = Proportion(DetentedIn(CH_KICK), HEMISPHERE_MAX_INPUT_CV, BNC_MAX_PARAM);
-        cv_snare = Proportion(DetentedIn(CH_SNARE), HEMISPHERE_MAX_INPUT_CV, BNC_MAX_PARAM);
+        cv_kick = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(CH_KICK), BNC_MAX_PARAM);
+        cv_snare = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(CH_SNARE), BNC_MAX_PARAM);
 
         // Kick drum
         if (cv_mode_kick == CV_MODE_TONE) {
@@ -134,17 +134,17 @@ public:
         }
         if (!env_kick.GetEOC()) {
             // base frequency
-            int freq_kick = Proportion(_tone_kick, BNC_MAX_PARAM, 3000) + 3000;
+            int freq_kick = Proportion<BNC_MAX_PARAM>(_tone_kick, 3000) + 3000;
             // punchy FM drop
             if (!env_punch.GetEOC()) {
-                int df = Proportion(env_punch.Next(), HEMISPHERE_3V_CV, freq_kick);
-                df = Proportion(_punch, BNC_MAX_PARAM/4, df);
+                int df = Proportion<HEMISPHERE_3V_CV>(env_punch.Next(), freq_kick);
+                df = Proportion<BNC_MAX_PARAM/4>(_punch, df);
                 freq_kick += df;
             }
             kick.SetFrequency(freq_kick);
             levels[0] = env_kick.Next();
             if (cv_mode_kick == CV_MODE_ATTEN) {
-                levels[0] = Proportion(BNC_MAX_PARAM - cv_kick, BNC_MAX_PARAM, levels[0]);
+                levels[0] = Proportion<BNC_MAX_PARAM>(BNC_MAX_PARAM - cv_kick, levels[0]);
             }
             bd_signal = Proportion(levels[0], HEMISPHERE_MAX_CV, kick.Next());
             // Because of overtones induced by the linear interpolation of the
@@ -183,11 +183,11 @@ public:
             snare.Start();
         }
         if (!env_noise.GetEOC()) {
-            int64_t freq_snare = Proportion(_tone_snare, BNC_MAX_PARAM, 600) + 100;
+            int64_t freq_snare = Proportion<BNC_MAX_PARAM>(_tone_snare, 600) + 100;
             freq_snare *= 100;
             if (!env_snap.GetEOC()) {
-                int64_t df = Proportion(env_snap.Next(), HEMISPHERE_3V_CV, freq_snare/1024);
-                df = Proportion(_snap, BNC_MAX_PARAM/4, df);
+                int64_t df = Proportion<HEMISPHERE_3V_CV>(env_snap.Next(), freq_snare/1024);
+                df = Proportion<BNC_MAX_PARAM/4>(_snap, df);
                 df *= 1024;
                 freq_snare += df;
             }
@@ -196,23 +196,23 @@ public:
             // noise levels
             levels[1] = env_noise.Next();
             if (cv_mode_snare == CV_MODE_ATTEN) {
-                levels[1] = Proportion(BNC_MAX_PARAM - cv_snare, BNC_MAX_PARAM, levels[1]);
+                levels[1] = Proportion<BNC_MAX_PARAM>(BNC_MAX_PARAM - cv_snare, levels[1]);
             }
-            ns_signal = Proportion(levels[1], HEMISPHERE_3V_CV, noise);
-            filter_sv.feed(ns_signal, (Proportion(_tone_snare, BNC_MAX_PARAM, 60000) + 100000), 500);
+            ns_signal = Proportion<HEMISPHERE_3V_CV>(levels[1], noise);
+            filter_sv.feed(ns_signal, (Proportion<BNC_MAX_PARAM>(_tone_snare, 60000) + 100000), 500);
             ns_signal = filter_sv.get_bp();
 
             // osc levels
             levels[2] = env_snare.Next();
             if (cv_mode_snare == CV_MODE_ATTEN) {
-                levels[2] = Proportion(BNC_MAX_PARAM - cv_snare, BNC_MAX_PARAM, levels[2]);
+                levels[2] = Proportion<BNC_MAX_PARAM>(BNC_MAX_PARAM - cv_snare, levels[2]);
             }
-            sd_signal = Proportion(levels[2], HEMISPHERE_3V_CV, snare.Next());
+            sd_signal = Proportion<HEMISPHERE_3V_CV>(levels[2], snare.Next());
             sd_signal = filter_lp2.filter(sd_signal, freq_snare);
 
             // blend osc and noise
-            sd_signal = Proportion(BNC_MAX_PARAM - _blend_snare, BNC_MAX_PARAM, sd_signal);
-            sd_signal += Proportion(_blend_snare, BNC_MAX_PARAM, ns_signal);
+            sd_signal = Proportion<BNC_MAX_PARAM>(BNC_MAX_PARAM - _blend_snare, sd_signal);
+            sd_signal += Proportion<BNC_MAX_PARAM>(_blend_snare, ns_signal);
         }
 
         // Kick Drum Output
@@ -371,7 +371,7 @@ private:
         switch (cursor) {
             // Kick drum
             case 0:
-                gfxPrint(1, 55, Proportion(_tone_kick, BNC_MAX_PARAM, 30) + 30);
+                gfxPrint(1, 55, Proportion<BNC_MAX_PARAM>(_tone_kick, 30) + 30);
                 gfxIcon(22, 54, HERTZ_ICON);
                 break;
             case 1:
@@ -387,7 +387,7 @@ private:
 
             // Snare drum
             case 5:
-                gfxPrint(35, 55, Proportion(_tone_snare, BNC_MAX_PARAM, 600) + 100);
+                gfxPrint(35, 55, Proportion<BNC_MAX_PARAM>(_tone_snare, 600) + 100);
                 gfxIcon(54, 54, HERTZ_ICON);
                 break;
             case 6:
@@ -415,11 +415,11 @@ private:
         const int8_t hmin = 6;
         const int8_t hmax = 16;
 
-        int8_t w = Proportion(decay, BNC_MAX_PARAM, wmax - wmin) + wmin;
-        int8_t h = Proportion(punch, BNC_MAX_PARAM, hmax - hmin) + hmin;
+        int8_t w = Proportion<BNC_MAX_PARAM>(decay, wmax - wmin) + wmin;
+        int8_t h = Proportion<BNC_MAX_PARAM>(punch, hmax - hmin) + hmin;
         int8_t body_h = (2*h/hmin - 1) + hmin - 2;
-        int8_t r = Proportion(pdecay, BNC_MAX_PARAM, body_h);
-        int8_t y = 40 - Proportion(tone, BNC_MAX_PARAM, 18);
+        int8_t r = Proportion<BNC_MAX_PARAM>(pdecay, body_h);
+        int8_t y = 40 - Proportion<BNC_MAX_PARAM>(tone, 18);
 
         int8_t cx = x + wmax/2;
         int8_t cy = y;
@@ -480,23 +480,23 @@ private:
 
     void SetEnvDecayKick(int decay) {
         // 100 ms - 1000 ms -> 10 Hz - 1 Hz
-        env_kick.SetFrequency(1000 - Proportion(decay, BNC_MAX_PARAM, 900));
+        env_kick.SetFrequency(1000 - Proportion<BNC_MAX_PARAM>(decay, 900));
     }
     void SetEnvDecayPunch(int decay) {
         // 25 ms - 200 ms -> 4000 cHz - 500 cHz
         env_punch.SetFrequency(
-            4000 - Proportion(decay, BNC_MAX_PARAM, 3500));
+            4000 - Proportion<BNC_MAX_PARAM>(decay, 3500));
     }
 
     void SetEnvDecaySnare(int decay) {
         // 50 ms - 1000 ms -> 20 Hz - 1 Hz
-        env_snare.SetFrequency(2000 - Proportion(decay, BNC_MAX_PARAM, 1900));
-        env_noise.SetFrequency(1000 - Proportion(decay, BNC_MAX_PARAM, 950));
+        env_snare.SetFrequency(2000 - Proportion<BNC_MAX_PARAM>(decay, 1900));
+        env_noise.SetFrequency(1000 - Proportion<BNC_MAX_PARAM>(decay, 950));
     }
     void SetEnvDecaySnap(int decay) {
         // 12.5 ms - 200 ms -> 80 Hz - 5 Hz
         env_snap.SetFrequency(
-            8000 - Proportion(decay, BNC_MAX_PARAM, 4000));
+            8000 - Proportion<BNC_MAX_PARAM>(decay, 4000));
     }
 };
 
@@ -509,13 +509,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-BugCrack BugCrack_instance[2];
-
-void BugCrack_Start(bool hemisphere) {BugCrack_instance[hemisphere].BaseStart(hemisphere);}
-void BugCrack_Controller(bool hemisphere, bool forwarding) {BugCrack_instance[hemisphere].BaseController(forwarding);}
-void BugCrack_View(bool hemisphere) {BugCrack_instance[hemisphere].BaseView();}
-void BugCrack_OnButtonPress(bool hemisphere) {BugCrack_instance[hemisphere].OnButtonPress();}
-void BugCrack_OnEncoderMove(bool hemisphere, int direction) {BugCrack_instance[hemisphere].OnEncoderMove(direction);}
-void BugCrack_ToggleHelpScreen(bool hemisphere) {BugCrack_instance[hemisphere].HelpScreen();}
-uint64_t BugCrack_OnDataRequest(bool hemisphere) {return BugCrack_instance[hemisphere].OnDataRequest();}
-void BugCrack_OnDataReceive(bool hemisphere, uint64_t data) {BugCrack_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(BugCrack)
+
+void BugCrack_Start(bool hemisphere) {hemisphere::ConstructInSlot<BugCrack>(hemisphere).BaseStart(hemisphere);}
+void BugCrack_Controller(bool hemisphere, bool forwarding) {BugCrack_instance(hemisphere).BaseController(forwarding);}
+void BugCrack_View(bool hemisphere) {BugCrack_instance(hemisphere).BaseView();}
+void BugCrack_OnButtonPress(bool hemisphere) {BugCrack_instance(hemisphere).OnButtonPress();}
+void BugCrack_OnEncoderMove(bool hemisphere, int direction) {BugCrack_instance(hemisphere).OnEncoderMove(direction);}
+void BugCrack_ToggleHelpScreen(bool hemisphere) {BugCrack_instance(hemisphere).HelpScreen();}
+uint64_t BugCrack_OnDataRequest(bool hemisphere) {return BugCrack_instance(hemisphere).OnDataRequest();}
+void BugCrack_OnDataReceive(bool hemisphere, uint64_t data) {BugCrack_instance(hemisphere).OnDataReceive(data);}
@@ -57,17 +57,17 @@ public:
             number = constrain(number, 1, HEM_BURST_NUMBER_MAX);
             last_number_cv_tick = oc::core::ticks;
         }
-        int spacing_mod = clocked ? 0 : Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, 500);
+        int spacing_mod = clocked ? 0 : Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), 500);
 
         // Get timing information
         if (Clock(0)) {
             if (clocked) {
                 // Get a tempo, if this is the second tick or later since the last clock
-                spacing = (ticks_since_clock / number) / 17;
-                ticks_since_clock = 0;
+                // The period is unsigned and can use all 32 bits
+                uint32_t period_ms = ClockPeriod(0) / (F_CPU / 1000);
+                spacing = min(period_ms / number, uint32_t(HEM_BURST_SPACING_MAX));
             } else clocked = 1;
         }
-        ticks_since_clock++;
 
         // Get spacing with clock division or multiplication calculated
         int effective_spacing = get_effective_spacing();
@@ -197,7 +197,6 @@ private:
     int burst_count; // How many bursts have passed
     bool clocked; // When a clock signal is received at Digital 1, clocked is activated, and the
                   // spacing of a new burst is number/clock length.
-    int ticks_since_clock; // When clocked, this is the time since the last clock.
     int last_number_cv_tick; // The last time the number was changed via CV. This is used to
                              // decide whether the ADC delay should be used when clocks come in.
 
@@ -269,36 +268,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Burst Burst_instance[2];
+DECLARE_APPLET_INSTANCE(Burst)
 
 void Burst_Start(bool hemisphere) {
-    Burst_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Burst>(hemisphere).BaseStart(hemisphere);
 }
 
 void Burst_Controller(bool hemisphere, bool forwarding) {
-    Burst_instance[hemisphere].BaseController(forwarding);
+    Burst_instance(hemisphere).BaseController(forwarding);
 }
 
 void Burst_View(bool hemisphere) {
-    Burst_instance[hemisphere].BaseView();
+    Burst_instance(hemisphere).BaseView();
 }
 
 void Burst_OnButtonPress(bool hemisphere) {
-    Burst_instance[hemisphere].OnButtonPress();
+    Burst_instance(hemisphere).OnButtonPress();
 }
 
 void Burst_OnEncoderMove(bool hemisphere, int direction) {
-    Burst_instance[hemisphere].OnEncoderMove(direction);
+    Burst_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Burst_ToggleHelpScreen(bool hemisphere) {
-    Burst_instance[hemisphere].HelpScreen();
+    Burst_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Burst_OnDataRequest(bool hemisphere) {
-    return Burst_instance[hemisphere].OnDataRequest();
+    return Burst_instance(hemisphere).OnDataRequest();
 }
 
 void Burst_OnDataReceive(bool hemisphere, uint64_t data) {
-    Burst_instance[hemisphere].OnDataReceive(data);
+    Burst_instance(hemisphere).OnDataReceive(data);
 }
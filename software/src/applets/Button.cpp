@@ -146,13 +146,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Button Button_instance[2];
-
-void Button_Start(bool hemisphere) {Button_instance[hemisphere].BaseStart(hemisphere);}
-void Button_Controller(bool hemisphere, bool forwarding) {Button_instance[hemisphere].BaseController(forwarding);}
-void Button_View(bool hemisphere) {Button_instance[hemisphere].BaseView();}
-void Button_OnButtonPress(bool hemisphere) {Button_instance[hemisphere].OnButtonPress();}
-void Button_OnEncoderMove(bool hemisphere, int direction) {Button_instance[hemisphere].OnEncoderMove(direction);}
-void Button_ToggleHelpScreen(bool hemisphere) {Button_instance[hemisphere].HelpScreen();}
-uint64_t Button_OnDataRequest(bool hemisphere) {return Button_instance[hemisphere].OnDataRequest();}
-void Button_OnDataReceive(bool hemisphere, uint64_t data) {Button_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Button)
+
+void Button_Start(bool hemisphere) {hemisphere::ConstructInSlot<Button>(hemisphere).BaseStart(hemisphere);}
+void Button_Controller(bool hemisphere, bool forwarding) {Button_instance(hemisphere).BaseController(forwarding);}
+void Button_View(bool hemisphere) {Button_instance(hemisphere).BaseView();}
+void Button_OnButtonPress(bool hemisphere) {Button_instance(hemisphere).OnButtonPress();}
+void Button_OnEncoderMove(bool hemisphere, int direction) {Button_instance(hemisphere).OnEncoderMove(direction);}
+void Button_ToggleHelpScreen(bool hemisphere) {Button_instance(hemisphere).HelpScreen();}
+uint64_t Button_OnDataRequest(bool hemisphere) {return Button_instance(hemisphere).OnDataRequest();}
+void Button_OnDataReceive(bool hemisphere, uint64_t data) {Button_instance(hemisphere).OnDataReceive(data);}
@@ -230,13 +230,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-CVRecV2 CVRecV2_instance[2];
-
-void CVRecV2_Start(bool hemisphere) {CVRecV2_instance[hemisphere].BaseStart(hemisphere);}
-void CVRecV2_Controller(bool hemisphere, bool forwarding) {CVRecV2_instance[hemisphere].BaseController(forwarding);}
-void CVRecV2_View(bool hemisphere) {CVRecV2_instance[hemisphere].BaseView();}
-void CVRecV2_OnButtonPress(bool hemisphere) {CVRecV2_instance[hemisphere].OnButtonPress();}
-void CVRecV2_OnEncoderMove(bool hemisphere, int direction) {CVRecV2_instance[hemisphere].OnEncoderMove(direction);}
-void CVRecV2_ToggleHelpScreen(bool hemisphere) {CVRecV2_instance[hemisphere].HelpScreen();}
-uint64_t CVRecV2_OnDataRequest(bool hemisphere) {return CVRecV2_instance[hemisphere].OnDataRequest();}
-void CVRecV2_OnDataReceive(bool hemisphere, uint64_t data) {CVRecV2_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(CVRecV2)
+
+void CVRecV2_Start(bool hemisphere) {hemisphere::ConstructInSlot<CVRecV2>(hemisphere).BaseStart(hemisphere);}
+void CVRecV2_Controller(bool hemisphere, bool forwarding) {CVRecV2_instance(hemisphere).BaseController(forwarding);}
+void CVRecV2_View(bool hemisphere) {CVRecV2_instance(hemisphere).BaseView();}
+void CVRecV2_OnButtonPress(bool hemisphere) {CVRecV2_instance(hemisphere).OnButtonPress();}
+void CVRecV2_OnEncoderMove(bool hemisphere, int direction) {CVRecV2_instance(hemisphere).OnEncoderMove(direction);}
+void CVRecV2_ToggleHelpScreen(bool hemisphere) {CVRecV2_instance(hemisphere).HelpScreen();}
+uint64_t CVRecV2_OnDataRequest(bool hemisphere) {return CVRecV2_instance(hemisphere).OnDataRequest();}
+void CVRecV2_OnDataReceive(bool hemisphere, uint64_t data) {CVRecV2_instance(hemisphere).OnDataReceive(data);}
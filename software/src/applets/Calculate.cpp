@@ -142,36 +142,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Calculate Calculate_instance[2];
+DECLARE_APPLET_INSTANCE(Calculate)
 
 void Calculate_Start(bool hemisphere) {
-    Calculate_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Calculate>(hemisphere).BaseStart(hemisphere);
 }
 
 void Calculate_Controller(bool hemisphere, bool forwarding) {
-    Calculate_instance[hemisphere].BaseController(forwarding);
+    Calculate_instance(hemisphere).BaseController(forwarding);
 }
 
 void Calculate_View(bool hemisphere) {
-    Calculate_instance[hemisphere].BaseView();
+    Calculate_instance(hemisphere).BaseView();
 }
 
 void Calculate_OnButtonPress(bool hemisphere) {
-    Calculate_instance[hemisphere].OnButtonPress();
+    Calculate_instance(hemisphere).OnButtonPress();
 }
 
 void Calculate_OnEncoderMove(bool hemisphere, int direction) {
-    Calculate_instance[hemisphere].OnEncoderMove(direction);
+    Calculate_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Calculate_ToggleHelpScreen(bool hemisphere) {
-    Calculate_instance[hemisphere].HelpScreen();
+    Calculate_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Calculate_OnDataRequest(bool hemisphere) {
-    return Calculate_instance[hemisphere].OnDataRequest();
+    return Calculate_instance(hemisphere).OnDataRequest();
 }
 
 void Calculate_OnDataReceive(bool hemisphere, uint64_t data) {
-    Calculate_instance[hemisphere].OnDataReceive(data);
+    Calculate_instance(hemisphere).OnDataReceive(data);
 }
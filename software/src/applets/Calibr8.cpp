@@ -182,13 +182,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Calibr8 Calibr8_instance[2];
-
-void Calibr8_Start(bool hemisphere) {Calibr8_instance[hemisphere].BaseStart(hemisphere);}
-void Calibr8_Controller(bool hemisphere, bool forwarding) {Calibr8_instance[hemisphere].BaseController(forwarding);}
-void Calibr8_View(bool hemisphere) {Calibr8_instance[hemisphere].BaseView();}
-void Calibr8_OnButtonPress(bool hemisphere) {Calibr8_instance[hemisphere].OnButtonPress();}
-void Calibr8_OnEncoderMove(bool hemisphere, int direction) {Calibr8_instance[hemisphere].OnEncoderMove(direction);}
-void Calibr8_ToggleHelpScreen(bool hemisphere) {Calibr8_instance[hemisphere].HelpScreen();}
-uint64_t Calibr8_OnDataRequest(bool hemisphere) {return Calibr8_instance[hemisphere].OnDataRequest();}
-void Calibr8_OnDataReceive(bool hemisphere, uint64_t data) {Calibr8_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Calibr8)
+
+void Calibr8_Start(bool hemisphere) {hemisphere::ConstructInSlot<Calibr8>(hemisphere).BaseStart(hemisphere);}
+void Calibr8_Controller(bool hemisphere, bool forwarding) {Calibr8_instance(hemisphere).BaseController(forwarding);}
+void Calibr8_View(bool hemisphere) {Calibr8_instance(hemisphere).BaseView();}
+void Calibr8_OnButtonPress(bool hemisphere) {Calibr8_instance(hemisphere).OnButtonPress();}
+void Calibr8_OnEncoderMove(bool hemisphere, int direction) {Calibr8_instance(hemisphere).OnEncoderMove(direction);}
+void Calibr8_ToggleHelpScreen(bool hemisphere) {Calibr8_instance(hemisphere).HelpScreen();}
+uint64_t Calibr8_OnDataRequest(bool hemisphere) {return Calibr8_instance(hemisphere).OnDataRequest();}
+void Calibr8_OnDataReceive(bool hemisphere, uint64_t data) {Calibr8_instance(hemisphere).OnDataReceive(data);}
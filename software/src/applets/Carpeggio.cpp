@@ -276,36 +276,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Carpeggio Carpeggio_instance[2];
+DECLARE_APPLET_INSTANCE(Carpeggio)
 
 void Carpeggio_Start(bool hemisphere) {
-    Carpeggio_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Carpeggio>(hemisphere).BaseStart(hemisphere);
 }
 
 void Carpeggio_Controller(bool hemisphere, bool forwarding) {
-    Carpeggio_instance[hemisphere].BaseController(forwarding);
+    Carpeggio_instance(hemisphere).BaseController(forwarding);
 }
 
 void Carpeggio_View(bool hemisphere) {
-    Carpeggio_instance[hemisphere].BaseView();
+    Carpeggio_instance(hemisphere).BaseView();
 }
 
 void Carpeggio_OnButtonPress(bool hemisphere) {
-    Carpeggio_instance[hemisphere].OnButtonPress();
+    Carpeggio_instance(hemisphere).OnButtonPress();
 }
 
 void Carpeggio_OnEncoderMove(bool hemisphere, int direction) {
-    Carpeggio_instance[hemisphere].OnEncoderMove(direction);
+    Carpeggio_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Carpeggio_ToggleHelpScreen(bool hemisphere) {
-    Carpeggio_instance[hemisphere].HelpScreen();
+    Carpeggio_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Carpeggio_OnDataRequest(bool hemisphere) {
-    return Carpeggio_instance[hemisphere].OnDataRequest();
+    return Carpeggio_instance(hemisphere).OnDataRequest();
 }
 
 void Carpeggio_OnDataReceive(bool hemisphere, uint64_t data) {
-    Carpeggio_instance[hemisphere].OnDataReceive(data);
+    Carpeggio_instance(hemisphere).OnDataReceive(data);
 }
@@ -209,36 +209,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Chordinator Chordinator_instance[2];
+DECLARE_APPLET_INSTANCE(Chordinator)
 
 void Chordinator_Start(bool hemisphere) {
-  Chordinator_instance[hemisphere].BaseStart(hemisphere);
+  hemisphere::ConstructInSlot<Chordinator>(hemisphere).BaseStart(hemisphere);
 }
 
 void Chordinator_Controller(bool hemisphere, bool forwarding) {
-  Chordinator_instance[hemisphere].BaseController(forwarding);
+  Chordinator_instance(hemisphere).BaseController(forwarding);
 }
 
 void Chordinator_View(bool hemisphere) {
-  Chordinator_instance[hemisphere].BaseView();
+  Chordinator_instance(hemisphere).BaseView();
 }
 
 void Chordinator_OnButtonPress(bool hemisphere) {
-  Chordinator_instance[hemisphere].OnButtonPress();
+  Chordinator_instance(hemisphere).OnButtonPress();
 }
 
 void Chordinator_OnEncoderMove(bool hemisphere, int direction) {
-  Chordinator_instance[hemisphere].OnEncoderMove(direction);
+  Chordinator_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Chordinator_ToggleHelpScreen(bool hemisphere) {
-  Chordinator_instance[hemisphere].HelpScreen();
+  Chordinator_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Chordinator_OnDataRequest(bool hemisphere) {
-  return Chordinator_instance[hemisphere].OnDataRequest();
+  return Chordinator_instance(hemisphere).OnDataRequest();
 }
 
 void Chordinator_OnDataReceive(bool hemisphere, uint64_t data) {
-  Chordinator_instance[hemisphere].OnDataReceive(data);
+  Chordinator_instance(hemisphere).OnDataReceive(data);
 }
@@ -33,14 +33,18 @@ public:
     void Start() { }
 
     void Controller() {
-        int this_tick = oc::core::ticks;
+        // Multiplied clocks are scheduled in cycles relative to the input edge,
+        // so they don't pick up the input's jitter against the tick
+        ForEachChannel(ch) {
+            if (div[ch] < 0) next_clock[ch] -= oc::DigitalInputs::kCyclesPerTick;
+        }
 
         // Set division via CV
         ForEachChannel(ch)
         {
             int input = DetentedIn(ch);
             if (input) {
-                div[ch] = Proportion(input, HEMISPHERE_MAX_INPUT_CV / 2, HEM_CLOCKDIV_MAX);
+                div[ch] = Proportion<HEMISPHERE_MAX_INPUT_CV / 2>(input, HEM_CLOCKDIV_MAX);
                 div[ch] = constrain(div[ch], -HEM_CLOCKDIV_MAX, HEM_CLOCKDIV_MAX);
                 if (div[ch] == 0 || div[ch] == -1) div[ch] = 1;
             }
@@ -52,7 +56,7 @@ public:
 
         // The input was clocked; set timing info
         if (Clock(0)) {
-        		cycle_time = ClockCycleTicks(0);
+            cycle_time = ClockPeriod(0);
             // At the clock input, handle clock division
             ForEachChannel(ch)
             {
@@ -62,8 +66,8 @@ public:
                     if (count[ch] >= div[ch]) count[ch] = 0; // Reset on last step
                 } else {
                     // Calculate next clock for multiplication on each clock
-                    int clock_every = (cycle_time / -div[ch]);
-                    next_clock[ch] = this_tick + clock_every;
+                    int64_t clock_every = cycle_time / -div[ch];
+                    next_clock[ch] = clock_every - ClockOffset(0);
                     ClockOut(ch); // Sync
                 }
             }
@@ -73,9 +77,11 @@ public:
         ForEachChannel(ch)
         {
             if (div[ch] < 0) { // Negative value indicates clock multiplication
-                if (this_tick >= next_clock[ch]) {
-                    int clock_every = (cycle_time / -div[ch]);
+                if (next_clock[ch] <= 0) {
+                    int64_t clock_every = cycle_time / -div[ch];
                     next_clock[ch] += clock_every;
+                    // Faster than the tick rate, don't try to catch up
+                    if (next_clock[ch] < 0) next_clock[ch] = 0;
                     ClockOut(ch);
                 }
             }
@@ -128,9 +134,11 @@ protected:
 private:
     int div[2] = {1, 2}; // Division data for outputs. Positive numbers are divisions, negative numbers are multipliers
     int count[2] = {0,0}; // Number of clocks since last output (for clock divide)
-    int next_clock[2] = {0,0}; // Tick number for the next output (for clock multiply)
+    // Cycles until the next output (for clock multiply). A clock period can
+    // use all 32 bits, so this and the period are kept wider than int
+    int64_t next_clock[2] = {0,0};
     int cursor = 0; // Which output is currently being edited
-    int cycle_time = 0; // Cycle time between the last two clock inputs
+    uint32_t cycle_time = 0; // Cycles between the last two clock inputs
 
     void DrawSelector() {
         ForEachChannel(ch)
@@ -161,36 +169,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ClockDivider ClockDivider_instance[2];
+DECLARE_APPLET_INSTANCE(ClockDivider)
 
 void ClockDivider_Start(bool hemisphere) {
-    ClockDivider_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<ClockDivider>(hemisphere).BaseStart(hemisphere);
 }
 
 void ClockDivider_Controller(bool hemisphere, bool forwarding) {
-    ClockDivider_instance[hemisphere].BaseController(forwarding);
+    ClockDivider_instance(hemisphere).BaseController(forwarding);
 }
 
 void ClockDivider_View(bool hemisphere) {
-    ClockDivider_instance[hemisphere].BaseView();
+    ClockDivider_instance(hemisphere).BaseView();
 }
 
 void ClockDivider_OnButtonPress(bool hemisphere) {
-    ClockDivider_instance[hemisphere].OnButtonPress();
+    ClockDivider_instance(hemisphere).OnButtonPress();
 }
 
 void ClockDivider_OnEncoderMove(bool hemisphere, int direction) {
-    ClockDivider_instance[hemisphere].OnEncoderMove(direction);
+    ClockDivider_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void ClockDivider_ToggleHelpScreen(bool hemisphere) {
-    ClockDivider_instance[hemisphere].HelpScreen();
+    ClockDivider_instance(hemisphere).HelpScreen();
 }
 
 uint64_t ClockDivider_OnDataRequest(bool hemisphere) {
-    return ClockDivider_instance[hemisphere].OnDataRequest();
+    return ClockDivider_instance(hemisphere).OnDataRequest();
 }
 
 void ClockDivider_OnDataReceive(bool hemisphere, uint64_t data) {
-    ClockDivider_instance[hemisphere].OnDataReceive(data);
+    ClockDivider_instance(hemisphere).OnDataReceive(data);
 }
@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include "hemisphere/applet_base.hpp"
+#include "oc/midi_out.h"
 using namespace hemisphere;
 
 class ClockSetup : public AppletBase {
@@ -29,6 +30,7 @@ public:
         FORWARDING,
         EXT_PPQN,
         TEMPO,
+        SYNC_BANDWIDTH,
         MULT1,
         MULT2,
         MULT3,
@@ -50,13 +52,13 @@ public:
     void Controller() {
         if (start_q){
             start_q = 0;
-            usbMIDI.sendRealTime(usbMIDI.Start);
+            oc::MidiOut::SendRealTime(usbMIDI.Start);
         }
         if (stop_q){
             stop_q = 0;
-            usbMIDI.sendRealTime(usbMIDI.Stop);
+            oc::MidiOut::SendRealTime(usbMIDI.Stop);
         }
-        if (clock_m->IsRunning() && clock_m->MIDITock()) usbMIDI.sendRealTime(usbMIDI.Clock);
+        if (clock_m->IsRunning() && clock_m->MIDITock()) oc::MidiOut::SendRealTime(usbMIDI.Clock);
 
         // 4 internal clock flashers
         for (int i = 0; i < 4; ++i) {
@@ -134,6 +136,9 @@ public:
         case TEMPO:
             clock_m->SetTempoBPM(clock_m->GetTempo() + direction);
             break;
+        case SYNC_BANDWIDTH:
+            clock_m->SetSyncBandwidth(clock_m->GetSyncBandwidth() + direction);
+            break;
 
         case MULT1:
         case MULT2:
@@ -155,6 +160,7 @@ public:
         for (size_t i = 0; i < 4; ++i) {
             Pack(data, PackLocation { 16+i*6, 6 }, clock_m->GetMultiply(i)+32);
         }
+        Pack(data, PackLocation { 40, 3 }, clock_m->GetSyncBandwidth());
 
         // other config settings are kept here as well, it's convenient
         Pack(data, PackLocation { 50, 2 }, AppletBase::modal_edit_mode);
@@ -177,6 +183,9 @@ public:
         for (size_t i = 0; i < 4; ++i) {
             clock_m->SetMultiply(Unpack(data, PackLocation { 16+i*6, 6 })-32, i);
         }
+        // 0 from before there was a setting
+        int bandwidth = Unpack(data, PackLocation { 40, 3 });
+        clock_m->SetSyncBandwidth(bandwidth ? bandwidth : CLOCK_SYNC_BANDWIDTH_DEFAULT);
 
         AppletBase::modal_edit_mode = Unpack(data, PackLocation { 50, 2 });
         AppletBase::trig_length = constrain( Unpack(data, PackLocation { 52, 7 }), 1, 127);
@@ -248,6 +257,10 @@ private:
         gfxPrint(pad(100, clock_m->GetTempo()), clock_m->GetTempo());
         gfxPrint(" BPM");
 
+        // External clock sync loop bandwidth
+        gfxPrint(64, 26, "Sync ");
+        gfxPrint(clock_m->GetSyncBandwidth());
+
         for (int ch=0; ch<4; ++ch) {
             int mult = clock_m->GetMultiply(ch);
             int x = ch * 32;
@@ -274,6 +287,10 @@ private:
             gfxCursor(22, 34, 18);
             break;
 
+        case SYNC_BANDWIDTH:
+            gfxCursor(94, 34, 6);
+            break;
+
         case MULT1:
         case MULT2:
         case MULT3:
@@ -314,3 +331,9 @@ void ClockSetup_OnEncoderMove(bool hemisphere, int direction) {ClockSetup_instan
 void ClockSetup_ToggleHelpScreen(bool hemisphere) {ClockSetup_instance[hemisphere].HelpScreen();}
 uint64_t ClockSetup_OnDataRequest(bool hemisphere) {return ClockSetup_instance[hemisphere].OnDataRequest();}
 void ClockSetup_OnDataReceive(bool hemisphere, uint64_t data) {ClockSetup_instance[hemisphere].OnDataReceive(data);}
+// The clock data has its own 64 bits in the preset, but no blob
+uint8_t ClockSetup_OnBlobRequest(bool hemisphere, util::BitWriter &blob) {return 0;}
+void ClockSetup_OnBlobReceive(bool hemisphere, uint8_t version, util::BitReader &blob) {}
+// Always resident rather than in an applet slot, so there's nothing to unload
+void ClockSetup_Unload(bool hemisphere) {}
+size_t ClockSetup_SizeOf() {return sizeof(ClockSetup);}
@@ -40,7 +40,7 @@ public:
         ForEachChannel(ch)
         {
             if (Clock(ch)) {
-                int prob = p[ch] + Proportion(DetentedIn(ch), HEMISPHERE_MAX_INPUT_CV, 100);
+                int prob = p[ch] + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(ch), 100);
                 if (random(1, 100) <= prob) {
                     ClockOut(ch);
                     trigger_countdown[ch] = 1667;
@@ -124,36 +124,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ClockSkip ClockSkip_instance[2];
+DECLARE_APPLET_INSTANCE(ClockSkip)
 
 void ClockSkip_Start(bool hemisphere) {
-    ClockSkip_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<ClockSkip>(hemisphere).BaseStart(hemisphere);
 }
 
 void ClockSkip_Controller(bool hemisphere, bool forwarding) {
-    ClockSkip_instance[hemisphere].BaseController(forwarding);
+    ClockSkip_instance(hemisphere).BaseController(forwarding);
 }
 
 void ClockSkip_View(bool hemisphere) {
-    ClockSkip_instance[hemisphere].BaseView();
+    ClockSkip_instance(hemisphere).BaseView();
 }
 
 void ClockSkip_OnButtonPress(bool hemisphere) {
-    ClockSkip_instance[hemisphere].OnButtonPress();
+    ClockSkip_instance(hemisphere).OnButtonPress();
 }
 
 void ClockSkip_OnEncoderMove(bool hemisphere, int direction) {
-    ClockSkip_instance[hemisphere].OnEncoderMove(direction);
+    ClockSkip_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void ClockSkip_ToggleHelpScreen(bool hemisphere) {
-    ClockSkip_instance[hemisphere].HelpScreen();
+    ClockSkip_instance(hemisphere).HelpScreen();
 }
 
 uint64_t ClockSkip_OnDataRequest(bool hemisphere) {
-    return ClockSkip_instance[hemisphere].OnDataRequest();
+    return ClockSkip_instance(hemisphere).OnDataRequest();
 }
 
 void ClockSkip_OnDataReceive(bool hemisphere, uint64_t data) {
-    ClockSkip_instance[hemisphere].OnDataReceive(data);
+    ClockSkip_instance(hemisphere).OnDataReceive(data);
 }
@@ -36,7 +36,7 @@ public:
     }
 
     void Controller() {
-        int cv_level = Proportion(level, HEM_COMPARE_MAX_VALUE, HEMISPHERE_MAX_CV);
+        int cv_level = Proportion<HEM_COMPARE_MAX_VALUE>(level, HEMISPHERE_MAX_CV);
         mod_cv = cv_level + DetentedIn(1);
         mod_cv = constrain(mod_cv, 0, HEMISPHERE_MAX_CV);
 
@@ -91,7 +91,7 @@ private:
     void DrawInterface() {
         // Draw currently-selected level
         gfxFrame(1, 15, 62, 6);
-        int x = Proportion(level, HEM_COMPARE_MAX_VALUE, 62);
+        int x = Proportion<HEM_COMPARE_MAX_VALUE>(level, 62);
         gfxLine(x, 15, x, 20);
 
         // Draw comparison
@@ -112,36 +112,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Compare Compare_instance[2];
+DECLARE_APPLET_INSTANCE(Compare)
 
 void Compare_Start(bool hemisphere) {
-    Compare_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Compare>(hemisphere).BaseStart(hemisphere);
 }
 
 void Compare_Controller(bool hemisphere, bool forwarding) {
-    Compare_instance[hemisphere].BaseController(forwarding);
+    Compare_instance(hemisphere).BaseController(forwarding);
 }
 
 void Compare_View(bool hemisphere) {
-    Compare_instance[hemisphere].BaseView();
+    Compare_instance(hemisphere).BaseView();
 }
 
 void Compare_OnButtonPress(bool hemisphere) {
-    Compare_instance[hemisphere].OnButtonPress();
+    Compare_instance(hemisphere).OnButtonPress();
 }
 
 void Compare_OnEncoderMove(bool hemisphere, int direction) {
-    Compare_instance[hemisphere].OnEncoderMove(direction);
+    Compare_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Compare_ToggleHelpScreen(bool hemisphere) {
-    Compare_instance[hemisphere].HelpScreen();
+    Compare_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Compare_OnDataRequest(bool hemisphere) {
-    return Compare_instance[hemisphere].OnDataRequest();
+    return Compare_instance(hemisphere).OnDataRequest();
 }
 
 void Compare_OnDataReceive(bool hemisphere, uint64_t data) {
-    Compare_instance[hemisphere].OnDataReceive(data);
+    Compare_instance(hemisphere).OnDataReceive(data);
 }
@@ -142,13 +142,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-DrCrusher DrCrusher_instance[2];
-
-void DrCrusher_Start(bool hemisphere) {DrCrusher_instance[hemisphere].BaseStart(hemisphere);}
-void DrCrusher_Controller(bool hemisphere, bool forwarding) {DrCrusher_instance[hemisphere].BaseController(forwarding);}
-void DrCrusher_View(bool hemisphere) {DrCrusher_instance[hemisphere].BaseView();}
-void DrCrusher_OnButtonPress(bool hemisphere) {DrCrusher_instance[hemisphere].OnButtonPress();}
-void DrCrusher_OnEncoderMove(bool hemisphere, int direction) {DrCrusher_instance[hemisphere].OnEncoderMove(direction);}
-void DrCrusher_ToggleHelpScreen(bool hemisphere) {DrCrusher_instance[hemisphere].HelpScreen();}
-uint64_t DrCrusher_OnDataRequest(bool hemisphere) {return DrCrusher_instance[hemisphere].OnDataRequest();}
-void DrCrusher_OnDataReceive(bool hemisphere, uint64_t data) {DrCrusher_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(DrCrusher)
+
+void DrCrusher_Start(bool hemisphere) {hemisphere::ConstructInSlot<DrCrusher>(hemisphere).BaseStart(hemisphere);}
+void DrCrusher_Controller(bool hemisphere, bool forwarding) {DrCrusher_instance(hemisphere).BaseController(forwarding);}
+void DrCrusher_View(bool hemisphere) {DrCrusher_instance(hemisphere).BaseView();}
+void DrCrusher_OnButtonPress(bool hemisphere) {DrCrusher_instance(hemisphere).OnButtonPress();}
+void DrCrusher_OnEncoderMove(bool hemisphere, int direction) {DrCrusher_instance(hemisphere).OnEncoderMove(direction);}
+void DrCrusher_ToggleHelpScreen(bool hemisphere) {DrCrusher_instance(hemisphere).HelpScreen();}
+uint64_t DrCrusher_OnDataRequest(bool hemisphere) {return DrCrusher_instance(hemisphere).OnDataRequest();}
+void DrCrusher_OnDataReceive(bool hemisphere, uint64_t data) {DrCrusher_instance(hemisphere).OnDataReceive(data);}
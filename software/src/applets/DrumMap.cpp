@@ -46,8 +46,8 @@ public:
     }
 
     void Controller() {
-        cv1 = Proportion(DetentedIn(0), HEMISPHERE_MAX_INPUT_CV, 255);
-        cv2 = Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, 255);
+        cv1 = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(0), 255);
+        cv2 = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), 255);
 
         int _fill[2] = {fill[0], fill[1]};
         if (cv_mode == 0) {
@@ -358,7 +358,7 @@ private:
     }
 
     void DrawKnobAt(byte x, byte y, byte len, byte value, bool is_cursor) {
-        byte w = Proportion(value, 255, len-1); // minus 1 because width is 2
+        byte w = Proportion<255>(value, len-1); // minus 1 because width is 2
         byte p = is_cursor ? 1 : 3;
         gfxDottedLine(x, y + 4, x + len, y + 4, p);
         gfxRect(x + w, y, 2, 8);
@@ -370,13 +370,13 @@ private:
     }
 };
 
-DrumMap DrumMap_instance[2];
+DECLARE_APPLET_INSTANCE(DrumMap)
 
-void DrumMap_Start(bool hemisphere) {DrumMap_instance[hemisphere].BaseStart(hemisphere);}
-void DrumMap_Controller(bool hemisphere, bool forwarding) {DrumMap_instance[hemisphere].BaseController(forwarding);}
-void DrumMap_View(bool hemisphere) {DrumMap_instance[hemisphere].BaseView();}
-void DrumMap_OnButtonPress(bool hemisphere) {DrumMap_instance[hemisphere].OnButtonPress();}
-void DrumMap_OnEncoderMove(bool hemisphere, int direction) {DrumMap_instance[hemisphere].OnEncoderMove(direction);}
-void DrumMap_ToggleHelpScreen(bool hemisphere) {DrumMap_instance[hemisphere].HelpScreen();}
-uint64_t DrumMap_OnDataRequest(bool hemisphere) {return DrumMap_instance[hemisphere].OnDataRequest();}
-void DrumMap_OnDataReceive(bool hemisphere, uint64_t data) {DrumMap_instance[hemisphere].OnDataReceive(data);}
+void DrumMap_Start(bool hemisphere) {hemisphere::ConstructInSlot<DrumMap>(hemisphere).BaseStart(hemisphere);}
+void DrumMap_Controller(bool hemisphere, bool forwarding) {DrumMap_instance(hemisphere).BaseController(forwarding);}
+void DrumMap_View(bool hemisphere) {DrumMap_instance(hemisphere).BaseView();}
+void DrumMap_OnButtonPress(bool hemisphere) {DrumMap_instance(hemisphere).OnButtonPress();}
+void DrumMap_OnEncoderMove(bool hemisphere, int direction) {DrumMap_instance(hemisphere).OnEncoderMove(direction);}
+void DrumMap_ToggleHelpScreen(bool hemisphere) {DrumMap_instance(hemisphere).HelpScreen();}
+uint64_t DrumMap_OnDataRequest(bool hemisphere) {return DrumMap_instance(hemisphere).OnDataRequest();}
+void DrumMap_OnDataReceive(bool hemisphere, uint64_t data) {DrumMap_instance(hemisphere).OnDataReceive(data);}
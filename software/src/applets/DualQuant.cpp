@@ -172,36 +172,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-DualQuant DualQuant_instance[2];
+DECLARE_APPLET_INSTANCE(DualQuant)
 
 void DualQuant_Start(bool hemisphere) {
-    DualQuant_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<DualQuant>(hemisphere).BaseStart(hemisphere);
 }
 
 void DualQuant_Controller(bool hemisphere, bool forwarding) {
-    DualQuant_instance[hemisphere].BaseController(forwarding);
+    DualQuant_instance(hemisphere).BaseController(forwarding);
 }
 
 void DualQuant_View(bool hemisphere) {
-    DualQuant_instance[hemisphere].BaseView();
+    DualQuant_instance(hemisphere).BaseView();
 }
 
 void DualQuant_OnButtonPress(bool hemisphere) {
-    DualQuant_instance[hemisphere].OnButtonPress();
+    DualQuant_instance(hemisphere).OnButtonPress();
 }
 
 void DualQuant_OnEncoderMove(bool hemisphere, int direction) {
-    DualQuant_instance[hemisphere].OnEncoderMove(direction);
+    DualQuant_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void DualQuant_ToggleHelpScreen(bool hemisphere) {
-    DualQuant_instance[hemisphere].HelpScreen();
+    DualQuant_instance(hemisphere).HelpScreen();
 }
 
 uint64_t DualQuant_OnDataRequest(bool hemisphere) {
-    return DualQuant_instance[hemisphere].OnDataRequest();
+    return DualQuant_instance(hemisphere).OnDataRequest();
 }
 
 void DualQuant_OnDataReceive(bool hemisphere, uint64_t data) {
-    DualQuant_instance[hemisphere].OnDataReceive(data);
+    DualQuant_instance(hemisphere).OnDataReceive(data);
 }
@@ -32,13 +32,13 @@ public:
             pitch_mod += In(ch);
             break;
         case SLOPE:
-            slope_mod += Proportion(DetentedIn(ch), HEMISPHERE_MAX_INPUT_CV, 127);
+            slope_mod += Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(ch), 127);
             break;
         case SHAPE:
-            shape_mod += Proportion(DetentedIn(ch), HEMISPHERE_MAX_INPUT_CV, 127);
+            shape_mod += Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(ch), 127);
             break;
         case FOLD:
-            fold_mod += Proportion(DetentedIn(ch), HEMISPHERE_MAX_INPUT_CV, 127);
+            fold_mod += Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(ch), 127);
             break;
         }
     }
@@ -63,10 +63,10 @@ public:
     ForEachChannel(ch) {
       switch (output(ch)) {
       case UNIPOLAR:
-        Out(ch, Proportion(sample.unipolar, 65535, HEMISPHERE_MAX_CV));
+        Out(ch, Proportion<65535>(sample.unipolar, HEMISPHERE_MAX_CV));
         break;
       case BIPOLAR:
-        Out(ch, Proportion(sample.bipolar, 32767, HEMISPHERE_MAX_CV / 2));
+        Out(ch, Proportion<32767>(sample.bipolar, HEMISPHERE_MAX_CV / 2));
         break;
       case EOA:
         GateOut(ch, eoa_reached);
@@ -84,33 +84,8 @@ public:
   void View() {
     gfxHeader(applet_name());
 
-    ForEachChannel(ch) {
-      int h = 17;
-      int bottom = 32 + (h + 1) * ch;
-      int last = bottom;
-      for (int i = 0; i < 64; i++) {
-        ProcessSample(slope_mod * 65535 / 127, shape_mod * 65535 / 127,
-                      fold_mod * 32767 / 127, 0xffffffff / 64 * i, disp_sample);
-        int next = 0;
-        switch (output(ch)) {
-        case UNIPOLAR:
-          next = bottom - disp_sample.unipolar * h / 65535;
-          break;
-        case BIPOLAR:
-          next = bottom - (disp_sample.bipolar + 32767) * h / 65535;
-          break;
-        case EOA:
-          next = bottom - ((disp_sample.flags & FLAG_EOA) ? h : 0);
-          break;
-        case EOR:
-          next = bottom - ((disp_sample.flags & FLAG_EOR) ? h : 0);
-          break;
-        }
-        if (i > 0) gfxLine(i - 1, last, i, next);
-        last = next;
-        // gfxPixel(i, 50 - disp_sample.unipolar * 35 / 65536);
-      }
-    }
+    RenderPreviews();
+    ForEachChannel(ch) gfxPreview(preview[ch]);
     uint32_t p = phase / (0xffffffff / 64);
     gfxLine(p, 15, p, 50);
 
@@ -265,6 +240,7 @@ private:
   uint8_t cv = 0b0001; // Freq on 1, shape on 2
   TidesLiteSample disp_sample;
   TidesLiteSample sample;
+  WaveformPreview<64> preview[2];
   bool eoa_reached = false;
 
   int knob_accel = 1 << 8;
@@ -279,6 +255,51 @@ private:
     return (CV) ((cv >> ((1 - ch) * 2)) & 0b11);
   }
 
+  // The previews only change with the shape parameters (after CV) and the
+  // output type, so the samples are only worked out again for a new
+  // combination, once for both channels.
+  void RenderPreviews() {
+    int slope_now = slope_mod;
+    int shape_now = shape_mod;
+    int fold_now = fold_mod;
+    uint32_t shape_key = (slope_now << 16) | (shape_now << 9) | (fold_now << 2);
+    bool stale[2];
+    ForEachChannel(ch) {
+      uint32_t key = shape_key | output(ch);
+      stale[ch] = preview[ch].Stale(key);
+      if (stale[ch]) preview[ch].Begin(key);
+    }
+    if (!stale[0] && !stale[1]) return;
+
+    int slope_scaled = slope_now * 65535 / 127;
+    int shape_scaled = shape_now * 65535 / 127;
+    int fold_scaled = fold_now * 32767 / 127;
+    const int h = 17;
+    for (int i = 0; i < 64; i++) {
+      ProcessSample(slope_scaled, shape_scaled, fold_scaled, 0xffffffff / 64 * i, disp_sample);
+      ForEachChannel(ch) {
+        if (!stale[ch]) continue;
+        int bottom = 32 + (h + 1) * ch;
+        int next = 0;
+        switch (output(ch)) {
+        case UNIPOLAR:
+          next = bottom - disp_sample.unipolar * h / 65535;
+          break;
+        case BIPOLAR:
+          next = bottom - (disp_sample.bipolar + 32767) * h / 65535;
+          break;
+        case EOA:
+          next = bottom - ((disp_sample.flags & FLAG_EOA) ? h : 0);
+          break;
+        case EOR:
+          next = bottom - ((disp_sample.flags & FLAG_EOR) ? h : 0);
+          break;
+        }
+        preview[ch].Add(i, next);
+      }
+    }
+  }
+
   void gfxPrintFreq(int16_t pitch) {
     uint32_t num = ComputePhaseIncrement(pitch);
     uint32_t denom = 0xffffffff / 16666;
@@ -324,36 +345,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EbbAndLfo EbbAndLfo_instance[2];
+DECLARE_APPLET_INSTANCE(EbbAndLfo)
 
 void EbbAndLfo_Start(bool hemisphere) {
-  EbbAndLfo_instance[hemisphere].BaseStart(hemisphere);
+  hemisphere::ConstructInSlot<EbbAndLfo>(hemisphere).BaseStart(hemisphere);
 }
 
 void EbbAndLfo_Controller(bool hemisphere, bool forwarding) {
-  EbbAndLfo_instance[hemisphere].BaseController(forwarding);
+  EbbAndLfo_instance(hemisphere).BaseController(forwarding);
 }
 
 void EbbAndLfo_View(bool hemisphere) {
-  EbbAndLfo_instance[hemisphere].BaseView();
+  EbbAndLfo_instance(hemisphere).BaseView();
 }
 
 void EbbAndLfo_OnButtonPress(bool hemisphere) {
-  EbbAndLfo_instance[hemisphere].OnButtonPress();
+  EbbAndLfo_instance(hemisphere).OnButtonPress();
 }
 
 void EbbAndLfo_OnEncoderMove(bool hemisphere, int direction) {
-  EbbAndLfo_instance[hemisphere].OnEncoderMove(direction);
+  EbbAndLfo_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void EbbAndLfo_ToggleHelpScreen(bool hemisphere) {
-  EbbAndLfo_instance[hemisphere].HelpScreen();
+  EbbAndLfo_instance(hemisphere).HelpScreen();
 }
 
 uint64_t EbbAndLfo_OnDataRequest(bool hemisphere) {
-  return EbbAndLfo_instance[hemisphere].OnDataRequest();
+  return EbbAndLfo_instance(hemisphere).OnDataRequest();
 }
 
 void EbbAndLfo_OnDataReceive(bool hemisphere, uint64_t data) {
-  EbbAndLfo_instance[hemisphere].OnDataReceive(data);
+  EbbAndLfo_instance(hemisphere).OnDataReceive(data);
 }
@@ -215,13 +215,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EnigmaJr EnigmaJr_instance[2];
-
-void EnigmaJr_Start(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseStart(hemisphere);}
-void EnigmaJr_Controller(bool hemisphere, bool forwarding) {EnigmaJr_instance[hemisphere].BaseController(forwarding);}
-void EnigmaJr_View(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseView();}
-void EnigmaJr_OnButtonPress(bool hemisphere) {EnigmaJr_instance[hemisphere].OnButtonPress();}
-void EnigmaJr_OnEncoderMove(bool hemisphere, int direction) {EnigmaJr_instance[hemisphere].OnEncoderMove(direction);}
-void EnigmaJr_ToggleHelpScreen(bool hemisphere) {EnigmaJr_instance[hemisphere].HelpScreen();}
-uint64_t EnigmaJr_OnDataRequest(bool hemisphere) {return EnigmaJr_instance[hemisphere].OnDataRequest();}
-void EnigmaJr_OnDataReceive(bool hemisphere, uint64_t data) {EnigmaJr_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(EnigmaJr)
+
+void EnigmaJr_Start(bool hemisphere) {hemisphere::ConstructInSlot<EnigmaJr>(hemisphere).BaseStart(hemisphere);}
+void EnigmaJr_Controller(bool hemisphere, bool forwarding) {EnigmaJr_instance(hemisphere).BaseController(forwarding);}
+void EnigmaJr_View(bool hemisphere) {EnigmaJr_instance(hemisphere).BaseView();}
+void EnigmaJr_OnButtonPress(bool hemisphere) {EnigmaJr_instance(hemisphere).OnButtonPress();}
+void EnigmaJr_OnEncoderMove(bool hemisphere, int direction) {EnigmaJr_instance(hemisphere).OnEncoderMove(direction);}
+void EnigmaJr_ToggleHelpScreen(bool hemisphere) {EnigmaJr_instance(hemisphere).HelpScreen();}
+uint64_t EnigmaJr_OnDataRequest(bool hemisphere) {return EnigmaJr_instance(hemisphere).OnDataRequest();}
+void EnigmaJr_OnDataReceive(bool hemisphere, uint64_t data) {EnigmaJr_instance(hemisphere).OnDataReceive(data);}
@@ -194,13 +194,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EnvFollow EnvFollow_instance[2];
-
-void EnvFollow_Start(bool hemisphere) {EnvFollow_instance[hemisphere].BaseStart(hemisphere);}
-void EnvFollow_Controller(bool hemisphere, bool forwarding) {EnvFollow_instance[hemisphere].BaseController(forwarding);}
-void EnvFollow_View(bool hemisphere) {EnvFollow_instance[hemisphere].BaseView();}
-void EnvFollow_OnButtonPress(bool hemisphere) {EnvFollow_instance[hemisphere].OnButtonPress();}
-void EnvFollow_OnEncoderMove(bool hemisphere, int direction) {EnvFollow_instance[hemisphere].OnEncoderMove(direction);}
-void EnvFollow_ToggleHelpScreen(bool hemisphere) {EnvFollow_instance[hemisphere].HelpScreen();}
-uint64_t EnvFollow_OnDataRequest(bool hemisphere) {return EnvFollow_instance[hemisphere].OnDataRequest();}
-void EnvFollow_OnDataReceive(bool hemisphere, uint64_t data) {EnvFollow_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(EnvFollow)
+
+void EnvFollow_Start(bool hemisphere) {hemisphere::ConstructInSlot<EnvFollow>(hemisphere).BaseStart(hemisphere);}
+void EnvFollow_Controller(bool hemisphere, bool forwarding) {EnvFollow_instance(hemisphere).BaseController(forwarding);}
+void EnvFollow_View(bool hemisphere) {EnvFollow_instance(hemisphere).BaseView();}
+void EnvFollow_OnButtonPress(bool hemisphere) {EnvFollow_instance(hemisphere).OnButtonPress();}
+void EnvFollow_OnEncoderMove(bool hemisphere, int direction) {EnvFollow_instance(hemisphere).OnEncoderMove(direction);}
+void EnvFollow_ToggleHelpScreen(bool hemisphere) {EnvFollow_instance(hemisphere).HelpScreen();}
+uint64_t EnvFollow_OnDataRequest(bool hemisphere) {return EnvFollow_instance(hemisphere).OnDataRequest();}
+void EnvFollow_OnDataReceive(bool hemisphere, uint64_t data) {EnvFollow_instance(hemisphere).OnDataReceive(data);}
@@ -81,7 +81,7 @@ public:
             ForEachChannel(cv_ch) {
                 switch (cv_dest[cv_ch] - ch * LENGTH2) { // this is dumb, but efficient
                 case LENGTH1:
-                    actual_length[ch] = constrain(actual_length[ch] + Proportion(cv_data[cv_ch], HEMISPHERE_MAX_INPUT_CV, 31), 2, 32);
+                    actual_length[ch] = constrain(actual_length[ch] + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[cv_ch], 31), 2, 32);
 
                     if (actual_beats[ch] > actual_length[ch])
                         actual_beats[ch] = actual_length[ch];
@@ -92,13 +92,13 @@ public:
 
                     break;
                 case BEATS1:
-                    actual_beats[ch] = constrain(actual_beats[ch] + Proportion(cv_data[cv_ch], HEMISPHERE_MAX_INPUT_CV, actual_length[ch]), 0, actual_length[ch]);
+                    actual_beats[ch] = constrain(actual_beats[ch] + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[cv_ch], actual_length[ch]), 0, actual_length[ch]);
                     break;
                 case OFFSET1:
-                    actual_offset[ch] = constrain(actual_offset[ch] + Proportion(cv_data[cv_ch], HEMISPHERE_MAX_INPUT_CV, actual_length[ch] + actual_padding[ch]), 0, actual_length[ch] + padding[ch] - 1);
+                    actual_offset[ch] = constrain(actual_offset[ch] + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[cv_ch], actual_length[ch] + actual_padding[ch]), 0, actual_length[ch] + padding[ch] - 1);
                     break;
                 case PADDING1:
-                    actual_padding[ch] = constrain(actual_padding[ch] + Proportion(cv_data[cv_ch], HEMISPHERE_MAX_INPUT_CV, 32 - actual_length[ch]), 0, 32 - actual_length[ch]);
+                    actual_padding[ch] = constrain(actual_padding[ch] + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[cv_ch], 32 - actual_length[ch]), 0, 32 - actual_length[ch]);
                     if (actual_offset[ch] >= actual_length[ch] + actual_padding[ch])
                         actual_offset[ch] = actual_length[ch] + actual_padding[ch] - 1;
                     break;
@@ -311,36 +311,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-EuclidX EuclidX_instance[2];
+DECLARE_APPLET_INSTANCE(EuclidX)
 
 void EuclidX_Start(bool hemisphere) {
-    EuclidX_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<EuclidX>(hemisphere).BaseStart(hemisphere);
 }
 
 void EuclidX_Controller(bool hemisphere, bool forwarding) {
-    EuclidX_instance[hemisphere].BaseController(forwarding);
+    EuclidX_instance(hemisphere).BaseController(forwarding);
 }
 
 void EuclidX_View(bool hemisphere) {
-    EuclidX_instance[hemisphere].BaseView();
+    EuclidX_instance(hemisphere).BaseView();
 }
 
 void EuclidX_OnButtonPress(bool hemisphere) {
-    EuclidX_instance[hemisphere].OnButtonPress();
+    EuclidX_instance(hemisphere).OnButtonPress();
 }
 
 void EuclidX_OnEncoderMove(bool hemisphere, int direction) {
-    EuclidX_instance[hemisphere].OnEncoderMove(direction);
+    EuclidX_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void EuclidX_ToggleHelpScreen(bool hemisphere) {
-    EuclidX_instance[hemisphere].HelpScreen();
+    EuclidX_instance(hemisphere).HelpScreen();
 }
 
 uint64_t EuclidX_OnDataRequest(bool hemisphere) {
-    return EuclidX_instance[hemisphere].OnDataRequest();
+    return EuclidX_instance(hemisphere).OnDataRequest();
 }
 
 void EuclidX_OnDataReceive(bool hemisphere, uint64_t data) {
-    EuclidX_instance[hemisphere].OnDataReceive(data);
+    EuclidX_instance(hemisphere).OnDataReceive(data);
 }
@@ -35,7 +35,7 @@ public:
         if (Gate(1)) AddToBoard(tx, ty);
 
         int global_density_cv = Proportion(global_density, 1200 - (weight * 10), HEMISPHERE_MAX_CV);
-        int local_density_cv = Proportion(local_density, 225, HEMISPHERE_MAX_CV);
+        int local_density_cv = Proportion<225>(local_density, HEMISPHERE_MAX_CV);
         Out(0, constrain(global_density_cv, 0, HEMISPHERE_MAX_CV));
         Out(1, constrain(local_density_cv, 0, HEMISPHERE_MAX_CV));
     }
@@ -198,40 +198,40 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-GameOfLife GameOfLife_instance[2];
+DECLARE_APPLET_INSTANCE(GameOfLife)
 
 void GameOfLife_Start(bool hemisphere) {
-    GameOfLife_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<GameOfLife>(hemisphere).BaseStart(hemisphere);
 }
 
 void GameOfLife_Controller(bool hemisphere, bool forwarding) {
-    GameOfLife_instance[hemisphere].BaseController(forwarding);
+    GameOfLife_instance(hemisphere).BaseController(forwarding);
 }
 
 void GameOfLife_View(bool hemisphere) {
-    GameOfLife_instance[hemisphere].BaseView();
+    GameOfLife_instance(hemisphere).BaseView();
 }
 
 void GameOfLife_Screensaver(bool hemisphere) {
-    GameOfLife_instance[hemisphere].BaseScreensaverView();
+    GameOfLife_instance(hemisphere).BaseScreensaverView();
 }
 
 void GameOfLife_OnButtonPress(bool hemisphere) {
-    GameOfLife_instance[hemisphere].OnButtonPress();
+    GameOfLife_instance(hemisphere).OnButtonPress();
 }
 
 void GameOfLife_OnEncoderMove(bool hemisphere, int direction) {
-    GameOfLife_instance[hemisphere].OnEncoderMove(direction);
+    GameOfLife_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void GameOfLife_ToggleHelpScreen(bool hemisphere) {
-    GameOfLife_instance[hemisphere].HelpScreen();
+    GameOfLife_instance(hemisphere).HelpScreen();
 }
 
 uint64_t GameOfLife_OnDataRequest(bool hemisphere) {
-    return GameOfLife_instance[hemisphere].OnDataRequest();
+    return GameOfLife_instance(hemisphere).OnDataRequest();
 }
 
 void GameOfLife_OnDataReceive(bool hemisphere, uint64_t data) {
-    GameOfLife_instance[hemisphere].OnDataReceive(data);
+    GameOfLife_instance(hemisphere).OnDataReceive(data);
 }
@@ -45,7 +45,7 @@ public:
             ForEachChannel(ch)
             {
                 record(ch, Gate(ch));
-                int mod_time = Proportion(DetentedIn(ch), HEMISPHERE_MAX_INPUT_CV, 1000) + time[ch];
+                int mod_time = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(ch), 1000) + time[ch];
                 mod_time = constrain(mod_time, 0, 2000);
 
                 bool p = play(ch, mod_time);
@@ -155,36 +155,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-GateDelay GateDelay_instance[2];
+DECLARE_APPLET_INSTANCE(GateDelay)
 
 void GateDelay_Start(bool hemisphere) {
-    GateDelay_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<GateDelay>(hemisphere).BaseStart(hemisphere);
 }
 
 void GateDelay_Controller(bool hemisphere, bool forwarding) {
-    GateDelay_instance[hemisphere].BaseController(forwarding);
+    GateDelay_instance(hemisphere).BaseController(forwarding);
 }
 
 void GateDelay_View(bool hemisphere) {
-    GateDelay_instance[hemisphere].BaseView();
+    GateDelay_instance(hemisphere).BaseView();
 }
 
 void GateDelay_OnButtonPress(bool hemisphere) {
-    GateDelay_instance[hemisphere].OnButtonPress();
+    GateDelay_instance(hemisphere).OnButtonPress();
 }
 
 void GateDelay_OnEncoderMove(bool hemisphere, int direction) {
-    GateDelay_instance[hemisphere].OnEncoderMove(direction);
+    GateDelay_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void GateDelay_ToggleHelpScreen(bool hemisphere) {
-    GateDelay_instance[hemisphere].HelpScreen();
+    GateDelay_instance(hemisphere).HelpScreen();
 }
 
 uint64_t GateDelay_OnDataRequest(bool hemisphere) {
-    return GateDelay_instance[hemisphere].OnDataRequest();
+    return GateDelay_instance(hemisphere).OnDataRequest();
 }
 
 void GateDelay_OnDataReceive(bool hemisphere, uint64_t data) {
-    GateDelay_instance[hemisphere].OnDataReceive(data);
+    GateDelay_instance(hemisphere).OnDataReceive(data);
 }
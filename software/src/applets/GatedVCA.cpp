@@ -57,7 +57,7 @@ public:
 
     void OnEncoderMove(int direction) {
         amp_offset_pct = constrain(amp_offset_pct + direction, 0, 100);
-        amp_offset_cv = Proportion(amp_offset_pct, 100, HEMISPHERE_MAX_CV);
+        amp_offset_cv = Proportion<100>(amp_offset_pct, HEMISPHERE_MAX_CV);
     }
 
     uint64_t OnDataRequest() {
@@ -96,36 +96,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-GatedVCA GatedVCA_instance[2];
+DECLARE_APPLET_INSTANCE(GatedVCA)
 
 void GatedVCA_Start(bool hemisphere) {
-    GatedVCA_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<GatedVCA>(hemisphere).BaseStart(hemisphere);
 }
 
 void GatedVCA_Controller(bool hemisphere, bool forwarding) {
-    GatedVCA_instance[hemisphere].BaseController(forwarding);
+    GatedVCA_instance(hemisphere).BaseController(forwarding);
 }
 
 void GatedVCA_View(bool hemisphere) {
-    GatedVCA_instance[hemisphere].BaseView();
+    GatedVCA_instance(hemisphere).BaseView();
 }
 
 void GatedVCA_OnButtonPress(bool hemisphere) {
-    GatedVCA_instance[hemisphere].OnButtonPress();
+    GatedVCA_instance(hemisphere).OnButtonPress();
 }
 
 void GatedVCA_OnEncoderMove(bool hemisphere, int direction) {
-    GatedVCA_instance[hemisphere].OnEncoderMove(direction);
+    GatedVCA_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void GatedVCA_ToggleHelpScreen(bool hemisphere) {
-    GatedVCA_instance[hemisphere].HelpScreen();
+    GatedVCA_instance(hemisphere).HelpScreen();
 }
 
 uint64_t GatedVCA_OnDataRequest(bool hemisphere) {
-    return GatedVCA_instance[hemisphere].OnDataRequest();
+    return GatedVCA_instance(hemisphere).OnDataRequest();
 }
 
 void GatedVCA_OnDataReceive(bool hemisphere, uint64_t data) {
-    GatedVCA_instance[hemisphere].OnDataReceive(data);
+    GatedVCA_instance(hemisphere).OnDataReceive(data);
 }
@@ -139,13 +139,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ICONS ICONS_instance[2];
+DECLARE_APPLET_INSTANCE(ICONS)
 
-void ICONS_Start(bool hemisphere) {ICONS_instance[hemisphere].BaseStart(hemisphere);}
-void ICONS_Controller(bool hemisphere, bool forwarding) {ICONS_instance[hemisphere].BaseController(forwarding);}
-void ICONS_View(bool hemisphere) {ICONS_instance[hemisphere].BaseView();}
-void ICONS_OnButtonPress(bool hemisphere) {ICONS_instance[hemisphere].OnButtonPress();}
-void ICONS_OnEncoderMove(bool hemisphere, int direction) {ICONS_instance[hemisphere].OnEncoderMove(direction);}
-void ICONS_ToggleHelpScreen(bool hemisphere) {ICONS_instance[hemisphere].HelpScreen();}
-uint64_t ICONS_OnDataRequest(bool hemisphere) {return ICONS_instance[hemisphere].OnDataRequest();}
-void ICONS_OnDataReceive(bool hemisphere, uint64_t data) {ICONS_instance[hemisphere].OnDataReceive(data);}
+void ICONS_Start(bool hemisphere) {hemisphere::ConstructInSlot<ICONS>(hemisphere).BaseStart(hemisphere);}
+void ICONS_Controller(bool hemisphere, bool forwarding) {ICONS_instance(hemisphere).BaseController(forwarding);}
+void ICONS_View(bool hemisphere) {ICONS_instance(hemisphere).BaseView();}
+void ICONS_OnButtonPress(bool hemisphere) {ICONS_instance(hemisphere).OnButtonPress();}
+void ICONS_OnEncoderMove(bool hemisphere, int direction) {ICONS_instance(hemisphere).OnEncoderMove(direction);}
+void ICONS_ToggleHelpScreen(bool hemisphere) {ICONS_instance(hemisphere).HelpScreen();}
+uint64_t ICONS_OnDataRequest(bool hemisphere) {return ICONS_instance(hemisphere).OnDataRequest();}
+void ICONS_OnDataReceive(bool hemisphere, uint64_t data) {ICONS_instance(hemisphere).OnDataReceive(data);}
@@ -21,43 +21,53 @@
 #include "hemisphere/applet_base.hpp"
 using namespace hemisphere;
 
-#define HEM_LOFI_PCM_BUFFER_SIZE 2048
 #define HEM_LOFI_PCM_SPEED 4
+// Samples for a delay time of 100%, so the time doesn't depend on how much of
+// the pool this hemisphere gets. Shorter buffers cap it at their length.
+#define HEM_LOFI_PCM_TIME_SPAN 2048
 
 // #define CLIPLIMIT 32512
 #define CLIPLIMIT HEMISPHERE_3V_CV
 
-#define PCM_TO_CV(S) Proportion((int)S - 127, 128, CLIPLIMIT)
-#define CV_TO_PCM(S) Proportion(constrain(S, -CLIPLIMIT, CLIPLIMIT), CLIPLIMIT, 128) + 127
-
-uint8_t lofi_pcm_buffer[HEM_LOFI_PCM_BUFFER_SIZE];
+#define SAMPLE_TO_CV(S) Proportion<32767>(S, CLIPLIMIT)
+#define CV_TO_SAMPLE(S) Proportion<CLIPLIMIT>(constrain(S, -CLIPLIMIT, CLIPLIMIT), 32767)
 
 class LoFiPCM : public AppletBase {
 public:
-    // TODO: consider making a singleton class to manage/share buffers
-    const int length = HEM_LOFI_PCM_BUFFER_SIZE;
-
     const char* applet_name() { // Maximum 10 characters
         return "LoFi Echo";
     }
 
     void Start() {
         countdown = HEM_LOFI_PCM_SPEED;
-        // this might take too long, which causes crashes. It's not crucial.
-        //for (int i = 0; i < HEM_LOFI_PCM_BUFFER_SIZE; i++) lofi_pcm_buffer[i] = 127;
+        // Cleared a bit every tick from here on
+        delay.Init(delay_pool.Allocate(hemisphere, HEMISPHERE_DELAY_POOL_SIZE),
+                   util::DELAY_SAMPLE_8BIT);
         cursor = 1; //for gui
     }
 
+    ~LoFiPCM() {
+        delay_pool.Release(hemisphere);
+    }
+
     void Controller() {
+        delay.Tick();
+
         play = !Gate(0); // Continuously play unless gated
         fdbk_g = Gate(1) ? 100 : feedback; // Feedback = 100 when gated
 
         if (play) {
             if (--countdown == 0) {
-                if (++head >= length) {
-                    head = 0;
-                    //ClockOut(1);
+                uint32_t length = delay.length();
+                if (length != delay_length || dt_pct != delay_pct) {
+                    // Delay time as a number of samples, which only changes
+                    // with the setting or when the buffer gets too short
+                    delay_length = length;
+                    delay_pct = dt_pct;
+                    delay_offset = dt_pct * HEM_LOFI_PCM_TIME_SPAN / 100;
+                    if (delay_offset >= length) delay_offset = length - 1;
                 }
+                ++head;
 
                 int cv = SmoothedIn(0);
                 int cv2 = DetentedIn(1);
@@ -66,20 +76,17 @@ public:
                 cv = cv >> depth;
                 cv = cv << depth;
 
-                // int dt = dt_pct * length / 100; //convert delaytime to length in samples 
-                head_w = (head + length + dt_pct*length/100) % length; //have to add the extra length to keep modulo positive in case delaytime is neg
-
                 // mix input into the buffer ahead, respecting feedback
-                int fbmix = PCM_TO_CV(lofi_pcm_buffer[head]) * fdbk_g / 100 + cv;
-                lofi_pcm_buffer[head_w] = CV_TO_PCM(fbmix);
-                
-                rate_mod = constrain( rate + Proportion(cv2, HEMISPHERE_MAX_INPUT_CV, 32), 1, 64);
+                int fbmix = SAMPLE_TO_CV(delay.Read(head)) * fdbk_g / 100 + cv;
+                delay.Write(head + delay_offset, CV_TO_SAMPLE(fbmix));
+
+                rate_mod = constrain( rate + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv2, 32), 1, 64);
 
                 countdown = rate_mod;
             }
 
-            SmoothedOut(0, PCM_TO_CV(lofi_pcm_buffer[head]), (rate_mod+1)/2);
-            SmoothedOut(1, PCM_TO_CV(lofi_pcm_buffer[length-1 - head]), (rate_mod+1)/2); // reverse buffer!
+            SmoothedOut(0, SAMPLE_TO_CV(delay.Read(head)), (rate_mod+1)/2);
+            SmoothedOut(1, SAMPLE_TO_CV(delay.Read(~head)), (rate_mod+1)/2); // reverse buffer!
         }
     }
 
@@ -90,12 +97,12 @@ public:
     }
 
     void OnButtonPress() {
-        CursorAction(cursor, 3);
+        CursorAction(cursor, 4);
     }
 
     void OnEncoderMove(int direction) {
         if (!EditMode()) {
-            MoveCursor(cursor, direction, 3);
+            MoveCursor(cursor, direction, 4);
             return;
         }
 
@@ -112,6 +119,10 @@ public:
         case 3:
             depth = constrain(depth + direction, 0, 13);
             break;
+        case 4:
+            delay.set_format(static_cast<util::DelaySampleFormat>(
+                constrain(delay.format() + direction, 0, util::DELAY_SAMPLE_FORMAT_LAST - 1)));
+            break;
         }
     }
 
@@ -121,6 +132,7 @@ public:
         Pack(data, PackLocation {7,7}, feedback);
         Pack(data, PackLocation {14,5}, rate);
         Pack(data, PackLocation {19,4}, depth);
+        Pack(data, PackLocation {23,2}, delay.format());
         return data;
     }
 
@@ -129,6 +141,9 @@ public:
         feedback = Unpack(data, PackLocation {7,7});
         rate = Unpack(data, PackLocation {14,5});
         depth = Unpack(data, PackLocation {19,4});
+        int format = Unpack(data, PackLocation {23,2});
+        delay.set_format(static_cast<util::DelaySampleFormat>(
+            constrain(format, 0, util::DELAY_SAMPLE_FORMAT_LAST - 1)));
     }
 
 protected:
@@ -142,10 +157,13 @@ protected:
     }
     
 private:
+    util::DelayLine delay;
     bool play = 0; //play always on unless gated on Digital 1
-    uint16_t head = 0; // Location of read/play head
-    uint16_t head_w = 0; // Location of write/record head
-    int8_t dt_pct = 50; //delaytime as percentage of delayline buffer
+    uint32_t head = 0; // Location of read/play head; wraps in the delay line
+    uint32_t delay_offset = 0; // Write head position relative to head
+    uint32_t delay_length = 0; // Buffer length and
+    int8_t delay_pct = -1; // delay time that delay_offset is for
+    int8_t dt_pct = 50; //delaytime as percentage of HEM_LOFI_PCM_TIME_SPAN
     int8_t feedback = 50;
     int8_t fdbk_g = feedback;
     int8_t countdown = HEM_LOFI_PCM_SPEED;
@@ -156,15 +174,13 @@ private:
     
     void DrawWaveform() {
         int inc = rate_mod/2 + 1;
-        int pos = head - (inc * 31) - random(1,3); // Try to center the head
-        if (pos < 0) pos += length;
+        uint32_t pos = head - (inc * 31) - random(1,3); // Try to center the head
         for (int i = 0; i < 64; i++)
         {
-            int height = Proportion((int)lofi_pcm_buffer[pos]-127, 128, 16);
+            int height = delay.Read(pos) >> 11; // +/-16
             gfxLine(i, 46, i, 46+height);
 
             pos += inc;
-            if (pos >= length) pos -= length;
         }
     }
     
@@ -177,7 +193,7 @@ private:
             gfxPrint(4 + pad(100, dt_pct), 15, dt_pct);
             gfxPrint(36 + pad(1000, fdbk_g), 15, fdbk_g);
             gfxCursor(10 + 31 * cursor, 23, 20);
-        } else {
+        } else if (cursor < 4) {
             gfxIcon(0, 15, WAVEFORM_ICON);
             gfxIcon(8, 15, BURST_ICON);
             gfxIcon(22, 15, LEFT_RIGHT_ICON);
@@ -185,6 +201,12 @@ private:
             gfxIcon(42, 15, UP_DOWN_ICON);
             gfxPrint(50, 15, depth);
             gfxCursor(30 + (cursor-2)*20, 23, 14);
+        } else {
+            // Sample format and the echo length it gives, in samples
+            const char *formats[] = {"8bit", "uLaw", "16bit"};
+            gfxPrint(0, 15, formats[delay.format()]);
+            gfxPrint(36, 15, (int)delay.length());
+            gfxCursor(0, 23, 30);
         }
     }
 
@@ -199,36 +221,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-LoFiPCM LoFiPCM_instance[2];
+DECLARE_APPLET_INSTANCE(LoFiPCM)
 
 void LoFiPCM_Start(bool hemisphere) {
-    LoFiPCM_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<LoFiPCM>(hemisphere).BaseStart(hemisphere);
 }
 
 void LoFiPCM_Controller(bool hemisphere, bool forwarding) {
-    LoFiPCM_instance[hemisphere].BaseController(forwarding);
+    LoFiPCM_instance(hemisphere).BaseController(forwarding);
 }
 
 void LoFiPCM_View(bool hemisphere) {
-    LoFiPCM_instance[hemisphere].BaseView();
+    LoFiPCM_instance(hemisphere).BaseView();
 }
 
 void LoFiPCM_OnButtonPress(bool hemisphere) {
-    LoFiPCM_instance[hemisphere].OnButtonPress();
+    LoFiPCM_instance(hemisphere).OnButtonPress();
 }
 
 void LoFiPCM_OnEncoderMove(bool hemisphere, int direction) {
-    LoFiPCM_instance[hemisphere].OnEncoderMove(direction);
+    LoFiPCM_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void LoFiPCM_ToggleHelpScreen(bool hemisphere) {
-    LoFiPCM_instance[hemisphere].HelpScreen();
+    LoFiPCM_instance(hemisphere).HelpScreen();
 }
 
 uint64_t LoFiPCM_OnDataRequest(bool hemisphere) {
-    return LoFiPCM_instance[hemisphere].OnDataRequest();
+    return LoFiPCM_instance(hemisphere).OnDataRequest();
 }
 
 void LoFiPCM_OnDataReceive(bool hemisphere, uint64_t data) {
-    LoFiPCM_instance[hemisphere].OnDataReceive(data);
+    LoFiPCM_instance(hemisphere).OnDataReceive(data);
 }
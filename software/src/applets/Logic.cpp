@@ -151,36 +151,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Logic Logic_instance[2];
+DECLARE_APPLET_INSTANCE(Logic)
 
 void Logic_Start(bool hemisphere) {
-    Logic_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Logic>(hemisphere).BaseStart(hemisphere);
 }
 
 void Logic_Controller(bool hemisphere, bool forwarding) {
-    Logic_instance[hemisphere].BaseController(forwarding);
+    Logic_instance(hemisphere).BaseController(forwarding);
 }
 
 void Logic_View(bool hemisphere) {
-    Logic_instance[hemisphere].BaseView();
+    Logic_instance(hemisphere).BaseView();
 }
 
 void Logic_OnButtonPress(bool hemisphere) {
-    Logic_instance[hemisphere].OnButtonPress();
+    Logic_instance(hemisphere).OnButtonPress();
 }
 
 void Logic_OnEncoderMove(bool hemisphere, int direction) {
-    Logic_instance[hemisphere].OnEncoderMove(direction);
+    Logic_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Logic_ToggleHelpScreen(bool hemisphere) {
-    Logic_instance[hemisphere].HelpScreen();
+    Logic_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Logic_OnDataRequest(bool hemisphere) {
-    return Logic_instance[hemisphere].OnDataRequest();
+    return Logic_instance(hemisphere).OnDataRequest();
 }
 
 void Logic_OnDataReceive(bool hemisphere, uint64_t data) {
-    Logic_instance[hemisphere].OnDataReceive(data);
+    Logic_instance(hemisphere).OnDataReceive(data);
 }
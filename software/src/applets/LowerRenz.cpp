@@ -45,8 +45,8 @@ public:
 
     void Controller() {
         if (!Gate(1)) { // Freeze if gated
-            int freq_cv = Proportion(In(0), HEMISPHERE_MAX_INPUT_CV, 63);
-            int rho_cv = Proportion(In(1), HEMISPHERE_MAX_INPUT_CV, 31);
+            int freq_cv = Proportion<HEMISPHERE_MAX_INPUT_CV>(In(0), 63);
+            int rho_cv = Proportion<HEMISPHERE_MAX_INPUT_CV>(In(1), 31);
 
             int32_t freq_h = SCALE8_16(constrain(freq + freq_cv, 0, 255));
             freq_h = USAT16(freq_h);
@@ -59,8 +59,8 @@ public:
             lorenz_m->Process();
 
             // The scaling here is based on observation of the value range
-            int x = Proportion(lorenz_m->GetOut(0 + (hemisphere * 2)) - 17000, 25000, HEMISPHERE_MAX_CV);
-            int y = Proportion(lorenz_m->GetOut(1 + (hemisphere * 2)) - 17000, 25000, HEMISPHERE_MAX_CV);
+            int x = Proportion<25000>(lorenz_m->GetOut(0 + (hemisphere * 2)) - 17000, HEMISPHERE_MAX_CV);
+            int y = Proportion<25000>(lorenz_m->GetOut(1 + (hemisphere * 2)) - 17000, HEMISPHERE_MAX_CV);
 
             Out(0, x);
             Out(1, y);
@@ -146,36 +146,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-LowerRenz LowerRenz_instance[2];
+DECLARE_APPLET_INSTANCE(LowerRenz)
 
 void LowerRenz_Start(bool hemisphere) {
-    LowerRenz_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<LowerRenz>(hemisphere).BaseStart(hemisphere);
 }
 
 void LowerRenz_Controller(bool hemisphere, bool forwarding) {
-    LowerRenz_instance[hemisphere].BaseController(forwarding);
+    LowerRenz_instance(hemisphere).BaseController(forwarding);
 }
 
 void LowerRenz_View(bool hemisphere) {
-    LowerRenz_instance[hemisphere].BaseView();
+    LowerRenz_instance(hemisphere).BaseView();
 }
 
 void LowerRenz_OnButtonPress(bool hemisphere) {
-    LowerRenz_instance[hemisphere].OnButtonPress();
+    LowerRenz_instance(hemisphere).OnButtonPress();
 }
 
 void LowerRenz_OnEncoderMove(bool hemisphere, int direction) {
-    LowerRenz_instance[hemisphere].OnEncoderMove(direction);
+    LowerRenz_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void LowerRenz_ToggleHelpScreen(bool hemisphere) {
-    LowerRenz_instance[hemisphere].HelpScreen();
+    LowerRenz_instance(hemisphere).HelpScreen();
 }
 
 uint64_t LowerRenz_OnDataRequest(bool hemisphere) {
-    return LowerRenz_instance[hemisphere].OnDataRequest();
+    return LowerRenz_instance(hemisphere).OnDataRequest();
 }
 
 void LowerRenz_OnDataReceive(bool hemisphere, uint64_t data) {
-    LowerRenz_instance[hemisphere].OnDataReceive(data);
+    LowerRenz_instance(hemisphere).OnDataReceive(data);
 }
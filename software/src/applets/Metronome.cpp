@@ -117,13 +117,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Metronome Metronome_instance[2];
-
-void Metronome_Start(bool hemisphere) {Metronome_instance[hemisphere].BaseStart(hemisphere);}
-void Metronome_Controller(bool hemisphere, bool forwarding) {Metronome_instance[hemisphere].BaseController(forwarding);}
-void Metronome_View(bool hemisphere) {Metronome_instance[hemisphere].BaseView();}
-void Metronome_OnButtonPress(bool hemisphere) {Metronome_instance[hemisphere].OnButtonPress();}
-void Metronome_OnEncoderMove(bool hemisphere, int direction) {Metronome_instance[hemisphere].OnEncoderMove(direction);}
-void Metronome_ToggleHelpScreen(bool hemisphere) {Metronome_instance[hemisphere].HelpScreen();}
-uint64_t Metronome_OnDataRequest(bool hemisphere) {return Metronome_instance[hemisphere].OnDataRequest();}
-void Metronome_OnDataReceive(bool hemisphere, uint64_t data) {Metronome_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Metronome)
+
+void Metronome_Start(bool hemisphere) {hemisphere::ConstructInSlot<Metronome>(hemisphere).BaseStart(hemisphere);}
+void Metronome_Controller(bool hemisphere, bool forwarding) {Metronome_instance(hemisphere).BaseController(forwarding);}
+void Metronome_View(bool hemisphere) {Metronome_instance(hemisphere).BaseView();}
+void Metronome_OnButtonPress(bool hemisphere) {Metronome_instance(hemisphere).OnButtonPress();}
+void Metronome_OnEncoderMove(bool hemisphere, int direction) {Metronome_instance(hemisphere).OnEncoderMove(direction);}
+void Metronome_ToggleHelpScreen(bool hemisphere) {Metronome_instance(hemisphere).HelpScreen();}
+uint64_t Metronome_OnDataRequest(bool hemisphere) {return Metronome_instance(hemisphere).OnDataRequest();}
+void Metronome_OnDataReceive(bool hemisphere, uint64_t data) {Metronome_instance(hemisphere).OnDataReceive(data);}
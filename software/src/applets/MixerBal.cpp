@@ -38,11 +38,11 @@ public:
         int signal1 = In(0);
         int signal2 = In(1);
 
-        int mix1 = Proportion(balance, MIXER_MAX_VALUE, signal2)
-                 + Proportion(MIXER_MAX_VALUE - balance, MIXER_MAX_VALUE, signal1);
+        int mix1 = Proportion<MIXER_MAX_VALUE>(balance, signal2)
+                 + Proportion<MIXER_MAX_VALUE>(MIXER_MAX_VALUE - balance, signal1);
 
-        int mix2 = Proportion(balance, MIXER_MAX_VALUE, signal1)
-                 + Proportion(MIXER_MAX_VALUE - balance, MIXER_MAX_VALUE, signal2);
+        int mix2 = Proportion<MIXER_MAX_VALUE>(balance, signal1)
+                 + Proportion<MIXER_MAX_VALUE>(MIXER_MAX_VALUE - balance, signal2);
 
         Out(0, mix1);
         Out(1, mix2);
@@ -87,7 +87,7 @@ private:
     
     void DrawBalanceIndicator() {
         gfxFrame(1, 15, 62, 6);
-        int x = Proportion(balance, MIXER_MAX_VALUE, 62);
+        int x = Proportion<MIXER_MAX_VALUE>(balance, 62);
         gfxLine(x, 15, x, 20);
     }
 };
@@ -101,36 +101,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-MixerBal MixerBal_instance[2];
+DECLARE_APPLET_INSTANCE(MixerBal)
 
 void MixerBal_Start(bool hemisphere) {
-    MixerBal_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<MixerBal>(hemisphere).BaseStart(hemisphere);
 }
 
 void MixerBal_Controller(bool hemisphere, bool forwarding) {
-    MixerBal_instance[hemisphere].BaseController(forwarding);
+    MixerBal_instance(hemisphere).BaseController(forwarding);
 }
 
 void MixerBal_View(bool hemisphere) {
-    MixerBal_instance[hemisphere].BaseView();
+    MixerBal_instance(hemisphere).BaseView();
 }
 
 void MixerBal_OnButtonPress(bool hemisphere) {
-    MixerBal_instance[hemisphere].OnButtonPress();
+    MixerBal_instance(hemisphere).OnButtonPress();
 }
 
 void MixerBal_OnEncoderMove(bool hemisphere, int direction) {
-    MixerBal_instance[hemisphere].OnEncoderMove(direction);
+    MixerBal_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void MixerBal_ToggleHelpScreen(bool hemisphere) {
-    MixerBal_instance[hemisphere].HelpScreen();
+    MixerBal_instance(hemisphere).HelpScreen();
 }
 
 uint64_t MixerBal_OnDataRequest(bool hemisphere) {
-    return MixerBal_instance[hemisphere].OnDataRequest();
+    return MixerBal_instance(hemisphere).OnDataRequest();
 }
 
 void MixerBal_OnDataReceive(bool hemisphere, uint64_t data) {
-    MixerBal_instance[hemisphere].OnDataReceive(data);
+    MixerBal_instance(hemisphere).OnDataReceive(data);
 }
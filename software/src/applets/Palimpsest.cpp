@@ -41,14 +41,14 @@ public:
         // Handle CV modulation of compose and decompose
         effective_decompose = decompose;
         if (DetentedIn(0)) {
-            int mod = Proportion(In(0), HEMISPHERE_3V_CV, HEM_PALIMPSEST_MAX_VALUE / 2);
+            int mod = Proportion<HEMISPHERE_3V_CV>(In(0), HEM_PALIMPSEST_MAX_VALUE / 2);
             mod = constrain(mod, -(HEM_PALIMPSEST_MAX_VALUE / 2), HEM_PALIMPSEST_MAX_VALUE / 2);
             effective_decompose = constrain(decompose + mod, 0, HEM_PALIMPSEST_MAX_VALUE);
         }
 
         effective_compose = compose;
         if (DetentedIn(1)) {
-            int mod = Proportion(In(1), HEMISPHERE_3V_CV, HEM_PALIMPSEST_MAX_VALUE / 2);
+            int mod = Proportion<HEMISPHERE_3V_CV>(In(1), HEM_PALIMPSEST_MAX_VALUE / 2);
             mod = constrain(mod, -(HEM_PALIMPSEST_MAX_VALUE / 2), HEM_PALIMPSEST_MAX_VALUE / 2);
             effective_compose = constrain(compose + mod, 0, HEM_PALIMPSEST_MAX_VALUE);
         }
@@ -150,8 +150,8 @@ private:
     int decompose;
 
     void DrawControls() {
-        int comp_w = Proportion(effective_compose, HEM_PALIMPSEST_MAX_VALUE, 30);
-        int decomp_w = Proportion(effective_decompose, HEM_PALIMPSEST_MAX_VALUE, 30);
+        int comp_w = Proportion<HEM_PALIMPSEST_MAX_VALUE>(effective_compose, 30);
+        int decomp_w = Proportion<HEM_PALIMPSEST_MAX_VALUE>(effective_decompose, 30);
 
         gfxFrame(30 - decomp_w, 15, decomp_w, 7);
         gfxRect(32, 15, comp_w, 7);
@@ -189,36 +189,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Palimpsest Palimpsest_instance[2];
+DECLARE_APPLET_INSTANCE(Palimpsest)
 
 void Palimpsest_Start(bool hemisphere) {
-    Palimpsest_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Palimpsest>(hemisphere).BaseStart(hemisphere);
 }
 
 void Palimpsest_Controller(bool hemisphere, bool forwarding) {
-    Palimpsest_instance[hemisphere].BaseController(forwarding);
+    Palimpsest_instance(hemisphere).BaseController(forwarding);
 }
 
 void Palimpsest_View(bool hemisphere) {
-    Palimpsest_instance[hemisphere].BaseView();
+    Palimpsest_instance(hemisphere).BaseView();
 }
 
 void Palimpsest_OnButtonPress(bool hemisphere) {
-    Palimpsest_instance[hemisphere].OnButtonPress();
+    Palimpsest_instance(hemisphere).OnButtonPress();
 }
 
 void Palimpsest_OnEncoderMove(bool hemisphere, int direction) {
-    Palimpsest_instance[hemisphere].OnEncoderMove(direction);
+    Palimpsest_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Palimpsest_ToggleHelpScreen(bool hemisphere) {
-    Palimpsest_instance[hemisphere].HelpScreen();
+    Palimpsest_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Palimpsest_OnDataRequest(bool hemisphere) {
-    return Palimpsest_instance[hemisphere].OnDataRequest();
+    return Palimpsest_instance(hemisphere).OnDataRequest();
 }
 
 void Palimpsest_OnDataReceive(bool hemisphere, uint64_t data) {
-    Palimpsest_instance[hemisphere].OnDataReceive(data);
+    Palimpsest_instance(hemisphere).OnDataReceive(data);
 }
@@ -262,7 +262,7 @@ private:
 
     void DrawKnobAt(byte x, byte y, byte len, byte value, bool is_cursor) {
         byte p = is_cursor ? 1 : 3;
-        byte w = Proportion(value, HEM_PROB_DIV_MAX_WEIGHT, len-1);
+        byte w = Proportion<HEM_PROB_DIV_MAX_WEIGHT>(value, len-1);
         gfxDottedLine(x, y + 3, x + len, y + 3, p);
         gfxRect(x + w, y, 2, 7);
         if (EditMode() && is_cursor) gfxInvert(x-1, y, len+3, 7);
@@ -327,13 +327,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ProbabilityDivider ProbabilityDivider_instance[2];
-
-void ProbabilityDivider_Start(bool hemisphere) {ProbabilityDivider_instance[hemisphere].BaseStart(hemisphere);}
-void ProbabilityDivider_Controller(bool hemisphere, bool forwarding) {ProbabilityDivider_instance[hemisphere].BaseController(forwarding);}
-void ProbabilityDivider_View(bool hemisphere) {ProbabilityDivider_instance[hemisphere].BaseView();}
-void ProbabilityDivider_OnButtonPress(bool hemisphere) {ProbabilityDivider_instance[hemisphere].OnButtonPress();}
-void ProbabilityDivider_OnEncoderMove(bool hemisphere, int direction) {ProbabilityDivider_instance[hemisphere].OnEncoderMove(direction);}
-void ProbabilityDivider_ToggleHelpScreen(bool hemisphere) {ProbabilityDivider_instance[hemisphere].HelpScreen();}
-uint64_t ProbabilityDivider_OnDataRequest(bool hemisphere) {return ProbabilityDivider_instance[hemisphere].OnDataRequest();}
-void ProbabilityDivider_OnDataReceive(bool hemisphere, uint64_t data) {ProbabilityDivider_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(ProbabilityDivider)
+
+void ProbabilityDivider_Start(bool hemisphere) {hemisphere::ConstructInSlot<ProbabilityDivider>(hemisphere).BaseStart(hemisphere);}
+void ProbabilityDivider_Controller(bool hemisphere, bool forwarding) {ProbabilityDivider_instance(hemisphere).BaseController(forwarding);}
+void ProbabilityDivider_View(bool hemisphere) {ProbabilityDivider_instance(hemisphere).BaseView();}
+void ProbabilityDivider_OnButtonPress(bool hemisphere) {ProbabilityDivider_instance(hemisphere).OnButtonPress();}
+void ProbabilityDivider_OnEncoderMove(bool hemisphere, int direction) {ProbabilityDivider_instance(hemisphere).OnEncoderMove(direction);}
+void ProbabilityDivider_ToggleHelpScreen(bool hemisphere) {ProbabilityDivider_instance(hemisphere).HelpScreen();}
+uint64_t ProbabilityDivider_OnDataRequest(bool hemisphere) {return ProbabilityDivider_instance(hemisphere).OnDataRequest();}
+void ProbabilityDivider_OnDataReceive(bool hemisphere, uint64_t data) {ProbabilityDivider_instance(hemisphere).OnDataReceive(data);}
@@ -319,13 +319,13 @@ private:
     }
 };
 
-ProbabilityMelody ProbabilityMelody_instance[2];
-
-void ProbabilityMelody_Start(bool hemisphere) {ProbabilityMelody_instance[hemisphere].BaseStart(hemisphere);}
-void ProbabilityMelody_Controller(bool hemisphere, bool forwarding) {ProbabilityMelody_instance[hemisphere].BaseController(forwarding);}
-void ProbabilityMelody_View(bool hemisphere) {ProbabilityMelody_instance[hemisphere].BaseView();}
-void ProbabilityMelody_OnButtonPress(bool hemisphere) {ProbabilityMelody_instance[hemisphere].OnButtonPress();}
-void ProbabilityMelody_OnEncoderMove(bool hemisphere, int direction) {ProbabilityMelody_instance[hemisphere].OnEncoderMove(direction);}
-void ProbabilityMelody_ToggleHelpScreen(bool hemisphere) {ProbabilityMelody_instance[hemisphere].HelpScreen();}
-uint64_t ProbabilityMelody_OnDataRequest(bool hemisphere) {return ProbabilityMelody_instance[hemisphere].OnDataRequest();}
-void ProbabilityMelody_OnDataReceive(bool hemisphere, uint64_t data) {ProbabilityMelody_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(ProbabilityMelody)
+
+void ProbabilityMelody_Start(bool hemisphere) {hemisphere::ConstructInSlot<ProbabilityMelody>(hemisphere).BaseStart(hemisphere);}
+void ProbabilityMelody_Controller(bool hemisphere, bool forwarding) {ProbabilityMelody_instance(hemisphere).BaseController(forwarding);}
+void ProbabilityMelody_View(bool hemisphere) {ProbabilityMelody_instance(hemisphere).BaseView();}
+void ProbabilityMelody_OnButtonPress(bool hemisphere) {ProbabilityMelody_instance(hemisphere).OnButtonPress();}
+void ProbabilityMelody_OnEncoderMove(bool hemisphere, int direction) {ProbabilityMelody_instance(hemisphere).OnEncoderMove(direction);}
+void ProbabilityMelody_ToggleHelpScreen(bool hemisphere) {ProbabilityMelody_instance(hemisphere).HelpScreen();}
+uint64_t ProbabilityMelody_OnDataRequest(bool hemisphere) {return ProbabilityMelody_instance(hemisphere).OnDataRequest();}
+void ProbabilityMelody_OnDataReceive(bool hemisphere, uint64_t data) {ProbabilityMelody_instance(hemisphere).OnDataReceive(data);}
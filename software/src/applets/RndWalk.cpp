@@ -19,6 +19,7 @@
 // SOFTWARE.
 #include "hemisphere/applet_base.hpp"
 #include "oc/core.h"
+#include "util/fixed_point.h"
 using namespace hemisphere;
 
 #define PROB_UP 500
@@ -70,8 +71,8 @@ public:
             default:
                 break;
         }
-        int rangeCv = Proportion(In(0), HEMISPHERE_MAX_INPUT_CV, MAX_RANGE);
-        int stepCv = Proportion(In(1), HEMISPHERE_MAX_INPUT_CV, MAX_STEP);
+        int rangeCv = Proportion<HEMISPHERE_MAX_INPUT_CV>(In(0), MAX_RANGE);
+        int stepCv = Proportion<HEMISPHERE_MAX_INPUT_CV>(In(1), MAX_STEP);
         
         ForEachChannel(ch) {
             // OUTPUT
@@ -82,14 +83,14 @@ public:
                     continue;
                 }
                 int randInt = random(0, 1000);
-                int randStep = (float)(random(1, constrain(step+stepCv, 0, MAX_STEP)))/MAX_STEP*maxVal/2;
-                int rangeScaled = (int)( ((float)constrain(range + rangeCv, 0, MAX_RANGE))/MAX_RANGE * maxVal);
+                int randStep = Proportion<MAX_STEP>(random(1, constrain(step+stepCv, 0, MAX_STEP)), maxVal) / 2;
+                int rangeScaled = Proportion<MAX_RANGE>(constrain(range + rangeCv, 0, MAX_RANGE), maxVal);
                 currentVal[ch] += randStep * (((randInt > PROB_UP) && (currentVal[ch] < rangeScaled)) -
                                               ((randInt < PROB_DN) && (currentVal[ch] > -rangeScaled)));
             }
-            currentOut[ch] = alpha*currentOut[ch] + (1-alpha)*(float)currentVal[ch];
+            currentOut[ch] = util::OnePole<19>(currentOut[ch], util::ToQ<16>(currentVal[ch]), alpha);
 
-            Out(ch, constrain((int)currentOut[ch], -HEMISPHERE_MAX_CV, HEMISPHERE_MAX_CV));
+            Out(ch, constrain(util::RoundQ<16>(currentOut[ch]), -HEMISPHERE_MAX_CV, HEMISPHERE_MAX_CV));
         }
     }
 
@@ -186,12 +187,12 @@ private:
     uint8_t smoothness = 20; // 8 bits
     uint8_t cvRange = 3; // 2 bit
     uint8_t clkMod = 0; //not stored, used for clock division
-    float alpha; // not stored, used for smoothing
+    uint32_t alpha; // not stored, used for smoothing (Q19)
 
     // Runtime parameters
     // unsigned int rndSeed[2];
     int currentVal[2];
-    float currentOut[2];
+    int32_t currentOut[2]; // Q16
     int cursor; // 0=Y clk src, 1=Y clk div, 2=Range,  3=step, 4=Smoothnes
     
     void DrawDisplay() {
@@ -264,8 +265,9 @@ private:
         gfxPrint(55, 55, "y");
         ForEachChannel(ch) {
             int w = 0;
-            if (range > 0) {
-                w = (currentOut[ch]/((float)range/MAX_RANGE*maxVal))*31;
+            int rangeScaled = Proportion<MAX_RANGE>(range, maxVal);
+            if (rangeScaled > 0) {
+                w = util::RoundQ<16>(currentOut[ch]) * 31 / rangeScaled;
                 if (w > 31) {
                     w = 31;
                 }
@@ -283,8 +285,9 @@ private:
     }
 
     void UpdateAlpha() {
-        // Use log mapping for better feeling
-        alpha = log(1+smoothness)/log(1+MAX_SMOOTH);
+        // Use log mapping for better feeling: log2(1+smoothness)/log2(1+MAX_SMOOTH).
+        // log2(1+MAX_SMOOTH) is 8, so that's log2(1+smoothness) in Q19.
+        alpha = util::Log2Q16(1 + smoothness);
         // alpha = (float)smoothness/(float)MAX_SMOOTH;
     }
 };
@@ -298,36 +301,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-RndWalk RndWalk_instance[2];
+DECLARE_APPLET_INSTANCE(RndWalk)
 
 void RndWalk_Start(bool hemisphere) {
-    RndWalk_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<RndWalk>(hemisphere).BaseStart(hemisphere);
 }
 
 void RndWalk_Controller(bool hemisphere, bool forwarding) {
-    RndWalk_instance[hemisphere].BaseController(forwarding);
+    RndWalk_instance(hemisphere).BaseController(forwarding);
 }
 
 void RndWalk_View(bool hemisphere) {
-    RndWalk_instance[hemisphere].BaseView();
+    RndWalk_instance(hemisphere).BaseView();
 }
 
 void RndWalk_OnButtonPress(bool hemisphere) {
-    RndWalk_instance[hemisphere].OnButtonPress();
+    RndWalk_instance(hemisphere).OnButtonPress();
 }
 
 void RndWalk_OnEncoderMove(bool hemisphere, int direction) {
-    RndWalk_instance[hemisphere].OnEncoderMove(direction);
+    RndWalk_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void RndWalk_ToggleHelpScreen(bool hemisphere) {
-    RndWalk_instance[hemisphere].HelpScreen();
+    RndWalk_instance(hemisphere).HelpScreen();
 }
 
 uint64_t RndWalk_OnDataRequest(bool hemisphere) {
-    return RndWalk_instance[hemisphere].OnDataRequest();
+    return RndWalk_instance(hemisphere).OnDataRequest();
 }
 
 void RndWalk_OnDataReceive(bool hemisphere, uint64_t data) {
-    RndWalk_instance[hemisphere].OnDataReceive(data);
+    RndWalk_instance(hemisphere).OnDataReceive(data);
 }
@@ -41,8 +41,8 @@ public:
                 reg = (reg << 1) | b0;
             }
 
-            int rungle = Proportion(reg & 0x07, 0x07, HEMISPHERE_MAX_CV);
-            int rungle_tap = Proportion((reg >> 5) & 0x07, 0x07, HEMISPHERE_MAX_CV);
+            int rungle = Proportion<0x07>(reg & 0x07, HEMISPHERE_MAX_CV);
+            int rungle_tap = Proportion<0x07>((reg >> 5) & 0x07, HEMISPHERE_MAX_CV);
 
             Out(0, rungle);
             Out(1, rungle_tap);
@@ -96,13 +96,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-RunglBook RunglBook_instance[2];
+DECLARE_APPLET_INSTANCE(RunglBook)
 
-void RunglBook_Start(bool hemisphere) {RunglBook_instance[hemisphere].BaseStart(hemisphere);}
-void RunglBook_Controller(bool hemisphere, bool forwarding) {RunglBook_instance[hemisphere].BaseController(forwarding);}
-void RunglBook_View(bool hemisphere) {RunglBook_instance[hemisphere].BaseView();}
-void RunglBook_OnButtonPress(bool hemisphere) {RunglBook_instance[hemisphere].OnButtonPress();}
-void RunglBook_OnEncoderMove(bool hemisphere, int direction) {RunglBook_instance[hemisphere].OnEncoderMove(direction);}
-void RunglBook_ToggleHelpScreen(bool hemisphere) {RunglBook_instance[hemisphere].HelpScreen();}
-uint64_t RunglBook_OnDataRequest(bool hemisphere) {return RunglBook_instance[hemisphere].OnDataRequest();}
-void RunglBook_OnDataReceive(bool hemisphere, uint64_t data) {RunglBook_instance[hemisphere].OnDataReceive(data);}
+void RunglBook_Start(bool hemisphere) {hemisphere::ConstructInSlot<RunglBook>(hemisphere).BaseStart(hemisphere);}
+void RunglBook_Controller(bool hemisphere, bool forwarding) {RunglBook_instance(hemisphere).BaseController(forwarding);}
+void RunglBook_View(bool hemisphere) {RunglBook_instance(hemisphere).BaseView();}
+void RunglBook_OnButtonPress(bool hemisphere) {RunglBook_instance(hemisphere).OnButtonPress();}
+void RunglBook_OnEncoderMove(bool hemisphere, int direction) {RunglBook_instance(hemisphere).OnEncoderMove(direction);}
+void RunglBook_ToggleHelpScreen(bool hemisphere) {RunglBook_instance(hemisphere).HelpScreen();}
+uint64_t RunglBook_OnDataRequest(bool hemisphere) {return RunglBook_instance(hemisphere).OnDataRequest();}
+void RunglBook_OnDataReceive(bool hemisphere, uint64_t data) {RunglBook_instance(hemisphere).OnDataReceive(data);}
@@ -164,36 +164,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ScaleDuet ScaleDuet_instance[2];
+DECLARE_APPLET_INSTANCE(ScaleDuet)
 
 void ScaleDuet_Start(bool hemisphere) {
-    ScaleDuet_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<ScaleDuet>(hemisphere).BaseStart(hemisphere);
 }
 
 void ScaleDuet_Controller(bool hemisphere, bool forwarding) {
-    ScaleDuet_instance[hemisphere].BaseController(forwarding);
+    ScaleDuet_instance(hemisphere).BaseController(forwarding);
 }
 
 void ScaleDuet_View(bool hemisphere) {
-    ScaleDuet_instance[hemisphere].BaseView();
+    ScaleDuet_instance(hemisphere).BaseView();
 }
 
 void ScaleDuet_OnButtonPress(bool hemisphere) {
-    ScaleDuet_instance[hemisphere].OnButtonPress();
+    ScaleDuet_instance(hemisphere).OnButtonPress();
 }
 
 void ScaleDuet_OnEncoderMove(bool hemisphere, int direction) {
-    ScaleDuet_instance[hemisphere].OnEncoderMove(direction);
+    ScaleDuet_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void ScaleDuet_ToggleHelpScreen(bool hemisphere) {
-    ScaleDuet_instance[hemisphere].HelpScreen();
+    ScaleDuet_instance(hemisphere).HelpScreen();
 }
 
 uint64_t ScaleDuet_OnDataRequest(bool hemisphere) {
-    return ScaleDuet_instance[hemisphere].OnDataRequest();
+    return ScaleDuet_instance(hemisphere).OnDataRequest();
 }
 
 void ScaleDuet_OnDataReceive(bool hemisphere, uint64_t data) {
-    ScaleDuet_instance[hemisphere].OnDataReceive(data);
+    ScaleDuet_instance(hemisphere).OnDataReceive(data);
 }
@@ -162,36 +162,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Schmitt Schmitt_instance[2];
+DECLARE_APPLET_INSTANCE(Schmitt)
 
 void Schmitt_Start(bool hemisphere) {
-    Schmitt_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Schmitt>(hemisphere).BaseStart(hemisphere);
 }
 
 void Schmitt_Controller(bool hemisphere, bool forwarding) {
-    Schmitt_instance[hemisphere].BaseController(forwarding);
+    Schmitt_instance(hemisphere).BaseController(forwarding);
 }
 
 void Schmitt_View(bool hemisphere) {
-    Schmitt_instance[hemisphere].BaseView();
+    Schmitt_instance(hemisphere).BaseView();
 }
 
 void Schmitt_OnButtonPress(bool hemisphere) {
-    Schmitt_instance[hemisphere].OnButtonPress();
+    Schmitt_instance(hemisphere).OnButtonPress();
 }
 
 void Schmitt_OnEncoderMove(bool hemisphere, int direction) {
-    Schmitt_instance[hemisphere].OnEncoderMove(direction);
+    Schmitt_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Schmitt_ToggleHelpScreen(bool hemisphere) {
-    Schmitt_instance[hemisphere].HelpScreen();
+    Schmitt_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Schmitt_OnDataRequest(bool hemisphere) {
-    return Schmitt_instance[hemisphere].OnDataRequest();
+    return Schmitt_instance(hemisphere).OnDataRequest();
 }
 
 void Schmitt_OnDataReceive(bool hemisphere, uint64_t data) {
-    Schmitt_instance[hemisphere].OnDataReceive(data);
+    Schmitt_instance(hemisphere).OnDataReceive(data);
 }
@@ -19,9 +19,17 @@
 // SOFTWARE.
 
 #include "hemisphere/applet_base.hpp"
+#include "util/scope_capture.h"
 using namespace hemisphere;
 
 #define SCOPE_CURRENT_SETTING_TIMEOUT 50001
+#define SCOPE_FULL_SCREEN_MODE 5
+
+// Ticks per pixel column; 0 is synced to Digital 2
+static constexpr uint32_t scope_timebases[] = {
+    0, 1, 2, 4, 8, 16, 33, 83, 166, 333, 833, 1666, 4166
+};
+static constexpr int SCOPE_TIMEBASE_COUNT = sizeof(scope_timebases) / sizeof(scope_timebases[0]);
 
 class Scope : public AppletBase {
 public:
@@ -33,11 +41,16 @@ public:
     void Start() {
         last_bpm_tick = oc::core::ticks;
         bpm = 0;
-        sample_ticks = 320;
+        sync_ticks = 5;
+        timebase = 7;
+        trigger = util::SCOPE_TRIGGER_FREE;
+        level = 0;
         freeze = 0;
         last_scope_tick = 0;
         current_setting = 0;
         current_display = 0;
+        capture.Init(64, scope_timebases[timebase]);
+        SetFullScreen(false);
     }
 
     void Controller() {
@@ -49,11 +62,13 @@ public:
             if (bpm > 9999) bpm = 9999;
         }
 
-        if (Clock(1)) {
+        bool clock2 = Clock(1);
+        if (clock2) {
             if (last_scope_tick) {
+                // One cycle fills the screen
                 int cycle_ticks = oc::core::ticks - last_scope_tick;
-                sample_ticks = cycle_ticks / 64;
-                sample_ticks = constrain(sample_ticks, 2, 64000);
+                sync_ticks = cycle_ticks / (int)capture.width();
+                sync_ticks = constrain(sync_ticks, 1, 64000);
             }
             last_scope_tick = oc::core::ticks;
         }
@@ -61,57 +76,60 @@ public:
         if (!freeze) {
             last_cv = In((current_display & 1) == 1);
 
-            if (--sample_countdown < 1) {
-                sample_countdown = sample_ticks;
-                sample_num = LoopInt(++sample_num, 63);
-
-                for (int n = 0; n < 2; n++) {
-                  int sample = Proportion(In(n) + HEMISPHERE_MAX_INPUT_CV, 2*HEMISPHERE_MAX_INPUT_CV, 255);
-                  sample = constrain(sample, 0, 255);
-                  snapshot[n][sample_num] = (uint8_t)sample;
-                }
-            }
+            // Settings are changed by the UI, but only applied here
+            capture.set_width(current_display == SCOPE_FULL_SCREEN_MODE ? 128 : 64);
+            capture.set_ticks_per_column(timebase ? scope_timebases[timebase] : sync_ticks);
+            capture.set_trigger(static_cast<util::ScopeTrigger>(trigger), CVToSample(level));
+            capture.Sample(CVToSample(In(0)), CVToSample(In(1)), clock2);
 
             ForEachChannel(ch) Out(ch, In(ch));
         }
     }
 
     void View() {
+        if (current_display == SCOPE_FULL_SCREEN_MODE && FullScreen()) {
+            DrawFullScreen();
+            return;
+        }
+
         gfxHeader(applet_name());
         
         if(current_display == 4) {
-            DrawInput(-1);
+            DrawXY();
         } else {
             DrawBPM();
-            DrawInput((current_display & 2) == 2);
+            DrawInput(gfx_offset, 25, 28, (current_display & 2) == 2);
             PrintInput();
         }
         
-        DrawCurrentSetting();
+        DrawCurrentSetting(gfx_offset);
         if (freeze) {
             gfxInvert(0, 24, 64, 40);
         }
     }
 
     void OnButtonPress() {
-        if (current_setting == 2 && !EditMode()) // FREEZE button
+        if (current_setting == 4 && !EditMode()) // FREEZE button
             freeze = !freeze;
         else if (oc::core::ticks - last_encoder_move < SCOPE_CURRENT_SETTING_TIMEOUT) // params visible? toggle edit
-            CursorAction(current_setting, 2);
+            CursorAction(current_setting, 4);
         else // show params
             last_encoder_move = oc::core::ticks;
     }
 
     void OnEncoderMove(int direction) {
         if (!EditMode()) { // switch setting
-            MoveCursor(current_setting, direction, 2);
+            MoveCursor(current_setting, direction, 4);
         } else { // edit
             if(current_setting == 0) {
-                if (sample_ticks < 32) sample_ticks += direction;
-                else sample_ticks += direction * 10;
-                sample_ticks = constrain(sample_ticks, 2, 64000);
+                timebase = constrain(timebase + direction, 0, SCOPE_TIMEBASE_COUNT - 1);
             } else if(current_setting == 1) {
-                current_display = constrain(current_display + direction, 0, 4);
+                current_display = constrain(current_display + direction, 0, SCOPE_FULL_SCREEN_MODE);
+                SetFullScreen(current_display == SCOPE_FULL_SCREEN_MODE);
+            } else if(current_setting == 2) {
+                trigger = constrain(trigger + direction, 0, util::SCOPE_TRIGGER_LAST - 1);
+            } else if(current_setting == 3) {
+                level = constrain(level + direction * 128, -HEMISPHERE_MAX_INPUT_CV, HEMISPHERE_MAX_INPUT_CV);
             }
         }
         last_encoder_move = oc::core::ticks;
@@ -119,14 +137,20 @@ public:
         
     uint64_t OnDataRequest() {
         uint64_t data = 0;
-        // example: pack property_name at bit 0, with size of 8 bits
-        // Pack(data, PackLocation {0,8}, property_name); 
+        Pack(data, PackLocation {0,4}, timebase);
+        Pack(data, PackLocation {4,3}, current_display);
+        Pack(data, PackLocation {7,3}, trigger);
+        Pack(data, PackLocation {10,8}, level / 128 + 128);
         return data;
     }
 
     void OnDataReceive(uint64_t data) {
-        // example: unpack value at bit 0 with size of 8 bits to property_name
-        // property_name = Unpack(data, PackLocation {0,8}); 
+        timebase = constrain(Unpack(data, PackLocation {0,4}), 0, SCOPE_TIMEBASE_COUNT - 1);
+        current_display = constrain(Unpack(data, PackLocation {4,3}), 0, SCOPE_FULL_SCREEN_MODE);
+        trigger = constrain(Unpack(data, PackLocation {7,3}), 0, util::SCOPE_TRIGGER_LAST - 1);
+        level = constrain(((int)Unpack(data, PackLocation {10,8}) - 128) * 128,
+                          -HEMISPHERE_MAX_INPUT_CV, HEMISPHERE_MAX_INPUT_CV);
+        SetFullScreen(current_display == SCOPE_FULL_SCREEN_MODE);
     }
 
 protected:
@@ -151,17 +175,19 @@ private:
     // Scope
     int current_display;
     int current_setting;
-    uint8_t snapshot[2][64];
-    int sample_ticks; // Ticks between samples
-    int sample_countdown; // Last time a sample was taken
-    int sample_num; // Current sample number at the start
+    util::ScopeCapture<128> capture;
+    int timebase; // Index into scope_timebases
+    int sync_ticks; // Ticks per column when synced to Digital 2
+    int trigger; // util::ScopeTrigger
+    int level; // Trigger level
     int last_encoder_move; // The last the the sample_ticks value was changed
     int last_scope_tick; // Used to auto-calculate sample countdown
 
-    int LoopInt(int n, int max) {
-        return n > max ? 0 : n;
+    static uint8_t CVToSample(int cv) {
+        int sample = Proportion<2*HEMISPHERE_MAX_INPUT_CV>(cv + HEMISPHERE_MAX_INPUT_CV, 255);
+        return constrain(sample, 0, 255);
     }
-    
+
     void DrawBPM() {
         gfxPrint(9, 15, "BPM ");
         gfxPrint(bpm / 4);
@@ -170,14 +196,37 @@ private:
         if (oc::core::ticks - last_bpm_tick < 1666) gfxBitmap(1, 15, 8, CLOCK_ICON);
     }
 
-    void DrawCurrentSetting() {
+    void PrintTimebase() {
+        if (timebase == 0) {
+            gfxPrint("Clk2");
+            return;
+        }
+        // Length of the whole trace
+        uint32_t ms = scope_timebases[timebase] * capture.width() * OC_CORE_TIMER_RATE / 1000;
+        if (ms < 1000) {
+            gfxPrint((int)ms);
+            gfxPrint("ms");
+        } else {
+            gfxPrint((int)(ms / 1000));
+            gfxPrint(".");
+            gfxPrint((int)(ms / 100 % 10));
+            gfxPrint("s");
+        }
+    }
+
+    // Draws the setting being changed at screen x = left, so that the full
+    // screen view can put it at the left edge whichever side it belongs to
+    void DrawCurrentSetting(int left) {
         if (oc::core::ticks - last_encoder_move < SCOPE_CURRENT_SETTING_TIMEOUT) {
+            graphics.setPrintPos(left + 1, 26);
             if(current_setting == 0) {
-                gfxPrint(1, 26, "Rate");
-                gfxPrint(32, 26, sample_ticks);
+                gfxPrint("Time ");
+                PrintTimebase();
             } else if(current_setting == 1) {
-                gfxPrint(1, 26, "Mode ");
-                if(current_display == 4) {
+                gfxPrint("Mode ");
+                if(current_display == SCOPE_FULL_SCREEN_MODE) {
+                    gfxPrint("Full");
+                } else if(current_display == 4) {
                     gfxPrint("1,2");
                 } else {
                     gfxPrint((current_display & 2) == 2 ? 2 : 1);
@@ -185,11 +234,18 @@ private:
                     gfxPrint((current_display & 1) == 1 ? 2 : 1);
                 }
             } else if(current_setting == 2) {
-                gfxPrint(1, 26, "Freeze ");
+                const char *triggers[] = {"Free", "Rise", "Fall", "High", "Clk2"};
+                gfxPrint("Trig ");
+                gfxPrint(triggers[trigger]);
+            } else if(current_setting == 3) {
+                gfxPrint("Lvl ");
+                gfxPrintVoltage(level);
+            } else if(current_setting == 4) {
+                gfxPrint("Freeze ");
                 gfxPrint(freeze ? "ON" : "OFF");
             }
 
-            if (EditMode()) gfxInvert(1, 25, 31, 9);
+            if (EditMode()) graphics.invertRect(left + 1, 25, 31, 9);
         }
     }
 
@@ -200,24 +256,59 @@ private:
         gfxPrintVoltage(last_cv);
     }
 
-    void DrawInput(int input) {
-        int max = input < 0 ? 54 : 28;
-        for (int s = 0; s < 64; s++)
-        {
-            int n = s + sample_num;
-            int px, py;
-            if (n > 63) n -= 64;
-            if (input < 0) { // X-Y mode
-                px = Proportion(snapshot[0][n], 255, 63);
-                py = Proportion(snapshot[1][n], 255, max);
-                gfxPixel(px, constrain((max - py) + 10, 0, 63));
-            } else {
-                px = n;
-                py = Proportion(snapshot[input][n], 255, max);
-                gfxPixel(px, (max - py) + 24);
+    // Draws the last columns of an input into the area at (left, top), each
+    // joined up with the one before so that steep edges stay connected
+    void DrawInput(int left, int top, int height, int input, int columns = 64, bool dotted = false) {
+        if (columns > (int)capture.width()) columns = capture.width();
+        int first = capture.width() - columns;
+        int last_min = -1, last_max = -1;
+        for (int x = 0; x < columns; x++) {
+            util::ScopeColumn column = capture.column(input, first + x);
+            if (column.min > column.max) continue; // Not captured yet
+            int y_min = Proportion<255>(column.min, height - 1);
+            int y_max = Proportion<255>(column.max, height - 1);
+            int lo = y_min, hi = y_max;
+            if (last_min >= 0) {
+                if (lo > last_max) lo = last_max;
+                if (hi < last_min) hi = last_min;
             }
+            last_min = y_min;
+            last_max = y_max;
+
+            if (dotted && (x & 1)) continue;
+            graphics.drawVLine(left + x, top + height - 1 - hi, hi - lo + 1);
+        }
+
+        // Trigger point
+        int trigger_x = capture.width() / 4 - first;
+        if (trigger != util::SCOPE_TRIGGER_FREE && trigger_x >= 0)
+            graphics.drawVLine(left + trigger_x, top - 2, 2);
+    }
+
+    void DrawXY() {
+        for (int x = 0; x < 64; x++) {
+            util::ScopeColumn a = capture.column(0, x);
+            util::ScopeColumn b = capture.column(1, x);
+            if (a.min > a.max) continue;
+            int px = Proportion<255>((a.min + a.max) / 2, 63);
+            int py = Proportion<255>((b.min + b.max) / 2, 54);
+            gfxPixel(px, constrain((54 - py) + 10, 0, 63));
         }
     }
+
+    void DrawFullScreen() {
+        graphics.setPrintPos(1, 2);
+        graphics.print(applet_name());
+        graphics.setPrintPos(40, 2);
+        graphics.print(hemisphere ? "CV3/4" : "CV1/2");
+        graphics.drawHLine(0, 10, 128);
+
+        DrawInput(0, 14, 50, 0, 128);
+        DrawInput(0, 14, 50, 1, 128, true);
+
+        DrawCurrentSetting(0);
+        if (freeze) graphics.invertRect(0, 12, 128, 52);
+    }
 };
 
 
@@ -229,36 +320,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Scope Scope_instance[2];
+DECLARE_APPLET_INSTANCE(Scope)
 
 void Scope_Start(bool hemisphere) {
-    Scope_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Scope>(hemisphere).BaseStart(hemisphere);
 }
 
 void Scope_Controller(bool hemisphere, bool forwarding) {
-    Scope_instance[hemisphere].BaseController(forwarding);
+    Scope_instance(hemisphere).BaseController(forwarding);
 }
 
 void Scope_View(bool hemisphere) {
-    Scope_instance[hemisphere].BaseView();
+    Scope_instance(hemisphere).BaseView();
 }
 
 void Scope_OnButtonPress(bool hemisphere) {
-    Scope_instance[hemisphere].OnButtonPress();
+    Scope_instance(hemisphere).OnButtonPress();
 }
 
 void Scope_OnEncoderMove(bool hemisphere, int direction) {
-    Scope_instance[hemisphere].OnEncoderMove(direction);
+    Scope_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Scope_ToggleHelpScreen(bool hemisphere) {
-    Scope_instance[hemisphere].HelpScreen();
+    Scope_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Scope_OnDataRequest(bool hemisphere) {
-    return Scope_instance[hemisphere].OnDataRequest();
+    return Scope_instance(hemisphere).OnDataRequest();
 }
 
 void Scope_OnDataReceive(bool hemisphere, uint64_t data) {
-    Scope_instance[hemisphere].OnDataReceive(data);
+    Scope_instance(hemisphere).OnDataReceive(data);
 }
@@ -170,36 +170,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-SequenceX SequenceX_instance[2];
+DECLARE_APPLET_INSTANCE(SequenceX)
 
 void SequenceX_Start(bool hemisphere) {
-    SequenceX_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<SequenceX>(hemisphere).BaseStart(hemisphere);
 }
 
 void SequenceX_Controller(bool hemisphere, bool forwarding) {
-    SequenceX_instance[hemisphere].BaseController(forwarding);
+    SequenceX_instance(hemisphere).BaseController(forwarding);
 }
 
 void SequenceX_View(bool hemisphere) {
-    SequenceX_instance[hemisphere].BaseView();
+    SequenceX_instance(hemisphere).BaseView();
 }
 
 void SequenceX_OnButtonPress(bool hemisphere) {
-    SequenceX_instance[hemisphere].OnButtonPress();
+    SequenceX_instance(hemisphere).OnButtonPress();
 }
 
 void SequenceX_OnEncoderMove(bool hemisphere, int direction) {
-    SequenceX_instance[hemisphere].OnEncoderMove(direction);
+    SequenceX_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void SequenceX_ToggleHelpScreen(bool hemisphere) {
-    SequenceX_instance[hemisphere].HelpScreen();
+    SequenceX_instance(hemisphere).HelpScreen();
 }
 
 uint64_t SequenceX_OnDataRequest(bool hemisphere) {
-    return SequenceX_instance[hemisphere].OnDataRequest();
+    return SequenceX_instance(hemisphere).OnDataRequest();
 }
 
 void SequenceX_OnDataReceive(bool hemisphere, uint64_t data) {
-    SequenceX_instance[hemisphere].OnDataReceive(data);
+    SequenceX_instance(hemisphere).OnDataReceive(data);
 }
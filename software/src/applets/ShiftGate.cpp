@@ -139,13 +139,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-ShiftGate ShiftGate_instance[2];
-
-void ShiftGate_Start(bool hemisphere) {ShiftGate_instance[hemisphere].BaseStart(hemisphere);}
-void ShiftGate_Controller(bool hemisphere, bool forwarding) {ShiftGate_instance[hemisphere].BaseController(forwarding);}
-void ShiftGate_View(bool hemisphere) {ShiftGate_instance[hemisphere].BaseView();}
-void ShiftGate_OnButtonPress(bool hemisphere) {ShiftGate_instance[hemisphere].OnButtonPress();}
-void ShiftGate_OnEncoderMove(bool hemisphere, int direction) {ShiftGate_instance[hemisphere].OnEncoderMove(direction);}
-void ShiftGate_ToggleHelpScreen(bool hemisphere) {ShiftGate_instance[hemisphere].HelpScreen();}
-uint64_t ShiftGate_OnDataRequest(bool hemisphere) {return ShiftGate_instance[hemisphere].OnDataRequest();}
-void ShiftGate_OnDataReceive(bool hemisphere, uint64_t data) {ShiftGate_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(ShiftGate)
+
+void ShiftGate_Start(bool hemisphere) {hemisphere::ConstructInSlot<ShiftGate>(hemisphere).BaseStart(hemisphere);}
+void ShiftGate_Controller(bool hemisphere, bool forwarding) {ShiftGate_instance(hemisphere).BaseController(forwarding);}
+void ShiftGate_View(bool hemisphere) {ShiftGate_instance(hemisphere).BaseView();}
+void ShiftGate_OnButtonPress(bool hemisphere) {ShiftGate_instance(hemisphere).OnButtonPress();}
+void ShiftGate_OnEncoderMove(bool hemisphere, int direction) {ShiftGate_instance(hemisphere).OnEncoderMove(direction);}
+void ShiftGate_ToggleHelpScreen(bool hemisphere) {ShiftGate_instance(hemisphere).HelpScreen();}
+uint64_t ShiftGate_OnDataRequest(bool hemisphere) {return ShiftGate_instance(hemisphere).OnDataRequest();}
+void ShiftGate_OnDataReceive(bool hemisphere, uint64_t data) {ShiftGate_instance(hemisphere).OnDataReceive(data);}
@@ -259,10 +259,10 @@ private:
         gfxLine(44, 45+o, 44, 52+o); // zero line
         // 10 pixels for neg, 18 pixels for pos
         if (current[ch] > 0) {
-          int w = Proportion(current[ch], HEM_SHREDDER_POS_5V, 18);
+          int w = Proportion<HEM_SHREDDER_POS_5V>(current[ch], 18);
           gfxRect(45, 48+o, w, 2);
         } else {
-          int w = Proportion(-current[ch], HEM_SHREDDER_NEG_3V, 10);
+          int w = Proportion<HEM_SHREDDER_NEG_3V>(-current[ch], 10);
           gfxRect(44-w, 48+o, w, 2);
         }
       }
@@ -326,13 +326,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Shredder Shredder_instance[2];
-
-void Shredder_Start(bool hemisphere) {Shredder_instance[hemisphere].BaseStart(hemisphere);}
-void Shredder_Controller(bool hemisphere, bool forwarding) {Shredder_instance[hemisphere].BaseController(forwarding);}
-void Shredder_View(bool hemisphere) {Shredder_instance[hemisphere].BaseView();}
-void Shredder_OnButtonPress(bool hemisphere) {Shredder_instance[hemisphere].OnButtonPress();}
-void Shredder_OnEncoderMove(bool hemisphere, int direction) {Shredder_instance[hemisphere].OnEncoderMove(direction);}
-void Shredder_ToggleHelpScreen(bool hemisphere) {Shredder_instance[hemisphere].HelpScreen();}
-uint64_t Shredder_OnDataRequest(bool hemisphere) {return Shredder_instance[hemisphere].OnDataRequest();}
-void Shredder_OnDataReceive(bool hemisphere, uint64_t data) {Shredder_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Shredder)
+
+void Shredder_Start(bool hemisphere) {hemisphere::ConstructInSlot<Shredder>(hemisphere).BaseStart(hemisphere);}
+void Shredder_Controller(bool hemisphere, bool forwarding) {Shredder_instance(hemisphere).BaseController(forwarding);}
+void Shredder_View(bool hemisphere) {Shredder_instance(hemisphere).BaseView();}
+void Shredder_OnButtonPress(bool hemisphere) {Shredder_instance(hemisphere).OnButtonPress();}
+void Shredder_OnEncoderMove(bool hemisphere, int direction) {Shredder_instance(hemisphere).OnEncoderMove(direction);}
+void Shredder_ToggleHelpScreen(bool hemisphere) {Shredder_instance(hemisphere).HelpScreen();}
+uint64_t Shredder_OnDataRequest(bool hemisphere) {return Shredder_instance(hemisphere).OnDataRequest();}
+void Shredder_OnDataReceive(bool hemisphere, uint64_t data) {Shredder_instance(hemisphere).OnDataReceive(data);}
@@ -67,10 +67,10 @@ public:
             // Swing
             which = 1 - which;
             if (last_tick) {
-                tempo = tick - last_tick;
-                int16_t d = delay[which] + Proportion(DetentedIn(which), HEMISPHERE_MAX_INPUT_CV, 100);
+                tempo = ClockCycleTicks(0);
+                int16_t d = delay[which] + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(which), 100);
                 d = constrain(d, 0, 100);
-                uint32_t delay_ticks = Proportion(d, 100, tempo);
+                uint32_t delay_ticks = Proportion<100>(d, tempo);
                 next_trigger = tick + delay_ticks;
             }
             last_tick = tick;
@@ -148,7 +148,7 @@ private:
     void DrawSelector() {
         for (int i = 0; i < 2; i++)
         {
-            int16_t d = delay[i] + Proportion(DetentedIn(i), HEMISPHERE_MAX_INPUT_CV, 100);
+            int16_t d = delay[i] + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(i), 100);
             d = constrain(d, 0, 100);
             gfxPrint(32 + pad(10, d), 15 + (i * 10), d);
             gfxPrint("%");
@@ -156,12 +156,12 @@ private:
         }
 
         // Lines to the first parameter
-        int x = Proportion(delay[0], 100, 20) + 8;
+        int x = Proportion<100>(delay[0], 20) + 8;
         gfxDottedLine(x, 41, x, 19, 3);
         gfxDottedLine(x, 19, 30, 19, 3);
 
         // Line to the second parameter
-        gfxDottedLine(Proportion(delay[1], 100, 20) + 28, 45, 41, 33, 3);
+        gfxDottedLine(Proportion<100>(delay[1], 20) + 28, 45, 41, 33, 3);
     }
 
     void DrawIndicator() {
@@ -175,9 +175,9 @@ private:
 
         for (int n = 0; n < 2; n++)
         {
-            int16_t d = delay[n] + Proportion(DetentedIn(n), HEMISPHERE_MAX_INPUT_CV, 100);
+            int16_t d = delay[n] + Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(n), 100);
             d = constrain(d, 0, 100);
-            int x = Proportion(d, 100, 20) + (n * 20) + 4;
+            int x = Proportion<100>(d, 20) + (n * 20) + 4;
             gfxBitmap(x, 48 - (which == n ? 3 : 0), 8, which == n ? NOTE_ICON : X_NOTE_ICON);
         }
 
@@ -196,36 +196,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Shuffle Shuffle_instance[2];
+DECLARE_APPLET_INSTANCE(Shuffle)
 
 void Shuffle_Start(bool hemisphere) {
-    Shuffle_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Shuffle>(hemisphere).BaseStart(hemisphere);
 }
 
 void Shuffle_Controller(bool hemisphere, bool forwarding) {
-    Shuffle_instance[hemisphere].BaseController(forwarding);
+    Shuffle_instance(hemisphere).BaseController(forwarding);
 }
 
 void Shuffle_View(bool hemisphere) {
-    Shuffle_instance[hemisphere].BaseView();
+    Shuffle_instance(hemisphere).BaseView();
 }
 
 void Shuffle_OnButtonPress(bool hemisphere) {
-    Shuffle_instance[hemisphere].OnButtonPress();
+    Shuffle_instance(hemisphere).OnButtonPress();
 }
 
 void Shuffle_OnEncoderMove(bool hemisphere, int direction) {
-    Shuffle_instance[hemisphere].OnEncoderMove(direction);
+    Shuffle_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Shuffle_ToggleHelpScreen(bool hemisphere) {
-    Shuffle_instance[hemisphere].HelpScreen();
+    Shuffle_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Shuffle_OnDataRequest(bool hemisphere) {
-    return Shuffle_instance[hemisphere].OnDataRequest();
+    return Shuffle_instance(hemisphere).OnDataRequest();
 }
 
 void Shuffle_OnDataReceive(bool hemisphere, uint64_t data) {
-    Shuffle_instance[hemisphere].OnDataReceive(data);
+    Shuffle_instance(hemisphere).OnDataReceive(data);
 }
@@ -48,10 +48,10 @@ public:
                 simfloat remaining = input - signal[ch];
 
                 // The number of ticks it would take to get from 0 to HEMISPHERE_MAX_INPUT_CV
-                int max_change = Proportion(segment, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS);
+                int max_change = Proportion<HEM_SLEW_MAX_VALUE>(segment, HEM_SLEW_MAX_TICKS);
 
                 // The number of ticks it would take to move the remaining amount at max_change
-                int ticks_to_remaining = Proportion(simfloat2int(remaining), HEMISPHERE_MAX_INPUT_CV, max_change);
+                int ticks_to_remaining = Proportion<HEMISPHERE_MAX_INPUT_CV>(simfloat2int(remaining), max_change);
                 if (ticks_to_remaining < 0) ticks_to_remaining = -ticks_to_remaining;
 
                 simfloat delta;
@@ -79,11 +79,11 @@ public:
     void OnEncoderMove(int direction) {
         if (cursor == 0) {
             rise = constrain(rise + direction, 0, HEM_SLEW_MAX_VALUE);
-            last_ms_value = Proportion(rise, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS) / 17;
+            last_ms_value = Proportion<HEM_SLEW_MAX_VALUE>(rise, HEM_SLEW_MAX_TICKS) / 17;
         }
         else {
             fall = constrain(fall + direction, 0, HEM_SLEW_MAX_VALUE);
-            last_ms_value = Proportion(fall, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS) / 17;
+            last_ms_value = Proportion<HEM_SLEW_MAX_VALUE>(fall, HEM_SLEW_MAX_TICKS) / 17;
         }
         last_change_ticks = oc::core::ticks;
     }
@@ -120,11 +120,11 @@ private:
 
     void DrawIndicator() {
         // Rise portion
-        int r_x = Proportion(rise, 200, 31);
+        int r_x = Proportion<200>(rise, 31);
         gfxLine(0, 62, r_x, 33, cursor == 1);
 
         // Fall portion
-        int f_x = 62 - Proportion(fall, 200, 31);
+        int f_x = 62 - Proportion<200>(fall, 31);
         gfxLine(f_x, 33, 62, 62, cursor == 0);
 
         // Center portion, if necessary
@@ -154,36 +154,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Slew Slew_instance[2];
+DECLARE_APPLET_INSTANCE(Slew)
 
 void Slew_Start(bool hemisphere) {
-    Slew_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Slew>(hemisphere).BaseStart(hemisphere);
 }
 
 void Slew_Controller(bool hemisphere, bool forwarding) {
-    Slew_instance[hemisphere].BaseController(forwarding);
+    Slew_instance(hemisphere).BaseController(forwarding);
 }
 
 void Slew_View(bool hemisphere) {
-    Slew_instance[hemisphere].BaseView();
+    Slew_instance(hemisphere).BaseView();
 }
 
 void Slew_OnButtonPress(bool hemisphere) {
-    Slew_instance[hemisphere].OnButtonPress();
+    Slew_instance(hemisphere).OnButtonPress();
 }
 
 void Slew_OnEncoderMove(bool hemisphere, int direction) {
-    Slew_instance[hemisphere].OnEncoderMove(direction);
+    Slew_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Slew_ToggleHelpScreen(bool hemisphere) {
-    Slew_instance[hemisphere].HelpScreen();
+    Slew_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Slew_OnDataRequest(bool hemisphere) {
-    return Slew_instance[hemisphere].OnDataRequest();
+    return Slew_instance(hemisphere).OnDataRequest();
 }
 
 void Slew_OnDataReceive(bool hemisphere, uint64_t data) {
-    Slew_instance[hemisphere].OnDataReceive(data);
+    Slew_instance(hemisphere).OnDataReceive(data);
 }
@@ -209,13 +209,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Squanch Squanch_instance[2];
-
-void Squanch_Start(bool hemisphere) {Squanch_instance[hemisphere].BaseStart(hemisphere);}
-void Squanch_Controller(bool hemisphere, bool forwarding) {Squanch_instance[hemisphere].BaseController(forwarding);}
-void Squanch_View(bool hemisphere) {Squanch_instance[hemisphere].BaseView();}
-void Squanch_OnButtonPress(bool hemisphere) {Squanch_instance[hemisphere].OnButtonPress();}
-void Squanch_OnEncoderMove(bool hemisphere, int direction) {Squanch_instance[hemisphere].OnEncoderMove(direction);}
-void Squanch_ToggleHelpScreen(bool hemisphere) {Squanch_instance[hemisphere].HelpScreen();}
-uint64_t Squanch_OnDataRequest(bool hemisphere) {return Squanch_instance[hemisphere].OnDataRequest();}
-void Squanch_OnDataReceive(bool hemisphere, uint64_t data) {Squanch_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Squanch)
+
+void Squanch_Start(bool hemisphere) {hemisphere::ConstructInSlot<Squanch>(hemisphere).BaseStart(hemisphere);}
+void Squanch_Controller(bool hemisphere, bool forwarding) {Squanch_instance(hemisphere).BaseController(forwarding);}
+void Squanch_View(bool hemisphere) {Squanch_instance(hemisphere).BaseView();}
+void Squanch_OnButtonPress(bool hemisphere) {Squanch_instance(hemisphere).OnButtonPress();}
+void Squanch_OnEncoderMove(bool hemisphere, int direction) {Squanch_instance(hemisphere).OnEncoderMove(direction);}
+void Squanch_ToggleHelpScreen(bool hemisphere) {Squanch_instance(hemisphere).HelpScreen();}
+uint64_t Squanch_OnDataRequest(bool hemisphere) {return Squanch_instance(hemisphere).OnDataRequest();}
+void Squanch_OnDataReceive(bool hemisphere, uint64_t data) {Squanch_instance(hemisphere).OnDataReceive(data);}
@@ -365,37 +365,37 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Stairs Stairs_instance[2];
+DECLARE_APPLET_INSTANCE(Stairs)
 
 void Stairs_Start(bool hemisphere) {
-    Stairs_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Stairs>(hemisphere).BaseStart(hemisphere);
 }
 
 void Stairs_Controller(bool hemisphere, bool forwarding) {
-    Stairs_instance[hemisphere].BaseController(forwarding);
+    Stairs_instance(hemisphere).BaseController(forwarding);
 }
 
 void Stairs_View(bool hemisphere) {
-    Stairs_instance[hemisphere].BaseView();
+    Stairs_instance(hemisphere).BaseView();
 }
 
 void Stairs_OnButtonPress(bool hemisphere) {
-    Stairs_instance[hemisphere].OnButtonPress();
+    Stairs_instance(hemisphere).OnButtonPress();
 }
 
 void Stairs_OnEncoderMove(bool hemisphere, int direction) {
-    Stairs_instance[hemisphere].OnEncoderMove(direction);
+    Stairs_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Stairs_ToggleHelpScreen(bool hemisphere) {
-    Stairs_instance[hemisphere].HelpScreen();
+    Stairs_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Stairs_OnDataRequest(bool hemisphere) {
-    return Stairs_instance[hemisphere].OnDataRequest();
+    return Stairs_instance(hemisphere).OnDataRequest();
 }
 
 void Stairs_OnDataReceive(bool hemisphere, uint64_t data) {
-    Stairs_instance[hemisphere].OnDataReceive(data);
+    Stairs_instance(hemisphere).OnDataReceive(data);
 }
 
@@ -110,36 +110,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Switch Switch_instance[2];
+DECLARE_APPLET_INSTANCE(Switch)
 
 void Switch_Start(bool hemisphere) {
-    Switch_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Switch>(hemisphere).BaseStart(hemisphere);
 }
 
 void Switch_Controller(bool hemisphere, bool forwarding) {
-    Switch_instance[hemisphere].BaseController(forwarding);
+    Switch_instance(hemisphere).BaseController(forwarding);
 }
 
 void Switch_View(bool hemisphere) {
-    Switch_instance[hemisphere].BaseView();
+    Switch_instance(hemisphere).BaseView();
 }
 
 void Switch_OnButtonPress(bool hemisphere) {
-    Switch_instance[hemisphere].OnButtonPress();
+    Switch_instance(hemisphere).OnButtonPress();
 }
 
 void Switch_OnEncoderMove(bool hemisphere, int direction) {
-    Switch_instance[hemisphere].OnEncoderMove(direction);
+    Switch_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Switch_ToggleHelpScreen(bool hemisphere) {
-    Switch_instance[hemisphere].HelpScreen();
+    Switch_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Switch_OnDataRequest(bool hemisphere) {
-    return Switch_instance[hemisphere].OnDataRequest();
+    return Switch_instance(hemisphere).OnDataRequest();
 }
 
 void Switch_OnDataReceive(bool hemisphere, uint64_t data) {
-    Switch_instance[hemisphere].OnDataReceive(data);
+    Switch_instance(hemisphere).OnDataReceive(data);
 }
@@ -139,7 +139,7 @@ class TB_3PO : public AppletBase
         // -2.5v to +5v (HEMISPHERE_MAX_CV),  giving about -8 to +15 added to encoder density value
         // Note: DetentedIn is used to cut out noise near 0, even though it's being quantized to int below (primarily to make the cv icon work better)
         int signal = constrain(DetentedIn(1), -HEMISPHERE_3V_CV, HEMISPHERE_MAX_INPUT_CV);  // Allow negative to go about as far as it will reach
-        density_cv = Proportion(abs(signal), HEMISPHERE_MAX_INPUT_CV, 15); // Apply proportion uniformly to +- voltages as + for symmetry (Avoids rounding differences)
+        density_cv = Proportion<HEMISPHERE_MAX_INPUT_CV>(abs(signal), 15); // Apply proportion uniformly to +- voltages as + for symmetry (Avoids rounding differences)
         if(signal <0)
         {
           density_cv *= -1;  // Restore negative sign if -v
@@ -618,7 +618,7 @@ class TB_3PO : public AppletBase
             range_from_scale = 4;
           }
           // Range from 2 pitches to just <= full scale available
-          available_pitches = 3 + Proportion(pitch_change_dens-3, 4, range_from_scale);
+          available_pitches = 3 + Proportion<4>(pitch_change_dens-3, range_from_scale);
           available_pitches = constrain(available_pitches, 1, scale_size -1);
         }
       }
@@ -873,7 +873,7 @@ class TB_3PO : public AppletBase
       gfxPrint(14, 37, dens_display);
 
       /* CV offset test
-      int test = Proportion(abs(density_cv), HEMISPHERE_3V_CV, 7);
+      int test = Proportion<HEMISPHERE_3V_CV>(abs(density_cv), 7);
       if(density_cv < 0) test *= -1;
       gfxPos(0, 27);gfxPrint(test);
       gfxPos(0, 37); gfxPrintVoltage(density_cv);
@@ -999,36 +999,36 @@ class TB_3PO : public AppletBase
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TB_3PO TB_3PO_instance[2];
+DECLARE_APPLET_INSTANCE(TB_3PO)
 
 void TB_3PO_Start(bool hemisphere) {
-    TB_3PO_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<TB_3PO>(hemisphere).BaseStart(hemisphere);
 }
 
 void TB_3PO_Controller(bool hemisphere, bool forwarding) {
-    TB_3PO_instance[hemisphere].BaseController(forwarding);
+    TB_3PO_instance(hemisphere).BaseController(forwarding);
 }
 
 void TB_3PO_View(bool hemisphere) {
-    TB_3PO_instance[hemisphere].BaseView();
+    TB_3PO_instance(hemisphere).BaseView();
 }
 
 void TB_3PO_OnButtonPress(bool hemisphere) {
-    TB_3PO_instance[hemisphere].OnButtonPress();
+    TB_3PO_instance(hemisphere).OnButtonPress();
 }
 
 void TB_3PO_OnEncoderMove(bool hemisphere, int direction) {
-    TB_3PO_instance[hemisphere].OnEncoderMove(direction);
+    TB_3PO_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void TB_3PO_ToggleHelpScreen(bool hemisphere) {
-    TB_3PO_instance[hemisphere].HelpScreen();
+    TB_3PO_instance(hemisphere).HelpScreen();
 }
 
 uint64_t TB_3PO_OnDataRequest(bool hemisphere) {
-    return TB_3PO_instance[hemisphere].OnDataRequest();
+    return TB_3PO_instance(hemisphere).OnDataRequest();
 }
 
 void TB_3PO_OnDataReceive(bool hemisphere, uint64_t data) {
-    TB_3PO_instance[hemisphere].OnDataReceive(data);
+    TB_3PO_instance(hemisphere).OnDataReceive(data);
 }
@@ -167,36 +167,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TLNeuron TLNeuron_instance[2];
+DECLARE_APPLET_INSTANCE(TLNeuron)
 
 void TLNeuron_Start(bool hemisphere) {
-    TLNeuron_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<TLNeuron>(hemisphere).BaseStart(hemisphere);
 }
 
 void TLNeuron_Controller(bool hemisphere, bool forwarding) {
-    TLNeuron_instance[hemisphere].BaseController(forwarding);
+    TLNeuron_instance(hemisphere).BaseController(forwarding);
 }
 
 void TLNeuron_View(bool hemisphere) {
-    TLNeuron_instance[hemisphere].BaseView();
+    TLNeuron_instance(hemisphere).BaseView();
 }
 
 void TLNeuron_OnButtonPress(bool hemisphere) {
-    TLNeuron_instance[hemisphere].OnButtonPress();
+    TLNeuron_instance(hemisphere).OnButtonPress();
 }
 
 void TLNeuron_OnEncoderMove(bool hemisphere, int direction) {
-    TLNeuron_instance[hemisphere].OnEncoderMove(direction);
+    TLNeuron_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void TLNeuron_ToggleHelpScreen(bool hemisphere) {
-    TLNeuron_instance[hemisphere].HelpScreen();
+    TLNeuron_instance(hemisphere).HelpScreen();
 }
 
 uint64_t TLNeuron_OnDataRequest(bool hemisphere) {
-    return TLNeuron_instance[hemisphere].OnDataRequest();
+    return TLNeuron_instance(hemisphere).OnDataRequest();
 }
 
 void TLNeuron_OnDataReceive(bool hemisphere, uint64_t data) {
-    TLNeuron_instance[hemisphere].OnDataReceive(data);
+    TLNeuron_instance(hemisphere).OnDataReceive(data);
 }
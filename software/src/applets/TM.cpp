@@ -79,13 +79,13 @@ public:
         // Send 5-bit quantized CV
         // APD: Scale this to the range of notes allowed by quant_range: 32 should be all
         // This defies the faithful Turing Machine sim aspect of this code but gives a useful addition that the Disting adds to the concept
-        int32_t note = Proportion(reg & 0x1f, 0x1f, quant_range);
+        int32_t note = Proportion<0x1f>(reg & 0x1f, quant_range);
         Out(0, quantizer.Lookup(note + 64));
 
         switch (cv2) {
         case 0:
           // Send 8-bit proportioned CV
-          Out(1, Proportion(reg & 0x00ff, 255, HEMISPHERE_MAX_CV) );
+          Out(1, Proportion<255>(reg & 0x00ff, HEMISPHERE_MAX_CV) );
           break;
         case 1:
           if (clk)
@@ -100,7 +100,7 @@ public:
           Out(1, quantizer.Lookup(note + 64));
           break;
         case 4: // alternative 6-bit pitch
-          note = Proportion( (reg >> 8 & 0x3f), 0x3f, quant_range);
+          note = Proportion<0x3f>( (reg >> 8 & 0x3f), quant_range);
           Out(1, quantizer.Lookup(note + 64));
           break;
         }
@@ -276,36 +276,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TM TM_instance[2];
+DECLARE_APPLET_INSTANCE(TM)
 
 void TM_Start(bool hemisphere) {
-    TM_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<TM>(hemisphere).BaseStart(hemisphere);
 }
 
 void TM_Controller(bool hemisphere, bool forwarding) {
-    TM_instance[hemisphere].BaseController(forwarding);
+    TM_instance(hemisphere).BaseController(forwarding);
 }
 
 void TM_View(bool hemisphere) {
-    TM_instance[hemisphere].BaseView();
+    TM_instance(hemisphere).BaseView();
 }
 
 void TM_OnButtonPress(bool hemisphere) {
-    TM_instance[hemisphere].OnButtonPress();
+    TM_instance(hemisphere).OnButtonPress();
 }
 
 void TM_OnEncoderMove(bool hemisphere, int direction) {
-    TM_instance[hemisphere].OnEncoderMove(direction);
+    TM_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void TM_ToggleHelpScreen(bool hemisphere) {
-    TM_instance[hemisphere].HelpScreen();
+    TM_instance(hemisphere).HelpScreen();
 }
 
 uint64_t TM_OnDataRequest(bool hemisphere) {
-    return TM_instance[hemisphere].OnDataRequest();
+    return TM_instance(hemisphere).OnDataRequest();
 }
 
 void TM_OnDataReceive(bool hemisphere, uint64_t data) {
-    TM_instance[hemisphere].OnDataReceive(data);
+    TM_instance(hemisphere).OnDataReceive(data);
 }
@@ -43,6 +43,7 @@ constexpr int TM2_MAX_SCALE = oc::Scales::NUM_SCALES;
 
 constexpr int TM2_MIN_LENGTH = 2;
 constexpr int TM2_MAX_LENGTH = 32;
+constexpr int TM2_SHORT_LOOP = 16; // Steps saved when the whole loop doesn't fit
 
 class DualTM : public AppletBase {
 public:
@@ -117,18 +118,18 @@ public:
         ForEachChannel(ch) {
             switch (cvmode[ch]) {
             case SLEW_MOD:
-                smooth_mod = constrain(smooth_mod + Proportion(cv_data[ch], HEMISPHERE_MAX_INPUT_CV, 128), 1, 128);
+                smooth_mod = constrain(smooth_mod + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[ch], 128), 1, 128);
                 break;
             case LENGTH_MOD:
-                len_mod = constrain(len_mod + Proportion(cv_data[ch], HEMISPHERE_MAX_INPUT_CV, TM2_MAX_LENGTH), TM2_MIN_LENGTH, TM2_MAX_LENGTH);
+                len_mod = constrain(len_mod + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[ch], TM2_MAX_LENGTH), TM2_MIN_LENGTH, TM2_MAX_LENGTH);
                 break;
 
             case P_MOD:
-                p_mod = constrain(p_mod + Proportion(cv_data[ch], HEMISPHERE_MAX_INPUT_CV, 100), 0, 100);
+                p_mod = constrain(p_mod + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[ch], 100), 0, 100);
                 break;
 
             case RANGE_MOD:
-                range_mod = constrain(range_mod + Proportion(cv_data[ch], HEMISPHERE_MAX_INPUT_CV, 32), 1, 32);
+                range_mod = constrain(range_mod + Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_data[ch], 32), 1, 32);
                 break;
 
             // bi-polar transpose before quantize
@@ -166,8 +167,8 @@ public:
         }
  
         // Send 8-bit scaled and quantized CV
-        int32_t note = Proportion(reg[0] & 0xff, 0xff, range_mod) + 64;
-        int32_t note2 = Proportion(reg[1] & 0xff, 0xff, range_mod) + 64;
+        int32_t note = Proportion<0xff>(reg[0] & 0xff, range_mod) + 64;
+        int32_t note2 = Proportion<0xff>(reg[1] & 0xff, range_mod) + 64;
 
         ForEachChannel(ch) {
             switch (outmode[ch]) {
@@ -186,10 +187,10 @@ public:
               Output[ch] = slew(Output[ch], quantizer.Lookup(note2 + note_trans[1]));
               break;
             case MOD1: // 8-bit bi-polar proportioned CV
-              Output[ch] = slew(Output[ch], Proportion( int(reg[0] & 0xff)-0x7f, 0x80, HEMISPHERE_MAX_CV) );
+              Output[ch] = slew(Output[ch], Proportion<0x80>( int(reg[0] & 0xff)-0x7f, HEMISPHERE_MAX_CV) );
               break;
             case MOD2:
-              Output[ch] = slew(Output[ch], Proportion( int(reg[1] & 0xff)-0x7f, 0x80, HEMISPHERE_MAX_CV) );
+              Output[ch] = slew(Output[ch], Proportion<0x80>( int(reg[1] & 0xff)-0x7f, HEMISPHERE_MAX_CV) );
               break;
             case TRIG1:
             case TRIG2:
@@ -304,6 +305,31 @@ public:
         smoothing = constrain(smoothing, 1, 128);
     }
 
+    // The registers are the sequence itself; only the looping part is stored.
+    // When the whole loop doesn't fit next to the other side's state, only
+    // its first 16 steps are (version 2).
+    uint8_t OnBlobRequest(util::BitWriter &blob) {
+        if (blob.remaining() >= 2U * length) {
+            ForEachChannel(ch) blob.Write(reg[ch], length);
+            return 1;
+        }
+        ForEachChannel(ch) blob.Write(reg[ch], TM2_SHORT_LOOP);
+        return 2;
+    }
+
+    void OnBlobReceive(uint8_t version, util::BitReader &blob) {
+        int bits = version == 1 ? length : TM2_SHORT_LOOP;
+        uint32_t loop[2];
+        ForEachChannel(ch) loop[ch] = blob.Read(bits);
+        if (blob.overflow()) return;
+        // Repeat the loop up the register, which is where it would be after
+        // going round a few times
+        ForEachChannel(ch) {
+            reg[ch] = 0;
+            for (int bit = 0; bit < 32; bit += bits) reg[ch] |= loop[ch] << bit;
+        }
+    }
+
 protected:
     void SetHelp() {
         //                               "------------------" <-- Size Guide
@@ -484,36 +510,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-DualTM DualTM_instance[2];
+DECLARE_APPLET_INSTANCE(DualTM)
 
 void DualTM_Start(bool hemisphere) {
-    DualTM_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<DualTM>(hemisphere).BaseStart(hemisphere);
 }
 
 void DualTM_Controller(bool hemisphere, bool forwarding) {
-    DualTM_instance[hemisphere].BaseController(forwarding);
+    DualTM_instance(hemisphere).BaseController(forwarding);
 }
 
 void DualTM_View(bool hemisphere) {
-    DualTM_instance[hemisphere].BaseView();
+    DualTM_instance(hemisphere).BaseView();
 }
 
 void DualTM_OnButtonPress(bool hemisphere) {
-    DualTM_instance[hemisphere].OnButtonPress();
+    DualTM_instance(hemisphere).OnButtonPress();
 }
 
 void DualTM_OnEncoderMove(bool hemisphere, int direction) {
-    DualTM_instance[hemisphere].OnEncoderMove(direction);
+    DualTM_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void DualTM_ToggleHelpScreen(bool hemisphere) {
-    DualTM_instance[hemisphere].HelpScreen();
+    DualTM_instance(hemisphere).HelpScreen();
 }
 
 uint64_t DualTM_OnDataRequest(bool hemisphere) {
-    return DualTM_instance[hemisphere].OnDataRequest();
+    return DualTM_instance(hemisphere).OnDataRequest();
 }
 
 void DualTM_OnDataReceive(bool hemisphere, uint64_t data) {
-    DualTM_instance[hemisphere].OnDataReceive(data);
+    DualTM_instance(hemisphere).OnDataReceive(data);
 }
@@ -155,7 +155,7 @@ private:
         gfxPrint(1, 25, hemisphere ? "D:" : "B:");
         gfxPrint(Trending_assignments[assign[1]]);
         gfxFrame(1, 35, 62, 6);
-        int px = Proportion(sensitivity, TRENDING_MAX_SENS, 62);
+        int px = Proportion<TRENDING_MAX_SENS>(sensitivity, 62);
         if (cursor == 2) gfxRect(1, 35, px, 6);
         else {
             gfxLine(px, 35, px, 40);
@@ -199,13 +199,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Trending Trending_instance[2];
-
-void Trending_Start(bool hemisphere) {Trending_instance[hemisphere].BaseStart(hemisphere);}
-void Trending_Controller(bool hemisphere, bool forwarding) {Trending_instance[hemisphere].BaseController(forwarding);}
-void Trending_View(bool hemisphere) {Trending_instance[hemisphere].BaseView();}
-void Trending_OnButtonPress(bool hemisphere) {Trending_instance[hemisphere].OnButtonPress();}
-void Trending_OnEncoderMove(bool hemisphere, int direction) {Trending_instance[hemisphere].OnEncoderMove(direction);}
-void Trending_ToggleHelpScreen(bool hemisphere) {Trending_instance[hemisphere].HelpScreen();}
-uint64_t Trending_OnDataRequest(bool hemisphere) {return Trending_instance[hemisphere].OnDataRequest();}
-void Trending_OnDataReceive(bool hemisphere, uint64_t data) {Trending_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Trending)
+
+void Trending_Start(bool hemisphere) {hemisphere::ConstructInSlot<Trending>(hemisphere).BaseStart(hemisphere);}
+void Trending_Controller(bool hemisphere, bool forwarding) {Trending_instance(hemisphere).BaseController(forwarding);}
+void Trending_View(bool hemisphere) {Trending_instance(hemisphere).BaseView();}
+void Trending_OnButtonPress(bool hemisphere) {Trending_instance(hemisphere).OnButtonPress();}
+void Trending_OnEncoderMove(bool hemisphere, int direction) {Trending_instance(hemisphere).OnEncoderMove(direction);}
+void Trending_ToggleHelpScreen(bool hemisphere) {Trending_instance(hemisphere).HelpScreen();}
+uint64_t Trending_OnDataRequest(bool hemisphere) {return Trending_instance(hemisphere).OnDataRequest();}
+void Trending_OnDataReceive(bool hemisphere, uint64_t data) {Trending_instance(hemisphere).OnDataReceive(data);}
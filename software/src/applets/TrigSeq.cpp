@@ -134,7 +134,7 @@ private:
     }
 
     int Offset(int ch) {
-        int offset = Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, end_step[ch]);
+        int offset = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), end_step[ch]);
         if (offset < 0) offset += Length(ch);
         offset %= Length(ch);
         return offset;
@@ -199,36 +199,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TrigSeq TrigSeq_instance[2];
+DECLARE_APPLET_INSTANCE(TrigSeq)
 
 void TrigSeq_Start(bool hemisphere) {
-    TrigSeq_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<TrigSeq>(hemisphere).BaseStart(hemisphere);
 }
 
 void TrigSeq_Controller(bool hemisphere, bool forwarding) {
-    TrigSeq_instance[hemisphere].BaseController(forwarding);
+    TrigSeq_instance(hemisphere).BaseController(forwarding);
 }
 
 void TrigSeq_View(bool hemisphere) {
-    TrigSeq_instance[hemisphere].BaseView();
+    TrigSeq_instance(hemisphere).BaseView();
 }
 
 void TrigSeq_OnButtonPress(bool hemisphere) {
-    TrigSeq_instance[hemisphere].OnButtonPress();
+    TrigSeq_instance(hemisphere).OnButtonPress();
 }
 
 void TrigSeq_OnEncoderMove(bool hemisphere, int direction) {
-    TrigSeq_instance[hemisphere].OnEncoderMove(direction);
+    TrigSeq_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void TrigSeq_ToggleHelpScreen(bool hemisphere) {
-    TrigSeq_instance[hemisphere].HelpScreen();
+    TrigSeq_instance(hemisphere).HelpScreen();
 }
 
 uint64_t TrigSeq_OnDataRequest(bool hemisphere) {
-    return TrigSeq_instance[hemisphere].OnDataRequest();
+    return TrigSeq_instance(hemisphere).OnDataRequest();
 }
 
 void TrigSeq_OnDataReceive(bool hemisphere, uint64_t data) {
-    TrigSeq_instance[hemisphere].OnDataReceive(data);
+    TrigSeq_instance(hemisphere).OnDataReceive(data);
 }
@@ -121,7 +121,7 @@ private:
     int cursor; // 0=ch1 low, 1=ch1 hi, 2=ch2 low, 3=ch3 hi, 4=end_step
 
     int Offset() {
-        int offset = Proportion(DetentedIn(1), HEMISPHERE_MAX_INPUT_CV, end_step);
+        int offset = Proportion<HEMISPHERE_MAX_INPUT_CV>(DetentedIn(1), end_step);
         if (offset < 0) offset += Length();
         offset %= Length();
         return offset;
@@ -200,36 +200,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-TrigSeq16 TrigSeq16_instance[2];
+DECLARE_APPLET_INSTANCE(TrigSeq16)
 
 void TrigSeq16_Start(bool hemisphere) {
-    TrigSeq16_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<TrigSeq16>(hemisphere).BaseStart(hemisphere);
 }
 
 void TrigSeq16_Controller(bool hemisphere, bool forwarding) {
-    TrigSeq16_instance[hemisphere].BaseController(forwarding);
+    TrigSeq16_instance(hemisphere).BaseController(forwarding);
 }
 
 void TrigSeq16_View(bool hemisphere) {
-    TrigSeq16_instance[hemisphere].BaseView();
+    TrigSeq16_instance(hemisphere).BaseView();
 }
 
 void TrigSeq16_OnButtonPress(bool hemisphere) {
-    TrigSeq16_instance[hemisphere].OnButtonPress();
+    TrigSeq16_instance(hemisphere).OnButtonPress();
 }
 
 void TrigSeq16_OnEncoderMove(bool hemisphere, int direction) {
-    TrigSeq16_instance[hemisphere].OnEncoderMove(direction);
+    TrigSeq16_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void TrigSeq16_ToggleHelpScreen(bool hemisphere) {
-    TrigSeq16_instance[hemisphere].HelpScreen();
+    TrigSeq16_instance(hemisphere).HelpScreen();
 }
 
 uint64_t TrigSeq16_OnDataRequest(bool hemisphere) {
-    return TrigSeq16_instance[hemisphere].OnDataRequest();
+    return TrigSeq16_instance(hemisphere).OnDataRequest();
 }
 
 void TrigSeq16_OnDataReceive(bool hemisphere, uint64_t data) {
-    TrigSeq16_instance[hemisphere].OnDataReceive(data);
+    TrigSeq16_instance(hemisphere).OnDataReceive(data);
 }
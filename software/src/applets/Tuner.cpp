@@ -48,6 +48,9 @@ public:
 #endif
             FreqMeasure.begin();
         }
+        period_sum_ = 0;
+        period_count_ = 0;
+        period_ = 0;
         AllowRestart();
     }
 
@@ -58,18 +61,19 @@ public:
         if (hemisphere == 1 && FreqMeasure.available())
 #endif
         {
-            // average several readings together
-            freq_sum_ = freq_sum_ + FreqMeasure.read();
-            freq_count_ = freq_count_ + 1;
+            // average several readings together. The sum is in F_BUS cycles,
+            // so it won't overflow in 750ms.
+            period_sum_ += FreqMeasure.read();
+            ++period_count_;
 
             if (milliseconds_since_last_freq_ > 750) {
-                frequency_ = FreqMeasure.countToFrequency(freq_sum_ / freq_count_);
-                freq_sum_ = 0;
-                freq_count_ = 0;
+                period_ = period_sum_ / period_count_;
+                period_sum_ = 0;
+                period_count_ = 0;
                 milliseconds_since_last_freq_ = 0;
             }
         } else if (milliseconds_since_last_freq_ > 100000) {
-            frequency_ = 0.0f;
+            period_ = 0;
         }
     }
 
@@ -125,10 +129,11 @@ protected:
     }
     
 private:
-    // Port from References
-    double freq_sum_;
-    uint32_t freq_count_;
-    float frequency_ ;
+    // Port from References. The frequency is only worked out (in float) for
+    // the display, the ISR just averages the periods.
+    uint32_t period_sum_;
+    uint32_t period_count_;
+    uint32_t period_; // Average period in F_BUS cycles, 0 if there is no signal
     elapsedMillis milliseconds_since_last_freq_;
     int A4_Hz; // Tuning reference
 
@@ -206,7 +211,10 @@ private:
     }
 #endif
 
-    float get_frequency() {return frequency_;}
+    float get_frequency() {
+        uint32_t period = period_;
+        return period ? FreqMeasure.countToFrequency(period) : 0.0f;
+    }
     
     float get_C0_freq() {
         return(static_cast<float>(A4_Hz * HEM_TUNER_AaboveMidCtoC0));
@@ -222,36 +230,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Tuner Tuner_instance[2];
+DECLARE_APPLET_INSTANCE(Tuner)
 
 void Tuner_Start(bool hemisphere) {
-    Tuner_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<Tuner>(hemisphere).BaseStart(hemisphere);
 }
 
 void Tuner_Controller(bool hemisphere, bool forwarding) {
-    Tuner_instance[hemisphere].BaseController(forwarding);
+    Tuner_instance(hemisphere).BaseController(forwarding);
 }
 
 void Tuner_View(bool hemisphere) {
-    Tuner_instance[hemisphere].BaseView();
+    Tuner_instance(hemisphere).BaseView();
 }
 
 void Tuner_OnButtonPress(bool hemisphere) {
-    Tuner_instance[hemisphere].OnButtonPress();
+    Tuner_instance(hemisphere).OnButtonPress();
 }
 
 void Tuner_OnEncoderMove(bool hemisphere, int direction) {
-    Tuner_instance[hemisphere].OnEncoderMove(direction);
+    Tuner_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void Tuner_ToggleHelpScreen(bool hemisphere) {
-    Tuner_instance[hemisphere].HelpScreen();
+    Tuner_instance(hemisphere).HelpScreen();
 }
 
 uint64_t Tuner_OnDataRequest(bool hemisphere) {
-    return Tuner_instance[hemisphere].OnDataRequest();
+    return Tuner_instance(hemisphere).OnDataRequest();
 }
 
 void Tuner_OnDataReceive(bool hemisphere, uint64_t data) {
-    Tuner_instance[hemisphere].OnDataReceive(data);
+    Tuner_instance(hemisphere).OnDataReceive(data);
 }
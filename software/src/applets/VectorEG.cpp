@@ -116,6 +116,7 @@ protected:
 private:
     int cursor; // 0=Freq A; 1=Waveform A; 2=Freq B; 3=Waveform B
     VectorOscillator osc[2];
+    WaveformPreview<hemisphere::VO_MAX_SEGMENTS + 1> preview[2];
     bool gated[2];
 
     // Settings
@@ -146,30 +147,38 @@ private:
     }
 
     void DrawWaveform(byte ch) {
+        if (preview[ch].Stale(waveform_number[ch])) RenderWaveform(ch);
+        gfxPreview(preview[ch]);
+
+        // Zero line
+        gfxDottedLine(0, 44, 63, 44, 8);
+    }
+
+    // The segments as a polyline, worked out again when the waveform changes
+    void RenderWaveform(byte ch) {
+        preview[ch].Begin(waveform_number[ch]);
         uint16_t total_time = osc[ch].TotalTime();
         VOSegment seg = osc[ch].GetSegment(osc[ch].SegmentCount() - 1);
         byte prev_x = 0; // Starting coordinates
-        byte prev_y = 63 - Proportion(seg.level, 255, 38);
+        byte prev_y = 63 - Proportion<255>(seg.level, 38);
+        preview[ch].Add(prev_x, prev_y);
         for (byte i = 0; i < osc[ch].SegmentCount(); i++)
         {
             seg = osc[ch].GetSegment(i);
-            byte y = 63 - Proportion(seg.level, 255, 38);
+            byte y = 63 - Proportion<255>(seg.level, 38);
             byte seg_x = Proportion(seg.time, total_time, 62);
             byte x = prev_x + seg_x;
             x = constrain(x, 0, 62);
             y = constrain(y, 25, 62);
-            gfxLine(prev_x, prev_y, x, y);
+            preview[ch].Add(x, y);
             prev_x = x;
-            prev_y = y;
         }
-
-        // Zero line
-        gfxDottedLine(0, 44, 63, 44, 8);
     }
 
     void SwitchWaveform(byte ch, int waveform) {
         osc[ch] = WaveformManager::VectorOscillatorFromWaveform(waveform);
         waveform_number[ch] = waveform;
+        preview[ch].Invalidate();
         osc[ch].SetFrequency(freq[ch]);
 #ifdef BUCHLA_4U
         osc[ch].SetScale((12 << 7) * 8); // 8V
@@ -194,13 +203,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorEG VectorEG_instance[2];
-
-void VectorEG_Start(bool hemisphere) {VectorEG_instance[hemisphere].BaseStart(hemisphere);}
-void VectorEG_Controller(bool hemisphere, bool forwarding) {VectorEG_instance[hemisphere].BaseController(forwarding);}
-void VectorEG_View(bool hemisphere) {VectorEG_instance[hemisphere].BaseView();}
-void VectorEG_OnButtonPress(bool hemisphere) {VectorEG_instance[hemisphere].OnButtonPress();}
-void VectorEG_OnEncoderMove(bool hemisphere, int direction) {VectorEG_instance[hemisphere].OnEncoderMove(direction);}
-void VectorEG_ToggleHelpScreen(bool hemisphere) {VectorEG_instance[hemisphere].HelpScreen();}
-uint64_t VectorEG_OnDataRequest(bool hemisphere) {return VectorEG_instance[hemisphere].OnDataRequest();}
-void VectorEG_OnDataReceive(bool hemisphere, uint64_t data) {VectorEG_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(VectorEG)
+
+void VectorEG_Start(bool hemisphere) {hemisphere::ConstructInSlot<VectorEG>(hemisphere).BaseStart(hemisphere);}
+void VectorEG_Controller(bool hemisphere, bool forwarding) {VectorEG_instance(hemisphere).BaseController(forwarding);}
+void VectorEG_View(bool hemisphere) {VectorEG_instance(hemisphere).BaseView();}
+void VectorEG_OnButtonPress(bool hemisphere) {VectorEG_instance(hemisphere).OnButtonPress();}
+void VectorEG_OnEncoderMove(bool hemisphere, int direction) {VectorEG_instance(hemisphere).OnEncoderMove(direction);}
+void VectorEG_ToggleHelpScreen(bool hemisphere) {VectorEG_instance(hemisphere).HelpScreen();}
+uint64_t VectorEG_OnDataRequest(bool hemisphere) {return VectorEG_instance(hemisphere).OnDataRequest();}
+void VectorEG_OnDataReceive(bool hemisphere, uint64_t data) {VectorEG_instance(hemisphere).OnDataReceive(data);}
@@ -46,7 +46,7 @@ public:
     void Controller() {
         // Input 1 is frequency modulation for channel 1
         if (Changed(0)) {
-            int mod = Proportion(DetentedIn(0), HEMISPHERE_3V_CV, 3000);
+            int mod = Proportion<HEMISPHERE_3V_CV>(DetentedIn(0), 3000);
             mod = constrain(mod, -3000, 3000);
             if (mod + freq[0] > 10) osc[0].SetFrequency(freq[0] + mod);
         }
@@ -169,6 +169,7 @@ private:
     static constexpr int pow10_lut[] = { 1, 10, 100, 1000 };
     int cursor; // 0=Freq A; 1=Waveform A; 2=Freq B; 3=Waveform B
     VectorOscillator osc[2];
+    WaveformPreview<hemisphere::VO_MAX_SEGMENTS + 1> preview[2];
 
     // Settings
     int waveform_number[2];
@@ -201,30 +202,38 @@ private:
     }
 
     void DrawWaveform(byte ch) {
+        if (preview[ch].Stale(waveform_number[ch])) RenderWaveform(ch);
+        gfxPreview(preview[ch]);
+
+        // Zero line
+        gfxDottedLine(0, 44, 63, 44, 8);
+    }
+
+    // The segments as a polyline, worked out again when the waveform changes
+    void RenderWaveform(byte ch) {
+        preview[ch].Begin(waveform_number[ch]);
         uint16_t total_time = osc[ch].TotalTime();
         VOSegment seg = osc[ch].GetSegment(osc[ch].SegmentCount() - 1);
         byte prev_x = 0; // Starting coordinates
-        byte prev_y = 63 - Proportion(seg.level, 255, 38);
+        byte prev_y = 63 - Proportion<255>(seg.level, 38);
+        preview[ch].Add(prev_x, prev_y);
         for (byte i = 0; i < osc[ch].SegmentCount(); i++)
         {
             seg = osc[ch].GetSegment(i);
-            byte y = 63 - Proportion(seg.level, 255, 38);
+            byte y = 63 - Proportion<255>(seg.level, 38);
             byte seg_x = Proportion(seg.time, total_time, 62);
             byte x = prev_x + seg_x;
             x = constrain(x, 0, 62);
             y = constrain(y, 25, 62);
-            gfxLine(prev_x, prev_y, x, y);
+            preview[ch].Add(x, y);
             prev_x = x;
-            prev_y = y;
         }
-
-        // Zero line
-        gfxDottedLine(0, 44, 63, 44, 8);
     }
 
     void SwitchWaveform(byte ch, int waveform) {
         osc[ch] = WaveformManager::VectorOscillatorFromWaveform(waveform);
         waveform_number[ch] = waveform;
+        preview[ch].Invalidate();
         osc[ch].SetFrequency(freq[ch]);
 #ifdef BUCHLA_4U
         osc[ch].Offset((12 << 7) * 4);
@@ -249,13 +258,13 @@ constexpr int VectorLFO::pow10_lut[];
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorLFO VectorLFO_instance[2];
+DECLARE_APPLET_INSTANCE(VectorLFO)
 
-void VectorLFO_Start(bool hemisphere) {VectorLFO_instance[hemisphere].BaseStart(hemisphere);}
-void VectorLFO_Controller(bool hemisphere, bool forwarding) {VectorLFO_instance[hemisphere].BaseController(forwarding);}
-void VectorLFO_View(bool hemisphere) {VectorLFO_instance[hemisphere].BaseView();}
-void VectorLFO_OnButtonPress(bool hemisphere) {VectorLFO_instance[hemisphere].OnButtonPress();}
-void VectorLFO_OnEncoderMove(bool hemisphere, int direction) {VectorLFO_instance[hemisphere].OnEncoderMove(direction);}
-void VectorLFO_ToggleHelpScreen(bool hemisphere) {VectorLFO_instance[hemisphere].HelpScreen();}
-uint64_t VectorLFO_OnDataRequest(bool hemisphere) {return VectorLFO_instance[hemisphere].OnDataRequest();}
-void VectorLFO_OnDataReceive(bool hemisphere, uint64_t data) {VectorLFO_instance[hemisphere].OnDataReceive(data);}
+void VectorLFO_Start(bool hemisphere) {hemisphere::ConstructInSlot<VectorLFO>(hemisphere).BaseStart(hemisphere);}
+void VectorLFO_Controller(bool hemisphere, bool forwarding) {VectorLFO_instance(hemisphere).BaseController(forwarding);}
+void VectorLFO_View(bool hemisphere) {VectorLFO_instance(hemisphere).BaseView();}
+void VectorLFO_OnButtonPress(bool hemisphere) {VectorLFO_instance(hemisphere).OnButtonPress();}
+void VectorLFO_OnEncoderMove(bool hemisphere, int direction) {VectorLFO_instance(hemisphere).OnEncoderMove(direction);}
+void VectorLFO_ToggleHelpScreen(bool hemisphere) {VectorLFO_instance(hemisphere).HelpScreen();}
+uint64_t VectorLFO_OnDataRequest(bool hemisphere) {return VectorLFO_instance(hemisphere).OnDataRequest();}
+void VectorLFO_OnDataReceive(bool hemisphere, uint64_t data) {VectorLFO_instance(hemisphere).OnDataReceive(data);}
@@ -46,7 +46,7 @@ public:
         ForEachChannel(ch)
         {
         		if (!linked || ch == 0) {
-        		    cv_phase = Proportion(In(ch), HEMISPHERE_MAX_INPUT_CV, 3599);
+        		    cv_phase = Proportion<HEMISPHERE_MAX_INPUT_CV>(In(ch), 3599);
         		    	cv_phase = constrain(cv_phase, -3599, 3599);
         		}
         		last_phase[ch] = (phase[ch] * 10) + cv_phase;
@@ -112,6 +112,7 @@ protected:
 private:
     int cursor; // 0=Phase A; 1=Waveform A; 2=Phase B; 3=Waveform B
     VectorOscillator osc[2];
+    WaveformPreview<hemisphere::VO_MAX_SEGMENTS + 1> preview[2];
     int last_phase[2]; // For display
 
     // Settings
@@ -143,35 +144,43 @@ private:
     }
 
     void DrawWaveform(byte ch) {
+        if (preview[ch].Stale(waveform_number[ch])) RenderWaveform(ch);
+        gfxPreview(preview[ch]);
+
+        // Zero line
+        gfxDottedLine(0, 44, 63, 44, 8);
+        
+        // Phase transport location
+        byte transport_x = Proportion<3600>(abs(last_phase[ch]) % 3600, 63);
+        gfxDottedLine(transport_x, 24, transport_x, 63, 3);
+    }
+
+    // The segments as a polyline, worked out again when the waveform changes
+    void RenderWaveform(byte ch) {
+        preview[ch].Begin(waveform_number[ch]);
         uint16_t total_time = osc[ch].TotalTime();
         VOSegment seg = osc[ch].GetSegment(osc[ch].SegmentCount() - 1);
         byte prev_x = 0; // Starting coordinates
-        byte prev_y = 63 - Proportion(seg.level, 255, 38);
+        byte prev_y = 63 - Proportion<255>(seg.level, 38);
+        preview[ch].Add(prev_x, prev_y);
 
         for (byte i = 0; i < osc[ch].SegmentCount(); i++)
         {
             seg = osc[ch].GetSegment(i);
-            byte y = 63 - Proportion(seg.level, 255, 38);
+            byte y = 63 - Proportion<255>(seg.level, 38);
             byte seg_x = Proportion(seg.time, total_time, 62);
             byte x = prev_x + seg_x;
             x = constrain(x, 0, 62);
             y = constrain(y, 25, 62);
-            gfxLine(prev_x, prev_y, x, y);
+            preview[ch].Add(x, y);
             prev_x = x;
-            prev_y = y;
         }
-
-        // Zero line
-        gfxDottedLine(0, 44, 63, 44, 8);
-        
-        // Phase transport location
-        byte transport_x = Proportion(abs(last_phase[ch]) % 3600, 3600, 63);
-        gfxDottedLine(transport_x, 24, transport_x, 63, 3);
     }
 
     void SwitchWaveform(byte ch, int waveform) {
         osc[ch] = WaveformManager::VectorOscillatorFromWaveform(waveform);
         waveform_number[ch] = waveform;
+        preview[ch].Invalidate();
         osc[ch].SetScale(HEMISPHERE_MAX_CV);
     }
 };
@@ -185,13 +194,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-VectorMorph VectorMorph_instance[2];
-
-void VectorMorph_Start(bool hemisphere) {VectorMorph_instance[hemisphere].BaseStart(hemisphere);}
-void VectorMorph_Controller(bool hemisphere, bool forwarding) {VectorMorph_instance[hemisphere].BaseController(forwarding);}
-void VectorMorph_View(bool hemisphere) {VectorMorph_instance[hemisphere].BaseView();}
-void VectorMorph_OnButtonPress(bool hemisphere) {VectorMorph_instance[hemisphere].OnButtonPress();}
-void VectorMorph_OnEncoderMove(bool hemisphere, int direction) {VectorMorph_instance[hemisphere].OnEncoderMove(direction);}
-void VectorMorph_ToggleHelpScreen(bool hemisphere) {VectorMorph_instance[hemisphere].HelpScreen();}
-uint64_t VectorMorph_OnDataRequest(bool hemisphere) {return VectorMorph_instance[hemisphere].OnDataRequest();}
-void VectorMorph_OnDataReceive(bool hemisphere, uint64_t data) {VectorMorph_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(VectorMorph)
+
+void VectorMorph_Start(bool hemisphere) {hemisphere::ConstructInSlot<VectorMorph>(hemisphere).BaseStart(hemisphere);}
+void VectorMorph_Controller(bool hemisphere, bool forwarding) {VectorMorph_instance(hemisphere).BaseController(forwarding);}
+void VectorMorph_View(bool hemisphere) {VectorMorph_instance(hemisphere).BaseView();}
+void VectorMorph_OnButtonPress(bool hemisphere) {VectorMorph_instance(hemisphere).OnButtonPress();}
+void VectorMorph_OnEncoderMove(bool hemisphere, int direction) {VectorMorph_instance(hemisphere).OnEncoderMove(direction);}
+void VectorMorph_ToggleHelpScreen(bool hemisphere) {VectorMorph_instance(hemisphere).HelpScreen();}
+uint64_t VectorMorph_OnDataRequest(bool hemisphere) {return VectorMorph_instance(hemisphere).OnDataRequest();}
+void VectorMorph_OnDataReceive(bool hemisphere, uint64_t data) {VectorMorph_instance(hemisphere).OnDataReceive(data);}
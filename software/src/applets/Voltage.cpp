@@ -138,13 +138,13 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-Voltage Voltage_instance[2];
-
-void Voltage_Start(bool hemisphere) {Voltage_instance[hemisphere].BaseStart(hemisphere);}
-void Voltage_Controller(bool hemisphere, bool forwarding) {Voltage_instance[hemisphere].BaseController(forwarding);}
-void Voltage_View(bool hemisphere) {Voltage_instance[hemisphere].BaseView();}
-void Voltage_OnButtonPress(bool hemisphere) {Voltage_instance[hemisphere].OnButtonPress();}
-void Voltage_OnEncoderMove(bool hemisphere, int direction) {Voltage_instance[hemisphere].OnEncoderMove(direction);}
-void Voltage_ToggleHelpScreen(bool hemisphere) {Voltage_instance[hemisphere].HelpScreen();}
-uint64_t Voltage_OnDataRequest(bool hemisphere) {return Voltage_instance[hemisphere].OnDataRequest();}
-void Voltage_OnDataReceive(bool hemisphere, uint64_t data) {Voltage_instance[hemisphere].OnDataReceive(data);}
+DECLARE_APPLET_INSTANCE(Voltage)
+
+void Voltage_Start(bool hemisphere) {hemisphere::ConstructInSlot<Voltage>(hemisphere).BaseStart(hemisphere);}
+void Voltage_Controller(bool hemisphere, bool forwarding) {Voltage_instance(hemisphere).BaseController(forwarding);}
+void Voltage_View(bool hemisphere) {Voltage_instance(hemisphere).BaseView();}
+void Voltage_OnButtonPress(bool hemisphere) {Voltage_instance(hemisphere).OnButtonPress();}
+void Voltage_OnEncoderMove(bool hemisphere, int direction) {Voltage_instance(hemisphere).OnEncoderMove(direction);}
+void Voltage_ToggleHelpScreen(bool hemisphere) {Voltage_instance(hemisphere).HelpScreen();}
+uint64_t Voltage_OnDataRequest(bool hemisphere) {return Voltage_instance(hemisphere).OnDataRequest();}
+void Voltage_OnDataReceive(bool hemisphere, uint64_t data) {Voltage_instance(hemisphere).OnDataReceive(data);}
@@ -71,15 +71,10 @@ public:
     }
 
     void Controller() {
-        while (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
-
-            if (message == MIDI_SYSEX) {
-                ReceiveManagerSysEx();
-                continue;
-            }
+        while (const oc::MidiMessage *midi = oc::MidiIn::Read(midi_subscription)) {
+            int message = midi->type;
+            int data1 = midi->data1;
+            int data2 = midi->data2;
 
             // Listen for incoming clock
             if (MIDI_CLOCK == message) {
@@ -108,7 +103,7 @@ public:
             }
 
             // all other messages are filtered by MIDI channel
-            if (usbMIDI.getChannel() == (channel + 1))
+            if (midi->channel == (channel + 1))
             {
                 last_tick = oc::core::ticks;
                 bool log_this = false;
@@ -130,7 +125,7 @@ public:
                             GateOut(ch, 1);
 
                         if (function[ch] == MIDI_VEL_OUT)
-                            Out(ch, Proportion(data2, 127, HEMISPHERE_MAX_CV));
+                            Out(ch, Proportion<127>(data2, HEMISPHERE_MAX_CV));
                     }
 
                     log_this = 1; // Log all MIDI notes. Other stuff is conditional.
@@ -155,7 +150,7 @@ public:
                     ForEachChannel(ch)
                     {
                         if (function[ch] == MIDI_CC_OUT && data1 == 1) {
-                            Out(ch, Proportion(data2, 127, HEMISPHERE_MAX_CV));
+                            Out(ch, Proportion<127>(data2, HEMISPHERE_MAX_CV));
                             log_this = 1;
                         }
                     }
@@ -166,7 +161,7 @@ public:
                     ForEachChannel(ch)
                     {
                         if (function[ch] == MIDI_AT_OUT) {
-                            Out(ch, Proportion(data1, 127, HEMISPHERE_MAX_CV));
+                            Out(ch, Proportion<127>(data1, HEMISPHERE_MAX_CV));
                             log_this = 1;
                         }
                     }
@@ -177,7 +172,7 @@ public:
                     {
                         if (function[ch] == MIDI_PB_OUT) {
                             int data = (data2 << 7) + data1 - 8192;
-                            Out(ch, Proportion(data, 0x7fff, HEMISPHERE_3V_CV));
+                            Out(ch, Proportion<0x7fff>(data, HEMISPHERE_3V_CV));
                             log_this = 1;
                         }
                     }
@@ -245,6 +240,8 @@ private:
     int function[2]; // Function for each channel
 
     // Housekeeping
+    // SysEx is left to the manager for presets
+    oc::MidiSubscription midi_subscription { oc::MIDI_TYPE_ALL & ~oc::MidiTypeBit(MIDI_SYSEX) };
     int cursor; // 0=MIDI channel, 1=A/C function, 2=B/D function
     int last_tick; // Tick of last received message
     int first_note; // First note received, for awaiting Note Off
@@ -353,36 +350,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-hMIDIIn hMIDIIn_instance[2];
+DECLARE_APPLET_INSTANCE(hMIDIIn)
 
 void hMIDIIn_Start(bool hemisphere) {
-    hMIDIIn_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<hMIDIIn>(hemisphere).BaseStart(hemisphere);
 }
 
 void hMIDIIn_Controller(bool hemisphere, bool forwarding) {
-    hMIDIIn_instance[hemisphere].BaseController(forwarding);
+    hMIDIIn_instance(hemisphere).BaseController(forwarding);
 }
 
 void hMIDIIn_View(bool hemisphere) {
-    hMIDIIn_instance[hemisphere].BaseView();
+    hMIDIIn_instance(hemisphere).BaseView();
 }
 
 void hMIDIIn_OnButtonPress(bool hemisphere) {
-    hMIDIIn_instance[hemisphere].OnButtonPress();
+    hMIDIIn_instance(hemisphere).OnButtonPress();
 }
 
 void hMIDIIn_OnEncoderMove(bool hemisphere, int direction) {
-    hMIDIIn_instance[hemisphere].OnEncoderMove(direction);
+    hMIDIIn_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void hMIDIIn_ToggleHelpScreen(bool hemisphere) {
-    hMIDIIn_instance[hemisphere].HelpScreen();
+    hMIDIIn_instance(hemisphere).HelpScreen();
 }
 
 uint64_t hMIDIIn_OnDataRequest(bool hemisphere) {
-    return hMIDIIn_instance[hemisphere].OnDataRequest();
+    return hMIDIIn_instance(hemisphere).OnDataRequest();
 }
 
 void hMIDIIn_OnDataReceive(bool hemisphere, uint64_t data) {
-    hMIDIIn_instance[hemisphere].OnDataReceive(data);
+    hMIDIIn_instance(hemisphere).OnDataReceive(data);
 }
@@ -20,6 +20,7 @@
 
 #include "hemisphere/applet_base.hpp"
 #include "HEMISPHERE.hpp"
+#include "oc/midi_out.h"
 
 using namespace hemisphere;
 
@@ -71,7 +72,7 @@ public:
 
             if (legato_on && midi_note != last_note) {
                 // Send note off if the note has changed
-                usbMIDI.sendNoteOff(last_note, 0, last_channel + 1);
+                oc::MidiOut::SendNoteOff(last_note, 0, last_channel + 1);
                 UpdateLog(MIDI_NOTE_OFF, midi_note, 0);
                 note_on = 1;
             }
@@ -83,8 +84,7 @@ public:
                 }
                 last_velocity = velocity;
 
-                usbMIDI.sendNoteOn(midi_note, velocity, channel + 1);
-                usbMIDI.send_now();
+                oc::MidiOut::SendNoteOn(midi_note, velocity, channel + 1);
                 last_note = midi_note;
                 last_channel = channel;
                 last_tick = oc::core::ticks;
@@ -95,8 +95,7 @@ public:
         }
 
         if (!read_gate && gated) { // A note off message should be sent
-            usbMIDI.sendNoteOff(last_note, 0, last_channel + 1);
-            usbMIDI.send_now();
+            oc::MidiOut::SendNoteOff(last_note, 0, last_channel + 1);
             UpdateLog(MIDI_NOTE_OFF, last_note, 0);
             last_tick = oc::core::ticks;
         }
@@ -110,8 +109,7 @@ public:
                 // Modulation wheel
                 if (function == MIDI_CC_IN) {
                     int value = ProportionCV(In(1), 127);
-                    usbMIDI.sendControlChange(1, value, channel + 1);
-                    usbMIDI.send_now();
+                    oc::MidiOut::SendControlChange(1, value, channel + 1);
                     UpdateLog(MIDI_CC, value, 0);
                     last_tick = oc::core::ticks;
                 }
@@ -119,18 +117,16 @@ public:
                 // Aftertouch
                 if (function == MIDI_AT_IN) {
                     int value = ProportionCV(In(1), 127);
-                    usbMIDI.sendAfterTouch(value, channel + 1);
-                    usbMIDI.send_now();
+                    oc::MidiOut::SendAfterTouch(value, channel + 1);
                     UpdateLog(MIDI_AFTERTOUCH, value, 0);
                     last_tick = oc::core::ticks;
                 }
 
                 // Pitch Bend
                 if (function == MIDI_PB_IN) {
-                    uint16_t bend = Proportion(In(1) + HEMISPHERE_3V_CV, HEMISPHERE_3V_CV * 2, 16383);
+                    uint16_t bend = Proportion<HEMISPHERE_3V_CV * 2>(In(1) + HEMISPHERE_3V_CV, 16383);
                     bend = constrain(bend, 0, 16383);
-                    usbMIDI.sendPitchBend(bend, channel + 1);
-                    usbMIDI.send_now();
+                    oc::MidiOut::SendPitchBend(bend, channel + 1);
                     UpdateLog(MIDI_PITCHBEND, bend - 8192, 0);
                     last_tick = oc::core::ticks;
                 }
@@ -308,36 +304,36 @@ private:
 ///  should prefer to handle things in the HemisphereApplet child class
 ///  above.
 ////////////////////////////////////////////////////////////////////////////////
-hMIDIOut hMIDIOut_instance[2];
+DECLARE_APPLET_INSTANCE(hMIDIOut)
 
 void hMIDIOut_Start(bool hemisphere) {
-    hMIDIOut_instance[hemisphere].BaseStart(hemisphere);
+    hemisphere::ConstructInSlot<hMIDIOut>(hemisphere).BaseStart(hemisphere);
 }
 
 void hMIDIOut_Controller(bool hemisphere, bool forwarding) {
-    hMIDIOut_instance[hemisphere].BaseController(forwarding);
+    hMIDIOut_instance(hemisphere).BaseController(forwarding);
 }
 
 void hMIDIOut_View(bool hemisphere) {
-    hMIDIOut_instance[hemisphere].BaseView();
+    hMIDIOut_instance(hemisphere).BaseView();
 }
 
 void hMIDIOut_OnButtonPress(bool hemisphere) {
-    hMIDIOut_instance[hemisphere].OnButtonPress();
+    hMIDIOut_instance(hemisphere).OnButtonPress();
 }
 
 void hMIDIOut_OnEncoderMove(bool hemisphere, int direction) {
-    hMIDIOut_instance[hemisphere].OnEncoderMove(direction);
+    hMIDIOut_instance(hemisphere).OnEncoderMove(direction);
 }
 
 void hMIDIOut_ToggleHelpScreen(bool hemisphere) {
-    hMIDIOut_instance[hemisphere].HelpScreen();
+    hMIDIOut_instance(hemisphere).HelpScreen();
 }
 
 uint64_t hMIDIOut_OnDataRequest(bool hemisphere) {
-    return hMIDIOut_instance[hemisphere].OnDataRequest();
+    return hMIDIOut_instance(hemisphere).OnDataRequest();
 }
 
 void hMIDIOut_OnDataReceive(bool hemisphere, uint64_t data) {
-    hMIDIOut_instance[hemisphere].OnDataReceive(data);
+    hMIDIOut_instance(hemisphere).OnDataReceive(data);
 }
@@ -22,6 +22,7 @@
 
 #include <Arduino.h>
 #include "oc/apps.h"
+#include "oc/ADC.h"
 #include "oc/digital_inputs.h"
 #include "oc/autotune.h"
 #include "oc/patterns.h"
@@ -29,6 +30,7 @@
 #include "oc/calibration.h"
 #include "oc/ui.h"
 #include "oc/menus.h"
+#include "util/rle.h"
 #include "apps/enigma/TuringMachine.h"
 #include "FreqMeasure.h"
 #include "ui/events.h"
@@ -74,22 +76,25 @@ EXTERN_APP(PONGGAME);
 EXTERN_APP(Backup);
 EXTERN_APP(Settings);
 
-#define DECLARE_APP(a, b, name, prefix) \
+#define DECLARE_APP_STORAGE(a, b, name, prefix, appendable) \
 { TWOCC<a,b>::value, name, \
   prefix ## _init, prefix ## _storageSize, prefix ## _save, prefix ## _restore, \
   prefix ## _handleAppEvent, \
   prefix ## _loop, prefix ## _menu, prefix ## _screensaver, \
   prefix ## _handleButtonEvent, \
   prefix ## _handleEncoderEvent, \
-  prefix ## _isr \
+  prefix ## _isr, \
+  appendable \
 }
 
+#define DECLARE_APP(a, b, name, prefix) DECLARE_APP_STORAGE(a, b, name, prefix, false)
+
 oc::App available_apps[] = {
 
   #ifdef ENABLE_APP_CALIBR8OR
   DECLARE_APP('C','8', "Calibr8or", Calibr8or),
   #endif
-  DECLARE_APP('H','S', "Hemisphere", HEMISPHERE),
+  DECLARE_APP_STORAGE('H','S', "Hemisphere", HEMISPHERE, true),
   #ifdef ENABLE_APP_ASR
   DECLARE_APP('A','S', "CopierMaschine", ASR),
   #endif
@@ -174,17 +179,31 @@ struct GlobalSettings {
 // this a bit more flexible during development.
 // Chunks are aligned on 2-byte boundaries for arbitrary reasons (thankfully M4
 // allows unaligned access...)
+//
+// The chunks are in the order of available_apps, which is also their priority
+// if they don't all fit: then the chunks are RLE-compressed where that helps
+// (marked in the length), and whatever still doesn't fit at the end is left
+// out. Keeping the layout the same from one save to the next means that only
+// the settings that actually changed get written to EEPROM.
 struct AppChunkHeader {
   uint16_t id;
   uint16_t length;
 } __attribute__((packed));
 
+static constexpr uint16_t APP_CHUNK_COMPRESSED = 0x8000;
+static constexpr uint16_t APP_CHUNK_LENGTH_MASK = 0x7fff;
+
+// Apps are saved here to compress them, and compressed ones restored from
+// here; larger apps are never compressed
+static constexpr size_t kAppChunkScratchSize = 256;
+static uint8_t app_chunk_scratch[kAppChunkScratchSize];
+
 struct AppData {
   static constexpr uint32_t FOURCC = FOURCC<'O','C','A',4>::value;
 
   static constexpr size_t kAppDataSize = EEPROM_APPDATA_BINARY_SIZE;
   char data[kAppDataSize];
-  size_t used;
+  uint32_t used;
 };
 
 typedef PageStorage<EEPROMStorage, EEPROM_GLOBALSETTINGS_START, EEPROM_GLOBALSETTINGS_END, GlobalSettings> GlobalSettingsStorage;
@@ -211,6 +230,7 @@ void save_global_settings() {
   global_settings.DAC_scaling = oc::DAC::store_scaling();
 
   global_settings_storage.Save(global_settings);
+  apps::last_save.changed += global_settings_storage.changed_bytes();
   SERIAL_PRINTLN("Saved global settings: page_index %d", global_settings_storage.page_index());
 }
 
@@ -220,59 +240,125 @@ void save_app_data() {
   app_settings.used = 0;
   char *data = app_settings.data;
   char *data_end = data + oc::AppData::kAppDataSize;
+  const char *stored = app_data_storage.data().data;
 
-  size_t start_app = random(NUM_AVAILABLE_APPS);
-  for (size_t i = 0; i < NUM_AVAILABLE_APPS; ++i) {
-    const auto &app = available_apps[(start_app + i) % NUM_AVAILABLE_APPS];
+  // Only compress if it's needed, since the layout then changes with the data
+  size_t raw_size = 0;
+  for (const auto &app : available_apps) {
     size_t storage_size = app.storageSize() + sizeof(AppChunkHeader);
-    if (storage_size & 1) ++storage_size; // Align chunks on 2-byte boundaries
-    if (storage_size > sizeof(AppChunkHeader) && app.Save) {
-      if (data + storage_size > data_end) {
-        SERIAL_PRINTLN("%s: ERROR: %u BYTES NEEDED, %u BYTES AVAILABLE OF %u BYTES TOTAL", app.name, storage_size, data_end - data, AppData::kAppDataSize);
-        continue;
-      }
+    if (storage_size & 1) ++storage_size;
+    if (storage_size > sizeof(AppChunkHeader) && app.Save)
+      raw_size += storage_size;
+  }
+  bool compress = raw_size > oc::AppData::kAppDataSize;
 
-      AppChunkHeader *chunk = reinterpret_cast<AppChunkHeader *>(data);
-      chunk->id = app.id;
-      chunk->length = storage_size;
-      #ifdef PRINT_DEBUG
-        SERIAL_PRINTLN("* %s (%02x) : Saved %u bytes... (%u)", app.name, app.id, app.Save(chunk + 1), storage_size);
-      #else
-        app.Save(chunk + 1);
-      #endif
-      app_settings.used += chunk->length;
-      data += chunk->length;
+  for (const auto &app : available_apps) {
+    size_t app_size = app.storageSize();
+    if (!app_size || !app.Save)
+      continue;
+
+    AppChunkHeader *chunk = reinterpret_cast<AppChunkHeader *>(data);
+    size_t available = data_end - data;
+    size_t storage_size = 0;
+    uint16_t flags = 0;
+    if (compress && app_size <= kAppChunkScratchSize && available > sizeof(AppChunkHeader)) {
+      app.Save(app_chunk_scratch);
+      size_t packed = util::RleEncode(app_chunk_scratch, app_size, reinterpret_cast<uint8_t *>(chunk + 1), available - sizeof(AppChunkHeader));
+      if (packed && packed < app_size) {
+        storage_size = packed + sizeof(AppChunkHeader);
+        flags = APP_CHUNK_COMPRESSED;
+        ++apps::last_save.compressed_apps;
+      } else if (app_size + sizeof(AppChunkHeader) <= available) {
+        memcpy(chunk + 1, app_chunk_scratch, app_size);
+        storage_size = app_size + sizeof(AppChunkHeader);
+      }
+    } else if (app_size + sizeof(AppChunkHeader) <= available) {
+      app.Save(chunk + 1);
+      storage_size = app_size + sizeof(AppChunkHeader);
+    }
+    bool padded = storage_size & 1;
+    if (padded) ++storage_size; // Align chunks on 2-byte boundaries
+    if (!storage_size || storage_size > available) {
+      SERIAL_PRINTLN("%s: ERROR: %u BYTES NEEDED, %u BYTES AVAILABLE OF %u BYTES TOTAL", app.name, app_size + sizeof(AppChunkHeader), available, AppData::kAppDataSize);
+      ++apps::last_save.skipped_apps;
+      continue;
     }
+    // Padding that doesn't change between saves, and that decodes as nothing
+    // in a compressed chunk
+    if (padded) data[storage_size - 1] = flags ? util::kRleNop : 0;
+
+    chunk->id = app.id;
+    chunk->length = storage_size | flags;
+    bool dirty = memcmp(data, stored + (data - app_settings.data), storage_size);
+    if (dirty) ++apps::last_save.dirty_apps;
+    SERIAL_PRINTLN("* %s (%02x) : %u bytes%s%s", app.name, app.id, storage_size, flags ? ", compressed" : "", dirty ? ", changed" : "");
+    app_settings.used += storage_size;
+    data += storage_size;
   }
   SERIAL_PRINTLN("App settings used: %u/%u", app_settings.used, EEPROM_APPDATA_BINARY_SIZE);
   app_data_storage.Save(app_settings);
+  apps::last_save.used = app_settings.used;
+  apps::last_save.changed += app_data_storage.changed_bytes();
   SERIAL_PRINTLN("Saved app settings in page_index %d", app_data_storage.page_index());
 }
 
 void restore_app_data() {
   SERIAL_PRINTLN("Restoring app data from page_index %d, used=%u", app_data_storage.page_index(), app_settings.used);
 
-  const char *data = app_settings.data;
-  const char *data_end = data + app_settings.used;
+  char *data = app_settings.data;
+  char *data_end = data + app_settings.used;
   size_t restored_bytes = 0;
 
   while (data < data_end) {
-    const AppChunkHeader *chunk = reinterpret_cast<const AppChunkHeader *>(data);
-    if (data + chunk->length > data_end) {
-      SERIAL_PRINTLN("App chunk length %u exceeds available space (%u)", chunk->length, data_end - data);
+    AppChunkHeader *chunk = reinterpret_cast<AppChunkHeader *>(data);
+    size_t chunk_length = chunk->length & APP_CHUNK_LENGTH_MASK;
+    if (data + chunk_length > data_end) {
+      SERIAL_PRINTLN("App chunk length %u exceeds available space (%u)", chunk_length, data_end - data);
       break;
     }
 
     App *app = apps::find(chunk->id);
     if (!app) {
-      SERIAL_PRINTLN("App %02x not found, ignoring chunk...", app->id);
-      if (!chunk->length)
+      SERIAL_PRINTLN("App %02x not found, ignoring chunk...", chunk->id);
+      if (!chunk_length)
         break;
-      data += chunk->length;
+      data += chunk_length;
+      continue;
+    }
+
+    if (chunk->length & APP_CHUNK_COMPRESSED) {
+      size_t app_size = app->storageSize();
+      size_t unpacked = 0;
+      if (app_size <= kAppChunkScratchSize)
+        unpacked = util::RleDecode(reinterpret_cast<const uint8_t *>(chunk + 1), chunk_length - sizeof(AppChunkHeader), app_chunk_scratch, app_size);
+      if (unpacked && unpacked < app_size && app->appendable_storage) {
+        memset(app_chunk_scratch + unpacked, 0, app_size - unpacked);
+        unpacked = app_size;
+      }
+      if (unpacked != app_size) {
+        SERIAL_PRINTLN("* %s (%02x): compressed chunk unpacks to %u != %u, skipping...", app->name, chunk->id, unpacked, app_size);
+      } else if (app->Restore) {
+        app->Restore(app_chunk_scratch);
+        restored_bytes += chunk_length;
+      }
+      data += chunk_length;
       continue;
     }
+
     size_t expected_length = app->storageSize() + sizeof(AppChunkHeader);
     if (expected_length & 0x1) ++expected_length;
+    if (chunk->length < expected_length && app->appendable_storage &&
+        app_settings.used + expected_length - chunk->length <= AppData::kAppDataSize) {
+      // Make room for the part this chunk doesn't have yet; the chunks after
+      // it are moved along, since they haven't been restored yet
+      size_t missing = expected_length - chunk->length;
+      memmove(data + expected_length, data + chunk->length, data_end - (data + chunk->length));
+      memset(data + chunk->length, 0, missing);
+      data_end += missing;
+      app_settings.used += missing;
+      SERIAL_PRINTLN("* %s (%02x): chunk length %u < %u, restoring with %u bytes zeroed", app->name, chunk->id, chunk->length, expected_length, missing);
+      chunk->length = expected_length;
+    }
     if (chunk->length != expected_length) {
       SERIAL_PRINTLN("* %s (%02x): chunk length %u != %u (storageSize=%u), skipping...", app->name, chunk->id, chunk->length, expected_length, app->storageSize());
       data += chunk->length;
@@ -295,9 +381,24 @@ void restore_app_data() {
 
 namespace apps {
 
+SaveStats last_save;
+
+void SaveSettings() {
+  uint32_t start = micros();
+  memset(&last_save, 0, sizeof(last_save));
+  save_global_settings();
+  save_app_data();
+  last_save.us = micros() - start;
+  SERIAL_PRINTLN("Save: %u bytes changed, %u apps changed, %u compressed, %u skipped, %u us",
+                 last_save.changed, last_save.dirty_apps, last_save.compressed_apps,
+                 last_save.skipped_apps, last_save.us);
+}
+
 void set_current_app(int index) {
   current_app = &available_apps[index];
   global_settings.current_app_id = current_app->id;
+  // Apps that need something else set it on APP_EVENT_RESUME
+  oc::ADC::set_filter_profile(oc::ADC::FILTER_PROFILE_STANDARD);
 }
 
 App *current_app = &available_apps[DEFAULT_APP_INDEX];
@@ -506,8 +607,7 @@ void Ui::AppSettings() {
     FreqMeasure.end();
     oc::DigitalInputs::reInit();
     if (save) {
-      save_global_settings();
-      save_app_data();
+      apps::SaveSettings();
       // draw message:
       int cnt = 0;
       while(idle_time() < SETTINGS_SAVE_TIMEOUT_MS)
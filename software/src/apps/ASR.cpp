@@ -429,8 +429,12 @@ public:
         }
         _ASR.Freeze(_buflen);
       }
-      else
+      else {
+        // Only the history is used, so make room by dropping the oldest
+        if (!_ASR.writable())
+          _ASR.Consume(1);
         _ASR.Write(_sample);
+      }
 
       // update outputs:
       _offset = _delay;
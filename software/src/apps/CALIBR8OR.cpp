@@ -211,9 +211,9 @@ public:
         bool reset = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_4>();
         bool midi_sync = 0;
 
-        // flush MIDI input and catch incoming Clock
-        while (usbMIDI.read()) {
-            switch (usbMIDI.getType()) {
+        // catch incoming MIDI Clock and transport
+        while (const oc::MidiMessage *midi = oc::MidiIn::Read(midi_subscription)) {
+            switch (midi->type) {
             case usbMIDI.Clock:
                 clock_sync = 1;
                 midi_sync = 1;
@@ -225,9 +225,6 @@ public:
                 clock_m->Stop();
                 break;
             }
-            // TODO: do we need to handle any other MIDI input?
-            // We will have to in Hemisphere... for the MIDI In applet.
-            // Might need to delegate other messages or something
         }
         if (midi_sync) clock_m->SetClockPPQN(24); // rudely snap to MIDI clock sync speed
 
@@ -468,6 +465,10 @@ public:
 private:
     int index = 0;
 
+    // MIDI Clock and transport only
+    oc::MidiSubscription midi_subscription {
+      oc::MidiTypeBit(usbMIDI.Clock) | oc::MidiTypeBit(usbMIDI.Start) | oc::MidiTypeBit(usbMIDI.Stop) };
+
 	int sel_chan = 0;
     bool edit_mode = 0;
     bool scale_edit = 0;
@@ -626,6 +627,7 @@ void Calibr8or_isr() { return Calibr8or_instance.BaseController(); }
 void Calibr8or_handleAppEvent(oc::AppEvent event) {
     switch (event) {
     case oc::APP_EVENT_RESUME:
+        oc::ADC::set_filter_profile(oc::ADC::FILTER_PROFILE_LOW_LATENCY);
         Calibr8or_instance.Resume();
         break;
 
@@ -1214,6 +1214,7 @@ size_t DQ_restore(const void *storage) {
 void DQ_handleAppEvent(oc::AppEvent event) {
   switch (event) {
     case oc::APP_EVENT_RESUME:
+      oc::ADC::set_filter_profile(oc::ADC::FILTER_PROFILE_LOW_LATENCY);
       dq_state.cursor.set_editing(false);
       dq_state.scale_editor.Close();
       break;
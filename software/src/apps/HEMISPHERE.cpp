@@ -5,7 +5,8 @@
 //// Hemisphere Manager
 ////////////////////////////////////////////////////////////////////////////////
 
-// TOTAL EEPROM SIZE: 4 * 26 bytes
+// TOTAL EEPROM SIZE: 4 * 26 bytes, then 4 * HEMISPHERE_PRESET_BLOB_SIZE, then
+// 6 bytes of output quantizer settings, which all the presets share
 SETTINGS_DECLARE(hemisphere::Preset, static_cast<size_t>(hemisphere::Setting::LAST)) {
     {0, 0, 255, "Applet ID L", NULL, settings::STORAGE_TYPE_U8},
     {0, 0, 255, "Applet ID R", NULL, settings::STORAGE_TYPE_U8},
@@ -23,9 +24,13 @@ SETTINGS_DECLARE(hemisphere::Preset, static_cast<size_t>(hemisphere::Setting::LA
     {0, 0, 65535, "Clock data 4", NULL, settings::STORAGE_TYPE_U16}
 };
 
-void ReceiveManagerSysEx() {
-    if (hemisphere::active_preset)
-        hemisphere::active_preset->OnReceiveSysEx();
+void SelectManagerApplet(int hemisphere, int applet_id) {
+    for (int i = 0; i < hemisphere::kNumAvailableApplets; ++i) {
+        if (hemisphere::available_applets[i].id == applet_id) {
+            manager.SetApplet(hemisphere, i);
+            break;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,7 +43,8 @@ void HEMISPHERE_init() {
 }
 
 size_t HEMISPHERE_storageSize() {
-    return hemisphere::Preset::storageSize() * hemisphere::kNumPresets;
+    return (hemisphere::Preset::storageSize() + hemisphere::Preset::blobSize()) * hemisphere::kNumPresets +
+           hemisphere::Manager::quantizersSize();
 }
 
 size_t HEMISPHERE_save(void *storage) {
@@ -46,6 +52,10 @@ size_t HEMISPHERE_save(void *storage) {
     for (int i = 0; i < hemisphere::kNumPresets; ++i) {
         used += hemisphere::presets[i].Save(static_cast<char*>(storage) + used);
     }
+    for (int i = 0; i < hemisphere::kNumPresets; ++i) {
+        used += hemisphere::presets[i].SaveBlob(static_cast<char*>(storage) + used);
+    }
+    used += manager.SaveQuantizers(static_cast<char*>(storage) + used);
     return used;
 }
 
@@ -54,6 +64,13 @@ size_t HEMISPHERE_restore(const void *storage) {
     for (int i = 0; i < hemisphere::kNumPresets; ++i) {
         used += hemisphere::presets[i].Restore(static_cast<const char*>(storage) + used);
     }
+    // Settings saved before there were blobs come with zeros here (see
+    // restore_app_data), which is no blob
+    for (int i = 0; i < hemisphere::kNumPresets; ++i) {
+        used += hemisphere::presets[i].RestoreBlob(static_cast<const char*>(storage) + used);
+    }
+    // Likewise the output quantizers, which come out as off
+    used += manager.RestoreQuantizers(static_cast<const char*>(storage) + used);
     manager.Resume();
     return used;
 }
@@ -27,6 +27,7 @@
 
 #include "hemisphere/application_base.hpp"
 #include "hemisphere/midi.hpp"
+#include "oc/midi_out.h"
 #include "util/settings.h"
 #include "oc/apps.h"
 #include "oc/ui.h"
@@ -303,13 +304,7 @@ public:
         Reset();
 
         // Send all notes off on every channel
-        for (int note = 0; note < 128; note++)
-        {
-            for (int channel = 1; channel <= 16; channel++)
-            {
-                usbMIDI.sendNoteOff(note, 0, channel);
-            }
-        }
+        oc::MidiOut::AllNotesOff();
     }
 
     /* When the app is suspended, it sends out a system exclusive dump, generated here */
@@ -393,6 +388,7 @@ public:
 
 private:
     // Housekeeping
+    oc::MidiSubscription midi_subscription { oc::MIDI_TYPE_ALL & ~oc::MidiTypeBit(MIDI_SYSEX) };
     int screen; // 0=Assign 2=Channel 3=Transpose
     bool display; // 0=Setup Edit 1=Log
     bool copy_mode; // Copy mode on/off
@@ -556,7 +552,7 @@ private:
 
                     if (legato_on[ch] && midi_note != note_out[ch]) {
                         // Send note off if the note has changed
-                        usbMIDI.sendNoteOff(note_out[ch], 0, last_channel[ch]);
+                        oc::MidiOut::SendNoteOff(note_out[ch], 0, last_channel[ch]);
                         UpdateLog(0, ch, 1, last_channel[ch], note_out[ch], 0);
                         note_out[ch] = -1;
                         indicator = 1;
@@ -571,11 +567,11 @@ private:
                         for (int vch = 0; vch < 4; vch++)
                         {
                             if (get_out_assign(vch) == MIDI_OUT_VELOCITY && get_out_channel(vch) == out_ch) {
-                                velocity = Proportion(In(vch), FIVE_VOLTS, 127);
+                                velocity = Proportion<FIVE_VOLTS>(In(vch), 127);
                             }
                         }
                         velocity = constrain(velocity, 0, 127);
-                        usbMIDI.sendNoteOn(midi_note, velocity, out_ch);
+                        oc::MidiOut::SendNoteOn(midi_note, velocity, out_ch);
                         UpdateLog(0, ch, 0, out_ch, midi_note, velocity);
                         indicator = 1;
                         note_out[ch] = midi_note;
@@ -585,7 +581,7 @@ private:
                 }
 
                 if (!read_gate && gated[ch]) { // A note off message should be sent
-                    usbMIDI.sendNoteOff(note_out[ch], 0, last_channel[ch]);
+                    oc::MidiOut::SendNoteOff(note_out[ch], 0, last_channel[ch]);
                     UpdateLog(0, ch, 1, last_channel[ch], note_out[ch], 0);
                     note_out[ch] = -1;
                     indicator = 1;
@@ -606,29 +602,29 @@ private:
                     if (out_fn == MIDI_OUT_BREATH) cc = 2;
                     if (out_fn == MIDI_OUT_Y_AXIS) cc = 74;
 
-                    int value = Proportion(In(ch), FIVE_VOLTS, 127);
+                    int value = Proportion<FIVE_VOLTS>(In(ch), 127);
                     value = constrain(value, 0, 127);
                     if (cc == 64) value = (value >= 60) ? 127 : 0; // On or off for sustain pedal
 
-                    usbMIDI.sendControlChange(cc, value, out_ch);
+                    oc::MidiOut::SendControlChange(cc, value, out_ch);
                     UpdateLog(0, ch, 2, out_ch, cc, value);
                     indicator = 1;
                 }
 
                 // Aftertouch
                 if (out_fn == MIDI_OUT_AFTERTOUCH) {
-                    int value = Proportion(In(ch), FIVE_VOLTS, 127);
+                    int value = Proportion<FIVE_VOLTS>(In(ch), 127);
                     value = constrain(value, 0, 127);
-                    usbMIDI.sendAfterTouch(value, out_ch);
+                    oc::MidiOut::SendAfterTouch(value, out_ch);
                     UpdateLog(0, ch, 3, out_ch, 0, value);
                     indicator = 1;
                 }
 
                 // Pitch Bend
                 if (out_fn == MIDI_OUT_PITCHBEND) {
-                    int16_t bend = Proportion(In(ch) + THREE_VOLTS, THREE_VOLTS * 2, 16383);
+                    int16_t bend = Proportion<THREE_VOLTS * 2>(In(ch) + THREE_VOLTS, 16383);
                     bend = constrain(bend, 0, 16383);
-                    usbMIDI.sendPitchBend(bend, out_ch);
+                    oc::MidiOut::SendPitchBend(bend, out_ch);
                     UpdateLog(0, ch, 4, out_ch, 0, bend - 8192);
                     indicator = 1;
                 }
@@ -639,14 +635,14 @@ private:
     }
 
     void midi_in() {
-        if (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int channel = usbMIDI.getChannel();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
+        // Handle system exclusive dump for Setup data
+        ListenForSysEx();
 
-            // Handle system exclusive dump for Setup data
-            if (message == MIDI_SYSEX) OnReceiveSysEx();
+        while (const oc::MidiMessage *midi = oc::MidiIn::Read(midi_subscription)) {
+            int message = midi->type;
+            int channel = midi->channel;
+            int data1 = midi->data1;
+            int data2 = midi->data2;
 
             // Listen for incoming clock
             if (message == MIDI_CLOCK) {
@@ -696,7 +692,7 @@ private:
 
                         if (in_fn == MIDI_IN_VELOCITY) {
                             // Send velocity data to CV
-                            Out(ch, Proportion(data2, 127, FIVE_VOLTS));
+                            Out(ch, Proportion<127>(data2, FIVE_VOLTS));
                             indicator = 1;
                         }
                     }
@@ -730,7 +726,7 @@ private:
                     // Send CC wheel to CV
                     if (data1 == cc) {
                         if (in_fn == MIDI_IN_HOLD && data2 > 0) data2 = 127;
-                        Out(ch, Proportion(data2, 127, FIVE_VOLTS));
+                        Out(ch, Proportion<127>(data2, FIVE_VOLTS));
                         UpdateLog(1, ch, 2, in_ch, data1, data2);
                         indicator = 1;
                     }
@@ -738,7 +734,7 @@ private:
 
                 if (message == MIDI_AFTERTOUCH && in_fn == MIDI_IN_AFTERTOUCH && in_ch == channel) {
                     // Send aftertouch to CV
-                    Out(ch, Proportion(data1, 127, FIVE_VOLTS));
+                    Out(ch, Proportion<127>(data1, FIVE_VOLTS));
                     UpdateLog(1, ch, 3, in_ch, data1, data2);
                     indicator = 1;
                 }
@@ -746,7 +742,7 @@ private:
                 if (message == MIDI_PITCHBEND && in_fn == MIDI_IN_PITCHBEND && in_ch == channel) {
                     // Send pitch bend to CV
                     int data = (data2 << 7) + data1 - 8192;
-                    Out(ch, Proportion(data, 0x7fff, THREE_VOLTS));
+                    Out(ch, Proportion<0x7fff>(data, THREE_VOLTS));
                     UpdateLog(1, ch, 4, in_ch, 0, data);
                     indicator = 1;
                 }
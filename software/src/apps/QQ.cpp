@@ -1247,6 +1247,7 @@ size_t QQ_restore(const void *storage) {
 void QQ_handleAppEvent(oc::AppEvent event) {
   switch (event) {
     case oc::APP_EVENT_RESUME:
+      oc::ADC::set_filter_profile(oc::ADC::FILTER_PROFILE_LOW_LATENCY);
       qq_state.cursor.set_editing(false);
       qq_state.scale_editor.Close();
       break;
@@ -2131,6 +2131,14 @@ void SEQ_handleAppEvent(oc::AppEvent event) {
 void SEQ_loop() {
 }
 
+// External clock period in ticks, from the edge timestamps when available
+static uint32_t ext_clock_ticks(oc::DigitalInput input, uint32_t ticks) {
+  uint32_t period = oc::DigitalInputs::edge_period(input);
+  if (!period)
+    return ticks;
+  return (period + oc::DigitalInputs::kCyclesPerTick / 2) / oc::DigitalInputs::kCyclesPerTick;
+}
+
 void SEQ_isr() {
 
   ticks_src1++; // src #1 ticks
@@ -2140,11 +2148,11 @@ void SEQ_isr() {
   uint32_t triggers = oc::DigitalInputs::clocked();
 
   if (triggers & (1 << oc::DIGITAL_INPUT_1)) {
-    ext_frequency[SEQ_CHANNEL_TRIGGER_TR1] = ticks_src1;
+    ext_frequency[SEQ_CHANNEL_TRIGGER_TR1] = ext_clock_ticks(oc::DIGITAL_INPUT_1, ticks_src1);
     ticks_src1 = 0x0;
   }
   if (triggers & (1 << oc::DIGITAL_INPUT_3)) {
-    ext_frequency[SEQ_CHANNEL_TRIGGER_TR2] = ticks_src2;
+    ext_frequency[SEQ_CHANNEL_TRIGGER_TR2] = ext_clock_ticks(oc::DIGITAL_INPUT_3, ticks_src2);
     ticks_src2 = 0x0;
   }
 
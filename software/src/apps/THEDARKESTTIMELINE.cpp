@@ -32,6 +32,7 @@
 #include "oc/scales.h"
 #include "hemisphere/application_base.hpp"
 #include "hemisphere/midi.hpp"
+#include "oc/midi_out.h"
 #include "oc/strings.h"
 #include "oc/apps.h"
 #include "oc/ui.h"
@@ -82,14 +83,14 @@ public:
         bool note_on = 0;
         uint8_t in_note_number = 0;
         uint8_t in_velocity = 0;
-        if (usbMIDI.read()) {
-            int message = usbMIDI.getType();
-            int channel = usbMIDI.getChannel();
-            int data1 = usbMIDI.getData1();
-            int data2 = usbMIDI.getData2();
+        // Handle system exclusive dump for Setup data
+        ListenForSysEx();
 
-            // Handle system exclusive dump for Setup data
-            if (message == MIDI_SYSEX) OnReceiveSysEx();
+        while (const oc::MidiMessage *midi = oc::MidiIn::Read(midi_subscription)) {
+            int message = midi->type;
+            int channel = midi->channel;
+            int data1 = midi->data1;
+            int data2 = midi->data2;
 
             if (message == MIDI_NOTE_ON && channel == midi_channel_in()) {
                 note_on = 1;
@@ -104,7 +105,7 @@ public:
             last_tempo = oc::core::ticks - last_clock_event;
             last_clock_event = oc::core::ticks;
             if (gate_time() > 0) {
-                gate_ticks = Proportion(gate_time(), 100, last_tempo);
+                gate_ticks = Proportion<100>(gate_time(), last_tempo);
             }
 
             // Reverse direction with gate at Digital 2
@@ -144,7 +145,7 @@ public:
                         if (tl == 0) { // Write to CV Timeline based on note number
                             write_cv = MIDIQuantizer::CV(in_note_number);
                         } else { // Write to Probability Timeline based on velocity
-                            write_cv = Proportion(in_velocity, 127, FIVE_VOLTS);
+                            write_cv = Proportion<127>(in_velocity, FIVE_VOLTS);
                         }
                         write_data_at(idx, tl, write_cv);
                     }
@@ -188,12 +189,12 @@ public:
                     ClockOut(2, gate_ticks);
 
                     // Send the MIDI Note On
-                    if (last_midi_note[0] > -1) usbMIDI.sendNoteOff(last_midi_note[0], 0, last_midi_channel[0]);
+                    if (last_midi_note[0] > -1) oc::MidiOut::SendNoteOff(last_midi_note[0], 0, last_midi_channel[0]);
                     if (midi_channel()) {
                         last_midi_channel[0] = midi_channel();
                         last_midi_note[0] = MIDIQuantizer::NoteNumber(get_data_at(idx, DT_CV_TIMELINE), transpose);
-                        vel = Proportion(cv, FIVE_VOLTS, 127);
-                        usbMIDI.sendNoteOn(last_midi_note[0], vel, last_midi_channel[0]);
+                        vel = Proportion<FIVE_VOLTS>(cv, 127);
+                        oc::MidiOut::SendNoteOn(last_midi_note[0], vel, last_midi_channel[0]);
                         last_length[0] = oc::core::ticks - last_clock[0];
                         last_clock[0] = oc::core::ticks;
                     }
@@ -205,13 +206,13 @@ public:
                     ClockOut(3, gate_ticks);
 
                     // Send the MIDI Note On for Alternate Universe
-                    if (last_midi_note[1] > -1) usbMIDI.sendNoteOff(last_midi_note[1], 0, last_midi_channel[1]);
+                    if (last_midi_note[1] > -1) oc::MidiOut::SendNoteOff(last_midi_note[1], 0, last_midi_channel[1]);
                     if (midi_channel_alt()) {
                         last_midi_channel[1] = midi_channel_alt();
                         uint8_t alt_idx = (idx + length()) % 32;
                         last_midi_note[1] = MIDIQuantizer::NoteNumber(get_data_at(alt_idx, DT_CV_TIMELINE));
-                        vel = Proportion(get_data_at(alt_idx, DT_PROBABILITY_TIMELINE), FIVE_VOLTS, 127);
-                        usbMIDI.sendNoteOn(last_midi_note[1], vel, last_midi_channel[1]);
+                        vel = Proportion<FIVE_VOLTS>(get_data_at(alt_idx, DT_PROBABILITY_TIMELINE), 127);
+                        oc::MidiOut::SendNoteOn(last_midi_note[1], vel, last_midi_channel[1]);
                         last_length[1] = oc::core::ticks - last_clock[1];
                         last_clock[1] = oc::core::ticks;
                     }
@@ -223,7 +224,7 @@ public:
         for (uint8_t ch = 0; ch < 2; ch++)
         {
             if (last_midi_note[ch] > -1 && (oc::core::ticks - last_clock[ch]) > (last_length[ch]) * 2) {
-                usbMIDI.sendNoteOff(last_midi_note[ch], 0, last_midi_channel[ch]);
+                oc::MidiOut::SendNoteOff(last_midi_note[ch], 0, last_midi_channel[ch]);
                 last_midi_note[ch] = -1;
             }
         }
@@ -375,6 +376,7 @@ public:
 
 private:
     // Internal States
+    oc::MidiSubscription midi_subscription { oc::MidiTypeBit(MIDI_NOTE_ON) };
     int8_t cursor; // The play/record point within the sequence
     bool record[2]; // 0 = CV Timeline, 1 = Proability Timeline
     bool index_edit_enabled; // The index is being edited via the panel
@@ -415,7 +417,7 @@ private:
     }
 
     void DrawColumn(int pos, int y_offset, int cv, bool is_recording, bool is_index) {
-        uint8_t height = Proportion(cv, FIVE_VOLTS, 22);
+        uint8_t height = Proportion<FIVE_VOLTS>(cv, 22);
         uint8_t width = (128 / length()) / 2;
         uint8_t x_pos = (128 / length()) * pos;
         uint8_t x_offset = width / 2;
@@ -65,7 +65,7 @@ public:
             if (DetentedIn(ch) && Changed(ch)) {
             		int cv = In(ch);
             		cv = constrain(cv, 0, FIVE_VOLTS);
-                int freq = Proportion(In(ch), FIVE_VOLTS, mod_range_high[ch] - mod_range_low[ch]) + mod_range_low[ch];
+                int freq = Proportion<FIVE_VOLTS>(In(ch), mod_range_high[ch] - mod_range_low[ch]) + mod_range_low[ch];
                 freq = constrain(freq, mod_range_low[ch], mod_range_high[ch]);
                 test[ch].SetFrequency(freq);
                 test_freq[ch] = freq;
@@ -260,11 +260,11 @@ private:
         uint16_t total_time = osc.TotalTime();
         VOSegment seg = osc.GetSegment(osc.SegmentCount() - 1);
         byte prev_x = 0; // Starting coordinates
-        byte prev_y = 63 - Proportion(seg.level, 255, 40);
+        byte prev_y = 63 - Proportion<255>(seg.level, 40);
         for (byte i = 0; i < osc.SegmentCount(); i++)
         {
             seg = osc.GetSegment(i);
-            byte y = 63 - Proportion(seg.level, 255, 40);
+            byte y = 63 - Proportion<255>(seg.level, 40);
             byte seg_x = Proportion(seg.time, total_time, 128);
             byte x = prev_x + seg_x;
             byte p = segment_number == i ? 1 : 2;
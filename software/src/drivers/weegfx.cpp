@@ -45,7 +45,6 @@ const uint8_t test_bitmap[8] = {
 // - Bench templated draw_pixel_row (inlined versions) vs. function pointers
 // - Offer specialized functions w/o clipping or specific draw mode?
 // - Remainder masks as LUT or switch
-// - 32bit ops? Should be possible along x-axis (use SIMD instructions?) but not y (page stride)
 // - Clipping for x, y < 0
 // - Support 16 bit text characters?
 // - Kerning/BBX etc.
@@ -70,16 +69,47 @@ inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) __
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, const uint8_t *src) __attribute__((always_inline));
 
+// Each byte of a page is one column, so the columns of a row can be done four
+// at a time with the mask repeated in each byte of a word. The frame is word
+// aligned; on the M4 unaligned words would work too, but cost an extra cycle.
+typedef uint32_t __attribute__((__may_alias__)) pixel_word;
+
+template <weegfx::DRAW_MODE draw_mode, typename T>
+inline void draw_pixels(T *dst, T mask) __attribute__((always_inline));
+
+template <weegfx::DRAW_MODE draw_mode, typename T>
+inline void draw_pixels(T *dst, T mask) {
+  switch (draw_mode) {
+    case weegfx::DRAW_NORMAL: *dst |= mask; break;
+    case weegfx::DRAW_INVERSE: *dst ^= mask; break;
+    case weegfx::DRAW_OVERWRITE: *dst = mask; break;
+    case weegfx::DRAW_CLEAR: *dst &= ~mask; break;
+    default: break;
+  }
+}
+
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) {
-  while (count-- > 0x0) {
-    switch (draw_mode) {
-      case weegfx::DRAW_NORMAL: *dst++ |= mask; break;
-      case weegfx::DRAW_INVERSE: *dst++ ^= mask; break;
-      case weegfx::DRAW_OVERWRITE: *dst++ = mask; break;
-      case weegfx::DRAW_CLEAR: *dst++ &= ~mask; break;
-      case weegfx::DRAW_DOT: { *dst++|= mask; *dst++|= mask; *dst++ |= 0x0; *dst++ |= 0x0; count -= 0x3; } break;
+  if (draw_mode == weegfx::DRAW_DOT) {
+    while (count-- > 0x0) {
+      *dst++|= mask; *dst++|= mask; *dst++ |= 0x0; *dst++ |= 0x0; count -= 0x3;
     }
+    return;
+  }
+
+  while (count > 0 && (reinterpret_cast<uintptr_t>(dst) & 0x3)) {
+    draw_pixels<draw_mode, uint8_t>(dst++, mask);
+    --count;
+  }
+  const uint32_t word_mask = mask * 0x01010101U;
+  pixel_word *word = reinterpret_cast<pixel_word *>(dst);
+  while (count >= 4) {
+    draw_pixels<draw_mode, pixel_word>(word++, word_mask);
+    count -= 4;
+  }
+  dst = reinterpret_cast<uint8_t *>(word);
+  while (count-- > 0) {
+    draw_pixels<draw_mode, uint8_t>(dst++, mask);
   }
 }
 
@@ -168,6 +198,12 @@ void Graphics::clearRect(coord_t x, coord_t y, coord_t w, coord_t h) {
   draw_rect<DRAW_CLEAR>(get_frame_ptr(x, y), y, w, h);
 }
 
+void Graphics::copyColumns(const uint8_t *frame, coord_t x, coord_t w) {
+  CLIPX(x, w);
+  for (size_t page = 0; page < kHeight / 8; ++page)
+    memcpy(frame_ + page * kWidth + x, frame + page * kWidth + x, w);
+}
+
 void Graphics::invertRect(coord_t x, coord_t y, coord_t w, coord_t h) {
   CLIPX(x, w);
   CLIPY(y, h);
@@ -395,36 +431,89 @@ static inline weegfx::font_glyph get_char_glyph(char c) {
   return ssd1306xled_font6x8 + Graphics::kFixedFontW * (c - 32);
 }
 
+static constexpr weegfx::coord_t kNumGlyphs = sizeof(ssd1306xled_font6x8) / Graphics::kFixedFontW;
+
+// Unaligned loads and stores, single instructions on the M4
+static inline uint32_t load_word(const uint8_t *src) __attribute__((always_inline));
+static inline uint32_t load_word(const uint8_t *src) {
+  uint32_t word;
+  memcpy(&word, src, sizeof(word));
+  return word;
+}
+
+static inline void store_word(uint8_t *dst, uint32_t word) __attribute__((always_inline));
+static inline void store_word(uint8_t *dst, uint32_t word) {
+  memcpy(dst, &word, sizeof(word));
+}
+
+static inline uint16_t load_half(const uint8_t *src) __attribute__((always_inline));
+static inline uint16_t load_half(const uint8_t *src) {
+  uint16_t half;
+  memcpy(&half, src, sizeof(half));
+  return half;
+}
+
+static inline void store_half(uint8_t *dst, uint16_t half) __attribute__((always_inline));
+static inline void store_half(uint8_t *dst, uint16_t half) {
+  memcpy(dst, &half, sizeof(half));
+}
+
+// Move the pixels of the columns packed in a word down (towards the next page)
+// or up by n rows, 0 < n < 8, dropping what leaves the page
+static inline uint32_t shift_columns_down(uint32_t columns, unsigned n) {
+  return (columns << n) & (0x01010101U * ((0xff << n) & 0xff));
+}
+
+static inline uint32_t shift_columns_up(uint32_t columns, unsigned n) {
+  return (columns >> n) & (0x01010101U * (0xff >> n));
+}
+
+// A whole glyph is ORed into each page it touches as a word and a halfword.
+// Glyphs that are clipped on the left or right fall back to bytes.
 // OPTIMIZE When printing strings, all chars will have the same y/remainder
-// This will probably only save a few cycles, if any. Also the clipping can
-// be made optional (template?)
 void Graphics::draw_char(char c, coord_t x, coord_t y) {
   if (!c) c = '0';
-  if (c <= 32 || c > 127)
+  if (c <= 32 || c >= 32 + kNumGlyphs)
     return;
 
-  coord_t w = Graphics::kFixedFontW;
-  coord_t h = Graphics::kFixedFontH;
   font_glyph data = get_char_glyph(c);
-  if (c + w > kWidth) w = kWidth - x;
+  coord_t w = kFixedFontW;
+  if (x + w > kWidth) w = kWidth - x;
   if (x < 0) {
     w += x;
-    data += x;
+    data -= x;
+    x = 0;
   }
-  if (w <= 0) return;
-  CLIPY(y, h);
-
-  uint8_t *dest = get_frame_ptr(x, y);
-  coord_t remainder = y & 0x7;
-  if (!remainder) {
-    SETPIXELS_H(dest, w, *data++);
+  if (w <= 0 || y <= -kFixedFontH || y >= kHeight) return;
+
+  // The glyph's rows end up in the page at y and, unless it's aligned, shifted
+  // into the one below; either may be off screen
+  coord_t page = y >> 3; // rounds down for y < 0
+  unsigned remainder = y & 0x7;
+  uint8_t *upper = page >= 0 ? frame_ + (page << 7) + x : nullptr;
+  uint8_t *lower = remainder && page < kHeight / 8 - 1 ? frame_ + ((page + 1) << 7) + x : nullptr;
+
+  if (w == kFixedFontW) {
+    static_assert(kFixedFontW == 6, "Glyphs are a word and a halfword");
+    uint32_t head = load_word(data);
+    uint32_t tail = load_half(data + 4);
+    if (!remainder) {
+      store_word(upper, load_word(upper) | head);
+      store_half(upper + 4, load_half(upper + 4) | tail);
+      return;
+    }
+    if (upper) {
+      store_word(upper, load_word(upper) | shift_columns_down(head, remainder));
+      store_half(upper + 4, load_half(upper + 4) | shift_columns_down(tail, remainder));
+    }
+    if (lower) {
+      store_word(lower, load_word(lower) | shift_columns_up(head, 8 - remainder));
+      store_half(lower + 4, load_half(lower + 4) | shift_columns_up(tail, 8 - remainder));
+    }
   } else {
-    const uint8_t *src = data;
-    SETPIXELS_H(dest, w, (*src++) << remainder);
-    if (h >= 8) {
-      dest += kWidth;
-      src = data;
-      SETPIXELS_H(dest, w, (*src++) >> (8 - remainder));
+    for (coord_t col = 0; col < w; ++col) {
+      if (upper) upper[col] |= data[col] << remainder;
+      if (lower) lower[col] |= data[col] >> (8 - remainder);
     }
   }
 }
@@ -495,7 +584,7 @@ void Graphics::print(uint16_t value, unsigned width) {
   print(str);
 }
 
-void Graphics::print(uint32_t value, size_t width) {
+void Graphics::print(uint32_t value, unsigned width) {
   char buf[24];
   char *str = itos<uint32_t, false>(value, buf, sizeof(buf));
   while (str > buf &&
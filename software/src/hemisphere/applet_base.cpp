@@ -4,6 +4,9 @@ using namespace hemisphere;
 
 int hemisphere::octave_max = 5;
 
+AppletSlot hemisphere::applet_slots[2];
+util::DelayPool<HEMISPHERE_DELAY_POOL_SIZE> hemisphere::delay_pool;
+
 uint8_t AppletBase::modal_edit_mode = 2; // 0=old behavior, 1=modal editing, 2=modal with wraparound
 uint8_t AppletBase::trig_length = 2; // multiplier for HEMISPHERE_CLOCK_TICKS
 int AppletBase::inputs[4];
@@ -13,9 +16,12 @@ int AppletBase::clock_countdown[4];
 int AppletBase::adc_lag_countdown[4];
 uint32_t AppletBase::last_clock[4];
 uint32_t AppletBase::cycle_ticks[4];
+uint32_t AppletBase::clock_period[4];
+uint32_t AppletBase::clock_offset[4];
 bool AppletBase::changed_cv[4];
 int AppletBase::last_cv[4];
 int AppletBase::cursor_countdown[2];
+int AppletBase::full_screen_hemisphere = -1;
 
 void AppletBase::BaseStart(bool hemisphere_) {
   hemisphere = hemisphere_;
@@ -116,13 +122,11 @@ void AppletBase::MoveCursor(int &cursor, int direction, int max) {
 }
 
 int AppletBase::Proportion(int numerator, int denominator, int max_value) {
-  simfloat proportion = int2simfloat((int32_t)numerator) / (int32_t)denominator;
-  int scaled = simfloat2int(proportion * max_value);
-  return scaled;
+  return hemisphere::Proportion(numerator, denominator, max_value);
 }
 
 int AppletBase::ProportionCV(int cv_value, int max_pixels) {
   int prop = constrain(
-      Proportion(cv_value, HEMISPHERE_MAX_INPUT_CV, max_pixels), 0, max_pixels);
+      Proportion<HEMISPHERE_MAX_INPUT_CV>(cv_value, max_pixels), 0, max_pixels);
   return prop;
 }
\ No newline at end of file
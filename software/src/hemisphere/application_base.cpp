@@ -52,9 +52,7 @@ void ApplicationBase::BaseView() {
 }
 
 int ApplicationBase::Proportion(int numerator, int denominator, int max_value) {
-  simfloat proportion = int2simfloat((int32_t)numerator) / (int32_t)denominator;
-  int scaled = simfloat2int(proportion * max_value);
-  return scaled;
+  return hemisphere::Proportion(numerator, denominator, max_value);
 }
 
 //////////////// Hemisphere-like IO methods
@@ -218,7 +216,7 @@ void ApplicationBase::gfxHeader(const char *str) {
 }
 
 int ApplicationBase::ProportionCV(int cv_value, int max_pixels) {
-  int prop = constrain(Proportion(cv_value, FIVE_VOLTS, max_pixels),
+  int prop = constrain(Proportion<FIVE_VOLTS>(cv_value, max_pixels),
                        -max_pixels, max_pixels);
   return prop;
 }
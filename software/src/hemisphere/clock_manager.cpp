@@ -1,6 +1,7 @@
 #include "hemisphere/clock_manager.hpp"
 
 #include "oc/core.h"
+#include "oc/digital_inputs.h"
 #include "util/templates.hpp"
 
 using namespace hemisphere;
@@ -17,15 +18,21 @@ void ClockManager::SetClockPPQN(int clkppqn) {
   clock_ppqn = clamp(clkppqn, 0, 24);
 }
 
-/* Set ticks per tock, based on one million ticks per minute divided by beats
- * per minute. This is approximate, because the arithmetical value is likely to
- * be fractional, and we need to live with a certain amount of imprecision here.
- * So I'm not even rounding up.
- */
+void ClockManager::SetSyncBandwidth(int bandwidth) {
+  sync_bandwidth = clamp(bandwidth, CLOCK_SYNC_BANDWIDTH_MIN, CLOCK_SYNC_BANDWIDTH_MAX);
+}
+
+void ClockManager::SetTempoIncrement(uint32_t increment) {
+  tempo_increment = clamp(increment, kIncrementMin, kIncrementMax);
+  phase_increment = tempo_increment;
+  sync_correction = 0;
+  // beats per minute = increment * 1000000 ticks per minute / 2^32
+  tempo = (static_cast<uint64_t>(tempo_increment) * 1000000 + (1U << 31)) >> 32;
+}
+
 void ClockManager::SetTempoBPM(uint16_t bpm) {
   bpm = clamp(bpm, CLOCK_TEMPO_MIN, CLOCK_TEMPO_MAX);
-  ticks_per_beat = 1000000 / bpm;
-  tempo = bpm;
+  SetTempoIncrement(((static_cast<uint64_t>(bpm) << 32) + 500000) / 1000000);
 }
 
 void ClockManager::SetTempoFromTaps(uint32_t *taps, int count) {
@@ -34,29 +41,24 @@ void ClockManager::SetTempoFromTaps(uint32_t *taps, int count) {
     total += taps[i];
   }
 
-  // update the tempo
-  uint32_t clock_diff = total / count;
-  ticks_per_beat =
-      clamp(clock_diff, CLOCK_TICKS_MIN,
-            CLOCK_TICKS_MAX);        // time since last clock is new tempo
-  tempo = 1000000 / ticks_per_beat;  // imprecise, for display purposes
+  // time since last clock is new tempo
+  uint32_t clock_diff = clamp(total / count, CLOCK_TICKS_MIN, CLOCK_TICKS_MAX);
+  SetTempoIncrement((UINT64_C(1) << 32) / clock_diff);
 }
 
-// Reset - Resync multipliers, optionally skipping the first tock
-void ClockManager::Reset(bool count_skip) {
-  beat_tick = oc::core::ticks;
-  for (int ch = 0; ch < NR_OF_CLOCKS; ch++) {
-    if (tocks_per_beat[ch] > 0 || 0 == count_skip) count[ch] = count_skip;
-  }
-  cycle = 1 - cycle;
+// Reset - Restart the beat, all clocks fire on the next tick
+void ClockManager::Reset() {
+  phase = 0;
+  restart = 1;
+  clock_count = 0;
 }
 
-// Nudge - Used to align the internal clock with incoming clock pulses
-// The rationale is that it's better to be short by 1 than to overshoot by 1
-void ClockManager::Nudge(int diff) {
-  if (diff > 0) diff--;
-  if (diff < 0) diff++;
-  beat_tick += diff;
+uint32_t ClockManager::Phase(int ch) {
+  int multiply = tocks_per_beat[ch];
+  if (multiply > 0) return phase * static_cast<uint32_t>(multiply);
+  if (multiply == 0) return 0;
+  uint32_t div = 1 - multiply;
+  return count[ch] * (0xffffffff / div) + phase / div;
 }
 
 // call this on every tick when clock is running, before all Controllers
@@ -66,73 +68,107 @@ void ClockManager::SyncTrig(bool clocked, bool hard_reset) {
 
   uint32_t now = oc::core::ticks;
 
-  // Reset only when all multipliers have been met
-  bool reset = 1;
+  // Advance the beat. An output tocks when its phase (the beat phase times
+  // the multiplier) wraps on this tick.
+  uint32_t increment = phase_increment;
+  bool restarted = restart;
+  bool beat = restart;
+  if (restart) {
+    restart = 0;
+  } else {
+    phase += increment;
+    beat = phase < increment;
+  }
+  if (beat) cycle = 1 - cycle;
 
-  // count and calculate Tocks
   for (int ch = 0; ch < NR_OF_CLOCKS; ch++) {
-    if (tocks_per_beat[ch] == 0) {  // disabled
+    int multiply = tocks_per_beat[ch];
+    if (multiply > 0) {
+      uint32_t m = multiply;
+      tock[ch] = beat || phase * m < increment * m;
+    } else if (multiply < 0 && beat) {
+      // division: -1 becomes /2, -2 becomes /3, etc.
+      tock[ch] = restarted || ++count[ch] >= 1 - multiply;
+      if (tock[ch]) count[ch] = 0;
+    } else {
       tock[ch] = 0;
-      continue;
-    }
-
-    if (tocks_per_beat[ch] > 0) {  // multiply
-      uint32_t next_tock_tick =
-          beat_tick + count[ch] * ticks_per_beat /
-                          static_cast<uint32_t>(tocks_per_beat[ch]);
-      tock[ch] = now >= next_tock_tick;
-      if (tock[ch]) ++count[ch];  // increment multiplier counter
-
-      reset = reset &&
-              (count[ch] > tocks_per_beat[ch]);  // multiplier has been exceeded
-    } else {  // division: -1 becomes /2, -2 becomes /3, etc.
-      int div = 1 - tocks_per_beat[ch];
-      uint32_t next_beat = beat_tick + (count[ch] ? ticks_per_beat : 0);
-      bool beat_exceeded = (now > next_beat);
-      if (beat_exceeded) {
-        ++count[ch];
-        tock[ch] = (count[ch] % div) == 1;
-      } else
-        tock[ch] = 0;
-
-      // resync on every beat
-      reset = reset && beat_exceeded;
-      if (tock[ch]) count[ch] = 1;
     }
+    if (tock[ch] || !multiply) on_beat[ch] = beat && multiply;
   }
-  if (reset) Reset(1);  // skip the one we're already on
 
   // handle syncing to physical clocks
   if (clocked && clock_tick && clock_ppqn) {
     uint32_t clock_diff = now - clock_tick;
-    if (clock_ppqn * clock_diff > CLOCK_TICKS_MAX)
-      clock_tick = 0;  // too slow, reset clock tracking
+    if (clock_ppqn * clock_diff > CLOCK_TICKS_MAX) {
+      // too slow, reset clock tracking and free run at the last tempo
+      clock_tick = 0;
+      synced = 0;
+      phase_increment = tempo_increment;
+      sync_correction = 0;
+    }
 
-    // if there is a previous clock tick, update tempo and sync
+    // if there is a previous clock tick, sync to it, to a fraction of a tick
+    // with the edge timestamps if it came from TR1 (rather than MIDI)
     if (clock_tick && clock_diff) {
-      // update the tempo
-      ticks_per_beat =
-          clamp(clock_ppqn * clock_diff, CLOCK_TICKS_MIN,
-                CLOCK_TICKS_MAX);        // time since last clock is new tempo
-      tempo = 1000000 / ticks_per_beat;  // imprecise, for display purposes
-
-      int ticks_per_clock = ticks_per_beat / clock_ppqn;  // rounded down
-
-      // time since last beat
-      int tick_offset = now - beat_tick;
-
-      // too long ago? time til next beat
-      if (tick_offset > ticks_per_clock / 2) {
-        tick_offset -= ticks_per_beat;
+      uint32_t period = 0;
+      uint32_t offset = 0;
+      if (oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_1>()) {
+        period = oc::DigitalInputs::edge_period(oc::DIGITAL_INPUT_1);
+        offset = oc::DigitalInputs::edge_offset(oc::DIGITAL_INPUT_1);
       }
-
-      // within half a clock pulse of the nearest beat AND significantly large
-      if (abs(tick_offset) < ticks_per_clock / 2 && abs(tick_offset) > 4)
-        Nudge(tick_offset);  // nudge the beat towards us
+      if (!period) {
+        period = clock_diff * oc::DigitalInputs::kCyclesPerTick;
+        offset = 0;
+      }
+      SyncToClock(period, offset);
     }
   }
   // clock has been physically ticked
   if (clocked) {
     clock_tick = now;
+    if (clock_count <= clock_ppqn) ++clock_count;
+  }
+}
+
+void ClockManager::SyncToClock(uint32_t period_cycles, uint32_t offset_cycles) {
+  // The tempo the clock period says
+  uint64_t beat_cycles = static_cast<uint64_t>(clock_ppqn) * period_cycles;
+  uint32_t measured = clamp<uint64_t>(
+      (static_cast<uint64_t>(oc::DigitalInputs::kCyclesPerTick) << 32) / beat_cycles,
+      kIncrementMin, kIncrementMax);
+  int32_t frequency_error = measured - tempo_increment;
+
+  // Where the beat was when the clock came in, and how far that is from where
+  // this clock should be, in clocks (2^32 to a clock); ahead is positive.
+  // Within the first beat after a restart, counting the clocks says which one
+  // it is, after that it's taken to be the nearest one.
+  uint32_t edge_phase = phase - static_cast<uint32_t>(
+      static_cast<uint64_t>(phase_increment) * offset_cycles / oc::DigitalInputs::kCyclesPerTick);
+  int64_t error;
+  if (clock_count < clock_ppqn) {
+    uint32_t expected = (UINT64_C(1) << 32) * clock_count / clock_ppqn;
+    error = static_cast<int32_t>(edge_phase - expected) * static_cast<int64_t>(clock_ppqn);
+  } else {
+    error = static_cast<int32_t>(edge_phase * static_cast<uint32_t>(clock_ppqn));
   }
-}
\ No newline at end of file
+
+  // The change in increment that would take the error out over one clock
+  int32_t step = (error * measured) >> 32;
+
+  // Proportional gain 1 / 2^p, integral 1 / 2^(2p + 2) for critical damping,
+  // and the period measurement at 1 / 2^(p + 1)
+  int p = CLOCK_SYNC_BANDWIDTH_MAX + 1 - sync_bandwidth;
+
+  if (!synced || abs(frequency_error) > static_cast<int32_t>(tempo_increment / 8)) {
+    // (Re)acquire: take the tempo as measured and the error out in one clock
+    SetTempoIncrement(measured);
+    sync_correction = -step;
+    synced = 1;
+  } else {
+    int32_t increment = tempo_increment + (frequency_error >> (p + 1)) - (step >> (2 * p + 2));
+    SetTempoIncrement(clamp<int32_t>(increment, kIncrementMin, kIncrementMax));
+    sync_correction = -(step >> p);
+  }
+  // with room to correct at the ends of the tempo range
+  phase_increment = clamp<int32_t>(tempo_increment + sync_correction, kIncrementMin / 2, kIncrementMax * 2);
+}
@@ -1,13 +1,18 @@
 #include "hemisphere/manager.hpp"
+#include "drivers/display.h"
+#include "oc/debug.h"
+#include "oc/midi_out.h"
+#include "oc/render_scheduler.h"
+#include "oc/strings.h"
 
 using namespace hemisphere;
 
 void Manager::Start() {
   select_mode = -1;         // Not selecting
-  midi_in_hemisphere = -1;  // No MIDI In
 
   help_hemisphere = -1;
   clock_setup = 0;
+  output_quantizer.Init();
 
   SetApplet(0, get_applet_index_by_id(18));  // DualTM
   SetApplet(1, get_applet_index_by_id(15));  // EuclidX
@@ -33,6 +38,8 @@ void Manager::StoreToPreset(Preset *preset) {
     uint64_t data = hemisphere::available_applets[index].OnDataRequest(h);
     active_preset->SetData(h, data);
   }
+  active_preset->StoreBlobs(hemisphere::available_applets[my_applet[0]],
+                            hemisphere::available_applets[my_applet[1]]);
   active_preset->StoreClockData();
 }
 void Manager::StoreToPreset(int id) {
@@ -47,6 +54,7 @@ void Manager::LoadFromPreset(int id) {
       int index = get_applet_index_by_id(active_preset->GetAppletId(h));
       SetApplet(h, index);
       hemisphere::available_applets[index].OnDataReceive(h, active_preset->GetData(h));
+      active_preset->LoadBlob(h, hemisphere::available_applets[index]);
     }
   }
   preset_id = id;
@@ -54,10 +62,18 @@ void Manager::LoadFromPreset(int id) {
 
 // does not modify the preset, only the manager
 void Manager::SetApplet(int hemisphere, int index) {
+  applet_loading[hemisphere] = true;
+  // The outgoing applet's slot is reused by the new one
+  if (my_applet[hemisphere] >= 0)
+    hemisphere::available_applets[my_applet[hemisphere]].Unload(hemisphere);
+  if (hemisphere::AppletBase::full_screen_hemisphere == hemisphere)
+    hemisphere::AppletBase::full_screen_hemisphere = -1;
   my_applet[hemisphere] = index;
-  if (midi_in_hemisphere == hemisphere) midi_in_hemisphere = -1;
-  if (hemisphere::available_applets[index].id & 0x80) midi_in_hemisphere = hemisphere;
+  oc::DEBUG::APPLET_cycles[hemisphere].Reset();
+  oc::DEBUG::APPLET_ids[hemisphere] = hemisphere::available_applets[index].id;
+  oc::render_scheduler.InvalidateAll();
   hemisphere::available_applets[index].Start(hemisphere);
+  applet_loading[hemisphere] = false;
 }
 
 void Manager::ChangeApplet(int h, int dir) {
@@ -68,15 +84,9 @@ void Manager::ChangeApplet(int h, int dir) {
 bool Manager::SelectModeEnabled() { return select_mode > -1; }
 
 void Manager::Controller() {
-  // TODO: eliminate the need for this with top-level MIDI handling
-  if (midi_in_hemisphere == -1) {
-    // Only one ISR can look for MIDI messages at a time, so we need to check
-    // for another MIDI In applet before looking for sysex. Note that applets
-    // that use MIDI In should check for sysex themselves; see Midi In for an
-    // example.
-    if (usbMIDI.read() && usbMIDI.getType() == usbMIDI.SystemExclusive) {
-      if (active_preset) active_preset->OnReceiveSysEx();
-    }
+  // Preset dumps; MIDI In applets get their own copy of the other messages
+  while (oc::MidiIn::Read(sysex_subscription)) {
+    if (active_preset) active_preset->OnReceiveSysEx();
   }
 
   bool clock_sync = oc::DigitalInputs::clocked<oc::DIGITAL_INPUT_1>();
@@ -90,12 +100,19 @@ void Manager::Controller() {
   if (clock_m->IsRunning()) clock_m->SyncTrig(clock_sync, reset);
 
   // NJM: always execute ClockSetup controller - it handles MIDI clock out
-  hemisphere::clock_setup_applet.Controller(LEFT_HEMISPHERE, clock_m->IsForwarded());
+  {
+    debug::ScopedCycleHistogram cycles(oc::DEBUG::CLOCK_SETUP_cycles);
+    hemisphere::clock_setup_applet.Controller(LEFT_HEMISPHERE, clock_m->IsForwarded());
+  }
 
   for (int h = 0; h < 2; h++) {
+    if (applet_loading[h]) continue;
+    debug::ScopedCycleHistogram cycles(oc::DEBUG::APPLET_cycles[h]);
     int index = my_applet[h];
     hemisphere::available_applets[index].Controller(h, clock_m->IsForwarded());
   }
+
+  output_quantizer.Process();
 }
 
 void Manager::View() {
@@ -109,29 +126,47 @@ void Manager::View() {
     return;
   }
 
+  int full_screen = hemisphere::AppletBase::full_screen_hemisphere;
   if (help_hemisphere > -1) {
     int index = my_applet[help_hemisphere];
     hemisphere::available_applets[index].View(help_hemisphere);
+  } else if (full_screen > -1 && select_mode < 0) {
+    int index = my_applet[full_screen];
+    hemisphere::available_applets[index].View(full_screen);
   } else {
+    // Halves that aren't drawn this frame keep what the last one showed,
+    // overlays included
+    uint32_t halves = oc::render_scheduler.Plan(2);
     for (int h = 0; h < 2; h++) {
-      int index = my_applet[h];
-      hemisphere::available_applets[index].View(h);
+      if (!(halves & (1 << h)))
+        graphics.copyColumns(display::frame_buffer.previous_frame(), h * 64, 64);
     }
-
-    if (clock_m->IsRunning()) {
-      // Metronome icon
-      gfxIcon(56, 1, clock_m->Cycle() ? METRO_L_ICON : METRO_R_ICON);
-    } else if (clock_m->IsPaused()) {
-      gfxIcon(56, 1, PAUSE_ICON);
+    for (int h = 0; h < 2; h++) {
+      if (halves & (1 << h)) {
+        debug::CycleMeasurement cycles;
+        int index = my_applet[h];
+        hemisphere::available_applets[index].View(h);
+        oc::render_scheduler.RegionDrawn(h, cycles.read());
+      }
     }
 
-    if (clock_m->IsForwarded()) {
-      // CV Forwarding Icon
-      gfxIcon(120, 1, CLOCK_ICON);
+    if (halves & (1 << LEFT_HEMISPHERE)) {
+      if (clock_m->IsRunning()) {
+        // Metronome icon
+        gfxIcon(56, 1, clock_m->Cycle() ? METRO_L_ICON : METRO_R_ICON);
+      } else if (clock_m->IsPaused()) {
+        gfxIcon(56, 1, PAUSE_ICON);
+      }
+      if (select_mode == LEFT_HEMISPHERE) graphics.drawFrame(0, 0, 64, 64);
     }
 
-    if (select_mode == LEFT_HEMISPHERE) graphics.drawFrame(0, 0, 64, 64);
-    if (select_mode == RIGHT_HEMISPHERE) graphics.drawFrame(64, 0, 64, 64);
+    if (halves & (1 << RIGHT_HEMISPHERE)) {
+      if (clock_m->IsForwarded()) {
+        // CV Forwarding Icon
+        gfxIcon(120, 1, CLOCK_ICON);
+      }
+      if (select_mode == RIGHT_HEMISPHERE) graphics.drawFrame(64, 0, 64, 64);
+    }
   }
 }
 
@@ -139,6 +174,7 @@ void Manager::DelegateEncoderPush(const UI::Event &event) {
   bool down = (event.type == UI::EVENT_BUTTON_DOWN);
   int h = (event.control == oc::CONTROL_BUTTON_L) ? LEFT_HEMISPHERE
                                                   : RIGHT_HEMISPHERE;
+  oc::render_scheduler.Invalidate(h);
 
   if (config_menu) {
     // button release for config screen
@@ -158,6 +194,7 @@ void Manager::DelegateEncoderPush(const UI::Event &event) {
   if (select_mode == h) {
     select_mode =
         -1;  // Pushing a button for the selected side turns off select mode
+    oc::render_scheduler.InvalidateAll();
   } else if (!clock_setup) {
     // regular applets get button release
     int index = my_applet[h];
@@ -169,6 +206,8 @@ void Manager::DelegateSelectButtonPush(const UI::Event &event) {
   bool down = (event.type == UI::EVENT_BUTTON_DOWN);
   int hemisphere = (event.control == oc::CONTROL_BUTTON_UP) ? LEFT_HEMISPHERE
                                                             : RIGHT_HEMISPHERE;
+  // Select mode, help and clock setup all change the layout
+  oc::render_scheduler.InvalidateAll();
 
   if (config_menu) {
     // cancel preset select, or config screen on select button release
@@ -232,6 +271,7 @@ void Manager::DelegateSelectButtonPush(const UI::Event &event) {
 void Manager::DelegateEncoderMovement(const UI::Event &event) {
   int h = (event.control == oc::CONTROL_ENCODER_L) ? LEFT_HEMISPHERE
                                                    : RIGHT_HEMISPHERE;
+  oc::render_scheduler.Invalidate(h);
   if (config_menu) {
     ConfigEncoderAction(h, event.value);
     return;
@@ -250,11 +290,11 @@ void Manager::DelegateEncoderMovement(const UI::Event &event) {
 void Manager::ToggleClockRun() {
   if (clock_m->IsRunning()) {
     clock_m->Stop();
-    usbMIDI.sendRealTime(usbMIDI.Stop);
+    oc::MidiOut::SendRealTime(usbMIDI.Stop);
   } else {
     bool p = clock_m->IsPaused();
     clock_m->Start(!p);
-    if (p) usbMIDI.sendRealTime(usbMIDI.Start);
+    if (p) oc::MidiOut::SendRealTime(usbMIDI.Start);
   }
 }
 
@@ -279,13 +319,26 @@ void Manager::SetHelpScreen(int hemisphere) {
   help_hemisphere = hemisphere;
 }
 
+size_t Manager::SaveQuantizers(void *storage) const {
+  output_quantizer.Pack(static_cast<uint8_t *>(storage));
+  return quantizersSize();
+}
+
+size_t Manager::RestoreQuantizers(const void *storage) {
+  output_quantizer.Unpack(static_cast<const uint8_t *>(storage));
+  return quantizersSize();
+}
+
 enum HEMConfigCursor {
   LOAD_PRESET,
   SAVE_PRESET,
   TRIG_LENGTH,
   CURSOR_MODE,
+  QUANTIZER_OUTPUT,
+  QUANTIZER_SCALE,
+  QUANTIZER_ROOT,
 
-  MAX_CURSOR = CURSOR_MODE
+  MAX_CURSOR = QUANTIZER_ROOT
 };
 
 void Manager::ConfigEncoderAction(int h, int dir) {
@@ -301,7 +354,26 @@ void Manager::ConfigEncoderAction(int h, int dir) {
         (uint32_t)constrain(int(AppletBase::trig_length + dir), 1, 127);
   } else if (config_cursor == SAVE_PRESET || config_cursor == LOAD_PRESET) {
     preset_cursor = constrain(preset_cursor + dir, 1, kNumPresets);
+  } else {
+    QuantizerEncoderAction(dir);
+  }
+}
+
+void Manager::QuantizerEncoderAction(int dir) {
+  if (config_cursor == QUANTIZER_OUTPUT) {
+    quantizer_output = constrain(quantizer_output + dir, 0, OutputQuantizer::kNumOutputs - 1);
+    return;
+  }
+
+  OutputQuantizerConfig config = output_quantizer.config(quantizer_output);
+  if (config_cursor == QUANTIZER_SCALE) {
+    config.scale += dir;
+    if (config.scale >= oc::Scales::NUM_SCALES) config.scale = 0;
+    if (config.scale < 0) config.scale = oc::Scales::NUM_SCALES - 1;
+  } else {
+    config.root = constrain(config.root + dir, 0, 11);
   }
+  output_quantizer.Configure(quantizer_output, config);
 }
 void Manager::ConfigButtonPush(int h) {
   if (preset_cursor) {
@@ -324,6 +396,9 @@ void Manager::ConfigButtonPush(int h) {
       break;
 
     case TRIG_LENGTH:
+    case QUANTIZER_OUTPUT:
+    case QUANTIZER_SCALE:
+    case QUANTIZER_ROOT:
       isEditing = !isEditing;
       break;
 
@@ -352,6 +427,15 @@ void Manager::DrawConfigMenu() {
   gfxPrint(1, 45, "Cursor:  ");
   gfxPrint(cursor_mode_name[AppletBase::modal_edit_mode]);
 
+  const OutputQuantizerConfig &quantizer = output_quantizer.config(quantizer_output);
+  const char output_name[] = {static_cast<char>('A' + quantizer_output), '\0'};
+  gfxPrint(1, 55, "Quant ");
+  gfxPrint(output_name);
+  gfxPrint(": ");
+  gfxPrint(oc::scale_names_short[quantizer.scale]);
+  gfxPrint(" ");
+  gfxPrint(oc::Strings::note_names_unpadded[quantizer.root]);
+
   switch (config_cursor) {
     case LOAD_PRESET:
     case SAVE_PRESET:
@@ -367,6 +451,19 @@ void Manager::DrawConfigMenu() {
     case CURSOR_MODE:
       gfxIcon(43, 45, RIGHT_ICON);
       break;
+
+    case QUANTIZER_OUTPUT:
+    case QUANTIZER_SCALE:
+    case QUANTIZER_ROOT: {
+      const int x[] = {37, 55, 85};
+      const int w[] = {6, 24, 12};
+      int i = config_cursor - QUANTIZER_OUTPUT;
+      if (isEditing)
+        gfxInvert(x[i] - 1, 54, w[i] + 1, 9);
+      else
+        gfxCursor(x[i], 63, w[i]);
+      break;
+    }
   }
 }
 
@@ -399,13 +496,5 @@ int Manager::get_next_applet_index(int index, int dir) {
   if (index >= kNumAvailableApplets) index = 0;
   if (index < 0) index = kNumAvailableApplets - 1;
 
-  // If an applet uses MIDI In, it can only be selected in one
-  // hemisphere, and is designated by bit 7 set in its id.
-  if (hemisphere::available_applets[index].id & 0x80) {
-    if (midi_in_hemisphere == (1 - select_mode)) {
-      return get_next_applet_index(index, dir);
-    }
-  }
-
   return index;
 }
@@ -0,0 +1,67 @@
+#include "hemisphere/output_quantizer.hpp"
+#include "hemisphere/applet_base.hpp"
+#include "oc/DAC.h"
+
+using namespace hemisphere;
+
+void OutputQuantizer::Init() {
+  enabled_mask_ = 0;
+  pending_mask_ = 0;
+  for (int ch = 0; ch < kNumOutputs; ++ch) {
+    quantizer_[ch].Init();
+    config_[ch].Reset();
+    root_[ch] = 0;
+  }
+}
+
+void OutputQuantizer::Configure(int ch, const OutputQuantizerConfig &config) {
+  // Process mustn't pick up a half-written config
+  pending_mask_.fetch_and(~(1 << ch));
+  config_[ch] = config;
+  pending_mask_.fetch_or(1 << ch);
+}
+
+void OutputQuantizer::Apply(int ch) {
+  const OutputQuantizerConfig &config = config_[ch];
+  root_[ch] = config.root;
+  quantizer_[ch].Configure(oc::Scales::GetScale(config.scale));
+  quantizer_[ch].Requantize();
+  if (config.enabled() && quantizer_[ch].enabled())
+    enabled_mask_ |= 1 << ch;
+  else
+    enabled_mask_ &= ~(1 << ch);
+}
+
+void OutputQuantizer::Process() {
+  if (pending_mask_.load(std::memory_order_relaxed)) {
+    uint8_t pending = pending_mask_.exchange(0);
+    for (int ch = 0; pending; ++ch, pending >>= 1) {
+      if (pending & 1) Apply(ch);
+    }
+  }
+
+  uint8_t enabled = enabled_mask_;
+  for (int ch = 0; enabled; ++ch, enabled >>= 1) {
+    if (enabled & 1) {
+      // The quantizer keeps the last note until the pitch leaves its
+      // boundaries, so a steady output costs a comparison
+      int32_t pitch = quantizer_[ch].Process(AppletBase::outputs[ch], root_[ch] << 7, 0);
+      oc::DAC::set_pitch(static_cast<DAC_CHANNEL>(ch), pitch, 0);
+    }
+  }
+}
+
+void OutputQuantizer::Pack(uint8_t *storage) const {
+  util::BitWriter writer(storage, kStorageSize);
+  for (int ch = 0; ch < kNumOutputs; ++ch)
+    config_[ch].Pack(writer);
+}
+
+void OutputQuantizer::Unpack(const uint8_t *storage) {
+  util::BitReader reader(storage, kStorageSize);
+  for (int ch = 0; ch < kNumOutputs; ++ch) {
+    OutputQuantizerConfig config;
+    config.Unpack(reader);
+    Configure(ch, config);
+  }
+}
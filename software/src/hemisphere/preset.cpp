@@ -1,9 +1,15 @@
 #include "hemisphere/preset.hpp"
+#include "util/misc.h"
 
 using namespace hemisphere;
 
 constexpr size_t as_idx(Setting s) { return static_cast<size_t>(s); }
 
+namespace hemisphere {
+Preset presets[kNumPresets];
+Preset *active_preset;
+}  // namespace hemisphere
+
 int Preset::GetAppletId(int h) {
   Setting setting_idx = (h == LEFT_HEMISPHERE) ? Setting::SELECTED_LEFT_ID
                                                : Setting::SELECTED_RIGHT_ID;
@@ -47,6 +53,50 @@ void Preset::SetData(int h, uint64_t data) {
   apply_value(8 + h, (data >> 48) & 0xffff);
 }
 
+void Preset::StoreBlobs(const Applet &left, const Applet &right) {
+  blob_.Clear();
+  if (StoreBlob(0, left, decltype(blob_)::kMaxLength) &&
+      StoreBlob(1, right, decltype(blob_)::kMaxLength))
+    return;
+
+  blob_.Clear();
+  const Applet *applets[2] = { &left, &right };
+  for (int h = 0; h < 2; ++h) {
+    if (!StoreBlob(h, *applets[h], decltype(blob_)::kHalfLength))
+      SERIAL_PRINTLN("Preset blob: %s state doesn't fit", h ? "right" : "left");
+  }
+}
+
+// @return false if the applet has state that wasn't stored
+bool Preset::StoreBlob(int h, const Applet &applet, size_t room) {
+  uint8_t data[decltype(blob_)::kMaxLength];
+  util::BitWriter writer(data, room);
+  uint8_t version = applet.OnBlobRequest(h, writer);
+  if (!version)
+    return true;
+  return !writer.overflow() && blob_.Set(h, version, data, writer.length());
+}
+
+void Preset::LoadBlob(int h, const Applet &applet) {
+  const uint8_t *data;
+  size_t length;
+  uint8_t version = blob_.Get(h, data, length);
+  if (version) {
+    util::BitReader reader(data, length);
+    applet.OnBlobReceive(h, version, reader);
+  }
+}
+
+size_t Preset::SaveBlob(void *storage) const {
+  memcpy(storage, blob_.bytes(), blobSize());
+  return blobSize();
+}
+
+size_t Preset::RestoreBlob(const void *storage) {
+  memcpy(blob_.bytes(), storage, blobSize());
+  return blobSize();
+}
+
 // TODO: I haven't updated the SysEx data structure here because I don't use
 // it. Clock data would probably be useful if it's not too big. -NJM
 void Preset::OnSendSysEx() {
@@ -107,6 +157,8 @@ void Preset::OnReceiveSysEx() {
         (static_cast<uint16_t>(V[15]) << 8) + V[14];
     values_[as_idx(Setting::RIGHT_DATA_B4)] =
         (static_cast<uint16_t>(V[17]) << 8) + V[16];
+    // The blob isn't in the dump, and may belong to other applets
+    blob_.Clear();
     // LoadClockData();
   }
 }
\ No newline at end of file
@@ -36,9 +36,12 @@
 #include "oc/calibration.h"
 #include "oc/digital_inputs.h"
 #include "oc/menus.h"
+#include "oc/midi_in.h"
+#include "oc/midi_out.h"
 #include "oc/strings.h"
 #include "oc/ui.h"
 #include "oc/options.h"
+#include "oc/render_scheduler.h"
 #include "drivers/display.h"
 #include "util/debugpins.h"
 #include "VBiasManager.h"
@@ -47,6 +50,7 @@ unsigned long LAST_REDRAW_TIME = 0;
 uint_fast8_t MENU_REDRAW = true;
 oc::UiMode ui_mode = oc::UI_MODE_MENU;
 const bool DUMMY = false;
+oc::RenderScheduler oc::render_scheduler;
 
 /*  ------------------------ UI timer ISR ---------------------------   */
 
@@ -66,14 +70,20 @@ volatile uint32_t oc::core::ticks = 0;
 void FASTRUN CORE_timer_ISR() {
   DEBUG_PIN_SCOPE(OC_GPIO_DEBUG_PIN2);
   OC_DEBUG_PROFILE_SCOPE(oc::DEBUG::ISR_cycles);
+  debug::CycleMeasurement isr_cycles;
+  debug::CycleMeasurement stage_cycles;
 
   // DAC and display share SPI. By first updating the DAC values, then starting
   // a DMA transfer to the display things are fairly nicely interleaved. In the
   // next ISR, the display transfer is finalized (CS update).
+  // Only the changed DAC channels are written, and with ENABLE_DAC_DMA that
+  // happens in the background while the inputs are scanned; the display waits
+  // for it to finish.
 
   display::Flush();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_DISPLAY_FLUSH);
   oc::DAC::Update();
-  display::Update();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_DAC);
 
   // The ADC scan uses async startSingleRead/readSingle and single channel each
   // loop, so should be fast enough even at 60us (check ADC::busy_waits() == 0)
@@ -81,11 +91,23 @@ void FASTRUN CORE_timer_ISR() {
   // 100us: 10kHz / 4 / 4 ~ .6kHz
   // 60us: 16.666K / 4 / 4 ~ 1kHz
   // kAdcSmoothing == 4 has some (maybe 1-2LSB) jitter but seems "Good Enough".
+  // With ENABLE_ADC_DMA the conversions run on their own and this only
+  // filters the last complete set of samples for all four channels.
   oc::ADC::Scan();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_ADC);
 
   // Pin changes are tracked in separate ISRs, so depending on prio it might
   // need extra precautions.
   oc::DigitalInputs::Scan();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_DIGITAL_INPUTS);
+
+  // All USB MIDI input goes through here, the apps read it from the queue
+  oc::MidiIn::Scan();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_MIDI_IN);
+
+  oc::DAC::WaitForTransfer();
+  display::Update();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_DISPLAY_UPDATE);
 
 #ifndef OC_UI_SEPARATE_ISR
   TODO needs a counter
@@ -95,6 +117,12 @@ void FASTRUN CORE_timer_ISR() {
   ++oc::core::ticks;
   if (oc::core::app_isr_enabled)
     oc::apps::ISR();
+  OC_DEBUG_PROFILE_STAGE(stage_cycles, oc::DEBUG::ISR_STAGE_APP);
+
+  uint32_t total = isr_cycles.read();
+  oc::DEBUG::ISR_total_cycles.push(total);
+  if (total > OC_CORE_TIMER_RATE * (F_CPU / 1000000))
+    ++oc::DEBUG::ISR_overruns;
 
   OC_DEBUG_RESET_CYCLES(oc::core::ticks, 16384, oc::DEBUG::ISR_cycles);
 }
@@ -110,6 +138,8 @@ void setup() {
 
   oc::DEBUG::Init();
   oc::DigitalInputs::Init();
+  oc::MidiIn::Init();
+  oc::MidiOut::Init();
   delay(400); 
   oc::ADC::Init(&oc::calibration_data.adc); // Yes, it's using the calibration_data before it's loaded...
   oc::DAC::Init(&oc::calibration_data.dac);
@@ -124,6 +154,7 @@ void setup() {
   display::AdjustOffset(oc::calibration_data.display_offset);
 
   oc::menu::Init();
+  oc::render_scheduler.Init(FRAME_PERIOD_US, FRAME_BUDGET_US * (F_CPU / 1000000));
   oc::ui.Init();
   oc::ui.configure_encoders(oc::calibration_data.encoder_config());
 
@@ -158,59 +189,69 @@ void setup() {
 
 /*  ---------    main loop  --------  */
 
+static uint32_t menu_redraws = 0;
+
+// One pass of the main loop; split out of loop() so the host-side virtual
+// module can interleave it with the (simulated) ISRs.
+void FASTRUN loop_step() {
+
+  // don't change current_app while it's running
+  if (oc::UI_MODE_APP_SETTINGS == ui_mode) {
+    oc::ui.AppSettings();
+    ui_mode = oc::UI_MODE_MENU;
+  }
+
+  // Refresh display
+  if (MENU_REDRAW) {
+    GRAPHICS_BEGIN_FRAME(false); // Don't busy wait
+      oc::render_scheduler.BeginFrame(micros());
+      if (oc::UI_MODE_MENU == ui_mode) {
+        OC_DEBUG_RESET_CYCLES(menu_redraws, 512, oc::DEBUG::MENU_draw_cycles);
+        OC_DEBUG_PROFILE_SCOPE(oc::DEBUG::MENU_draw_cycles);
+        oc::apps::current_app->DrawMenu();
+        ++menu_redraws;
+
+        #ifdef VOR
+        // JEJ:On app screens, show the bias popup, if necessary
+        VBiasManager *vbias_m = vbias_m->get();
+        vbias_m->DrawPopupPerhaps();
+        #endif
+
+      } else {
+        oc::apps::current_app->DrawScreensaver();
+      }
+      MENU_REDRAW = 0;
+      LAST_REDRAW_TIME = millis();
+    GRAPHICS_END_FRAME();
+  }
+
+  // Run current app
+  oc::apps::current_app->loop();
+
+  // MIDI output queued by the ISR and the UI
+  oc::MidiOut::Drain();
+
+  // UI events
+  oc::UiMode mode = oc::ui.DispatchEvents(oc::apps::current_app);
+
+  // State transition for app
+  if (mode != ui_mode) {
+    if (oc::UI_MODE_SCREENSAVER == mode)
+      oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SCREENSAVER_ON);
+    else if (oc::UI_MODE_SCREENSAVER == ui_mode)
+      oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SCREENSAVER_OFF);
+    ui_mode = mode;
+  }
+
+  if (millis() - LAST_REDRAW_TIME > REDRAW_TIMEOUT_MS)
+    MENU_REDRAW = 1;
+}
+
 void FASTRUN loop() {
 
   oc::core::app_isr_enabled = true;
-  uint32_t menu_redraws = 0;
-  while (true) {
-
-    // don't change current_app while it's running
-    if (oc::UI_MODE_APP_SETTINGS == ui_mode) {
-      oc::ui.AppSettings();
-      ui_mode = oc::UI_MODE_MENU;
-    }
-
-    // Refresh display
-    if (MENU_REDRAW) {
-      GRAPHICS_BEGIN_FRAME(false); // Don't busy wait
-        if (oc::UI_MODE_MENU == ui_mode) {
-          OC_DEBUG_RESET_CYCLES(menu_redraws, 512, oc::DEBUG::MENU_draw_cycles);
-          OC_DEBUG_PROFILE_SCOPE(oc::DEBUG::MENU_draw_cycles);
-          oc::apps::current_app->DrawMenu();
-          ++menu_redraws;
-
-          #ifdef VOR
-          // JEJ:On app screens, show the bias popup, if necessary
-          VBiasManager *vbias_m = vbias_m->get();
-          vbias_m->DrawPopupPerhaps();
-          #endif
-
-        } else {
-          oc::apps::current_app->DrawScreensaver();
-        }
-        MENU_REDRAW = 0;
-        LAST_REDRAW_TIME = millis();
-      GRAPHICS_END_FRAME();
-    }
-
-    // Run current app
-    oc::apps::current_app->loop();
-
-    // UI events
-    oc::UiMode mode = oc::ui.DispatchEvents(oc::apps::current_app);
-
-    // State transition for app
-    if (mode != ui_mode) {
-      if (oc::UI_MODE_SCREENSAVER == mode)
-        oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SCREENSAVER_ON);
-      else if (oc::UI_MODE_SCREENSAVER == ui_mode)
-        oc::apps::current_app->HandleAppEvent(oc::APP_EVENT_SCREENSAVER_OFF);
-      ui_mode = mode;
-    }
-
-    if (millis() - LAST_REDRAW_TIME > REDRAW_TIMEOUT_MS)
-      MENU_REDRAW = 1;
-  }
+  while (true)
+    loop_step();
 }
 
 
@@ -20,14 +20,70 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   static const int PIN = CV4;
 };
 
+// log2 of the smoothing filter (and oversampling) for each filter profile.
+// The profiles only apply to the DMA scan, which updates all channels every
+// ISR. The round robin updates each channel every fourth ISR and keeps the
+// kAdcSmoothing it always had, whatever the app asks for.
+struct FilterProfileDesc {
+  uint8_t smoothing_shift;
+  uint8_t oversampling;
+};
+
+static constexpr FilterProfileDesc kFilterProfiles[ADC::FILTER_PROFILE_LAST] = {
+#ifdef ENABLE_ADC_DMA
+  { 1, 1 }, // FILTER_PROFILE_LOW_LATENCY
+  { 4, 1 }, // FILTER_PROFILE_STANDARD
+  { 6, 3 }, // FILTER_PROFILE_LOW_NOISE
+#else
+  { 2, 0 }, // FILTER_PROFILE_LOW_LATENCY
+  { 2, 0 }, // FILTER_PROFILE_STANDARD
+  { 2, 0 }, // FILTER_PROFILE_LOW_NOISE
+#endif
+};
+
+#ifndef ENABLE_ADC_DMA
+static_assert(ADC::kAdcSmoothing == 1 << 2, "Round robin filter profiles are kAdcSmoothing");
+#endif
+
+#ifdef ENABLE_ADC_DMA
+// ADC0 channel numbers (SC1A ADCH) of pins A0-A9, as in the ADC library's
+// channel2sc1aADC0. A6 is ADC0_SE6b, so Init selects the b mux channels.
+static constexpr uint8_t kADC0Channels[] = { 5, 14, 8, 9, 13, 12, 6, 7, 15, 4 };
+
+static constexpr uint8_t ADC0Channel(int pin) {
+  return kADC0Channels[pin - 14];
+}
+
+static constexpr uint8_t kChannelSC1A[ADC_CHANNEL_LAST] = {
+  ADC0Channel(ChannelDesc<ADC_CHANNEL_1>::PIN),
+  ADC0Channel(ChannelDesc<ADC_CHANNEL_2>::PIN),
+  ADC0Channel(ChannelDesc<ADC_CHANNEL_3>::PIN),
+  ADC0Channel(ChannelDesc<ADC_CHANNEL_4>::PIN),
+};
+#endif
+
 /*static*/ ::ADC ADC::adc_;
 /*static*/ size_t ADC::scan_channel_;
 /*static*/ ADC::CalibrationData *ADC::calibration_data_;
+/*static*/ ADC::FilterProfile ADC::filter_profile_;
+/*static*/ uint8_t ADC::smoothing_shift_;
 /*static*/ uint32_t ADC::raw_[ADC_CHANNEL_LAST];
 /*static*/ uint32_t ADC::smoothed_[ADC_CHANNEL_LAST];
 #ifdef ENABLE_ADC_DEBUG
 /*static*/ volatile uint32_t ADC::busy_waits_;
 #endif
+#ifdef ENABLE_ADC_DMA
+/*static*/ DMAChannel ADC::dma_result_;
+/*static*/ DMAChannel ADC::dma_mux_;
+/*static*/ uint8_t ADC::oversampling_[ADC_CHANNEL_LAST];
+/*static*/ volatile bool ADC::sequence_dirty_;
+/*static*/ size_t ADC::sequence_length_;
+/*static*/ uint8_t ADC::sequence_channel_[kAdcMaxSequenceLength];
+/*static*/ uint8_t ADC::sequence_oversampling_[ADC_CHANNEL_LAST];
+/*static*/ uint32_t ADC::sequence_sc1a_[kAdcMaxSequenceLength];
+/*static*/ volatile uint16_t ADC::dma_samples_[2 * kAdcMaxSequenceLength];
+/*static*/ bool ADC::dma_primed_;
+#endif
 
 /*static*/ void ADC::Init(CalibrationData *calibration_data) {
 
@@ -42,7 +98,11 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   adc_.adc0->setResolution(kAdcScanResolution);
   adc_.adc0->setConversionSpeed(kAdcConversionSpeed);
   adc_.adc0->setSamplingSpeed(kAdcSamplingSpeed);
+#ifdef ENABLE_ADC_DMA
+  adc_.adc0->setAveraging(kAdcDMAAverages);
+#else
   adc_.adc0->setAveraging(kAdcScanAverages);
+#endif
   adc_.adc0->disableDMA();
   adc_.adc0->disableInterrupts();
   adc_.adc0->disableCompare();
@@ -56,17 +116,119 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   adc_.adc1->disableInterrupts();
   adc_.adc1->disableCompare();
 
-  scan_channel_ = ADC_CHANNEL_1;
-  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN);
-
   calibration_data_ = calibration_data;
   std::fill(raw_, raw_ + ADC_CHANNEL_LAST, 0);
   std::fill(smoothed_, smoothed_ + ADC_CHANNEL_LAST, 0);
 #ifdef ENABLE_ADC_DEBUG
   busy_waits_ = 0;
 #endif
+
+  set_filter_profile(FILTER_PROFILE_STANDARD);
+
+#ifdef ENABLE_ADC_DMA
+  dma_result_.begin(true);
+  dma_mux_.begin(true);
+  ADC0_CFG2 |= ADC_CFG2_MUXSEL;
+  adc_.adc0->enableDMA();
+  sequence_dirty_ = false;
+  StartDMA();
+#else
+  scan_channel_ = ADC_CHANNEL_1;
+  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN);
+#endif
 }
 
+/*static*/ void ADC::set_filter_profile(FilterProfile profile) {
+  if (profile >= FILTER_PROFILE_LAST)
+    return;
+  filter_profile_ = profile;
+  smoothing_shift_ = kFilterProfiles[profile].smoothing_shift;
+#ifdef ENABLE_ADC_DMA
+  for (size_t channel = ADC_CHANNEL_1; channel < ADC_CHANNEL_LAST; ++channel)
+    set_oversampling(static_cast<ADC_CHANNEL>(channel), kFilterProfiles[profile].oversampling);
+#endif
+}
+
+#ifdef ENABLE_ADC_DMA
+/*static*/ void ADC::set_oversampling(ADC_CHANNEL channel, uint8_t oversampling) {
+  oversampling = std::min(oversampling, kAdcMaxOversampling);
+  if (oversampling_[channel] != oversampling) {
+    oversampling_[channel] = oversampling;
+    sequence_dirty_ = true;
+  }
+}
+
+// dma_result_ moves each result from ADC0_RA into a circular buffer that holds
+// the sequence twice, and every transfer triggers dma_mux_ to write the next
+// channel into ADC0_SC1A, which starts the next conversion. Neither channel
+// ever completes, so once started it runs without any CPU involvement.
+/*static*/ void ADC::StartDMA() {
+  dma_mux_.disable();
+  dma_result_.disable();
+  ADC0_SC1A = ADC_SC1_ADCH(0x1f); // abort conversion in progress
+
+  // Spread repeated reads of a channel over the sequence
+  size_t length = 0;
+  for (size_t pass = 0; pass < (1U << kAdcMaxOversampling); ++pass) {
+    for (size_t channel = ADC_CHANNEL_1; channel < ADC_CHANNEL_LAST; ++channel) {
+      if (pass < (1U << oversampling_[channel]))
+        sequence_channel_[length++] = channel;
+    }
+  }
+  std::copy(oversampling_, oversampling_ + ADC_CHANNEL_LAST, sequence_oversampling_);
+  sequence_length_ = length;
+
+  // SC1A for entry i is written after sample i, so it's for sample i + 1
+  for (size_t i = 0; i < length; ++i)
+    sequence_sc1a_[i] = ADC_SC1_ADCH(kChannelSC1A[sequence_channel_[(i + 1) % length]]);
+  for (auto &sample : dma_samples_)
+    sample = 0;
+  dma_primed_ = false;
+
+  dma_result_.source((volatile uint16_t &)ADC0_RA);
+  dma_result_.destinationBuffer(dma_samples_, 2 * length * sizeof(uint16_t));
+  dma_result_.triggerAtHardwareEvent(DMAMUX_SOURCE_ADC0);
+
+  dma_mux_.sourceBuffer(sequence_sc1a_, length * sizeof(uint32_t));
+  dma_mux_.destination(ADC0_SC1A);
+  dma_mux_.triggerAtTransfersOf(dma_result_);
+  dma_mux_.triggerAtCompletionOf(dma_result_);
+
+  dma_mux_.enable();
+  dma_result_.enable();
+  ADC0_SC1A = sequence_sc1a_[length - 1];
+}
+
+/*static*/ void FASTRUN ADC::Scan() {
+  if (sequence_dirty_) {
+    sequence_dirty_ = false;
+    StartDMA();
+    return;
+  }
+
+  // Use whichever half of the buffer isn't being written to. A half takes
+  // longer to fill than this takes to read, so there's no need to lock. Until
+  // the first half is complete, keep the previous values.
+  const size_t length = sequence_length_;
+  const volatile uint16_t *write_position =
+      static_cast<const volatile uint16_t *>(dma_result_.destinationAddress());
+  const bool second_half = write_position >= dma_samples_ + length;
+  if (!dma_primed_) {
+    if (!second_half)
+      return;
+    dma_primed_ = true;
+  }
+  const volatile uint16_t *samples = second_half ? dma_samples_ : dma_samples_ + length;
+
+  uint32_t sums[ADC_CHANNEL_LAST] = { 0 };
+  for (size_t i = 0; i < length; ++i)
+    sums[sequence_channel_[i]] += samples[i];
+  for (size_t channel = ADC_CHANNEL_1; channel < ADC_CHANNEL_LAST; ++channel)
+    update(channel, sums[channel] >> sequence_oversampling_[channel]);
+}
+
+#else
+
 // As I understand it, only CV4 can be muxed to ADC1, so it's not possible to
 // use ADC::startSynchronizedSingleRead, which would allow reading two channels
 // simultaneously
@@ -109,6 +271,7 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   }
   scan_channel_ = channel;
 }
+#endif // ENABLE_ADC_DMA
 
 /*static*/ void ADC::CalibratePitch(int32_t c2, int32_t c4) {
   // This is the method used by the Mutable Instruments calibration and
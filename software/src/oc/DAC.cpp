@@ -80,10 +80,88 @@ void DAC::Init(CalibrationData *calibration_data) {
   if (F_BUS == 60000000 || F_BUS == 48000000) 
     SPIFIFO.begin(DAC_CS, SPICLOCK_30MHz, SPI_MODE0);  
 
+#ifdef ENABLE_DAC_DMA
+  dma_tx_.begin(true);
+  dma_tx_.destination(SPI0_PUSHR);
+  dma_tx_.disableOnCompletion();
+
+  dma_rx_.begin(true);
+  dma_rx_.source(SPI0_POPR);
+  dma_rx_.destination(dma_rx_data_);
+  dma_rx_.disableOnCompletion();
+
+  dma_tx_.triggerAtTransfersOf(dma_rx_);
+  dma_busy_ = false;
+#endif
+  busy_waits_ = 0;
+
+  // Make sure everything is written on the first update
+  for (auto &value : sent_values_)
+    value = 0xffffffff;
+  refresh_ticks_ = kRefreshTicks;
+  refresh_channel_ = DAC_CHANNEL_A;
+
   set_all(0xffff);
   Update();
+  WaitForTransfer();
 }
 
+#ifdef ENABLE_DAC_DMA
+// Each channel is a command byte followed by 16 data bits, i.e. two PUSHR
+// words, with PCS0 (DAC_CS) held active in between. dma_tx_ writes the first
+// word when triggered manually, and then each frame that arrives in the RX
+// FIFO triggers dma_rx_ to pop it, which links to dma_tx_ for the next word.
+// The last frame completes dma_rx_, and the SPI0 is free again. dma_rx_ is
+// only attached to the SPI0 RX request from here until WaitForTransfer, so the
+// display's page transfers can't trigger it.
+static constexpr uint32_t kDACPushrCommand = SPI_PUSHR_PCS(0x01) | SPI_PUSHR_CONT | SPI_PUSHR_CTAS(0);
+static constexpr uint32_t kDACPushrData = SPI_PUSHR_PCS(0x01) | SPI_PUSHR_CTAS(1);
+
+/*static*/
+void FASTRUN DAC::Write(uint32_t channels) {
+  uint32_t *pushr = dma_commands_;
+  for (size_t channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel) {
+    if (channels & (0x1 << channel)) {
+      const uint32_t value = values_[channel];
+      *pushr++ = kDACPushrCommand | command(channel);
+      *pushr++ = kDACPushrData | data(value);
+      sent_values_[channel] = value;
+    }
+  }
+  const size_t words = pushr - dma_commands_;
+
+  // The display transfer from the previous tick is done (see display::Flush)
+  SPI0_RSER = 0;
+  SPI0_MCR = SPI_MCR_MSTR | SPI_MCR_PCSIS(0x1F) | SPI_MCR_CLR_TXF | SPI_MCR_CLR_RXF;
+  SPI0_SR = 0xFF0F0000;
+
+  dma_tx_.sourceBuffer(dma_commands_, words * sizeof(uint32_t));
+  dma_rx_.transferCount(words);
+  dma_rx_.clearComplete();
+  dma_rx_.triggerAtHardwareEvent(DMAMUX_SOURCE_SPI0_RX);
+  dma_tx_.enable();
+  dma_rx_.enable();
+  dma_busy_ = true;
+
+  SPI0_RSER = SPI_RSER_RFDF_RE | SPI_RSER_RFDF_DIRS;
+  dma_tx_.triggerManual();
+}
+#else
+/*static*/
+void FASTRUN DAC::Write(uint32_t channels) {
+  for (size_t channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel) {
+    if (channels & (0x1 << channel)) {
+      const uint32_t value = values_[channel];
+      SPIFIFO.write(command(channel), SPI_CONTINUE);
+      SPIFIFO.write16(data(value));
+      SPIFIFO.read();
+      SPIFIFO.read();
+      sent_values_[channel] = value;
+    }
+  }
+}
+#endif
+
 /*static*/
 uint8_t DAC::calibration_data_used(uint8_t channel_id) {
   const oc::Autotune_data &autotune_data = oc::AUTOTUNE::GetAutotune_data(channel_id);
@@ -223,6 +301,26 @@ DAC::CalibrationData *DAC::calibration_data_ = nullptr;
 /*static*/
 uint32_t DAC::values_[DAC_CHANNEL_LAST];
 /*static*/
+uint32_t DAC::sent_values_[DAC_CHANNEL_LAST];
+/*static*/
+uint32_t DAC::refresh_ticks_;
+/*static*/
+size_t DAC::refresh_channel_;
+/*static*/
+volatile uint32_t DAC::busy_waits_;
+#ifdef ENABLE_DAC_DMA
+/*static*/
+DMAChannel DAC::dma_tx_;
+/*static*/
+DMAChannel DAC::dma_rx_;
+/*static*/
+uint32_t DAC::dma_commands_[2 * DAC_CHANNEL_LAST];
+/*static*/
+volatile uint32_t DAC::dma_rx_data_;
+/*static*/
+bool DAC::dma_busy_;
+#endif
+/*static*/
 uint16_t DAC::history_[DAC_CHANNEL_LAST][DAC::kHistoryDepth];
 /*static*/ 
 volatile size_t DAC::history_tail_;
@@ -230,70 +328,6 @@ volatile size_t DAC::history_tail_;
 uint8_t DAC::DAC_scaling[DAC_CHANNEL_LAST];
 }; // namespace oc
 
-void set8565_CHA(uint32_t data) {
-  #ifdef BUCHLA_cOC
-  uint32_t _data = data;
-  #else
-  uint32_t _data = oc::DAC::MAX_VALUE - data;
-  #endif
-  #ifdef FLIP_180
-  SPIFIFO.write(0b00010110, SPI_CONTINUE);
-  #else
-  SPIFIFO.write(0b00010000, SPI_CONTINUE);
-  #endif
-  SPIFIFO.write16(_data);
-  SPIFIFO.read();
-  SPIFIFO.read();
-}
-
-void set8565_CHB(uint32_t data) {
-  #ifdef BUCHLA_cOC
-  uint32_t _data = data;
-  #else
-  uint32_t _data = oc::DAC::MAX_VALUE - data;
-  #endif
-  #ifdef FLIP_180
-  SPIFIFO.write(0b00010100, SPI_CONTINUE);
-  #else
-  SPIFIFO.write(0b00010010, SPI_CONTINUE);
-  #endif
-  SPIFIFO.write16(_data);
-  SPIFIFO.read();
-  SPIFIFO.read();
-}
-
-void set8565_CHC(uint32_t data) {
-  #ifdef BUCHLA_cOC
-  uint32_t _data = data;
-  #else
-  uint32_t _data = oc::DAC::MAX_VALUE - data;
-  #endif
-  #ifdef FLIP_180
-  SPIFIFO.write(0b00010010, SPI_CONTINUE);
-  #else
-  SPIFIFO.write(0b00010100, SPI_CONTINUE);
-  #endif
-  SPIFIFO.write16(_data);
-  SPIFIFO.read();
-  SPIFIFO.read(); 
-}
-
-void set8565_CHD(uint32_t data) {
-  #ifdef BUCHLA_cOC
-  uint32_t _data = data;
-  #else
-  uint32_t _data = oc::DAC::MAX_VALUE - data;
-  #endif
-  #ifdef FLIP_180
-  SPIFIFO.write(0b00010000, SPI_CONTINUE);
-  #else
-  SPIFIFO.write(0b00010110, SPI_CONTINUE);
-  #endif
-  SPIFIFO.write16(_data);
-  SPIFIFO.read();
-  SPIFIFO.read();
-}
-
 // adapted from https://github.com/xxxajk/spi4teensy3 (MISO disabled) : 
 
 void SPI_init() {
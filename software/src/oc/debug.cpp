@@ -1,9 +1,14 @@
 #include <Arduino.h>
+#include "drivers/display.h"
 #include "oc/ADC.h"
+#include "oc/apps.h"
 #include "oc/config.h"
 #include "oc/core.h"
 #include "oc/debug.h"
 #include "oc/menus.h"
+#include "oc/midi_in.h"
+#include "oc/midi_out.h"
+#include "oc/render_scheduler.h"
 #include "oc/ui.h"
 #include "oc/strings.h"
 #include "util/misc.h"
@@ -47,10 +52,56 @@ namespace DEBUG {
   uint32_t UI_max_queue_depth;
   uint32_t UI_queue_overflow;
 
+  const char * const ISR_stage_names[ISR_STAGE_LAST] = {
+    "FLSH", "DAC", "ADC", "DIGI", "MIDI", "DISP", "APP"
+  };
+  debug::CycleHistogram ISR_stage_cycles[ISR_STAGE_LAST];
+  debug::CycleHistogram ISR_total_cycles;
+  uint32_t ISR_overruns;
+  debug::CycleHistogram APPLET_cycles[2];
+  int APPLET_ids[2] = { -1, -1 };
+  debug::CycleHistogram CLOCK_SETUP_cycles;
+
   void Init() {
     debug::CycleMeasurement::Init();
     DebugPins::Init();
   }
+
+  void ResetProfile() {
+    for (auto &h : ISR_stage_cycles)
+      h.Reset();
+    ISR_total_cycles.Reset();
+    ISR_overruns = 0;
+    APPLET_cycles[0].Reset();
+    APPLET_cycles[1].Reset();
+    CLOCK_SETUP_cycles.Reset();
+  }
+
+  static void dump_histogram(const char *name, const debug::CycleHistogram &h) {
+    serial_printf("%-6s n=%lu mean=%lu p99<%lu max=%lu |", name,
+                  (unsigned long)h.count(), (unsigned long)h.mean(),
+                  (unsigned long)h.percentile_bound(99), (unsigned long)h.max_value());
+    for (auto count : h.buckets_)
+      serial_printf(" %lu", (unsigned long)count);
+    serial_printf("\n");
+  }
+
+  void DumpProfile() {
+    serial_printf("# CORE ISR profile, cycles @ %luMHz, budget %lu\n",
+                  (unsigned long)(F_CPU / 1000000),
+                  (unsigned long)(OC_CORE_TIMER_RATE * (F_CPU / 1000000)));
+    serial_printf("# histogram buckets: 0, <2, <4, <8 ... <65536, >=65536\n");
+    for (int stage = 0; stage < ISR_STAGE_LAST; ++stage)
+      dump_histogram(ISR_stage_names[stage], ISR_stage_cycles[stage]);
+    dump_histogram("TOTAL", ISR_total_cycles);
+    serial_printf("overruns=%lu\n", (unsigned long)ISR_overruns);
+    dump_histogram("CLKSET", CLOCK_SETUP_cycles);
+    for (int h = 0; h < 2; ++h) {
+      char name[8];
+      snprintf(name, sizeof(name), "%c%d", h ? 'R' : 'L', APPLET_ids[h]);
+      dump_histogram(name, APPLET_cycles[h]);
+    }
+  }
 }; // namespace DEBUG
 
 static void debug_menu_core() {
@@ -75,8 +126,39 @@ static void debug_menu_core() {
 #ifdef OC_UI_DEBUG
   graphics.setPrintPos(2, 42);
   graphics.printf("UI   !%u #%u", DEBUG::UI_queue_overflow, DEBUG::UI_event_count);
-  graphics.setPrintPos(2, 52);
+#else
+  graphics.setPrintPos(2, 42);
+  graphics.printf("MOUT %u/%u ~%u !%u", MidiOut::depth(), MidiOut::max_depth(), MidiOut::coalesced(), MidiOut::dropped());
 #endif
+
+  graphics.setPrintPos(2, 52);
+  graphics.printf("MIDI #%u !%u >%u", MidiIn::received(), MidiIn::dropped(), MidiIn::deferred());
+}
+
+// Mean/max cycles per ISR stage; UP resets, DOWN dumps histograms to serial
+static void debug_menu_isr() {
+  weegfx::coord_t y = 12;
+  for (int stage = 0; stage < DEBUG::ISR_STAGE_LAST; ++stage, y += 7) {
+    const debug::CycleHistogram &h = DEBUG::ISR_stage_cycles[stage];
+    graphics.setPrintPos(2, y);
+    graphics.printf("%-4s %5u %6u", DEBUG::ISR_stage_names[stage], h.mean(), h.max_value());
+  }
+}
+
+static void debug_menu_applets() {
+  graphics.setPrintPos(2, 12);
+  graphics.printf("ISR  %5u %6u", DEBUG::ISR_total_cycles.mean(), DEBUG::ISR_total_cycles.max_value());
+  graphics.setPrintPos(2, 20);
+  graphics.printf("p99< %5u", DEBUG::ISR_total_cycles.percentile_bound(99));
+  graphics.setPrintPos(2, 28);
+  graphics.printf("OVR  %u", DEBUG::ISR_overruns);
+  graphics.setPrintPos(2, 36);
+  graphics.printf("CLK  %5u %6u", DEBUG::CLOCK_SETUP_cycles.mean(), DEBUG::CLOCK_SETUP_cycles.max_value());
+  for (int h = 0; h < 2; ++h) {
+    graphics.setPrintPos(2, 44 + h * 8);
+    graphics.printf("%c%-3d %5u %6u", h ? 'R' : 'L', DEBUG::APPLET_ids[h],
+                    DEBUG::APPLET_cycles[h].mean(), DEBUG::APPLET_cycles[h].max_value());
+  }
 }
 
 static void debug_menu_version()
@@ -110,6 +192,37 @@ static void debug_menu_gfx() {
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.min_value()),
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.value()),
                   debug::cycles_to_us(DEBUG::MENU_draw_cycles.max_value()));
+
+  // Display pages sent/skipped and frames drawn/dropped per second
+  static uint32_t last_millis, last_sent, last_skipped, last_frames, last_dropped;
+  static uint32_t sent_per_second, skipped_per_second;
+  static uint32_t frames_per_second, dropped_per_second;
+  const uint32_t now = millis();
+  if (now - last_millis >= 1000) {
+    const uint32_t sent = display::driver.pages_sent();
+    const uint32_t skipped = display::driver.pages_skipped();
+    const uint32_t frames = render_scheduler.frames();
+    const uint32_t dropped = render_scheduler.dropped();
+    sent_per_second = ((sent - last_sent) * 1000) / (now - last_millis);
+    skipped_per_second = ((skipped - last_skipped) * 1000) / (now - last_millis);
+    frames_per_second = ((frames - last_frames) * 1000) / (now - last_millis);
+    dropped_per_second = ((dropped - last_dropped) * 1000) / (now - last_millis);
+    last_millis = now;
+    last_sent = sent;
+    last_skipped = skipped;
+    last_frames = frames;
+    last_dropped = dropped;
+  }
+  graphics.setPrintPos(2, 32);
+  graphics.printf("PAGE %4u/%4u/s", sent_per_second, skipped_per_second);
+  graphics.setPrintPos(2, 42);
+  graphics.printf("FPS  %4u/%4u/s", frames_per_second, dropped_per_second);
+
+  // Last Hemisphere view cost per half
+  graphics.setPrintPos(2, 52);
+  graphics.printf("HALF %4u/%4uus",
+                  debug::cycles_to_us(render_scheduler.region_cycles(0)),
+                  debug::cycles_to_us(render_scheduler.region_cycles(1)));
 }
 
 static void debug_menu_adc() {
@@ -131,6 +244,18 @@ static void debug_menu_adc() {
 //      graphics.setPrintPos(2, 52); graphics.print(ADC::fail_flag1());
 }
 
+static void debug_menu_save() {
+  const apps::SaveStats &stats = apps::last_save;
+  graphics.setPrintPos(2, 12);
+  graphics.printf("USED %u/%u", stats.used, EEPROM_APPDATA_BINARY_SIZE);
+  graphics.setPrintPos(2, 22);
+  graphics.printf("CHG  %uB %u apps", stats.changed, stats.dirty_apps);
+  graphics.setPrintPos(2, 32);
+  graphics.printf("RLE  %u SKIP %u", stats.compressed_apps, stats.skipped_apps);
+  graphics.setPrintPos(2, 42);
+  graphics.printf("TIME %ums", stats.us / 1000);
+}
+
 struct DebugMenu {
   const char *title;
   void (*display_fn)();
@@ -138,9 +263,12 @@ struct DebugMenu {
 
 static const DebugMenu debug_menus[] = {
   { " CORE", debug_menu_core },
+  { " ISR", debug_menu_isr },
+  { " HEM", debug_menu_applets },
   { " VERS", debug_menu_version },
   { " GFX", debug_menu_gfx },
   { " ADC", debug_menu_adc },
+  { " SAVE", debug_menu_save },
 #ifdef POLYLFO_DEBUG  
   { " POLYLFO", POLYLFO_debug },
 #endif // POLYLFO_DEBUG
@@ -187,6 +315,10 @@ void Ui::DebugStats() {
         ++current_menu;
         if (!current_menu->title || !current_menu->display_fn)
           current_menu = &debug_menus[0];
+      } else if (CONTROL_BUTTON_UP == event.control && UI::EVENT_BUTTON_PRESS == event.type) {
+        DEBUG::ResetProfile();
+      } else if (CONTROL_BUTTON_DOWN == event.control && UI::EVENT_BUTTON_PRESS == event.type) {
+        DEBUG::DumpProfile();
       }
     }
   }
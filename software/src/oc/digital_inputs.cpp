@@ -8,7 +8,17 @@
 uint32_t oc::DigitalInputs::clocked_mask_;
 
 /*static*/
-volatile uint32_t oc::DigitalInputs::clocked_[DIGITAL_INPUT_LAST];
+oc::DigitalInputs::EdgeQueue oc::DigitalInputs::edge_queue_[DIGITAL_INPUT_LAST];
+/*static*/
+uint32_t oc::DigitalInputs::scan_timestamp_;
+/*static*/
+uint32_t oc::DigitalInputs::edge_count_[DIGITAL_INPUT_LAST];
+/*static*/
+uint32_t oc::DigitalInputs::edge_timestamp_[DIGITAL_INPUT_LAST];
+/*static*/
+uint32_t oc::DigitalInputs::edge_ticks_[DIGITAL_INPUT_LAST];
+/*static*/
+uint32_t oc::DigitalInputs::edge_period_[DIGITAL_INPUT_LAST];
 
 void FASTRUN tr1_ISR() {  
   oc::DigitalInputs::clock<oc::DIGITAL_INPUT_1>();
@@ -45,12 +55,18 @@ void oc::DigitalInputs::Init() {
   }
 
   clocked_mask_ = 0;
-  std::fill(clocked_, clocked_ + DIGITAL_INPUT_LAST, 0);
+  for (auto &queue : edge_queue_) {
+    queue.write = 0;
+    queue.read = 0;
+  }
+  std::fill(edge_count_, edge_count_ + DIGITAL_INPUT_LAST, 0);
+  std::fill(edge_ticks_, edge_ticks_ + DIGITAL_INPUT_LAST, 0);
+  std::fill(edge_period_, edge_period_ + DIGITAL_INPUT_LAST, 0);
 
-  // Assume the priority of pin change interrupts is lower or equal to the
-  // thread where ::Scan function is called. Otherwise a safer mechanism is
-  // required to avoid conflicts (LDREX/STREX or store ARM_DWT_CYCCNT in the
-  // array to check for changes.
+  // The pin ISRs only ever write their own edge queue and Scan only reads it,
+  // so the pin change interrupts may have any priority relative to the thread
+  // that calls ::Scan. Each edge carries its ARM_DWT_CYCCNT timestamp, so the
+  // trigger time isn't limited to the core ISR rate either.
   //
   // A really nice approach would be to use the FTM timer mechanism and avoid
   // the ISR altogether, but this only works for one of the pins. Using more
@@ -78,6 +94,7 @@ void oc::DigitalInputs::reInit() {
 
 /*static*/
 void oc::DigitalInputs::Scan() {
+  scan_timestamp_ = OC_EDGE_TIMESTAMP();
   clocked_mask_ =
     ScanInput<DIGITAL_INPUT_1>() |
     ScanInput<DIGITAL_INPUT_2>() |
@@ -0,0 +1,44 @@
+#include <Arduino.h>
+#include "oc/midi_in.h"
+
+namespace oc {
+
+/*static*/ MidiMessage MidiIn::queue_[MidiIn::kQueueSize];
+/*static*/ uint32_t MidiIn::write_ptr_;
+/*static*/ uint32_t MidiIn::scan_write_ptr_;
+/*static*/ uint32_t MidiIn::received_;
+/*static*/ uint32_t MidiIn::dropped_;
+/*static*/ uint32_t MidiIn::deferred_;
+
+/*static*/
+void MidiIn::Init() {
+  write_ptr_ = scan_write_ptr_ = 0;
+  received_ = dropped_ = deferred_ = 0;
+}
+
+/*static*/
+void FASTRUN MidiIn::Scan() {
+  uint32_t write_ptr = write_ptr_;
+  scan_write_ptr_ = write_ptr;
+
+  size_t reads = kMaxReadsPerScan;
+  while (usbMIDI.read()) {
+    MidiMessage &message = queue_[write_ptr & (kQueueSize - 1)];
+    message.type = usbMIDI.getType();
+    message.channel = message.type < usbMIDI.SystemExclusive ? usbMIDI.getChannel() : 0;
+    message.data1 = usbMIDI.getData1();
+    message.data2 = usbMIDI.getData2();
+    ++write_ptr;
+    ++received_;
+
+    if (usbMIDI.SystemExclusive == message.type)
+      break;
+    if (!--reads) {
+      ++deferred_;
+      break;
+    }
+  }
+  write_ptr_ = write_ptr;
+}
+
+} // namespace oc
@@ -0,0 +1,139 @@
+#include <Arduino.h>
+#include "oc/midi_out.h"
+
+namespace oc {
+
+/*static*/ MidiMessage MidiOut::queue_[MidiOut::kQueueSize];
+/*static*/ volatile uint32_t MidiOut::write_ptr_;
+/*static*/ volatile uint32_t MidiOut::read_ptr_;
+/*static*/ uint8_t MidiOut::realtime_queue_[MidiOut::kRealTimeQueueSize];
+/*static*/ volatile uint32_t MidiOut::realtime_write_ptr_;
+/*static*/ volatile uint32_t MidiOut::realtime_read_ptr_;
+/*static*/ size_t MidiOut::max_depth_;
+/*static*/ uint32_t MidiOut::sent_;
+/*static*/ uint32_t MidiOut::coalesced_;
+/*static*/ uint32_t MidiOut::dropped_;
+
+static inline bool IsController(uint8_t type) {
+  return usbMIDI.ControlChange == type || usbMIDI.AfterTouchChannel == type || usbMIDI.PitchBend == type;
+}
+
+/*static*/
+void MidiOut::Init() {
+  write_ptr_ = read_ptr_ = 0;
+  realtime_write_ptr_ = realtime_read_ptr_ = 0;
+  max_depth_ = 0;
+  sent_ = coalesced_ = dropped_ = 0;
+}
+
+// Drain copies an entry before it moves read_ptr_ past it, so the one at
+// read_ptr_ may be in use; everything after it can still be changed.
+/*static*/
+void MidiOut::Push(uint8_t type, uint8_t channel, uint8_t data1, uint8_t data2) {
+  noInterrupts();
+  const uint32_t write_ptr = write_ptr_;
+  const uint32_t read_ptr = read_ptr_;
+
+  if (IsController(type)) {
+    uint32_t ptr = write_ptr;
+    size_t depth = kCoalesceDepth;
+    while (depth-- && ptr - read_ptr > 1) {
+      MidiMessage &queued = queue_[--ptr & (kQueueSize - 1)];
+      if (queued.channel != channel)
+        continue;
+      if (queued.type == type && (usbMIDI.ControlChange != type || queued.data1 == data1)) {
+        queued.data1 = data1;
+        queued.data2 = data2;
+        ++coalesced_;
+        interrupts();
+        return;
+      }
+      if (!IsController(queued.type))
+        break;
+    }
+  }
+
+  if (write_ptr - read_ptr >= kQueueSize) {
+    ++dropped_;
+  } else {
+    MidiMessage &message = queue_[write_ptr & (kQueueSize - 1)];
+    message.type = type;
+    message.channel = channel;
+    message.data1 = data1;
+    message.data2 = data2;
+    write_ptr_ = write_ptr + 1;
+    if (write_ptr + 1 - read_ptr > max_depth_)
+      max_depth_ = write_ptr + 1 - read_ptr;
+  }
+  interrupts();
+}
+
+/*static*/
+void MidiOut::SendRealTime(uint8_t type) {
+  noInterrupts();
+  const uint32_t write_ptr = realtime_write_ptr_;
+  if (write_ptr - realtime_read_ptr_ >= kRealTimeQueueSize) {
+    ++dropped_;
+  } else {
+    realtime_queue_[write_ptr & (kRealTimeQueueSize - 1)] = type;
+    realtime_write_ptr_ = write_ptr + 1;
+  }
+  interrupts();
+}
+
+/*static*/
+void MidiOut::AllNotesOff() {
+  for (uint8_t channel = 1; channel <= 16; ++channel)
+    SendControlChange(123, 0, channel);
+}
+
+/*static*/
+void MidiOut::Send(const MidiMessage &message) {
+  switch (message.type) {
+    case usbMIDI.NoteOn:
+      usbMIDI.sendNoteOn(message.data1, message.data2, message.channel);
+      break;
+    case usbMIDI.NoteOff:
+      usbMIDI.sendNoteOff(message.data1, message.data2, message.channel);
+      break;
+    case usbMIDI.ControlChange:
+      usbMIDI.sendControlChange(message.data1, message.data2, message.channel);
+      break;
+    case usbMIDI.AfterTouchChannel:
+      usbMIDI.sendAfterTouch(message.data1, message.channel);
+      break;
+    case usbMIDI.PitchBend:
+      usbMIDI.sendPitchBend(static_cast<int16_t>(message.data1 | (message.data2 << 8)), message.channel);
+      break;
+    default:
+      break;
+  }
+}
+
+/*static*/
+void MidiOut::Drain() {
+  bool sent = false;
+
+  uint32_t read_ptr = realtime_read_ptr_;
+  while (read_ptr != realtime_write_ptr_) {
+    usbMIDI.sendRealTime(realtime_queue_[read_ptr & (kRealTimeQueueSize - 1)]);
+    realtime_read_ptr_ = ++read_ptr;
+    ++sent_;
+    sent = true;
+  }
+
+  read_ptr = read_ptr_;
+  size_t sends = kMaxSendsPerDrain;
+  while (read_ptr != write_ptr_ && sends--) {
+    const MidiMessage message = queue_[read_ptr & (kQueueSize - 1)];
+    read_ptr_ = ++read_ptr;
+    Send(message);
+    ++sent_;
+    sent = true;
+  }
+
+  if (sent)
+    usbMIDI.send_now();
+}
+
+} // namespace oc
@@ -44,6 +44,7 @@ void Ui::Init() {
 
   encoder_right_.Init(OC_GPIO_ENC_PINMODE);
   encoder_left_.Init(OC_GPIO_ENC_PINMODE);
+  encoder_right_backlog_ = encoder_left_backlog_ = 0;
 
   event_queue_.Init();
 }
@@ -101,20 +102,16 @@ void FASTRUN Ui::Poll() {
   encoder_right_.Poll();
   encoder_left_.Poll();
 
-  int32_t increment;
-  increment = encoder_right_.Read();
-  if (increment)
-    PushEvent(UI::EVENT_ENCODER, CONTROL_ENCODER_R, increment, button_state);
-
-  increment = encoder_left_.Read();
-  if (increment)
-    PushEvent(UI::EVENT_ENCODER, CONTROL_ENCODER_L, increment, button_state);
+  PushEncoderEvent(CONTROL_ENCODER_R, encoder_right_backlog_, encoder_right_.Read(), button_state);
+  PushEncoderEvent(CONTROL_ENCODER_L, encoder_left_backlog_, encoder_left_.Read(), button_state);
 
   button_state_ = button_state;
 }
 
 UiMode Ui::DispatchEvents(App *app) {
 
+  // Each event is taken off the queue before it's handled, since handlers
+  // (e.g. calibration, reset confirmation) may pull events themselves
   while (event_queue_.available()) {
     const UI::Event event = event_queue_.PullEvent();
     if (IgnoreEvent(event))
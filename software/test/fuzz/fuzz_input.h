@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Consumes the fuzzer's input as a stream of integers; reads past the end
+// return zero so every input maps onto a valid sequence of operations.
+class FuzzInput {
+public:
+  FuzzInput(const uint8_t *data, size_t size) : data_(data), size_(size) { }
+
+  bool empty() const { return !size_; }
+  size_t remaining() const { return size_; }
+
+  template <typename T>
+  T Read() {
+    T value = 0;
+    size_t n = size_ < sizeof(T) ? size_ : sizeof(T);
+    memcpy(&value, data_, n);
+    data_ += n;
+    size_ -= n;
+    return value;
+  }
+
+  // Value in [min, max]
+  int32_t Read(int32_t min, int32_t max) {
+    uint32_t range = static_cast<uint32_t>(max - min) + 1;
+    uint32_t value = Read<uint32_t>();
+    return min + static_cast<int32_t>(range ? value % range : value);
+  }
+
+  const uint8_t *data() const { return data_; }
+
+private:
+  const uint8_t *data_;
+  size_t size_;
+};
+
+#define FUZZ_CHECK(condition) \
+  do { if (!(condition)) __builtin_trap(); } while (0)
@@ -0,0 +1,50 @@
+// Stand-in for the libFuzzer driver when clang isn't available: replays the
+// files given on the command line, or runs -runs=N pseudo-random inputs with a
+// fixed seed. There's no coverage feedback, so this is a smoke test only.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int main(int argc, char **argv) {
+  long runs = 10000;
+  int files = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (!strncmp(argv[i], "-runs=", 6)) {
+      runs = strtol(argv[i] + 6, nullptr, 10);
+      continue;
+    }
+    FILE *f = fopen(argv[i], "rb");
+    if (!f) {
+      fprintf(stderr, "Can't open %s\n", argv[i]);
+      return 1;
+    }
+    std::vector<uint8_t> data;
+    int c;
+    while ((c = fgetc(f)) != EOF)
+      data.push_back(c);
+    fclose(f);
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+    ++files;
+  }
+
+  if (!files) {
+    std::mt19937 rng(0x0c0c);
+    std::vector<uint8_t> data;
+    for (long run = 0; run < runs; ++run) {
+      data.resize(rng() % 1024);
+      for (uint8_t &b : data)
+        b = rng();
+      LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    printf("%s: %ld runs\n", argv[0], runs);
+  } else {
+    printf("%s: %d files\n", argv[0], files);
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+// Differential fuzzing of braids::Quantizer against the linear-scan reference:
+// the input picks a scale, a mask and a sequence of pitch/root/transpose
+// changes, and both have to produce the same pitch and note number.
+
+#include "braids/quantizer.h"
+#include "../reference_quantizer.h"
+#include "fuzz_input.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  FuzzInput input(data, size);
+
+  braids::Scale scale;
+  scale.span = input.Read(1, 4096);
+  scale.num_notes = input.Read(1, 16);
+  for (size_t i = 0; i < scale.num_notes; ++i)
+    scale.notes[i] = input.Read(0, scale.span - 1);
+  if (input.Read<uint8_t>() & 1)
+    braids::SortScale(scale);
+  uint16_t mask = input.Read<uint16_t>() | 1;
+
+  braids::Quantizer quantizer;
+  ReferenceQuantizer reference;
+  quantizer.Init();
+  quantizer.Configure(scale, mask);
+  reference.Configure(scale, mask);
+
+  int32_t pitch = 0, root = 0, transpose = 0;
+  while (!input.empty()) {
+    switch (input.Read<uint8_t>() & 7) {
+      case 0: pitch = input.Read(-16 * 1536, 16 * 1536); break;
+      case 1: root = input.Read(0, 11 * 128); break;
+      case 2: transpose = input.Read(-32, 32); break;
+      case 3: quantizer.Requantize(); reference.requantize = true; break;
+      default: pitch += input.Read<int8_t>(); break;
+    }
+    FUZZ_CHECK(reference.Process(pitch, root, transpose) == quantizer.Process(pitch, root, transpose));
+    FUZZ_CHECK(reference.note_number == quantizer.GetLatestNoteNumber());
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+// settings::SettingsBase::Restore on arbitrary stored data: every value must
+// end up within its limits, and saving and restoring again is lossless.
+
+#include "util/settings.h"
+#include "fuzz_input.h"
+
+#include <vector>
+
+namespace {
+
+class FuzzSettings : public settings::SettingsBase<FuzzSettings, 10> { };
+
+}  // namespace
+
+SETTINGS_DECLARE(FuzzSettings, 10) {
+  { 0, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 0, -64, 63, "I8", nullptr, settings::STORAGE_TYPE_I8 },
+  { 0, 0, 200, "U8", nullptr, settings::STORAGE_TYPE_U8 },
+  { 0, 3, 12, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 0, -1000, 1000, "I16", nullptr, settings::STORAGE_TYPE_I16 },
+  { 0, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 0, 0, 50000, "U16", nullptr, settings::STORAGE_TYPE_U16 },
+  { 0, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 0, -100000, 100000, "I32", nullptr, settings::STORAGE_TYPE_I32 },
+  { 0, 0, 0x7fffffff, "U32", nullptr, settings::STORAGE_TYPE_U32 },
+};
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const size_t storage_size = FuzzSettings::storageSize();
+  std::vector<uint8_t> stored(storage_size, 0);
+  memcpy(&stored.front(), data, size < storage_size ? size : storage_size);
+
+  FuzzSettings settings;
+  settings.InitDefaults();
+  FUZZ_CHECK(settings.Restore(&stored.front()) == storage_size);
+  for (size_t i = 0; i < 10; ++i) {
+    FUZZ_CHECK(settings.get_value(i) >= FuzzSettings::value_attr(i).min_);
+    FUZZ_CHECK(settings.get_value(i) <= FuzzSettings::value_attr(i).max_);
+  }
+
+  std::vector<uint8_t> saved(storage_size + 1, 0xa5);
+  FUZZ_CHECK(settings.Save(&saved.front()) == storage_size);
+  FUZZ_CHECK(saved[storage_size] == 0xa5);
+
+  FuzzSettings restored;
+  restored.InitDefaults();
+  restored.Restore(&saved.front());
+  for (size_t i = 0; i < 10; ++i)
+    FUZZ_CHECK(settings.get_value(i) == restored.get_value(i));
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+#include "gtest/gtest.h"
+#include "util/delay_line.h"
+
+// DelayPool hands out power-of-2 blocks, one per owner, and DelayLine clears
+// its block over several ticks and wraps with a mask.
+
+namespace {
+
+typedef util::DelayPool<1024> Pool;
+
+void ClearAll(util::DelayLine &line) {
+  while (!line.cleared()) line.Tick();
+}
+
+} // namespace
+
+TEST(DelayPoolTest, SingleOwnerGetsEverything) {
+  Pool pool;
+  const util::DelayBlock *block = pool.Allocate(0, 1024);
+  EXPECT_EQ(1024U, block->size);
+  EXPECT_EQ(0U, pool.available());
+  pool.Release(0);
+  EXPECT_EQ(1024U, pool.available());
+}
+
+TEST(DelayPoolTest, SecondOwnerShrinksFirst) {
+  Pool pool;
+  const util::DelayBlock *left = pool.Allocate(0, 1024);
+  uint8_t *left_data = left->data;
+  uint32_t generation = left->generation;
+
+  const util::DelayBlock *right = pool.Allocate(1, 1024);
+  EXPECT_EQ(512U, left->size);
+  EXPECT_EQ(512U, right->size);
+  EXPECT_NE(generation, left->generation);
+  // The left block shrinks in place and the right one ends at the end
+  EXPECT_EQ(left_data, left->data);
+  EXPECT_EQ(left->data + 512, right->data);
+
+  // The right side is shrunk the same way
+  pool.Release(0);
+  pool.Allocate(0, 1024);
+  EXPECT_EQ(512U, left->size);
+  EXPECT_EQ(512U, right->size);
+}
+
+TEST(DelayPoolTest, RoundsDownToPowerOf2) {
+  Pool pool;
+  EXPECT_EQ(256U, pool.Allocate(1, 300)->size);
+  EXPECT_EQ(512U, pool.Allocate(0, 1024)->size);
+  EXPECT_EQ(256U, pool.available());
+}
+
+TEST(DelayLineTest, ClearsIncrementally) {
+  Pool pool;
+  const util::DelayBlock *block = pool.Allocate(0, 1024);
+  memset(block->data, 0x55, block->size);
+
+  util::DelayLine line;
+  line.Init(block, util::DELAY_SAMPLE_8BIT);
+  line.Tick();
+  EXPECT_FALSE(line.cleared());
+  // Not cleared yet: silent, and writes are dropped
+  line.Write(1000, 0x7f00);
+  EXPECT_EQ(0, line.Read(1000));
+
+  size_t ticks = 1;
+  while (!line.cleared()) {
+    line.Tick();
+    ++ticks;
+  }
+  EXPECT_EQ(1024 / util::DelayLine::kClearBytesPerTick, ticks);
+  for (uint32_t i = 0; i < 1024; ++i)
+    ASSERT_EQ(0, line.Read(i)) << i;
+}
+
+TEST(DelayLineTest, Wraps) {
+  Pool pool;
+  const util::DelayBlock *block = pool.Allocate(0, 512);
+  util::DelayLine line;
+  line.Init(block, util::DELAY_SAMPLE_16BIT);
+  ClearAll(line);
+  EXPECT_EQ(256U, line.length());
+
+  // Nothing outside the block is touched
+  uint8_t *rest = block->data + block->size;
+  memset(rest, 0x55, pool.available());
+
+  for (uint32_t i = 0; i < 256; ++i)
+    line.Write(i, i * 128 - 16384);
+  for (uint32_t i = 0; i < 256; ++i) {
+    ASSERT_EQ(static_cast<int16_t>(i * 128 - 16384), line.Read(i + 256));
+    ASSERT_EQ(line.Read(i), line.Read(i - 256));
+  }
+  for (uint32_t i = 0; i < 1024; ++i)
+    line.Write(0xfffffe00 + i, -1);
+  for (size_t i = 0; i < pool.available(); ++i)
+    ASSERT_EQ(0x55, rest[i]) << i;
+}
+
+TEST(DelayLineTest, FollowsPoolChanges) {
+  Pool pool;
+  util::DelayLine left, right;
+  left.Init(pool.Allocate(0, 1024), util::DELAY_SAMPLE_8BIT);
+  ClearAll(left);
+  EXPECT_EQ(1024U, left.length());
+
+  right.Init(pool.Allocate(1, 1024), util::DELAY_SAMPLE_8BIT);
+  left.Tick();
+  EXPECT_EQ(512U, left.length());
+  ClearAll(left);
+  ClearAll(right);
+
+  for (uint32_t i = 0; i < 1024; ++i) {
+    left.Write(i, 0x1000);
+    right.Write(i, -0x1000);
+  }
+  for (uint32_t i = 0; i < 512; ++i) {
+    ASSERT_EQ(0x1000, left.Read(i));
+    ASSERT_EQ(-0x1000, right.Read(i));
+  }
+}
+
+TEST(DelayLineTest, FormatChangeTakesEffectOnTick) {
+  Pool pool;
+  util::DelayLine line;
+  line.Init(pool.Allocate(0, 1024), util::DELAY_SAMPLE_8BIT);
+  ClearAll(line);
+  line.Write(0, 0x4000);
+
+  line.set_format(util::DELAY_SAMPLE_ULAW);
+  EXPECT_EQ(util::DELAY_SAMPLE_ULAW, line.format());
+  EXPECT_EQ(0x4000, line.Read(0));
+  line.Tick();
+  EXPECT_FALSE(line.cleared());
+  ClearAll(line);
+  EXPECT_EQ(0, line.Read(0));
+}
+
+TEST(DelayLineTest, SampleResolution) {
+  Pool pool;
+  util::DelayLine line;
+  line.Init(pool.Allocate(0, 1024), util::DELAY_SAMPLE_8BIT);
+
+  for (int format = 0; format < util::DELAY_SAMPLE_FORMAT_LAST; ++format) {
+    line.set_format(static_cast<util::DelaySampleFormat>(format));
+    line.Tick();
+    ClearAll(line);
+    for (int32_t sample = -32768; sample <= 32767; sample += 7) {
+      line.Write(0, sample);
+      int32_t error = line.Read(0) - sample;
+      switch (format) {
+      case util::DELAY_SAMPLE_16BIT:
+        ASSERT_EQ(0, error);
+        break;
+      case util::DELAY_SAMPLE_ULAW:
+        // Finer than 8 bits for quiet samples, coarser for loud ones
+        ASSERT_LE(abs(error), abs(sample) / 8 + 8) << sample;
+        break;
+      default:
+        ASSERT_LE(error, 0);
+        ASSERT_GT(error, -256);
+        break;
+      }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+#include <cmath>
+#include "gtest/gtest.h"
+#include "util/fixed_point.h"
+
+// The fixed point helpers against the float arithmetic they replace.
+
+TEST(FixedPointTest, Log2Q16) {
+  EXPECT_EQ(0U, util::Log2Q16(1));
+  EXPECT_EQ(8U << 16, util::Log2Q16(256));
+  EXPECT_EQ(31U << 16, util::Log2Q16(0x80000000U));
+  for (uint32_t x = 1; x < 70000; x += 7) {
+    double expected = std::log2(static_cast<double>(x)) * 65536.0;
+    EXPECT_NEAR(expected, util::Log2Q16(x), 2.0) << x;
+  }
+}
+
+TEST(FixedPointTest, RoundQ) {
+  EXPECT_EQ(2, util::RoundQ<16>(util::ToQ<16>(2) + 32767));
+  EXPECT_EQ(3, util::RoundQ<16>(util::ToQ<16>(2) + 32768));
+  EXPECT_EQ(-2, util::RoundQ<16>(util::ToQ<16>(-2) + 32767));
+  EXPECT_EQ(-5, util::RoundQ<16>(util::ToQ<16>(-5)));
+}
+
+// RndWalk's smoothing, which used to be done in float. With the heaviest
+// smoothing the time constants differ slightly (as does float's own).
+TEST(FixedPointTest, OnePoleTracksFloat) {
+  const struct { int smoothness; float tolerance; } cases[] = {
+    {0, 1.0f}, {20, 1.0f}, {128, 1.0f}, {224, 1.0f}, {254, 8.0f}
+  };
+  for (auto c : cases) {
+    int smoothness = c.smoothness;
+    uint32_t alpha = util::Log2Q16(1 + smoothness);  // Q19, / 8
+    float float_alpha = std::log(1.0f + smoothness) / std::log(256.0f);
+    float float_state = 0;
+    int32_t state = 0;
+    for (int tick = 0; tick < 20000; ++tick) {
+      int target = (tick / 1000) & 1 ? -7000 : 6000;
+      float_state = float_alpha * float_state + (1 - float_alpha) * target;
+      state = util::OnePole<19>(state, util::ToQ<16>(target), alpha);
+      ASSERT_NEAR(float_state, state / 65536.0f, c.tolerance) << smoothness << " " << tick;
+    }
+  }
+
+  // Full smoothing holds the state
+  EXPECT_EQ(12345, util::OnePole<16>(12345, util::ToQ<16>(5000), 65536));
+
+  // A walk of 1.5 times the VOR range is more than int32_t apart in Q16
+  const int32_t low = util::ToQ<16>(-23040), high = util::ToQ<16>(23040);
+  EXPECT_EQ(high, util::OnePole<19>(low, high, 0));
+  EXPECT_EQ(0, util::OnePole<19>(low, high, 1 << 18));
+  EXPECT_EQ(util::ToQ<16>(17280), util::OnePole<19>(low, high, 1 << 16));  // 7/8 of the way
+}
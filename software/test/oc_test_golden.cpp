@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+
+#include "bjorklund.h"
+#include "braids/quantizer.h"
+#include "braids/quantizer_scales.h"
+#include "frames/poly_lfo.h"
+#include "peaks/bytebeat.h"
+#include "peaks/multistage_envelope.h"
+#include "streams/lorenz_generator.h"
+#include "tideslite.h"
+
+// Golden-output baselines for the DSP library code: every test drives one
+// processor with a fixed, deterministic input sequence and hashes the output.
+// A rewrite that is meant to be bit-exact (LUTs, reciprocal math etc.) must not
+// change these. If a change is supposed to alter the output, update the hash
+// from the failure message.
+
+namespace {
+
+// FNV-1a, 32 bit
+class Hash {
+public:
+  template <typename T>
+  void Add(T value) {
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      hash_ ^= p[i];
+      hash_ *= 16777619U;
+    }
+  }
+
+  uint32_t value() const { return hash_; }
+
+private:
+  uint32_t hash_ = 2166136261U;
+};
+
+// Deterministic stand-in for CV inputs; the library code is not allowed to
+// depend on the host's rand()
+class Lcg {
+public:
+  uint32_t Next() {
+    state_ = state_ * 1664525U + 1013904223U;
+    return state_;
+  }
+
+  uint32_t Next(uint32_t range) { return (Next() >> 8) % range; }
+
+private:
+  uint32_t state_ = 0x1234;
+};
+
+// The processors are statically allocated in the firmware, so they start out
+// zeroed and some of them rely on that for state that Init() doesn't touch
+template <typename T>
+void Zero(T &processor) {
+  memset(static_cast<void *>(&processor), 0, sizeof(T));
+}
+
+}  // namespace
+
+#define EXPECT_GOLDEN(expected, hash) \
+  EXPECT_EQ(expected, (hash).value()) << "0x" << std::hex << (hash).value()
+
+// 32 steps shifts by 32 in rotl32, which is 0 on the Cortex-M4 but a no-op on
+// x86, so the host can't produce the firmware's output for those
+TEST(GoldenBjorklund, Patterns) {
+  Hash hash;
+  for (uint8_t steps = 1; steps < 32; ++steps) {
+    for (uint8_t beats = 0; beats <= steps; ++beats) {
+      for (uint8_t rotation = 0; rotation < steps; rotation += 3) {
+        hash.Add(EuclideanPattern(steps, beats, rotation));
+        hash.Add(EuclideanFilter(steps, beats, rotation, steps + rotation + 1));
+      }
+    }
+  }
+  EXPECT_GOLDEN(0xb609539cU, hash);
+}
+
+TEST(GoldenBraids, QuantizerScales) {
+  Hash hash;
+  braids::Quantizer quantizer;
+  Zero(quantizer);
+  quantizer.Init();
+  for (const braids::Scale &scale : braids::scales) {
+    quantizer.Configure(scale, 0xffff);
+    for (int32_t pitch = -4 * 1536; pitch < 4 * 1536; pitch += 7) {
+      hash.Add(quantizer.Process(pitch, 0, 0));
+      hash.Add(quantizer.GetLatestNoteNumber());
+    }
+    if (!quantizer.enabled())
+      continue;
+    for (int32_t index = 0; index < 128; ++index)
+      hash.Add(quantizer.Lookup(index));
+  }
+  EXPECT_GOLDEN(0xd82471d7U, hash);
+}
+
+TEST(GoldenFrames, PolyLfo) {
+  Hash hash;
+  Lcg lcg;
+  frames::PolyLfo lfo;
+  Zero(lfo);
+  lfo.Init();
+  for (int block = 0; block < 64; ++block) {
+    lfo.set_freq_range(lcg.Next(5));
+    lfo.set_shape(lcg.Next(65536));
+    lfo.set_shape_spread(lcg.Next(65536));
+    lfo.set_spread(lcg.Next(65536));
+    lfo.set_coupling(lcg.Next(65536));
+    lfo.set_attenuation(lcg.Next(65536));
+    lfo.set_offset(lcg.Next(65536) - 32768);
+    lfo.set_freq_div_b(static_cast<frames::PolyLfoFreqMultipliers>(lcg.Next(frames::POLYLFO_FREQ_MULT_LAST)));
+    lfo.set_b_xor_a(lcg.Next(256));
+    lfo.set_c_am_by_b(lcg.Next(128));
+    int32_t frequency = lcg.Next(65536);
+    for (int i = 0; i < 1000; ++i) {
+      lfo.Render(frequency, i == 0 && (block & 1), false, frames::POLYLFO_FREQ_MULT_NONE);
+      for (size_t ch = 0; ch < frames::kNumChannels; ++ch)
+        hash.Add(lfo.dac_code(ch));
+    }
+  }
+  EXPECT_GOLDEN(0x227047baU, hash);
+}
+
+TEST(GoldenPeaks, MultistageEnvelope) {
+  Hash hash;
+  Lcg lcg;
+  peaks::MultistageEnvelope envelope;
+  Zero(envelope);
+  envelope.Init();
+  for (int block = 0; block < 64; ++block) {
+    envelope.set_attack_shape(static_cast<peaks::EnvelopeShape>(lcg.Next(peaks::ENV_SHAPE_LAST)));
+    envelope.set_decay_shape(static_cast<peaks::EnvelopeShape>(lcg.Next(peaks::ENV_SHAPE_LAST)));
+    envelope.set_release_shape(static_cast<peaks::EnvelopeShape>(lcg.Next(peaks::ENV_SHAPE_LAST)));
+    envelope.set_attack_reset_behaviour(static_cast<peaks::EnvResetBehaviour>(lcg.Next(peaks::RESET_BEHAVIOUR_LAST)));
+    uint16_t a = lcg.Next(65536), d = lcg.Next(65536), s = lcg.Next(65536), r = lcg.Next(65536);
+    switch (block % 4) {
+      case 0: envelope.set_adsr(a, d, s, r); break;
+      case 1: envelope.set_ad(a, d, 0, 1); break;
+      case 2: envelope.set_ar(a, r); break;
+      case 3: envelope.set_adsar(a, d, s, r); break;
+    }
+    // As in the apps, after changing the number of segments
+    envelope.reset();
+    envelope.set_amplitude(lcg.Next(65536), false);
+
+    const int gate_length = 16 + lcg.Next(2000);
+    for (int i = 0; i < 4000; ++i) {
+      uint8_t control = 0;
+      if (i < gate_length) control |= peaks::CONTROL_GATE;
+      if (i == 0) control |= peaks::CONTROL_GATE_RISING;
+      if (i == gate_length) control |= peaks::CONTROL_GATE_FALLING;
+      hash.Add(envelope.ProcessSingleSample(control));
+    }
+  }
+  EXPECT_GOLDEN(0x60bfc7bbU, hash);
+}
+
+// Most of the equations divide by parameters or by the previous sample. The
+// Cortex-M4 returns 0 for a division by zero, the host traps, so only the
+// equations that can't divide by zero are covered here.
+static const int32_t kByteBeatEquations[] = { 0, 1, 4, 5, 7, 12 };
+
+TEST(GoldenPeaks, ByteBeat) {
+  Hash hash;
+  Lcg lcg;
+  peaks::ByteBeat bytebeat;
+  Zero(bytebeat);
+  bytebeat.Init();
+  for (int block = 0; block < 64; ++block) {
+    int32_t parameters[12];
+    for (int32_t &p : parameters)
+      p = lcg.Next(65536);
+    parameters[0] = kByteBeatEquations[block % 6] << 12;
+    parameters[2] = 256 + lcg.Next(65536 - 256); // p0 is a modulus in "monk"
+    parameters[5] = parameters[6] = parameters[7] = 0;
+    parameters[8] = lcg.Next(256);
+    parameters[9] = lcg.Next(256);
+    parameters[10] = lcg.Next(256);
+    bytebeat.Configure(parameters, block & 1, block & 2);
+    for (int i = 0; i < 2000; ++i) {
+      uint8_t control = (i & 255) < 8 ? peaks::CONTROL_GATE : 0;
+      if ((i & 255) == 0) control |= peaks::CONTROL_GATE_RISING;
+      hash.Add(bytebeat.ProcessSingleSample(control));
+    }
+  }
+  EXPECT_GOLDEN(0xd31428f5U, hash);
+}
+
+TEST(GoldenStreams, Lorenz) {
+  Hash hash;
+  Lcg lcg;
+  streams::LorenzGenerator lorenz;
+  Zero(lorenz);
+  lorenz.Init(0);
+  for (int block = 0; block < 32; ++block) {
+    lorenz.set_index(block & 1);
+    lorenz.set_rho1(lcg.Next(256));
+    lorenz.set_rho2(lcg.Next(256));
+    lorenz.set_out_a(lcg.Next(6));
+    lorenz.set_out_b(lcg.Next(6));
+    lorenz.set_out_c(lcg.Next(6));
+    lorenz.set_out_d(lcg.Next(6));
+    int32_t freq1 = lcg.Next(256), freq2 = lcg.Next(256);
+    uint8_t range1 = lcg.Next(4), range2 = lcg.Next(4);
+    for (int i = 0; i < 2000; ++i) {
+      lorenz.Process(freq1, freq2, i == 0 && (block & 2), i == 0 && (block & 4), range1, range2);
+      for (uint8_t ch = 0; ch < 4; ++ch)
+        hash.Add(lorenz.dac_code(ch));
+    }
+  }
+  EXPECT_GOLDEN(0x09ccb045U, hash);
+}
+
+TEST(GoldenTidesLite, Pitch) {
+  Hash hash;
+  for (int32_t pitch = -6 * kOctave; pitch <= 6 * kOctave; ++pitch) {
+    uint32_t increment = ComputePhaseIncrement(pitch);
+    hash.Add(increment);
+    hash.Add(ComputePitch(increment));
+  }
+  EXPECT_GOLDEN(0xc92699daU, hash);
+}
+
+TEST(GoldenTidesLite, ProcessSample) {
+  Hash hash;
+  Lcg lcg;
+  for (int block = 0; block < 256; ++block) {
+    uint16_t slope = lcg.Next(65536);
+    uint16_t shape = lcg.Next(65536);
+    int16_t fold = block & 1 ? lcg.Next(32768) : 0;
+    uint32_t increment = ComputePhaseIncrement(lcg.Next(8 * kOctave) - 4 * kOctave);
+    uint32_t phase = 0;
+    for (int i = 0; i < 500; ++i) {
+      TidesLiteSample sample;
+      ProcessSample(slope, shape, fold, phase, sample);
+      hash.Add(sample.unipolar);
+      hash.Add(sample.bipolar);
+      hash.Add(sample.flags);
+      phase += increment;
+    }
+  }
+  EXPECT_GOLDEN(0xfed00128U, hash);
+}
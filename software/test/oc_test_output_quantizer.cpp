@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "hemisphere/output_quantizer.hpp"
+
+// The output quantizer settings are stored after the Hemisphere presets; all
+// zeros has to come out as off.
+
+using hemisphere::OutputQuantizerConfig;
+
+TEST(OutputQuantizerConfigTest, ZerosAreOff) {
+  uint8_t storage[4] = {0};
+  util::BitReader reader(storage, sizeof(storage));
+  OutputQuantizerConfig config;
+  config.Unpack(reader);
+  EXPECT_FALSE(config.enabled());
+  EXPECT_EQ(oc::Scales::SCALE_NONE, config.scale);
+  EXPECT_EQ(0, config.root);
+}
+
+TEST(OutputQuantizerConfigTest, RoundTrip) {
+  uint8_t storage[16];
+  OutputQuantizerConfig configs[4];
+  for (int i = 0; i < 4; ++i) configs[i].Reset();
+  configs[0].scale = oc::Scales::SCALE_USER_0;
+  configs[1].scale = oc::Scales::NUM_SCALES - 1;
+  configs[1].root = 11;
+  configs[3].root = 5;
+
+  util::BitWriter writer(storage, sizeof(storage));
+  for (auto &config : configs) config.Pack(writer);
+  EXPECT_FALSE(writer.overflow());
+  EXPECT_EQ(6U, writer.length());
+
+  util::BitReader reader(storage, writer.length());
+  for (auto &expected : configs) {
+    OutputQuantizerConfig config;
+    config.Unpack(reader);
+    EXPECT_EQ(expected.scale, config.scale);
+    EXPECT_EQ(expected.root, config.root);
+  }
+  EXPECT_FALSE(reader.overflow());
+}
+
+TEST(OutputQuantizerConfigTest, JunkIsClamped) {
+  uint8_t storage[4];
+  memset(storage, 0xff, sizeof(storage));
+  util::BitReader reader(storage, sizeof(storage));
+  OutputQuantizerConfig config;
+  config.Unpack(reader);
+  EXPECT_FALSE(config.enabled());
+  EXPECT_EQ(0, config.root);
+}
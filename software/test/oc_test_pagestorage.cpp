@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "util/pagestorage.h"
+
+#include <string.h>
+
+// PageStorage against an in-memory EEPROM with the same interface as
+// EEPROMStorage. Writes are counted per byte so wear can be checked.
+
+namespace {
+
+struct MemoryStorage {
+  static const size_t LENGTH = 2048;
+
+  static uint8_t memory[LENGTH];
+  static size_t bytes_written;
+
+  static void Erase() {
+    memset(memory, 0xff, sizeof(memory));
+    bytes_written = 0;
+  }
+
+  static void update(size_t addr, const void *data, size_t length) {
+    const uint8_t *src = static_cast<const uint8_t *>(data);
+    while (length--) {
+      if (memory[addr] != *src) {
+        memory[addr] = *src;
+        ++bytes_written;
+      }
+      ++addr; ++src;
+    }
+  }
+
+  static void write(size_t addr, const void *data, size_t length) {
+    memcpy(memory + addr, data, length);
+    bytes_written += length;
+  }
+
+  static void read(size_t addr, void *data, size_t length) {
+    memcpy(data, memory + addr, length);
+  }
+};
+
+uint8_t MemoryStorage::memory[MemoryStorage::LENGTH];
+size_t MemoryStorage::bytes_written;
+
+struct TestData {
+  static constexpr uint32_t FOURCC = FOURCC<'T', 'E', 'S', 'T'>::value;
+
+  uint8_t values[32];
+};
+
+static constexpr size_t kBase = 64;
+static constexpr size_t kEnd = kBase + 4 * 44; // 4 pages of header + data
+
+typedef PageStorage<MemoryStorage, kBase, kEnd, TestData> TestStorage;
+typedef PageStorage<MemoryStorage, kBase, kEnd, TestData, STORAGE_WRITE, false> TestStorageSlowScan;
+
+class PageStorageTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    MemoryStorage::Erase();
+    memset(&data_, 0, sizeof(data_));
+  }
+
+  TestData data_;
+};
+
+}  // namespace
+
+TEST_F(PageStorageTest, Layout) {
+  EXPECT_EQ(44U, TestStorage::PAGESIZE);
+  EXPECT_EQ(4U, TestStorage::PAGES);
+}
+
+TEST_F(PageStorageTest, LoadEmpty) {
+  TestStorage storage;
+  EXPECT_FALSE(storage.Load(data_));
+  EXPECT_EQ(-1, storage.page_index());
+}
+
+TEST_F(PageStorageTest, SaveLoad) {
+  TestStorage storage;
+  storage.Load(data_);
+  for (int i = 0; i < 32; ++i)
+    data_.values[i] = i;
+  EXPECT_TRUE(storage.Save(data_));
+  EXPECT_EQ(0, storage.page_index());
+
+  TestStorage loader;
+  TestData loaded = { };
+  EXPECT_TRUE(loader.Load(loaded));
+  EXPECT_EQ(0, loader.page_index());
+  EXPECT_EQ(0, memcmp(&data_, &loaded, sizeof(TestData)));
+}
+
+TEST_F(PageStorageTest, UnchangedIsNotWritten) {
+  TestStorage storage;
+  storage.Load(data_);
+  data_.values[0] = 1;
+  EXPECT_TRUE(storage.Save(data_));
+  size_t written = MemoryStorage::bytes_written;
+  EXPECT_FALSE(storage.Save(data_));
+  EXPECT_EQ(written, MemoryStorage::bytes_written);
+}
+
+TEST_F(PageStorageTest, ChangedBytes) {
+  TestStorage storage;
+  storage.Load(data_);
+  data_.values[3] = 1;
+  data_.values[9] = 2;
+  EXPECT_TRUE(storage.Save(data_));
+  EXPECT_EQ(2U, storage.changed_bytes());
+  EXPECT_EQ(2, storage.data().values[9]);
+  EXPECT_FALSE(storage.Save(data_));
+  EXPECT_EQ(0U, storage.changed_bytes());
+}
+
+TEST_F(PageStorageTest, Rotation) {
+  // Each save goes to the next page and the newest one wins, including after
+  // wrapping around
+  TestStorage storage;
+  storage.Load(data_);
+  for (int generation = 1; generation <= 10; ++generation) {
+    data_.values[0] = generation;
+    ASSERT_TRUE(storage.Save(data_));
+    EXPECT_EQ((generation - 1) % 4, storage.page_index());
+
+    TestStorage loader;
+    TestData loaded = { };
+    ASSERT_TRUE(loader.Load(loaded));
+    EXPECT_EQ(generation, loaded.values[0]);
+    EXPECT_EQ(storage.page_index(), loader.page_index());
+  }
+}
+
+TEST_F(PageStorageTest, CorruptPage) {
+  TestStorageSlowScan storage;
+  storage.Load(data_);
+  data_.values[0] = 1;
+  storage.Save(data_);
+  data_.values[0] = 2;
+  storage.Save(data_);
+
+  // Flip a data byte in the newest page, the checksum should reject it
+  MemoryStorage::memory[kBase + TestStorageSlowScan::PAGESIZE + 12] ^= 0x01;
+
+  TestStorageSlowScan loader;
+  TestData loaded = { };
+  EXPECT_TRUE(loader.Load(loaded));
+  EXPECT_EQ(0, loader.page_index());
+  EXPECT_EQ(1, loaded.values[0]);
+}
+
+TEST_F(PageStorageTest, OtherFourCC) {
+  TestStorage storage;
+  storage.Load(data_);
+  data_.values[0] = 1;
+  storage.Save(data_);
+  MemoryStorage::memory[kBase] ^= 0xff;
+
+  TestStorage loader;
+  EXPECT_FALSE(loader.Load(data_));
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "util/bit_packer.h"
+#include "hemisphere/preset_blob.hpp"
+
+// BitWriter/BitReader pack fields of any width, and PresetBlob keeps a
+// versioned record for each hemisphere in a fixed number of bytes.
+
+namespace {
+
+typedef hemisphere::PresetBlob<10> Blob;
+
+}  // namespace
+
+TEST(BitPackerTest, RoundTrip) {
+  uint8_t buffer[16];
+  util::BitWriter writer(buffer, sizeof(buffer));
+  for (uint32_t i = 0; i < 8; ++i) writer.Write(i * 3, 5);
+  writer.Write(0xdeadbeef, 32);
+  EXPECT_FALSE(writer.overflow());
+  EXPECT_EQ(9U, writer.length());  // 72 bits
+
+  util::BitReader reader(buffer, writer.length());
+  for (uint32_t i = 0; i < 8; ++i) EXPECT_EQ(i * 3, reader.Read(5));
+  EXPECT_EQ(0xdeadbeefU, reader.Read(32));
+  EXPECT_FALSE(reader.overflow());
+}
+
+TEST(BitPackerTest, Overflow) {
+  uint8_t buffer[2];
+  util::BitWriter writer(buffer, sizeof(buffer));
+  writer.Write(0x1ff, 9);
+  writer.Write(0xff, 8);  // Doesn't fit and is dropped
+  EXPECT_TRUE(writer.overflow());
+  writer.Write(0x7f, 7);
+  EXPECT_EQ(2U, writer.length());
+
+  // A short blob reads back as zeros past its end
+  util::BitReader reader(buffer, 2);
+  EXPECT_EQ(0x1ffU, reader.Read(9));
+  EXPECT_EQ(0x7fU, reader.Read(7));
+  EXPECT_EQ(0U, reader.remaining());
+  EXPECT_EQ(0U, reader.Read(1));
+  EXPECT_TRUE(reader.overflow());
+}
+
+TEST(PresetBlobTest, EmptyWhenZeroed) {
+  Blob blob;
+  blob.Clear();
+  const uint8_t *data;
+  size_t length;
+  EXPECT_EQ(0, blob.Get(0, data, length));
+  EXPECT_EQ(0, blob.Get(1, data, length));
+  EXPECT_EQ(0U, length);
+}
+
+TEST(PresetBlobTest, SidesShareTheBlob) {
+  Blob blob;
+  blob.Clear();
+  const uint8_t left[] = {1, 2, 3};
+  const uint8_t right[] = {4, 5, 6, 7, 8};
+
+  // Either order gives the same layout
+  EXPECT_TRUE(blob.Set(1, 2, right, sizeof(right)));
+  EXPECT_TRUE(blob.Set(0, 7, left, sizeof(left)));
+
+  const uint8_t *data;
+  size_t length;
+  EXPECT_EQ(7, blob.Get(0, data, length));
+  ASSERT_EQ(3U, length);
+  EXPECT_EQ(0, memcmp(left, data, length));
+  EXPECT_EQ(2, blob.Get(1, data, length));
+  ASSERT_EQ(5U, length);
+  EXPECT_EQ(0, memcmp(right, data, length));
+  EXPECT_EQ(data, blob.bytes() + 5);
+
+  // The left side grows and the right side no longer fits next to it
+  const uint8_t big[] = {9, 9, 9, 9};
+  EXPECT_FALSE(blob.Set(0, 1, big, sizeof(big)));
+  EXPECT_EQ(0, blob.Get(0, data, length));
+  EXPECT_EQ(2, blob.Get(1, data, length));
+
+  // Removing a record
+  EXPECT_FALSE(blob.Set(1, 0, nullptr, 0));
+  EXPECT_EQ(0, blob.Get(1, data, length));
+  EXPECT_TRUE(blob.Set(0, 1, big, sizeof(big)));
+  EXPECT_EQ(1, blob.Get(0, data, length));
+}
+
+// What Preset::StoreBlobs runs into with DualTM on both sides
+TEST(PresetBlobTest, TwoFullRecords) {
+  Blob blob;
+  blob.Clear();
+  const uint8_t left[Blob::kMaxLength] = {1, 2, 3, 4, 5, 6, 7, 8};
+  const uint8_t right[Blob::kMaxLength] = {8, 7, 6, 5, 4, 3, 2, 1};
+
+  // The side stored first keeps its record
+  EXPECT_TRUE(blob.Set(0, 1, left, sizeof(left)));
+  EXPECT_FALSE(blob.Set(1, 1, right, sizeof(right)));
+  const uint8_t *data;
+  size_t length;
+  EXPECT_EQ(1, blob.Get(0, data, length));
+  ASSERT_EQ(sizeof(left), length);
+  EXPECT_EQ(0, memcmp(left, data, length));
+  EXPECT_EQ(0, blob.Get(1, data, length));
+
+  // Records of half the length both fit
+  static_assert(Blob::kHalfLength == 4, "");
+  blob.Clear();
+  EXPECT_TRUE(blob.Set(0, 2, left, Blob::kHalfLength));
+  EXPECT_TRUE(blob.Set(1, 2, right, Blob::kHalfLength));
+  EXPECT_EQ(2, blob.Get(0, data, length));
+  ASSERT_EQ(Blob::kHalfLength, length);
+  EXPECT_EQ(0, memcmp(left, data, length));
+  EXPECT_EQ(2, blob.Get(1, data, length));
+  ASSERT_EQ(Blob::kHalfLength, length);
+  EXPECT_EQ(0, memcmp(right, data, length));
+}
+
+TEST(PresetBlobTest, JunkIsNoRecord) {
+  Blob blob;
+  memset(blob.bytes(), 0xff, Blob::kSize);
+  const uint8_t *data;
+  size_t length;
+  EXPECT_EQ(0, blob.Get(0, data, length));
+  EXPECT_EQ(0, blob.Get(1, data, length));
+
+  // The left record is fine, the right one runs off the end
+  blob.Clear();
+  blob.bytes()[0] = (1 << 5) | 2;
+  blob.bytes()[3] = (1 << 5) | 7;
+  EXPECT_EQ(1, blob.Get(0, data, length));
+  EXPECT_EQ(0, blob.Get(1, data, length));
+}
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "hemisphere/proportion.hpp"
+
+// The constant-denominator version has to match the runtime division exactly,
+// including the rounding of negative numerators and out-of-range values.
+
+static const int32_t kMaxValues[] = { 1, 16, 32, 127, 128, 255, 4608, 7680, 9216, 15360, 16383 };
+
+template <int32_t denominator>
+static void CheckProportion() {
+  volatile int32_t runtime_denominator = denominator;
+  for (int32_t max_value : kMaxValues) {
+    for (int32_t numerator = -2 * 9216; numerator <= 2 * 9216; ++numerator) {
+      ASSERT_EQ(hemisphere::Proportion(numerator, runtime_denominator, max_value),
+                hemisphere::Proportion<denominator>(numerator, max_value))
+          << numerator << "/" << denominator << "*" << max_value;
+    }
+  }
+}
+
+TEST(ProportionTest, MaxInputCV) {
+  CheckProportion<9216>(); // HEMISPHERE_MAX_INPUT_CV
+}
+
+TEST(ProportionTest, ThreeVolts) {
+  CheckProportion<4608>(); // HEMISPHERE_3V_CV
+}
+
+TEST(ProportionTest, FiveVolts) {
+  CheckProportion<7680>();
+}
+
+TEST(ProportionTest, Bytes) {
+  CheckProportion<255>();
+  CheckProportion<127>();
+  CheckProportion<128>();
+}
+
+TEST(ProportionTest, Percent) {
+  CheckProportion<100>();
+}
+
+TEST(ProportionTest, Small) {
+  CheckProportion<7>();
+  CheckProportion<63>();
+}
+
+TEST(ProportionTest, Values) {
+  EXPECT_EQ(0, hemisphere::Proportion<100>(0, 9216));
+  EXPECT_EQ(4608, hemisphere::Proportion<100>(50, 9216));
+  EXPECT_EQ(9216, hemisphere::Proportion<9216>(9216, 9216));
+  EXPECT_EQ(32, hemisphere::Proportion<9216>(9216, 32));
+  EXPECT_EQ(-16, hemisphere::Proportion<9216>(-4608, 32));
+}
@@ -1,6 +1,6 @@
 #include "gtest/gtest.h"
-#include "braids_quantizer.h"
-#include "braids_quantizer_scales.h"
+#include "braids/quantizer.h"
+#include "braids/quantizer_scales.h"
 
 
 static const int32_t kOctave = 12 << 7;
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+#include "braids/quantizer.h"
+#include "reference_quantizer.h"
+
+#include <random>
+
+// Randomized comparison of braids::Quantizer against the original linear scan
+// over the notes.
+
+namespace {
+
+class QuantizerTableTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    quantizer_.Init();
+  }
+
+  // Random scale: sorted or not, possibly with duplicates
+  braids::Scale RandomScale() {
+    braids::Scale scale;
+    scale.span = std::uniform_int_distribution<int>(1, 4096)(rng_);
+    scale.num_notes = std::uniform_int_distribution<int>(1, 16)(rng_);
+    std::uniform_int_distribution<int> note(0, scale.span - 1);
+    for (size_t i = 0; i < scale.num_notes; ++i)
+      scale.notes[i] = note(rng_);
+    if (rng_() & 1)
+      braids::SortScale(scale);
+    return scale;
+  }
+
+  void Configure(const braids::Scale &scale, uint16_t mask) {
+    quantizer_.Configure(scale, mask);
+    reference_.Configure(scale, mask);
+  }
+
+  void Run(int iterations) {
+    std::uniform_int_distribution<int32_t> pitch(-8 * 1536, 8 * 1536);
+    std::uniform_int_distribution<int32_t> step(-200, 200);
+    std::uniform_int_distribution<int32_t> root(0, 11 * 128);
+    std::uniform_int_distribution<int32_t> transpose(-20, 20);
+
+    int32_t p = pitch(rng_);
+    int32_t r = 0, t = 0;
+    for (int i = 0; i < iterations; ++i) {
+      // Mostly small steps so the hysteresis gets exercised
+      switch (rng_() % 16) {
+        case 0: p = pitch(rng_); break;
+        case 1: r = root(rng_); break;
+        case 2: t = transpose(rng_); break;
+        case 3: quantizer_.Requantize(); reference_.requantize = true; break;
+        default: p += step(rng_); break;
+      }
+      ASSERT_EQ(reference_.Process(p, r, t), quantizer_.Process(p, r, t))
+          << "pitch " << p << " root " << r << " transpose " << t;
+      if (reference_.enabled()) {
+        ASSERT_EQ(reference_.note_number, quantizer_.GetLatestNoteNumber());
+      }
+    }
+  }
+
+  std::mt19937 rng_{12345};
+  braids::Quantizer quantizer_;
+  ReferenceQuantizer reference_;
+};
+
+}  // namespace
+
+TEST_F(QuantizerTableTest, Chromatic) {
+  braids::Scale scale = { 12 << 7, 12, { 0, 128, 256, 384, 512, 640, 768, 896, 1024, 1152, 1280, 1408 } };
+  Configure(scale, 0xffff);
+  Run(100000);
+}
+
+TEST_F(QuantizerTableTest, RotatingMask) {
+  braids::Scale scale = { 12 << 7, 12, { 0, 128, 256, 384, 512, 640, 768, 896, 1024, 1152, 1280, 1408 } };
+  uint16_t mask = 0x0ad5; // major
+  for (int i = 0; i < 100; ++i) {
+    mask = ((mask << 1) | (mask >> 11)) & 0x0fff;
+    Configure(scale, mask);
+    quantizer_.Requantize();
+    reference_.requantize = true;
+    Run(1000);
+  }
+}
+
+TEST_F(QuantizerTableTest, RandomScales) {
+  std::uniform_int_distribution<int> mask(1, 0xffff);
+  for (int i = 0; i < 2000; ++i) {
+    braids::Scale scale = RandomScale();
+    uint16_t m = mask(rng_);
+    if (!(m & ((1 << scale.num_notes) - 1)))
+      m = 1;
+    Configure(scale, m);
+    Run(500);
+  }
+}
+
+TEST_F(QuantizerTableTest, Sweep) {
+  // Every pitch around a few octaves, forcing a requantize each time
+  for (int i = 0; i < 200; ++i) {
+    braids::Scale scale = RandomScale();
+    Configure(scale, 0xffff);
+    for (int32_t p = -3 * scale.span; p <= 3 * scale.span; ++p) {
+      quantizer_.Requantize();
+      reference_.requantize = true;
+      ASSERT_EQ(reference_.Process(p, 0, 0), quantizer_.Process(p, 0, 0)) << "pitch " << p;
+    }
+  }
+}
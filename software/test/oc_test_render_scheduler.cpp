@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "oc/render_scheduler.h"
+
+// Frame counting and the partial redraws of oc::RenderScheduler
+
+namespace {
+
+constexpr uint32_t kPeriod = 2000;
+constexpr uint32_t kBudget = 1000;
+
+struct Frames {
+  oc::RenderScheduler scheduler;
+  uint32_t now = 0;
+
+  Frames() {
+    scheduler.Init(kPeriod, kBudget);
+  }
+
+  // Starts a frame, plans it and draws the planned regions at the given cost
+  uint32_t Draw(uint32_t left, uint32_t right) {
+    scheduler.BeginFrame(now);
+    now += kPeriod;
+    uint32_t regions = scheduler.Plan(2);
+    if (regions & 1) scheduler.RegionDrawn(0, left);
+    if (regions & 2) scheduler.RegionDrawn(1, right);
+    return regions;
+  }
+};
+
+}  // namespace
+
+TEST(RenderSchedulerTest, CountsDroppedFrames) {
+  oc::RenderScheduler scheduler;
+  scheduler.Init(kPeriod, kBudget);
+  scheduler.BeginFrame(100000);  // the first frame has nothing to be late for
+  scheduler.BeginFrame(100000 + kPeriod);
+  scheduler.BeginFrame(100000 + 2 * kPeriod + kPeriod / 2);
+  EXPECT_EQ(0U, scheduler.dropped());
+  scheduler.BeginFrame(100000 + 5 * kPeriod + kPeriod / 2);  // two missed
+  EXPECT_EQ(2U, scheduler.dropped());
+  EXPECT_EQ(4U, scheduler.frames());
+
+  // across the micros() wrap
+  scheduler.Init(kPeriod, kBudget);
+  scheduler.BeginFrame(0xffffffff - kPeriod / 2);
+  scheduler.BeginFrame(kPeriod / 2);
+  EXPECT_EQ(0U, scheduler.dropped());
+  scheduler.BeginFrame(kPeriod / 2 + 3 * kPeriod);
+  EXPECT_EQ(2U, scheduler.dropped());
+}
+
+TEST(RenderSchedulerTest, DrawsEverythingWithinBudget) {
+  Frames frames;
+  for (int i = 0; i < 100; ++i)
+    ASSERT_EQ(3U, frames.Draw(400, 500)) << i;
+  EXPECT_EQ(0U, frames.scheduler.partial());
+}
+
+TEST(RenderSchedulerTest, AlternatesOverBudget) {
+  Frames frames;
+  EXPECT_EQ(3U, frames.Draw(900, 900));
+  uint32_t previous = frames.Draw(900, 900);
+  EXPECT_NE(3U, previous);
+  for (int i = 0; i < 20; ++i) {
+    uint32_t regions = frames.Draw(900, 900);
+    ASSERT_TRUE(regions == 1 || regions == 2) << i;
+    ASSERT_NE(previous, regions) << i;
+    previous = regions;
+  }
+  EXPECT_EQ(21U, frames.scheduler.partial());
+
+  // Back to full frames once the views are cheap again
+  int partial = 0;
+  while (frames.Draw(100, 100) != 3U)
+    ASSERT_LT(++partial, 100);
+  EXPECT_EQ(3U, frames.Draw(100, 100));
+}
+
+TEST(RenderSchedulerTest, PendingRegionGoesFirst) {
+  Frames frames;
+  frames.Draw(900, 900);
+  uint32_t drawn[2] = { 0, 0 };
+  for (int i = 0; i < 30; ++i) {
+    frames.scheduler.Invalidate(1);
+    uint32_t regions = frames.Draw(900, 900);
+    ASSERT_NE(3U, regions);
+    ++drawn[regions >> 1];
+  }
+  // Mostly the one being edited, but the other one keeps updating
+  EXPECT_EQ(20U, drawn[1]);
+  EXPECT_EQ(10U, drawn[0]);
+}
+
+TEST(RenderSchedulerTest, FullRedrawAfterUnplannedFrame) {
+  Frames frames;
+  frames.Draw(900, 900);
+  EXPECT_NE(3U, frames.Draw(900, 900));
+
+  // A frame drawn by something else (e.g. a full screen view) doesn't leave
+  // anything to copy
+  frames.scheduler.BeginFrame(frames.now);
+  frames.now += kPeriod;
+  EXPECT_EQ(3U, frames.Draw(900, 900));
+  EXPECT_NE(3U, frames.Draw(900, 900));
+
+  frames.scheduler.InvalidateAll();
+  EXPECT_EQ(3U, frames.Draw(900, 900));
+}
@@ -0,0 +1,132 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "util/ringbuffer.h"
+
+// RingBuffer is a single-producer/single-consumer queue: writes to a full
+// buffer are dropped and counted, spans stop at the end of the storage, and a
+// producer and consumer on different threads see every item in order.
+
+namespace {
+
+struct Item {
+  uint32_t sequence;
+  uint32_t check;
+
+  Item() { }
+  Item(uint32_t s) : sequence(s), check(~s) { }
+};
+
+typedef util::RingBuffer<uint32_t, 8> Ring;
+
+} // namespace
+
+TEST(RingBufferTest, FullDropsAndCounts) {
+  Ring ring;
+  ring.Init();
+  for (uint32_t i = 0; i < 8; ++i) EXPECT_TRUE(ring.Write(i));
+  EXPECT_EQ(0U, ring.writable());
+  EXPECT_FALSE(ring.Write(8));
+  EXPECT_FALSE(ring.EmplaceWrite(9U));
+  EXPECT_EQ(2U, ring.overflows());
+
+  // Nothing was overwritten
+  for (uint32_t i = 0; i < 8; ++i) EXPECT_EQ(i, ring.Read());
+  EXPECT_EQ(0U, ring.readable());
+}
+
+TEST(RingBufferTest, SpansWrap) {
+  Ring ring;
+  ring.Init();
+  const uint32_t values[] = {0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(6U, ring.Write(values, 6));
+  uint32_t out[8];
+  EXPECT_EQ(4U, ring.Read(out, 4));
+
+  // 6 free slots, but only 2 before the end of the storage
+  uint32_t *write_span;
+  EXPECT_EQ(2U, ring.WriteSpan(write_span));
+  EXPECT_EQ(6U, ring.writable());
+
+  const uint32_t more[] = {6, 7, 8, 9, 10, 11, 12};
+  EXPECT_EQ(6U, ring.Write(more, 7));
+  EXPECT_EQ(1U, ring.overflows());
+
+  const uint32_t *read_span;
+  EXPECT_EQ(4U, ring.ReadSpan(read_span));
+  EXPECT_EQ(4U, read_span[0]);
+  EXPECT_EQ(7U, read_span[3]);
+  ring.Consume(4);
+  EXPECT_EQ(4U, ring.ReadSpan(read_span));
+  EXPECT_EQ(8U, read_span[0]);
+
+  ring.Flush();
+  EXPECT_EQ(0U, ring.readable());
+  EXPECT_EQ(0U, ring.ReadSpan(read_span));
+}
+
+TEST(RingBufferTest, PokeReadsHistory) {
+  util::RingBuffer<int16_t, 4> ring;
+  ring.Init();
+  for (int16_t i = 0; i < 10; ++i) {
+    if (!ring.writable()) ring.Consume(1);
+    ring.Write(i);
+  }
+  EXPECT_EQ(9, ring.Poke(0));
+  EXPECT_EQ(6, ring.Poke(3));
+  EXPECT_EQ(0U, ring.overflows());
+}
+
+TEST(RingBufferTest, ThreadedProducerConsumer) {
+  static util::RingBuffer<Item, 16> ring;
+  ring.Init();
+  const uint32_t kItems = 200000;
+
+  std::thread producer([] {
+    uint32_t sequence = 0;
+    while (sequence < kItems) {
+      if (sequence & 1) {
+        if (ring.EmplaceWrite(sequence)) ++sequence;
+        else std::this_thread::yield();
+      } else {
+        // Batch write whatever fits
+        Item batch[3];
+        size_t count = 0;
+        while (count < 3 && sequence + count < kItems) {
+          batch[count] = Item(sequence + count);
+          ++count;
+        }
+        Item *span;
+        size_t length = ring.WriteSpan(span);
+        if (!length) std::this_thread::yield();
+        if (length > count) length = count;
+        for (size_t i = 0; i < length; ++i) span[i] = batch[i];
+        ring.Commit(length);
+        sequence += length;
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  uint32_t errors = 0;
+  while (expected < kItems) {
+    if (expected & 2) {
+      const Item *span;
+      size_t length = ring.ReadSpan(span);
+      if (!length) std::this_thread::yield();
+      for (size_t i = 0; i < length; ++i, ++expected) {
+        if (span[i].sequence != expected || span[i].check != ~expected) ++errors;
+      }
+      ring.Consume(length);
+    } else if (ring.readable()) {
+      Item item = ring.Read();
+      if (item.sequence != expected || item.check != ~expected) ++errors;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(0U, errors);
+  EXPECT_EQ(0U, ring.readable());
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "util/rle.h"
+
+#include <string.h>
+
+// RleEncode/RleDecode round trips, and the encoding of runs and literals.
+
+namespace {
+
+size_t RoundTrip(const uint8_t *src, size_t length) {
+  uint8_t packed[512], unpacked[256];
+  size_t packed_length = util::RleEncode(src, length, packed, sizeof(packed));
+  EXPECT_EQ(length, util::RleDecode(packed, packed_length, unpacked, sizeof(unpacked)));
+  EXPECT_EQ(0, memcmp(src, unpacked, length));
+  return packed_length;
+}
+
+}  // namespace
+
+TEST(RleTest, Runs) {
+  uint8_t data[200];
+  memset(data, 0, sizeof(data));
+  // 200 = 129 + 71
+  EXPECT_EQ(4U, RoundTrip(data, sizeof(data)));
+
+  // Two the same isn't a run
+  const uint8_t pairs[] = {1, 1, 2, 2, 3, 3};
+  EXPECT_EQ(7U, RoundTrip(pairs, sizeof(pairs)));
+}
+
+TEST(RleTest, Literals) {
+  uint8_t data[256];
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = i;
+  // Two runs of 128 literals
+  EXPECT_EQ(258U, RoundTrip(data, sizeof(data)));
+}
+
+TEST(RleTest, SettingsLike) {
+  // Nibbles and bytes, mostly defaults
+  uint8_t data[120];
+  memset(data, 0, sizeof(data));
+  for (size_t i = 0; i < sizeof(data); i += 10) {
+    data[i] = 0x3a;
+    data[i + 1] = i;
+  }
+  EXPECT_LT(RoundTrip(data, sizeof(data)), sizeof(data) / 2);
+}
+
+TEST(RleTest, Limits) {
+  uint8_t data[16], packed[16];
+  memset(data, 7, sizeof(data));
+  EXPECT_EQ(0U, util::RleEncode(data, sizeof(data), packed, 1));
+  ASSERT_EQ(2U, util::RleEncode(data, sizeof(data), packed, sizeof(packed)));
+
+  // A no-op can pad the data
+  packed[2] = util::kRleNop;
+  uint8_t unpacked[16];
+  EXPECT_EQ(16U, util::RleDecode(packed, 3, unpacked, sizeof(unpacked)));
+  // Not enough room, or truncated data
+  EXPECT_EQ(0U, util::RleDecode(packed, 3, unpacked, 15));
+  EXPECT_EQ(0U, util::RleDecode(packed, 1, unpacked, sizeof(unpacked)));
+  const uint8_t literals[] = {3, 1, 2};
+  EXPECT_EQ(0U, util::RleDecode(literals, sizeof(literals), unpacked, sizeof(unpacked)));
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "util/scope_capture.h"
+
+// ScopeCapture decimates to min/max columns and captures triggered frames
+// with a quarter of the width before the trigger.
+
+namespace {
+
+typedef util::ScopeCapture<128> Capture;
+
+void Feed(Capture &capture, uint32_t ticks, uint8_t a, uint8_t b = 0) {
+  while (ticks--) capture.Sample(a, b);
+}
+
+} // namespace
+
+TEST(ScopeCaptureTest, ShortPulseIsKept) {
+  Capture capture;
+  capture.Init(64, 100);
+  Feed(capture, 1000, 128);
+  Feed(capture, 3, 250); // Much shorter than a column
+  Feed(capture, 97 + 100, 128);
+
+  // The pulse is in the column before the last
+  util::ScopeColumn column = capture.column(0, 62);
+  EXPECT_EQ(128, column.min);
+  EXPECT_EQ(250, column.max);
+  column = capture.column(0, 63);
+  EXPECT_EQ(128, column.min);
+  EXPECT_EQ(128, column.max);
+  EXPECT_FALSE(capture.has_frame());
+}
+
+TEST(ScopeCaptureTest, Rolls) {
+  Capture capture;
+  capture.Init(64, 1);
+  for (int i = 0; i < 200; ++i) capture.Sample(i, 255 - i);
+  for (int x = 0; x < 64; ++x) {
+    ASSERT_EQ(136 + x, capture.column(0, x).min);
+    ASSERT_EQ(255 - 136 - x, capture.column(1, x).max);
+  }
+}
+
+TEST(ScopeCaptureTest, RisingEdgeTrigger) {
+  Capture capture;
+  capture.Init(64, 2);
+  capture.set_trigger(util::SCOPE_TRIGGER_RISE, 100);
+  Feed(capture, 1000, 50);
+  EXPECT_FALSE(capture.has_frame());
+
+  Feed(capture, 1, 150);
+  EXPECT_TRUE(capture.triggered());
+  Feed(capture, 200, 150);
+  EXPECT_TRUE(capture.has_frame());
+  EXPECT_FALSE(capture.triggered());
+
+  // The edge is 16 columns in, and the frame stays put
+  EXPECT_EQ(50, capture.column(0, 15).max);
+  EXPECT_EQ(150, capture.column(0, 16).max);
+  Feed(capture, 1000, 150);
+  EXPECT_EQ(50, capture.column(0, 15).max);
+}
+
+TEST(ScopeCaptureTest, FallingEdgeAndLevelTriggers) {
+  Capture capture;
+  capture.Init(128, 1);
+  capture.set_trigger(util::SCOPE_TRIGGER_FALL, 100);
+  Feed(capture, 500, 200);
+  Feed(capture, 500, 20);
+  EXPECT_TRUE(capture.has_frame());
+  EXPECT_EQ(200, capture.column(0, 31).max);
+  EXPECT_EQ(20, capture.column(0, 32).max);
+
+  // Level triggering keeps capturing while the signal is high
+  capture.set_trigger(util::SCOPE_TRIGGER_HIGH, 100);
+  EXPECT_FALSE(capture.has_frame());
+  Feed(capture, 500, 20);
+  EXPECT_FALSE(capture.has_frame());
+  Feed(capture, 200, 200);
+  EXPECT_TRUE(capture.has_frame());
+}
+
+TEST(ScopeCaptureTest, ExternalTriggerNeedsHistory) {
+  Capture capture;
+  capture.Init(64, 1);
+  capture.set_trigger(util::SCOPE_TRIGGER_EXTERNAL, 0);
+  // Not enough pre-trigger columns yet
+  capture.Sample(10, 0, true);
+  EXPECT_FALSE(capture.triggered());
+
+  Feed(capture, 20, 10);
+  capture.Sample(99, 0, true);
+  EXPECT_TRUE(capture.triggered());
+  Feed(capture, 47, 10);
+  EXPECT_TRUE(capture.has_frame());
+  EXPECT_EQ(99, capture.column(0, 16).max);
+}
+
+TEST(ScopeCaptureTest, WidthChangeDropsFrame) {
+  Capture capture;
+  capture.Init(64, 1);
+  capture.set_trigger(util::SCOPE_TRIGGER_HIGH, 0);
+  Feed(capture, 100, 10);
+  EXPECT_TRUE(capture.has_frame());
+  capture.set_width(128);
+  EXPECT_FALSE(capture.has_frame());
+  EXPECT_EQ(128U, capture.width());
+}
@@ -107,3 +107,83 @@ TEST(TestSettings,TestPackU4OddEnd)
   EXPECT_EQ(-1, settings.get_value(0));
   EXPECT_EQ(0x09, settings.get_value(1));
 }
+
+class TestAllTypesSettings : public settings::SettingsBase<TestAllTypesSettings, 9> { };
+SETTINGS_DECLARE(TestAllTypesSettings, 9) {
+  { 1, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { -2, -128, 127, "I8", nullptr, settings::STORAGE_TYPE_I8 },
+  { 3, 0, 255, "U8", nullptr, settings::STORAGE_TYPE_U8 },
+  { 4, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { 5, 0, 15, "U4", nullptr, settings::STORAGE_TYPE_U4 },
+  { -6, -32768, 32767, "I16", nullptr, settings::STORAGE_TYPE_I16 },
+  { 7, 0, 65535, "U16", nullptr, settings::STORAGE_TYPE_U16 },
+  { -8, -100000, 100000, "I32", nullptr, settings::STORAGE_TYPE_I32 },
+  { 9, 0, 0x7fffffff, "U32", nullptr, settings::STORAGE_TYPE_U32 },
+};
+
+TEST(TestSettings,TestAllTypesLayout)
+{
+  // The stored layout is what ends up in EEPROM, so it must not change
+  static const uint8_t kExpected[] = {
+    0x10, // U4 + padding
+    0xfe, // I8
+    0x03, // U8
+    0x45, // U4, U4
+    0xfa, 0xff, // I16
+    0x07, 0x00, // U16
+    0xf8, 0xff, 0xff, 0xff, // I32
+    0x09, 0x00, 0x00, 0x00, // U32
+  };
+  ASSERT_EQ(sizeof(kExpected), TestAllTypesSettings::storageSize());
+
+  TestAllTypesSettings settings;
+  settings.InitDefaults();
+  uint8_t data[sizeof(kExpected) + 1];
+  memset(data, 0xff, sizeof(data));
+  EXPECT_EQ(sizeof(kExpected), settings.Save(data));
+  EXPECT_EQ(0, memcmp(kExpected, data, sizeof(kExpected)));
+  EXPECT_EQ(0xff, data[sizeof(kExpected)]);
+}
+
+TEST(TestSettings,TestAllTypesRoundTrip)
+{
+  const int values[][9] = {
+    { 0, -128, 0, 0, 0, -32768, 0, -100000, 0 },
+    { 15, 127, 255, 15, 15, 32767, 65535, 100000, 0x7fffffff },
+    { 9, -1, 128, 6, 10, -1, 32768, -1, 0x12345678 },
+  };
+
+  for (auto &v : values) {
+    TestAllTypesSettings settings;
+    settings.InitDefaults();
+    for (size_t i = 0; i < 9; ++i)
+      settings.apply_value(i, v[i]);
+
+    std::vector<uint8_t> data(TestAllTypesSettings::storageSize());
+    EXPECT_EQ(data.size(), settings.Save(&data.front()));
+
+    TestAllTypesSettings restored;
+    restored.InitDefaults();
+    EXPECT_EQ(data.size(), restored.Restore(&data.front()));
+    for (size_t i = 0; i < 9; ++i)
+      EXPECT_EQ(v[i], restored.get_value(i)) << "setting " << i;
+  }
+}
+
+TEST(TestSettings,TestRestoreClamps)
+{
+  // Stale or corrupt data must still produce values within the limits
+  TestAllTypesSettings settings;
+  settings.InitDefaults();
+  std::vector<uint8_t> data(TestAllTypesSettings::storageSize(), 0xff);
+  EXPECT_EQ(data.size(), settings.Restore(&data.front()));
+
+  for (size_t i = 0; i < 9; ++i) {
+    const settings::value_attr &attr = TestAllTypesSettings::value_attr(i);
+    EXPECT_GE(settings.get_value(i), attr.min_) << "setting " << i;
+    EXPECT_LE(settings.get_value(i), attr.max_) << "setting " << i;
+  }
+  EXPECT_EQ(15, settings.get_value(0));
+  EXPECT_EQ(-1, settings.get_value(1));
+  EXPECT_EQ(0, settings.get_value(8)); // 0xffffffff is -1 as int
+}
@@ -0,0 +1,257 @@
+#include "gtest/gtest.h"
+#include "vector_osc/HSVectorOscillator.h"
+#include "vector_osc/WaveformManager.h"
+#include "reference_vector_oscillator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// The table-driven VectorOscillator against the original segment walker, for
+// the user waveforms and the waveform library.
+//
+// The original times each segment to whole ticks and carries the rounding of
+// its per-tick rise into the next one, so the two are compared allowing for
+// timing differences of a few ticks: each output has to be within the range the
+// other one covers around the same tick, give or take one tick's worth of
+// change.
+
+namespace {
+
+constexpr int kScale = 7680;
+
+class VectorOscillatorTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    WaveformManager::Setup();
+
+    // A few more user waveforms: random ones, with segments of no time among
+    // them, and the longest there can be
+    std::mt19937 rng(7);
+    for (int w = 0; w < 4; ++w) {
+      WaveformManager::AddWaveform();
+      byte number = WaveformManager::WaveformCount() - 1;
+      int segments = w == 3 ? hemisphere::VO_MAX_SEGMENTS : 3 + w * 2;
+      for (int s = 2; s < segments; ++s)
+        WaveformManager::AddSegmentToWaveformAtSegmentIndex(number, 0);
+      for (int s = 0; s < segments; ++s) {
+        VOSegment segment;
+        segment.level = rng() & 0xff;
+        segment.time = rng() % 4 ? rng() % 60 : 0;
+        if (s == 0) segment.time = std::max<byte>(segment.time, 1);
+        WaveformManager::Update(number, s, &segment);
+      }
+    }
+  }
+
+  std::vector<byte> Waveforms() const {
+    std::vector<byte> numbers;
+    for (byte w = 0; w < WaveformManager::WaveformCount(); ++w)
+      numbers.push_back(w);
+    for (byte w = 0; w < hemisphere::WAVEFORM_LIBRARY_COUNT; ++w)
+      numbers.push_back(32 + w);
+    return numbers;
+  }
+
+  void Load(byte waveform, uint32_t frequency, bool cycle = true) {
+    osc_ = WaveformManager::VectorOscillatorFromWaveform(waveform);
+    reference_ = ReferenceVectorOscillator();
+    for (byte s = 0; s < osc_.SegmentCount(); ++s)
+      reference_.SetSegment(osc_.GetSegment(s));
+    Setup(osc_, frequency, cycle);
+    Setup(reference_, frequency, cycle);
+  }
+
+  template <typename Osc>
+  static void Setup(Osc &osc, uint32_t frequency, bool cycle) {
+    osc.SetScale(kScale);
+    osc.SetFrequency(frequency);
+    osc.Cycle(cycle);
+    osc.Offset(0);
+  }
+
+  // The largest change from one sample to the next, leaving out jumps
+  // (segments with no time), which aren't a rate
+  static int32_t Step(const std::vector<int32_t> &samples) {
+    int32_t step = 0;
+    for (size_t t = 1; t < samples.size(); ++t)
+      step = std::max(step, abs(samples[t] - samples[t - 1]));
+    return std::min(step, kScale / 16);
+  }
+
+  // Samples [first, last) of each within the other's range over +/- window
+  // samples, give or take the tolerance
+  static void ExpectTracks(const std::vector<int32_t> &a, const std::vector<int32_t> &b,
+                           size_t first, size_t last, size_t window, int32_t tolerance,
+                           const std::string &what) {
+    for (size_t t = first; t < last; ++t) {
+      size_t begin = t > window ? t - window : 0;
+      auto range = std::minmax_element(b.begin() + begin, b.begin() + t + window + 1);
+      ASSERT_GE(a[t], *range.first - tolerance) << what << " at " << t;
+      ASSERT_LE(a[t], *range.second + tolerance) << what << " at " << t;
+    }
+  }
+
+  static void ExpectMatches(const std::vector<int32_t> &out,
+                            const std::vector<int32_t> &expected, size_t first, size_t last,
+                            size_t window, int32_t tolerance, const std::string &what) {
+    ExpectTracks(out, expected, first, last, window, tolerance, what + " (new in original)");
+    ExpectTracks(expected, out, first, last, window, tolerance, what + " (original in new)");
+  }
+
+  // Runs both for count ticks (and the window after), calling event on each
+  // one first
+  template <typename Event>
+  void Run(size_t count, size_t window, std::vector<int32_t> &out,
+           std::vector<int32_t> &expected, Event event) {
+    for (size_t t = 0; t < count + window; ++t) {
+      event(t);
+      out.push_back(osc_.Next());
+      expected.push_back(reference_.Next());
+    }
+  }
+
+  // The original overshoots each level by up to a tick's change, and a tick
+  // in between two samples of the new one is a tick's change off
+  static int32_t TickTolerance(const std::vector<int32_t> &out,
+                               const std::vector<int32_t> &expected) {
+    return 2 * std::max(Step(out), Step(expected)) + 2;
+  }
+
+  VectorOscillator osc_;
+  ReferenceVectorOscillator reference_;
+};
+
+std::string Name(byte waveform, uint32_t frequency) {
+  return "waveform " + std::to_string(waveform) + " at " + std::to_string(frequency) + "cHz";
+}
+
+TEST_F(VectorOscillatorTest, Cycling) {
+  for (byte waveform : Waveforms()) {
+    for (uint32_t frequency : {50, 200, 1000}) {
+      Load(waveform, frequency);
+      osc_.Reset();
+      reference_.Reset();
+      size_t cycle_ticks = 1666667 / frequency;
+      // The original rounds each segment to whole ticks, and its rise is short
+      // by up to 0.5% at these rates, so it falls behind over the cycle
+      size_t window = 2 + osc_.SegmentCount() + cycle_ticks / 200;
+      std::vector<int32_t> out, expected;
+      Run(cycle_ticks, window, out, expected, [](size_t) {});
+      ExpectMatches(out, expected, 0, cycle_ticks, window, TickTolerance(out, expected),
+                    Name(waveform, frequency));
+    }
+  }
+}
+
+// Cycle length and EOC, over a few cycles
+TEST_F(VectorOscillatorTest, EndOfCycle) {
+  for (byte waveform : Waveforms()) {
+    Load(waveform, 1000);
+    osc_.Reset();
+    std::vector<size_t> eoc;
+    for (size_t t = 0; t < 1667 * 2 + 800; ++t) {
+      osc_.Next();
+      if (osc_.GetEOC()) eoc.push_back(t);
+    }
+    ASSERT_EQ(2U, eoc.size()) << Name(waveform, 1000);
+    EXPECT_NEAR(1666.67, eoc[0] + 1, 1) << Name(waveform, 1000);
+    EXPECT_NEAR(1666.67, eoc[1] - eoc[0], 1) << Name(waveform, 1000);
+  }
+}
+
+// One-shot: runs through once and holds the last level
+TEST_F(VectorOscillatorTest, NonCycling) {
+  for (byte waveform : Waveforms()) {
+    Load(waveform, 1000, false);
+    std::vector<int32_t> out, expected;
+    size_t window = 2 + osc_.SegmentCount() + 1666 / 200;
+    Run(3000, window, out, expected, [this](size_t t) {
+      if (t == 100) {
+        osc_.Start();
+        reference_.Start();
+      }
+    });
+    ExpectMatches(out, expected, 0, 3000, window, TickTolerance(out, expected),
+                  Name(waveform, 1000));
+    EXPECT_TRUE(osc_.GetEOC());
+  }
+}
+
+// Envelopes: sustain at the end of the penultimate segment, then release from
+// there or from wherever the signal got to if the gate was short
+TEST_F(VectorOscillatorTest, SustainRelease) {
+  for (byte waveform : Waveforms()) {
+    for (size_t release : {100, 900, 2000}) {
+      Load(waveform, 500, false);
+      osc_.Sustain();
+      reference_.Sustain();
+      std::vector<int32_t> out, expected;
+      size_t window = 2 + osc_.SegmentCount() + 3333 / 200;
+      Run(6000, window, out, expected, [&](size_t t) {
+        if (t == 0) {
+          osc_.Start();
+          reference_.Start();
+        }
+        if (t == release) {
+          osc_.Release();
+          reference_.Release();
+        }
+      });
+      // Each releases from wherever it had got to, and the original may have
+      // been a few ticks behind
+      std::string name = Name(waveform, 500) + " released at " + std::to_string(release);
+      int32_t tolerance = TickTolerance(out, expected);
+      int32_t gap = abs(out[release - 1] - expected[release - 1]);
+      ExpectMatches(out, expected, 0, release - window, window, tolerance, name);
+      ExpectMatches(out, expected, release - window, 6000, window, tolerance + gap, name);
+    }
+  }
+}
+
+// The waveform as drawn, for a phase in cycles
+double Exact(VectorOscillator &osc, double phase) {
+  auto level = [&osc](int ix) {
+    int b_level = osc.GetSegment(ix).level - 128;
+    return static_cast<double>((((b_level << 10) / 127) * kScale) >> 10);
+  };
+  int total = 0;
+  for (byte s = 0; s < osc.SegmentCount(); ++s) total += osc.GetSegment(s).time;
+  double time = std::max(0.0, phase * total);
+  int start = 0;
+  byte s = 0;
+  while (start + osc.GetSegment(s).time <= time) start += osc.GetSegment(s++).time;
+  double from = level(s ? s - 1 : osc.SegmentCount() - 1);
+  return from + (level(s) - from) * (time - start) / osc.GetSegment(s).time;
+}
+
+// The original works out where the segments are to 1/1024 of the cycle, so its
+// output is a few tenths of a degree off, and overshoots around some of the
+// corners; the new one is checked against the waveform as drawn, and for being
+// within what the original covers
+TEST_F(VectorOscillatorTest, Phase) {
+  for (byte waveform : Waveforms()) {
+    Load(waveform, 100);
+    std::vector<int32_t> out, expected;
+    for (int degrees = 0; degrees < 3600 + 8; ++degrees) {
+      out.push_back(osc_.Phase(degrees));
+      expected.push_back(reference_.Phase(degrees));
+      ASSERT_EQ(out.back(), osc_.Phase(-degrees));
+      // The segments start to 1/65536 of the cycle (about 0.05 tenths of a
+      // degree), which matters at jumps and on the steepest slopes
+      if (degrees < 3600) {
+        double low = 1e9, high = -1e9;
+        for (double d = degrees - 0.2; d <= degrees + 0.2; d += 0.01) {
+          low = std::min(low, Exact(osc_, d / 3600.0));
+          high = std::max(high, Exact(osc_, d / 3600.0));
+        }
+        ASSERT_GE(out.back(), low - 4) << "waveform " << int(waveform) << " at " << degrees;
+        ASSERT_LE(out.back(), high + 4) << "waveform " << int(waveform) << " at " << degrees;
+      }
+    }
+    ExpectTracks(out, expected, 0, 3600, 8, 2 * Step(out) + 2,
+                 "waveform " + std::to_string(waveform));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "braids/quantizer.h"
+
+#include <stdlib.h>
+
+// The original linear scan over the notes in braids::Quantizer::Process, kept
+// as the reference for the table-driven version (tests and fuzzer)
+
+struct ReferenceQuantizer {
+  int32_t codeword = 0;
+  int32_t transpose = 0;
+  int32_t previous_boundary = 0;
+  int32_t next_boundary = 0;
+  int32_t span = 0;
+  int16_t notes[16];
+  uint8_t num_notes = 0;
+  uint16_t note_number = 0;
+  bool requantize = false;
+
+  void Configure(const braids::Scale &scale, uint16_t mask) {
+    num_notes = 0;
+    for (uint16_t i = 0; i < scale.num_notes; i++) {
+      if (mask & 1) notes[num_notes++] = scale.notes[i];
+      mask >>= 1;
+    }
+    span = scale.span;
+  }
+
+  bool enabled() const {
+    return num_notes != 0 && span != 0;
+  }
+
+  int32_t Process(int32_t pitch, int32_t root, int32_t transpose_) {
+    if (!enabled())
+      return pitch;
+
+    const int32_t kOffset = (12 << 7) << 1;
+    pitch -= root;
+    pitch -= kOffset;
+
+    if (!requantize && pitch >= previous_boundary && pitch <= next_boundary && transpose_ == transpose) {
+      pitch = codeword;
+    } else {
+      requantize = false;
+      int16_t octave = pitch / span - (pitch < 0 ? 1 : 0);
+      int16_t rel_pitch = pitch - span * octave;
+
+      int16_t best_distance = 16384;
+      int16_t q = -1;
+      for (int16_t i = 0; i < num_notes; i++) {
+        int16_t distance = abs(rel_pitch - notes[i]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          q = i;
+        }
+      }
+
+      if (abs(pitch - (octave + 1) * span - notes[0]) < best_distance) {
+        octave++;
+        q = 0;
+      } else if (abs(pitch - (octave - 1) * span - notes[num_notes - 1]) <= best_distance) {
+        octave--;
+        q = num_notes - 1;
+      }
+
+      codeword = notes[q] + octave * span;
+      previous_boundary = q == 0
+        ? notes[num_notes - 1] + (octave - 1) * span
+        : notes[q - 1] + octave * span;
+      previous_boundary = (10 * previous_boundary + 6 * codeword) >> 4;
+
+      next_boundary = q == num_notes - 1
+        ? notes[0] + (octave + 1) * span
+        : notes[q + 1] + octave * span;
+      next_boundary = (10 * next_boundary + 6 * codeword) >> 4;
+
+      q += transpose_;
+      octave += q / num_notes;
+      q %= num_notes;
+      if (q < 0) {
+        q += num_notes;
+        octave--;
+      }
+
+      note_number = octave * num_notes + q;
+      codeword = notes[q] + octave * span;
+      transpose = transpose_;
+      pitch = codeword;
+    }
+    return pitch + root + kOffset;
+  }
+};
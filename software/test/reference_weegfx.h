@@ -0,0 +1,158 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include "drivers/weegfx.h"
+
+// The original byte-at-a-time weegfx fills and text, kept as the reference for
+// the word-at-a-time versions. Only the primitives that changed are here; they
+// draw into the same page-organized frame as weegfx::Graphics.
+
+// The value is evaluated for each pixel, so a *src++ walks the glyph
+#define REFERENCE_SETPIXELS_H(start, count, value) \
+do { \
+  uint8_t *ptr = start; \
+  size_t n = count; \
+  while (n--) { \
+    *ptr++ |= value; \
+  }; \
+} while (0)
+
+class ReferenceGraphics {
+public:
+  typedef weegfx::coord_t coord_t;
+
+  static const uint8_t kWidth = weegfx::Graphics::kWidth;
+  static const uint8_t kHeight = weegfx::Graphics::kHeight;
+  static const coord_t kFixedFontW = weegfx::Graphics::kFixedFontW;
+  static const coord_t kFixedFontH = weegfx::Graphics::kFixedFontH;
+
+  enum DRAW_MODE {
+    DRAW_NORMAL,
+    DRAW_INVERSE,
+    DRAW_OVERWRITE,
+    DRAW_CLEAR,
+  };
+
+  ReferenceGraphics(uint8_t *frame, const uint8_t *font) : frame_(frame), font_(font) { }
+
+  void drawRect(coord_t x, coord_t y, coord_t w, coord_t h) {
+    if (!clip(x, w, y, h)) return;
+    draw_rect<DRAW_NORMAL>(get_frame_ptr(x, y), y, w, h);
+  }
+
+  void clearRect(coord_t x, coord_t y, coord_t w, coord_t h) {
+    if (!clip(x, w, y, h)) return;
+    draw_rect<DRAW_CLEAR>(get_frame_ptr(x, y), y, w, h);
+  }
+
+  void invertRect(coord_t x, coord_t y, coord_t w, coord_t h) {
+    if (!clip(x, w, y, h)) return;
+    draw_rect<DRAW_INVERSE>(get_frame_ptr(x, y), y, w, h);
+  }
+
+  void drawHLine(coord_t x, coord_t y, coord_t w) {
+    coord_t h = 1;
+    if (!clip(x, w, y, h)) return;
+    draw_pixel_row<DRAW_NORMAL>(get_frame_ptr(x, y), w, 0x1 << (y & 0x7));
+  }
+
+  void draw_char(char c, coord_t x, coord_t y) {
+    if (!c) c = '0';
+    if (c <= 32 || c > 127)
+      return;
+
+    coord_t w = kFixedFontW;
+    coord_t h = kFixedFontH;
+    const uint8_t *data = font_ + kFixedFontW * (c - 32);
+    if (c + w > kWidth) w = kWidth - x;
+    if (x < 0) {
+      w += x;
+      data += x;
+    }
+    if (w <= 0) return;
+    if (y + h > kHeight) h = kHeight - y;
+    if (y < 0) { h += y; y = 0; }
+    if (h <= 0) return;
+
+    uint8_t *dest = get_frame_ptr(x, y);
+    coord_t remainder = y & 0x7;
+    if (!remainder) {
+      REFERENCE_SETPIXELS_H(dest, w, *data++);
+    } else {
+      const uint8_t *src = data;
+      REFERENCE_SETPIXELS_H(dest, w, (*src++) << remainder);
+      if (h >= 8) {
+        dest += kWidth;
+        src = data;
+        REFERENCE_SETPIXELS_H(dest, w, (*src++) >> (8 - remainder));
+      }
+    }
+  }
+
+  void drawStr(coord_t x, coord_t y, const char *s) {
+    while (*s) {
+      draw_char(*s++, x, y);
+      x += kFixedFontW;
+    }
+  }
+
+private:
+  uint8_t *frame_;
+  const uint8_t *font_;
+
+  uint8_t *get_frame_ptr(const coord_t x, const coord_t y) {
+    return frame_ + ((y >> 3) << 7) + x;
+  }
+
+  static bool clip(coord_t &x, coord_t &w, coord_t &y, coord_t &h) {
+    if (x + w > kWidth) w = kWidth - x;
+    if (x < 0) { w += x; x = 0; }
+    if (w <= 0) return false;
+    if (y + h > kHeight) h = kHeight - y;
+    if (y < 0) { h += y; y = 0; }
+    return h > 0;
+  }
+
+  template <DRAW_MODE draw_mode>
+  static void draw_pixel_row(uint8_t *dst, coord_t count, uint8_t mask) {
+    while (count-- > 0x0) {
+      switch (draw_mode) {
+        case DRAW_NORMAL: *dst++ |= mask; break;
+        case DRAW_INVERSE: *dst++ ^= mask; break;
+        case DRAW_OVERWRITE: *dst++ = mask; break;
+        case DRAW_CLEAR: *dst++ &= ~mask; break;
+      }
+    }
+  }
+
+  template <DRAW_MODE draw_mode>
+  static void draw_rect(uint8_t *buf, coord_t y, coord_t w, coord_t h) {
+    coord_t remainder = y & 0x7;
+    if (remainder) {
+      remainder = 8 - remainder;
+      uint8_t mask = ~(0xff >> remainder);
+      if (h < remainder) {
+        mask &= (0xff >> (remainder - h));
+        h = 0;
+      } else {
+        h -= remainder;
+      }
+
+      draw_pixel_row<draw_mode>(buf, w, mask);
+      buf += kWidth;
+    }
+
+    remainder = h & 0x7;
+    h >>= 3;
+    while (h--) {
+      draw_pixel_row<draw_mode>(buf, w, 0xff);
+      buf += kWidth;
+    }
+
+    if (remainder) {
+      draw_pixel_row<draw_mode>(buf, w, ~(0xff << remainder));
+    }
+  }
+};